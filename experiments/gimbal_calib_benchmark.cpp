@@ -0,0 +1,200 @@
+#include "gvio/gimbal/calibration/calibration.hpp"
+
+using namespace gvio;
+
+// Calibration target observed by the static camera
+#define TARGET_ROWS 10
+#define TARGET_COLS 10
+#define TARGET_SPACING 0.05
+#define TARGET_DEPTH 1.0
+
+void print_usage() {
+  // Usage
+  std::cout << "Usage: gimbal_calib_benchmark ";
+  std::cout << "<camchain_file> <joint_file> ";
+  std::cout << "[nb_repeats] [linear_solver]" << std::endl;
+
+  // Example
+  std::cout << "Example: gimbal_calib_benchmark ";
+  std::cout << "tests/test_configs/gimbal/calibration/camchain.yaml ";
+  std::cout << "tests/test_data/calibration/joint.csv 20 SPARSE_SCHUR";
+  std::cout << std::endl;
+}
+
+/**
+ * Repeat joint angles with jitter to form a larger problem
+ */
+int form_joint_file(const std::string &joint_file,
+                    const int nb_repeats,
+                    const std::string &output_file) {
+  MatX joint_data;
+  if (csv2mat(joint_file, false, joint_data) != 0) {
+    LOG_ERROR("Failed to load joint angles file [%s]!", joint_file.c_str());
+    return -1;
+  }
+
+  const long nb_rows = joint_data.rows();
+  MatX output = zeros(nb_rows * nb_repeats, 2);
+  for (int n = 0; n < nb_repeats; n++) {
+    for (long i = 0; i < nb_rows; i++) {
+      const double jitter = (n == 0) ? 0.0 : 0.05;
+      output(n * nb_rows + i, 0) = joint_data(i, 0) + randf(jitter, -jitter);
+      output(n * nb_rows + i, 1) = joint_data(i, 1) + randf(jitter, -jitter);
+    }
+  }
+
+  return mat2csv(output_file, output);
+}
+
+/**
+ * Synthesize corner observations of a calibration target seen by both
+ * cameras, using the loaded params as ground truth
+ */
+void synthesize_data(CalibParams &params, CalibData &data) {
+  GimbalCalibResidual chain;
+  const Mat3 K_s = params.camchain.cam[0].K();
+  const Mat3 K_d = params.camchain.cam[2].K();
+  const Vec4 D_s = params.camchain.cam[0].D();
+  const Vec4 D_d = params.camchain.cam[2].D();
+  const Vec2 res_s = params.camchain.cam[0].resolution;
+  const Vec2 res_d = params.camchain.cam[2].resolution;
+
+  data.nb_measurements = params.nb_measurements;
+  for (int i = 0; i < params.nb_measurements; i++) {
+    const Mat4 T_ds = chain.T_ds(params.tau_s,
+                                 params.tau_d,
+                                 params.w1,
+                                 params.w2,
+                                 &params.Lambda1[i],
+                                 &params.Lambda2[i]);
+
+    std::vector<Vec3> P_s;
+    std::vector<Vec3> P_d;
+    std::vector<Vec2> Q_s;
+    std::vector<Vec2> Q_d;
+    for (int r = 0; r < TARGET_ROWS; r++) {
+      for (int c = 0; c < TARGET_COLS; c++) {
+        const double x = (c - (TARGET_COLS - 1) / 2.0) * TARGET_SPACING;
+        const double y = (r - (TARGET_ROWS - 1) / 2.0) * TARGET_SPACING;
+        const Vec3 p_s{x, y, TARGET_DEPTH};
+        const Vec3 p_d = (T_ds * p_s.homogeneous()).head(3);
+        if (p_d(2) < 0.1) {
+          continue;
+        }
+
+        // Only keep corners seen by both cameras
+        const Vec2 q_s = chain.project_pinhole_equi(K_s, D_s, p_s);
+        const Vec2 q_d = chain.project_pinhole_equi(K_d, D_d, p_d);
+        if ((q_s.array() < 0.0).any() || (q_s.array() > res_s.array()).any() ||
+            (q_d.array() < 0.0).any() || (q_d.array() > res_d.array()).any()) {
+          continue;
+        }
+
+        P_s.push_back(p_s);
+        P_d.push_back(p_d);
+        Q_s.push_back(q_s);
+        Q_d.push_back(q_d);
+      }
+    }
+
+    MatX P_s_i(P_s.size(), 3);
+    MatX P_d_i(P_d.size(), 3);
+    MatX Q_s_i(Q_s.size(), 2);
+    MatX Q_d_i(Q_d.size(), 2);
+    for (size_t j = 0; j < P_s.size(); j++) {
+      P_s_i.row(j) = P_s[j].transpose();
+      P_d_i.row(j) = P_d[j].transpose();
+      Q_s_i.row(j) = Q_s[j].transpose();
+      Q_d_i.row(j) = Q_d[j].transpose();
+    }
+    data.P_s.push_back(P_s_i);
+    data.P_d.push_back(P_d_i);
+    data.Q_s.push_back(Q_s_i);
+    data.Q_d.push_back(Q_d_i);
+  }
+}
+
+/**
+ * Solve calibration problem and report timings
+ */
+int benchmark(const std::string &name,
+              const std::string &camchain_file,
+              const std::string &joint_file,
+              const std::string &linear_solver,
+              const bool per_measurement) {
+  // Setup problem
+  GimbalCalib calib;
+  calib.per_measurement = per_measurement;
+  if (calib.params.load(camchain_file, joint_file) != 0) {
+    LOG_ERROR("Failed to load optimization params!");
+    return -1;
+  }
+  synthesize_data(calib.params, calib.data);
+  if (calib.setup() != 0) {
+    LOG_ERROR("Failed to setup calibration problem!");
+    return -1;
+  }
+
+  // Perturb initial estimate
+  for (int i = 0; i < 3; i++) {
+    calib.params.tau_s[i] += 0.01;
+    calib.params.tau_d[i] -= 0.01;
+    calib.params.tau_s[i + 3] += 0.02;
+    calib.params.tau_d[i + 3] -= 0.02;
+  }
+  calib.params.w1[0] += 0.01;
+
+  // Solve
+  calib.linear_solver = linear_solver;
+  calib.nb_threads = 1;
+  calib.max_iterations = 100;
+  calib.verbose = false;
+  if (calib.setupSolver() != 0) {
+    LOG_ERROR("Failed to setup solver!");
+    return -1;
+  }
+  ceres::Solve(calib.options, &calib.problem, &calib.summary);
+
+  // Report
+  const ceres::Solver::Summary &summary = calib.summary;
+  printf("%-12s ", name.c_str());
+  printf("residual blocks: %5d  ", calib.problem.NumResidualBlocks());
+  printf("iterations: %3d  ", (int) summary.iterations.size());
+  printf("final cost: %.3e  ", summary.final_cost);
+  printf("residual eval: %.4fs  ", summary.residual_evaluation_time_in_seconds);
+  printf("jacobian eval: %.4fs  ", summary.jacobian_evaluation_time_in_seconds);
+  printf("linear solver: %.4fs  ", summary.linear_solver_time_in_seconds);
+  printf("total: %.4fs\n", summary.total_time_in_seconds);
+
+  return 0;
+}
+
+int main(const int argc, const char *argv[]) {
+  // Parse cli args
+  if (argc < 3 || argc > 5) {
+    print_usage();
+    return -1;
+  }
+  const std::string camchain_file(argv[1]);
+  const std::string joint_file(argv[2]);
+  const int nb_repeats = (argc >= 4) ? atoi(argv[3]) : 1;
+  const std::string solver = (argc == 5) ? argv[4] : "SPARSE_SCHUR";
+
+  // Form joint angles file
+  const std::string bench_joint_file = "/tmp/gimbal_calib_benchmark_joint.csv";
+  if (form_joint_file(joint_file, nb_repeats, bench_joint_file) != 0) {
+    LOG_ERROR("Failed to form joint angles file!");
+    return -1;
+  }
+
+  // Compare autodiff per corner against analytic per measurement
+  const std::string &joints = bench_joint_file;
+  if (benchmark("autodiff", camchain_file, joints, solver, false) != 0) {
+    return -1;
+  }
+  if (benchmark("analytic", camchain_file, joints, solver, true) != 0) {
+    return -1;
+  }
+
+  return 0;
+}
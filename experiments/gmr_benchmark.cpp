@@ -0,0 +1,114 @@
+#include "gvio/util/util.hpp"
+#include "gvio/gimbal/gmr/gmr.hpp"
+
+using namespace gvio;
+
+void print_usage() {
+  // Usage
+  std::cout << "Usage: gmr_benchmark ";
+  std::cout << "<image_dir> [nb_repeats]" << std::endl;
+
+  // Example
+  std::cout << "Example: gmr_benchmark ";
+  std::cout << "tests/test_data/kitti/raw/2011_09_26/";
+  std::cout << "2011_09_26_drive_0001_sync/image_02/data 10" << std::endl;
+}
+
+/**
+ * Load image sequence, images are sorted by file name
+ */
+int load_images(const std::string &image_dir, std::vector<cv::Mat> &images) {
+  std::vector<std::string> files;
+  if (list_dir(image_dir, files) != 0) {
+    LOG_ERROR("Failed to list image dir [%s]!", image_dir.c_str());
+    return -1;
+  }
+  std::sort(files.begin(), files.end());
+
+  for (const auto &file : files) {
+    cv::Mat image = cv::imread(image_dir + "/" + file, cv::IMREAD_COLOR);
+    if (image.empty()) {
+      continue;
+    }
+    images.push_back(image);
+  }
+  if (images.empty()) {
+    LOG_ERROR("No images in [%s]!", image_dir.c_str());
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+ * Per-frame latency statistics
+ */
+struct Latency {
+  std::vector<float> samples;
+
+  void print(const std::string &name) {
+    std::sort(samples.begin(), samples.end());
+    const float sum = std::accumulate(samples.begin(), samples.end(), 0.0f);
+    printf("%-8s ", name.c_str());
+    printf("frames: %4zu  ", samples.size());
+    printf("mean: %7.2fms  ", sum / samples.size());
+    printf("median: %7.2fms  ", samples[samples.size() / 2]);
+    printf("max: %7.2fms\n", samples.back());
+  }
+};
+
+int main(const int argc, const char *argv[]) {
+  // Parse cli args
+  if (argc < 2 || argc > 3) {
+    print_usage();
+    return -1;
+  }
+  const std::string image_dir(argv[1]);
+  const int nb_repeats = (argc == 3) ? atoi(argv[2]) : 1;
+
+  // Load images
+  std::vector<cv::Mat> images;
+  if (load_images(image_dir, images) != 0) {
+    return -1;
+  }
+
+  // Play the sequence forwards and backwards so it has no jump when repeated
+  std::vector<cv::Mat> sequence;
+  for (int n = 0; n < nb_repeats; n++) {
+    if (n % 2 == 0) {
+      sequence.insert(sequence.end(), images.begin(), images.end());
+    } else {
+      sequence.insert(sequence.end(), images.rbegin(), images.rend());
+    }
+  }
+
+  // Compare full recompute against the incremental session
+  GMR gmr_full;
+  GMR gmr_session;
+  Latency full;
+  Latency session;
+  int nb_reused = 0;
+  double diff = 0.0;
+  for (const auto &image : sequence) {
+    cv::Mat input = image.clone();
+    struct timespec t_full = tic();
+    const cv::Mat sal_full = gmr_full.GetSal(input);
+    full.samples.push_back(mtoc(&t_full));
+
+    input = image.clone();
+    struct timespec t_session = tic();
+    const cv::Mat sal_session = gmr_session.Update(input);
+    session.samples.push_back(mtoc(&t_session));
+
+    nb_reused += (gmr_session.graph_reused) ? 1 : 0;
+    diff += cv::norm(sal_full, sal_session, cv::NORM_L1) / sal_full.total();
+  }
+
+  // Report
+  full.print("full");
+  session.print("session");
+  printf("graph reused: %d/%zu frames  ", nb_reused, sequence.size());
+  printf("mean abs saliency diff: %.4f\n", diff / sequence.size());
+
+  return 0;
+}
@@ -0,0 +1,109 @@
+#include "gvio/util/util.hpp"
+#include "gvio/quadrotor/mission.hpp"
+
+using namespace gvio;
+
+void print_usage() {
+  // Usage
+  std::cout << "Usage: mission_benchmark [max_nb_waypoints]" << std::endl;
+
+  // Example
+  std::cout << "Example: mission_benchmark 10000 | grep -v INFO" << std::endl;
+}
+
+/**
+ * Lawnmower survey mission with rows 20m long and 5m apart
+ */
+std::vector<double> survey_waypoints(const int nb_waypoints) {
+  std::vector<double> wp_data;
+  for (int i = 0; i < nb_waypoints; i++) {
+    const int row = i / 2;
+    const bool row_start = ((i % 2) == 0) == ((row % 2) == 0);
+    wp_data.push_back(row_start ? 0.0 : 20.0);
+    wp_data.push_back(5.0 * row);
+    wp_data.push_back(10.0);
+  }
+  return wp_data;
+}
+
+/**
+ * Fly mission with a follower that moves towards the interpolated waypoint
+ */
+int fly_mission(Mission &mission, double &time) {
+  Vec3 position = mission.local_waypoints[0];
+  const double step = 0.2;
+  int nb_ticks = 0;
+  double heading = 0.0;
+  double error = 0.0;
+
+  struct timespec start = tic();
+  while (true) {
+    Vec3 waypoint;
+    if (mission.update(position, waypoint) != 0) {
+      break;
+    }
+    error += mission.crossTrackError(position);
+    heading += mission.waypointHeading();
+
+    const Vec3 dp = waypoint - position;
+    position += (dp.norm() > step) ? step * dp.normalized() : dp;
+    nb_ticks++;
+  }
+  time = toc(&start);
+
+  // Keep results alive
+  if (std::isnan(heading + error)) {
+    LOG_ERROR("Invalid cross track error or heading!");
+  }
+
+  return nb_ticks;
+}
+
+int main(const int argc, const char *argv[]) {
+  // Parse cli args
+  if (argc > 2) {
+    print_usage();
+    return -1;
+  }
+  const int max_nb_waypoints = (argc == 2) ? atoi(argv[1]) : 10000;
+  if (max_nb_waypoints < 2) {
+    print_usage();
+    return -1;
+  }
+
+  // Fly survey missions of increasing size, the time per tick should not
+  // depend on the number of waypoints
+  std::vector<std::string> results;
+  for (int nb_wps = 100; nb_wps <= max_nb_waypoints; nb_wps *= 10) {
+    Mission mission;
+    mission.configured = true;
+    mission.look_ahead_dist = 0.5;
+    mission.threshold_waypoint_reached = 0.2;
+
+    struct timespec start = tic();
+    if (mission.loadLocalWaypoints(survey_waypoints(nb_wps)) != 0) {
+      return -1;
+    }
+    const double load_time = toc(&start);
+
+    double fly_time = 0.0;
+    const int nb_ticks = fly_mission(mission, fly_time);
+
+    char buf[256];
+    snprintf(buf,
+             sizeof(buf),
+             "%6d waypoints: load %8.3fms, %8d ticks, %6.1f ns/tick",
+             nb_wps,
+             load_time * 1e3,
+             nb_ticks,
+             fly_time * 1e9 / nb_ticks);
+    results.emplace_back(buf);
+  }
+
+  // Print results after the waypoint reached messages
+  for (const auto &result : results) {
+    std::cout << result << std::endl;
+  }
+
+  return 0;
+}
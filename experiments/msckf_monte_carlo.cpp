@@ -0,0 +1,44 @@
+#include "gvio/msckf/monte_carlo.hpp"
+
+using namespace gvio;
+
+void print_usage() {
+  // Usage
+  std::cout << "Usage: msckf_monte_carlo ";
+  std::cout << "<config_file> [output_csv] [nb_runs] [seed]" << std::endl;
+
+  // Example
+  std::cout << "Example: msckf_monte_carlo ";
+  std::cout << "experiments/configs/msckf_monte_carlo.yaml ";
+  std::cout << "/tmp/msckf_monte_carlo.csv 100 42" << std::endl;
+}
+
+int main(const int argc, const char *argv[]) {
+  // Parse cli args
+  if (argc < 2 || argc > 5) {
+    print_usage();
+    return -1;
+  }
+  const std::string config_file(argv[1]);
+  const std::string output_path = (argc >= 3) ? argv[2] : "";
+
+  // Setup
+  MSCKFMonteCarlo monte_carlo;
+  if (monte_carlo.configure(config_file) != 0) {
+    LOG_ERROR("Failed to configure Monte Carlo runs [%s]!",
+              config_file.c_str());
+    return -1;
+  }
+  monte_carlo.nb_runs = (argc >= 4) ? atoi(argv[3]) : monte_carlo.nb_runs;
+  monte_carlo.seed = (argc == 5) ? atoi(argv[4]) : monte_carlo.seed;
+
+  // Run and report
+  monte_carlo.run();
+  monte_carlo.printReport();
+  if (output_path != "" && monte_carlo.saveResults(output_path) != 0) {
+    LOG_ERROR("Failed to save results to [%s]!", output_path.c_str());
+    return -1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,91 @@
+#include "gvio/msckf/msckf.hpp"
+#include "gvio/quaternion/jpl.hpp"
+#include "gvio/sim/world.hpp"
+
+using namespace gvio;
+
+void print_usage() {
+  // Usage
+  std::cout << "Usage: msckf_sim_benchmark ";
+  std::cout << "<msckf_config> [imu_rate] [camera_rate] [duration]";
+  std::cout << std::endl;
+
+  // Example
+  std::cout << "Example: msckf_sim_benchmark ";
+  std::cout << "experiments/configs/msckf_kitti_raw-2011_09_26-0005.yaml ";
+  std::cout << "1000 10 30" << std::endl;
+}
+
+int main(const int argc, const char *argv[]) {
+  // Parse cli args
+  if (argc < 2 || argc > 5) {
+    print_usage();
+    return -1;
+  }
+  const std::string config_file(argv[1]);
+  const double imu_rate = (argc >= 3) ? atof(argv[2]) : 200.0;
+  const double camera_rate = (argc >= 4) ? atof(argv[3]) : 10.0;
+  const double duration = (argc == 5) ? atof(argv[4]) : 10.0;
+
+  // Setup world with EuRoC like IMU noise
+  SimWorld world;
+  world.imu.rate = imu_rate;
+  world.imu.accel_noise_density = 2.0e-3;
+  world.imu.gyro_noise_density = 1.7e-4;
+  world.imu.accel_random_walk = 3.0e-3;
+  world.imu.gyro_random_walk = 1.9e-5;
+  world.pixel_noise = 0.5;
+  if (world.configure(1.0 / camera_rate) != 0) {
+    LOG_ERROR("Failed to configure world!");
+    return -1;
+  }
+  world.t_end = duration;
+
+  // Setup MSCKF
+  MSCKF msckf;
+  if (msckf.configure(config_file) != 0) {
+    LOG_ERROR("Failed to configure MSCKF [%s]!", config_file.c_str());
+    return -1;
+  }
+  msckf.initialize(0,
+                   euler2quat(world.robot.rpy_G),
+                   euler321ToRot(world.robot.rpy_G) * world.robot.v_B,
+                   world.robot.p_G);
+
+  // Feed simulated measurements to MSCKF
+  Histogram imu_time{0.0, 1.0, 1000};
+  Histogram camera_time{0.0, 100.0, 1000};
+  world.imu_cb = [&](const Vec3 &a_m, const Vec3 &w_m, const long ts) {
+    struct timespec start = tic();
+    const int retval = msckf.predictionUpdate(a_m, w_m, ts);
+    imu_time.add(mtoc(&start));
+    return retval;
+  };
+  world.camera_cb = [&](const FeatureTracks &tracks, const long) {
+    struct timespec start = tic();
+    const int retval = msckf.measurementUpdate(tracks);
+    camera_time.add(mtoc(&start));
+    return retval;
+  };
+
+  // Run and report
+  struct timespec start = tic();
+  const int retval = world.run();
+  const double wall_time = toc(&start);
+  if (retval != 0) {
+    LOG_ERROR("Simulation stopped at t = %.2fs!", world.t);
+  }
+
+  const Vec3 e = msckf.imu_state.p_G - world.robot.p_G;
+  std::cout << "simulated: " << world.t << "s  ";
+  std::cout << "wall time: " << wall_time << "s  ";
+  std::cout << "position error: " << e.norm() << "m" << std::endl;
+  std::cout << "IMU updates: " << imu_time.nb_samples << "  ";
+  std::cout << imu_time.nb_samples / wall_time << " Hz" << std::endl;
+  std::cout << "camera updates: " << camera_time.nb_samples << "  ";
+  std::cout << camera_time.nb_samples / wall_time << " Hz" << std::endl;
+  std::cout << "prediction [ms]: " << imu_time << std::endl;
+  std::cout << "measurement [ms]: " << camera_time << std::endl;
+
+  return retval;
+}
@@ -0,0 +1,93 @@
+#include "gvio/util/util.hpp"
+#include "gvio/quadrotor/quadrotor_batch.hpp"
+#include "gvio/quadrotor/quadrotor_model.hpp"
+
+using namespace gvio;
+
+void print_usage() {
+  // Usage
+  std::cout << "Usage: quadrotor_batch_benchmark ";
+  std::cout << "[nb_vehicles] [nb_steps]" << std::endl;
+
+  // Example
+  std::cout << "Example: quadrotor_batch_benchmark 1000 1000" << std::endl;
+}
+
+/**
+ * Print vehicle steps per second
+ */
+void print_rate(const std::string &name,
+                const int nb_vehicles,
+                const int nb_steps,
+                const double time) {
+  const double rate = (double) nb_vehicles * nb_steps / time;
+  printf("%-28s %8.3fs  %12.0f vehicle-steps/s\n", name.c_str(), time, rate);
+}
+
+/**
+ * Setup batch hovering at different heights with position setpoints
+ */
+void setup_batch(QuadrotorBatch &batch, const int nb_vehicles) {
+  batch.configure(nb_vehicles);
+  for (int k = 0; k < nb_vehicles; k++) {
+    batch.setPose(k, Vec3{0.0, 0.0, 0.0}, Vec3{0.0, 0.0, 5.0});
+    batch.position_setpoints[k] = Vec3{1.0, 1.0, 5.0 + 0.001 * k};
+    batch.setMotorInputs(k, Vec4{2.5, 2.5, 2.5, 2.5});
+  }
+}
+
+int main(const int argc, const char *argv[]) {
+  // Parse cli args
+  if (argc > 3) {
+    print_usage();
+    return -1;
+  }
+  const int nb_vehicles = (argc >= 2) ? atoi(argv[1]) : 1000;
+  const int nb_steps = (argc == 3) ? atoi(argv[2]) : 1000;
+  const double dt = 0.001;
+  if (nb_vehicles <= 0 || nb_steps <= 0) {
+    print_usage();
+    return -1;
+  }
+
+  // QuadrotorModel, one vehicle at a time
+  std::vector<QuadrotorModel> models;
+  for (int k = 0; k < nb_vehicles; k++) {
+    models.emplace_back(Vec3{0.0, 0.0, 0.0}, Vec3{0.0, 0.0, 5.0});
+    models.back().setPosition(Vec3{1.0, 1.0, 5.0 + 0.001 * k});
+  }
+  struct timespec start = tic();
+  for (int i = 0; i < nb_steps; i++) {
+    for (auto &model : models) {
+      model.update(dt);
+    }
+  }
+  print_rate("QuadrotorModel", nb_vehicles, nb_steps, toc(&start));
+
+  // Batch with controllers
+  QuadrotorBatch batch;
+  setup_batch(batch, nb_vehicles);
+  start = tic();
+  for (int i = 0; i < nb_steps; i++) {
+    batch.update(dt);
+  }
+  print_rate("QuadrotorBatch euler + ctrl", nb_vehicles, nb_steps, toc(&start));
+
+  // Batch dynamics only
+  setup_batch(batch, nb_vehicles);
+  start = tic();
+  for (int i = 0; i < nb_steps; i++) {
+    batch.integrate(dt);
+  }
+  print_rate("QuadrotorBatch euler", nb_vehicles, nb_steps, toc(&start));
+
+  setup_batch(batch, nb_vehicles);
+  batch.integrator = QB_RK4;
+  start = tic();
+  for (int i = 0; i < nb_steps; i++) {
+    batch.integrate(dt);
+  }
+  print_rate("QuadrotorBatch rk4", nb_vehicles, nb_steps, toc(&start));
+
+  return 0;
+}
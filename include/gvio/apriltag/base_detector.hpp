@@ -68,6 +68,20 @@ public:
   }
 };
 
+/**
+ * Tracked AprilTag, used to predict where to search in the next frame
+ */
+class TagTrack {
+public:
+  int id = -1;
+  Vec3 position{0.0, 0.0, 0.0}; ///< Last detected position (camera frame)
+  Vec3 velocity{0.0, 0.0, 0.0}; ///< Change in position per frame
+  int nb_missed = 0;            ///< Consecutive frames without detection
+
+  TagTrack() {}
+  TagTrack(const TagPose &pose) : id{pose.id}, position{pose.position} {}
+};
+
 class BaseDetector {
 public:
   bool configured = false;
@@ -94,6 +108,16 @@ public:
   double window_padding = FLT_MAX;
   bool imshow = false;
 
+  // Multi-tag tracking
+  bool tracking = false;          ///< Search only around tracked tags
+  double roi_padding = 0.5;       ///< ROI padding as a fraction of tag size
+  int full_search_interval = 10;  ///< Frames between full-frame searches
+  int full_search_decimation = 2; ///< Image decimation of full-frame search
+  int max_missed = 5;             ///< Frames before a lost tag is dropped
+  std::map<int, TagTrack> tracks;
+  int frames_since_search = 0;    ///< Frames since last full-frame search
+  bool full_search = false;       ///< Last frame ran a full-frame search
+
   BaseDetector() {}
   ~BaseDetector() {}
 
@@ -217,6 +241,42 @@ public:
                 cv::Mat &cropped_image,
                 const double padding = 0.5);
 
+  /**
+   * Predict region of interest of a tracked tag in the current frame
+   *
+   * The tag position is propagated with its velocity over the frames since
+   * it was last seen, and the ROI is padded by `roi_padding` tag sizes, plus
+   * half a tag size for every missed frame.
+   *
+   * @param image Image
+   * @param track Tracked tag
+   * @param roi Region of interest
+   *
+   * @returns
+   *    - 0: Success
+   *    - -1: Tag not in front of camera or ROI outside image
+   *    - -2: AprilTag ID is not in list of IDs to look out for
+   *    - -3: Image dimension / configuration mismatch
+   */
+  int predictROI(const cv::Mat &image, const TagTrack &track, cv::Rect &roi);
+
+  /**
+   * Predict regions of interest of all tracked tags, overlapping regions are
+   * merged into their bounding rectangle so no pixel is searched twice
+   *
+   * @param image Image
+   * @returns Regions of interest
+   */
+  std::vector<cv::Rect> predictROIs(const cv::Mat &image);
+
+  /**
+   * Update tag tracks with the tags detected in the current frame, tracks
+   * missed for more than `max_missed` frames are dropped
+   *
+   * @param tags Detected tags
+   */
+  void updateTracks(const std::vector<TagPose> &tags);
+
   /**
    * Get relative transform
    *
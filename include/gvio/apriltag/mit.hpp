@@ -39,6 +39,9 @@ class MITDetector : public BaseDetector {
 public:
   AprilTags::TagDetector *detector = nullptr;
 
+  cv::Mat roi_buffer; ///< Decimated region of interest, reused
+  cv::Mat roi_gray;   ///< Gray-scale region of interest, reused
+
   MITDetector() {}
 
   /**
@@ -57,6 +60,34 @@ public:
    * @returns 0 for success else failure
    */
   int extractTags(cv::Mat &image, std::vector<TagPose> &tags);
+
+  /**
+   * Detect AprilTags in a region of interest
+   *
+   * @param image Image
+   * @param roi Region of interest
+   * @param decimation Image decimation factor
+   * @param detections Detections in full image coordinates, appended to
+   */
+  void detectROI(const cv::Mat &image,
+                 const cv::Rect &roi,
+                 const int decimation,
+                 std::vector<AprilTags::TagDetection> &detections);
+
+  /**
+   * Extract AprilTags in tracking mode
+   *
+   * The detector only runs at full resolution on the predicted regions of
+   * interest of the tracked tags. A decimated full-frame search runs every
+   * `full_search_interval` frames, or when no tag is tracked, to pick up
+   * new tags; new tags are then re-detected at full resolution around their
+   * coarse corners.
+   *
+   * @param image
+   * @param tags
+   * @returns 0 for success else failure
+   */
+  int trackTags(cv::Mat &image, std::vector<TagPose> &tags);
 };
 
 /** @} group apriltag */
@@ -7,9 +7,12 @@
 
 #include "gvio/util/util.hpp"
 #include "gvio/camera/camera_config.hpp"
+#include "gvio/camera/capture_ring.hpp"
 #include "gvio/camera/distortion.hpp"
 #include "gvio/camera/ids.hpp"
 #include "gvio/camera/pinhole_model.hpp"
+#include "gvio/camera/undistort_grid.hpp"
+#include "gvio/camera/undistort_map.hpp"
 
 namespace gvio {
 /**
@@ -51,6 +51,37 @@ public:
    */
   virtual Vec3 project(const Vec4 &X, const Mat3 &R, const Vec3 &t) = 0;
 
+  /**
+   * Project 3D points to image plane
+   *
+   * @param X 3D points (3xN)
+   * @param R Rotation matrix
+   * @param t translation vector
+   * @param pixels Points in image plane (2xN)
+   * @param depths Depth of points in camera frame (N)
+   */
+  virtual void project(const Mat3X &X,
+                       const Mat3 &R,
+                       const Vec3 &t,
+                       Mat2X &pixels,
+                       VecX &depths) const = 0;
+
+  /**
+   * Project 3D points to image plane with lens distortion applied
+   *
+   * @param X 3D points (3xN)
+   * @param R Rotation matrix
+   * @param t translation vector
+   * @param pixels Distorted points in image plane (2xN)
+   * @param depths Depth of points in camera frame (N)
+   * @returns 0 for success, -1 for invalid distortion coefficients
+   */
+  virtual int projectDistorted(const Mat3X &X,
+                               const Mat3 &R,
+                               const Vec3 &t,
+                               Mat2X &pixels,
+                               VecX &depths) const = 0;
+
   /**
    * Convert pixel measurement to image coordinates
    *
@@ -89,6 +120,31 @@ public:
    * @copydoc Vec2 pixel2image(const cv::KeyPoint &pixel)
    */
   virtual Vec2 pixel2image(const cv::KeyPoint &pixel) const = 0;
+
+  /**
+   * Convert pixel measurements to image coordinates
+   *
+   * @param pixels Pixel measurements (2xN)
+   * @param points Points in image coordinates (2xN)
+   */
+  virtual void pixel2image(const Mat2X &pixels, Mat2X &points) const = 0;
+
+  /**
+   * Un-distort pixel measurements to image coordinates
+   *
+   * @param pixels Distorted pixel measurements
+   * @param points Un-distorted points in image coordinates
+   */
+  virtual void undistortPoints(const std::vector<cv::Point2f> &pixels,
+                               std::vector<cv::Point2f> &points) const = 0;
+
+  /**
+   * Un-distort pixel measurements to image coordinates
+   *
+   * @param pixels Distorted pixel measurements (2xN)
+   * @param points Un-distorted points in image coordinates (2xN)
+   */
+  virtual void undistortPoints(const Mat2X &pixels, Mat2X &points) const = 0;
 };
 
 /** @} group camera */
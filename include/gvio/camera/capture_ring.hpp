@@ -0,0 +1,200 @@
+/**
+ * @file
+ * @ingroup camera
+ */
+#ifndef GVIO_CAMERA_CAPTURE_RING_HPP
+#define GVIO_CAMERA_CAPTURE_RING_HPP
+
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+#include "gvio/util/util.hpp"
+
+namespace gvio {
+/**
+ * @addtogroup camera
+ * @{
+ */
+
+/**
+ * Captured frame
+ *
+ * The image is a header over the capture buffer, no pixel data is copied.
+ * The data is only valid until the frame is released back to the ring.
+ */
+struct CaptureFrame {
+  cv::Mat image;         ///< Image header over capture buffer
+  long timestamp = 0;    ///< Hardware timestamp [ns]
+  uint64_t seq = 0;      ///< Hardware frame sequence number
+  int buffer_index = -1; ///< Index of locked capture buffer
+};
+
+/**
+ * Capture statistics
+ */
+struct CaptureStats {
+  uint64_t frames_grabbed = 0; ///< Frames handed to the consumer
+  uint64_t frames_dropped = 0; ///< Frames lost (gaps in sequence number)
+  uint64_t timeouts = 0;       ///< Waits that timed out
+  int buffers_held = 0;        ///< Buffers currently held by the consumer
+};
+
+/**
+ * Capture backend
+ *
+ * Interface to the camera driver's image memory. A backend owns a fixed set
+ * of capture buffers, the driver fills them in sequence and skips any buffer
+ * that is still locked by the consumer.
+ */
+class CaptureBackend {
+public:
+  virtual ~CaptureBackend() {}
+
+  /**
+   * Number of capture buffers
+   */
+  virtual int captureBuffers() const = 0;
+
+  /**
+   * Start queued capture
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  virtual int startCapture() = 0;
+
+  /**
+   * Stop queued capture
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  virtual int stopCapture() = 0;
+
+  /**
+   * Wait for the next filled buffer and lock it
+   *
+   * @param timeout_ms Timeout [ms]
+   * @param frame Captured frame
+   * @returns 0 for success, 1 for timeout, -1 for failure
+   */
+  virtual int waitFrame(const int timeout_ms, CaptureFrame &frame) = 0;
+
+  /**
+   * Unlock buffer so that the driver can fill it again
+   *
+   * @param buffer_index Buffer index
+   * @returns 0 for success, -1 for failure
+   */
+  virtual int unlockFrame(const int buffer_index) = 0;
+};
+
+/**
+ * Capture ring
+ *
+ * Hands out zero-copy frames from a capture backend and keeps track of the
+ * buffers held by the consumer. At least one buffer is always left to the
+ * driver, so `grab()` fails if the consumer does not release frames. Frames
+ * can be released from a different thread than the one grabbing.
+ */
+class CaptureRing {
+public:
+  CaptureBackend *backend = nullptr;
+  std::vector<bool> held; ///< Buffers held by the consumer
+  bool started = false;
+  bool has_seq = false;
+  uint64_t last_seq = 0;
+  CaptureStats capture_stats;
+  mutable std::mutex mutex;
+
+  CaptureRing(CaptureBackend *backend);
+  virtual ~CaptureRing();
+
+  /**
+   * Start capture
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int start();
+
+  /**
+   * Stop capture
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int stop();
+
+  /**
+   * Grab next frame
+   *
+   * @param frame Captured frame, must be released with `release()`
+   * @param timeout_ms Timeout [ms]
+   * @returns 0 for success, 1 for timeout, -1 for failure
+   */
+  int grab(CaptureFrame &frame, const int timeout_ms = 1000);
+
+  /**
+   * Release frame back to the driver
+   *
+   * @param frame Captured frame
+   * @returns 0 for success, -1 for failure
+   */
+  int release(CaptureFrame &frame);
+
+  /**
+   * Capture statistics
+   */
+  CaptureStats stats() const;
+};
+
+/**
+ * Fake capture backend
+ *
+ * Simulates the driver's queued capture in memory for tests. Frames are
+ * published into the next free buffer, if every buffer is either queued or
+ * locked the frame is dropped.
+ */
+class FakeCaptureBackend : public CaptureBackend {
+public:
+  enum BufferState { FREE, QUEUED, LOCKED };
+
+  int image_width = 0;
+  int image_height = 0;
+  int image_type = CV_8UC1;
+  bool capturing = false;
+
+  std::vector<cv::Mat> buffers;
+  std::vector<BufferState> states;
+  std::deque<int> queue;
+  std::vector<long> timestamps;
+  std::vector<uint64_t> seqs;
+  uint64_t seq = 0;
+  int next_index = 0;
+
+  std::mutex mutex;
+  std::condition_variable ready;
+
+  FakeCaptureBackend(const int nb_buffers,
+                     const int image_width,
+                     const int image_height,
+                     const int image_type = CV_8UC1);
+  virtual ~FakeCaptureBackend() {}
+
+  /**
+   * Publish a frame as if it were captured by the sensor
+   *
+   * @param image Image
+   * @param timestamp Hardware timestamp [ns]
+   * @returns 0 for success, -1 if frame was dropped
+   */
+  int publish(const cv::Mat &image, const long timestamp);
+
+  virtual int captureBuffers() const override;
+  virtual int startCapture() override;
+  virtual int stopCapture() override;
+  virtual int waitFrame(const int timeout_ms, CaptureFrame &frame) override;
+  virtual int unlockFrame(const int buffer_index) override;
+};
+
+/** @} group camera */
+} // namespace gvio
+#endif // GVIO_CAMERA_CAPTURE_RING_HPP
@@ -8,6 +8,7 @@
 #include <opencv2/calib3d/calib3d.hpp>
 
 #include "gvio/util/util.hpp"
+#include "gvio/camera/undistort_map.hpp"
 
 namespace gvio {
 /**
@@ -68,6 +69,48 @@ void equi_undistort(const double k1,
                     const double k4,
                     Vec2 &p);
 
+/**
+ * Un-distort a 2D point with the radial-tangential distortion model using
+ * Newton's method
+ *
+ * @param k1 Radial distortion coefficient k1
+ * @param k2 Radial distortion coefficient k2
+ * @param k3 Radial distortion coefficient k3
+ * @param p1 Tangential distortion coefficient p1
+ * @param p2 Tangential distortion coefficient p2
+ * @param p_d Distorted point in image coordinates
+ * @param p Initial guess on input, un-distorted point on output
+ * @param max_iter Maximum number of Newton iterations
+ */
+void radtan_undistort(const double k1,
+                      const double k2,
+                      const double k3,
+                      const double p1,
+                      const double p2,
+                      const Vec2 &p_d,
+                      Vec2 &p,
+                      const int max_iter);
+
+/**
+ * Un-distort a 2D point with the equi-distant distortion model using
+ * Newton's method
+ *
+ * @param k1 Distortion coefficient k1
+ * @param k2 Distortion coefficient k2
+ * @param k3 Distortion coefficient k3
+ * @param k4 Distortion coefficient k4
+ * @param p_d Distorted point in image coordinates
+ * @param p Initial guess on input, un-distorted point on output
+ * @param max_iter Maximum number of Newton iterations
+ */
+void equi_undistort(const double k1,
+                    const double k2,
+                    const double k3,
+                    const double k4,
+                    const Vec2 &p_d,
+                    Vec2 &p,
+                    const int max_iter);
+
 /**
  * Pinhole Equidistant undistort image
  */
@@ -85,6 +128,18 @@ cv::Mat pinhole_equi_undistort_image(const Mat3 &K,
                                      const cv::Mat &image,
                                      cv::Mat &K_new);
 
+/**
+ * Pinhole Equidistant undistort image, the undistortion map is only rebuilt
+ * when K, D, image size or balance differ from the ones in `map`. Returns an
+ * empty image and leaves `K_new` untouched on failure.
+ */
+cv::Mat pinhole_equi_undistort_image(const Mat3 &K,
+                                     const VecX &D,
+                                     const cv::Mat &image,
+                                     const double balance,
+                                     UndistortMap &map,
+                                     cv::Mat &K_new);
+
 /**
  * Project pinhole radial-tangential
  */
@@ -95,6 +150,34 @@ Vec2 project_pinhole_radtan(const Mat3 &K, const VecX &D, const Vec3 &X);
  */
 Vec2 project_pinhole_equi(const Mat3 &K, const Vec4 &D, const Vec3 &X);
 
+/**
+ * Project pinhole radial-tangential
+ *
+ * @param K Camera intrinsics matrix
+ * @param D Distortion coefficients (k1, k2, p1, p2, k3)
+ * @param X 3D points in camera frame (3xN)
+ * @param pixels Distorted points in image plane (2xN)
+ * @returns 0 for success, -1 if D does not have 5 coefficients
+ */
+int project_pinhole_radtan(const Mat3 &K,
+                           const VecX &D,
+                           const Mat3X &X,
+                           Mat2X &pixels);
+
+/**
+ * Project pinhole equidistant
+ *
+ * @param K Camera intrinsics matrix
+ * @param D Distortion coefficients (k1, k2, k3, k4)
+ * @param X 3D points in camera frame (3xN)
+ * @param pixels Distorted points in image plane (2xN)
+ * @returns 0 for success, -1 if D does not have 4 coefficients
+ */
+int project_pinhole_equi(const Mat3 &K,
+                         const VecX &D,
+                         const Mat3X &X,
+                         Mat2X &pixels);
+
 /** @} group camera */
 } // namespace gvio
 #endif // GVIO_CAMERA_DISTORTION_HPP
@@ -8,6 +8,7 @@
 #include <ueye.h>
 
 #include "gvio/camera/camera.hpp"
+#include "gvio/camera/capture_ring.hpp"
 
 namespace gvio {
 /**
@@ -116,6 +117,15 @@ void ueye_print_sensor_info(const SENSORINFO &info);
   */
 void ueye_print_camera_info(const CAMINFO &info);
 
+/**
+  * Convert channels and bits per pixel to `cv::Mat` type
+  *
+  * @param channels Image channels
+  * @param bpp Bits per pixel
+  * @returns `cv::Mat` type, else -1 for failure
+  */
+int raw2cvtype(const int channels, const int bpp);
+
 /**
   * Convert raw image data to `cv::Mat`
   *
@@ -134,8 +144,14 @@ int raw2cvmat(void *image_data,
               const int bpp,
               cv::Mat &output);
 
-/** IDS Camera **/
-class IDSCamera {
+/**
+ * IDS Camera
+ *
+ * Besides `getFrame()`, the camera can be used as a `CaptureBackend` with a
+ * `CaptureRing` for zero-copy queued capture. Do not mix both on the same
+ * camera.
+ */
+class IDSCamera : public CaptureBackend {
 public:
   bool configured = false;
 
@@ -461,6 +477,43 @@ public:
    * @returns 0 for success, -1 for failure
    */
   int getFrame(cv::Mat &image);
+
+  /**
+   * Number of capture buffers
+   */
+  virtual int captureBuffers() const override;
+
+  /**
+   * Start queued capture (uEye image queue)
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  virtual int startCapture() override;
+
+  /**
+   * Stop queued capture
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  virtual int stopCapture() override;
+
+  /**
+   * Wait for the next buffer in the image queue, the driver locks the buffer
+   * until `unlockFrame()` is called
+   *
+   * @param timeout_ms Timeout [ms]
+   * @param frame Captured frame
+   * @returns 0 for success, 1 for timeout, -1 for failure
+   */
+  virtual int waitFrame(const int timeout_ms, CaptureFrame &frame) override;
+
+  /**
+   * Unlock buffer
+   *
+   * @param buffer_index Buffer index
+   * @returns 0 for success, -1 for failure
+   */
+  virtual int unlockFrame(const int buffer_index) override;
 };
 
 /** @} group camera */
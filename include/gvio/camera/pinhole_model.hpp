@@ -7,6 +7,7 @@
 
 #include "gvio/util/util.hpp"
 #include "gvio/camera/camera_model.hpp"
+#include "gvio/camera/undistort_grid.hpp"
 
 namespace gvio {
 /**
@@ -27,6 +28,10 @@ public:
   double fx = 0.0;      ///< Focal length in x-axis
   double fy = 0.0;      ///< Focal length in y-axis
 
+  std::string distortion_model = "none"; ///< Distortion model
+  VecX distortion_coeffs;                ///< Distortion coefficients
+  UndistortGrid undistort_grid;          ///< Point un-distortion lookup grid
+
   PinholeModel() {}
   virtual ~PinholeModel() {}
 
@@ -57,6 +62,17 @@ public:
    */
   int configure(const std::string &config_file);
 
+  /**
+   * Set distortion model
+   *
+   * @param distortion_model Distortion model ("none", "radial-tangential" or
+   * "equidistant")
+   * @param distortion_coeffs Distortion coefficients
+   * @returns 0 for success, -1 for failure
+   */
+  int setDistortion(const std::string &distortion_model,
+                    const VecX &distortion_coeffs);
+
   /**
    * Focal length in x-axis
    *
@@ -119,6 +135,38 @@ public:
    */
   Vec3 project(const Vec4 &X, const Mat3 &R, const Vec3 &t) override;
 
+  /**
+   * Project 3D points to image plane
+   *
+   * @param X 3D points (3xN)
+   * @param R Rotation matrix
+   * @param t translation vector
+   * @param pixels Points in image plane (2xN)
+   * @param depths Depth of points in camera frame (N)
+   */
+  void project(const Mat3X &X,
+               const Mat3 &R,
+               const Vec3 &t,
+               Mat2X &pixels,
+               VecX &depths) const override;
+
+  /**
+   * Project 3D points to image plane with lens distortion applied, if no
+   * distortion model is set this is the same as `project()`
+   *
+   * @param X 3D points (3xN)
+   * @param R Rotation matrix
+   * @param t translation vector
+   * @param pixels Distorted points in image plane (2xN)
+   * @param depths Depth of points in camera frame (N)
+   * @returns 0 for success, -1 for invalid distortion coefficients
+   */
+  int projectDistorted(const Mat3X &X,
+                       const Mat3 &R,
+                       const Vec3 &t,
+                       Mat2X &pixels,
+                       VecX &depths) const override;
+
   /**
    * Convert pixel measurement to image coordinates
    *
@@ -157,6 +205,37 @@ public:
    * @copydoc Vec2 pixel2image(const cv::KeyPoint &pixel)
    */
   Vec2 pixel2image(const cv::KeyPoint &pixel) const override;
+
+  /**
+   * Convert pixel measurements to image coordinates
+   *
+   * @param pixels Pixel measurements (2xN)
+   * @param points Points in image coordinates (2xN)
+   */
+  void pixel2image(const Mat2X &pixels, Mat2X &points) const override;
+
+  /**
+   * Un-distort pixel measurements to image coordinates
+   *
+   * If no distortion model is set this is equivalent to calling
+   * `pixel2image()` on every pixel.
+   *
+   * @param pixels Distorted pixel measurements
+   * @param points Un-distorted points in image coordinates
+   */
+  void undistortPoints(const std::vector<cv::Point2f> &pixels,
+                       std::vector<cv::Point2f> &points) const override;
+
+  /**
+   * Un-distort pixel measurements to image coordinates
+   *
+   * If no distortion model is set this is equivalent to the batch
+   * `pixel2image()`.
+   *
+   * @param pixels Distorted pixel measurements (2xN)
+   * @param points Un-distorted points in image coordinates (2xN)
+   */
+  void undistortPoints(const Mat2X &pixels, Mat2X &points) const override;
 };
 
 /**
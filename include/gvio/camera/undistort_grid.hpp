@@ -0,0 +1,110 @@
+/**
+ * @file
+ * @ingroup camera
+ */
+#ifndef GVIO_CAMERA_UNDISTORT_GRID_HPP
+#define GVIO_CAMERA_UNDISTORT_GRID_HPP
+
+#include "gvio/util/util.hpp"
+#include "gvio/camera/distortion.hpp"
+
+namespace gvio {
+/**
+ * @addtogroup camera
+ * @{
+ */
+
+/**
+ * Lookup grid for un-distorting sparse pixel measurements
+ *
+ * Instead of un-distorting the full image, only the tracked keypoints are
+ * un-distorted. The un-distorted image coordinates are precomputed at the
+ * nodes of a coarse grid over the image, a query point is bilinearly
+ * interpolated from the grid and then refined with a few Newton iterations.
+ */
+class UndistortGrid {
+public:
+  bool configured = false;
+
+  std::string distortion_model = "none";
+  VecX D; ///< Distortion coefficients
+  double fx = 0.0;
+  double fy = 0.0;
+  double cx = 0.0;
+  double cy = 0.0;
+
+  int cell_size = 8;      ///< Grid cell size in pixels
+  int grid_cols = 0;      ///< Number of grid nodes in x-axis
+  int grid_rows = 0;      ///< Number of grid nodes in y-axis
+  int max_iter = 2;       ///< Newton iterations after grid lookup
+  int max_iter_init = 20; ///< Newton iterations without grid lookup
+
+  std::vector<double> grid_x; ///< Un-distorted x at grid nodes (row-major)
+  std::vector<double> grid_y; ///< Un-distorted y at grid nodes (row-major)
+
+  UndistortGrid() {}
+  virtual ~UndistortGrid() {}
+
+  /**
+   * Configure
+   *
+   * @param distortion_model Distortion model ("none", "radial-tangential" or
+   * "equidistant")
+   * @param D Distortion coefficients
+   * @param fx Focal length in x-axis
+   * @param fy Focal length in y-axis
+   * @param cx Principle center in x-axis
+   * @param cy Principle center in y-axis
+   * @param image_width Image width
+   * @param image_height Image height
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int configure(const std::string &distortion_model,
+                const VecX &D,
+                const double fx,
+                const double fy,
+                const double cx,
+                const double cy,
+                const int image_width,
+                const int image_height);
+
+  /**
+   * Un-distort a single point
+   *
+   * @param p_d Distorted point in image coordinates
+   * @param p Initial guess on input, un-distorted point on output
+   * @param max_iter Maximum number of Newton iterations
+   */
+  void undistortPoint(const Vec2 &p_d, Vec2 &p, const int max_iter) const;
+
+  /**
+   * Un-distort a single pixel measurement
+   *
+   * @param px Distorted pixel x
+   * @param py Distorted pixel y
+   * @returns Un-distorted point in image coordinates
+   */
+  Vec2 undistortPixel(const double px, const double py) const;
+
+  /**
+   * Un-distort pixel measurements
+   *
+   * @param pixels Distorted pixel measurements
+   * @param points Un-distorted points in image coordinates
+   */
+  void undistort(const std::vector<cv::Point2f> &pixels,
+                 std::vector<cv::Point2f> &points) const;
+
+  /**
+   * Un-distort pixel measurements
+   *
+   * @param pixels Distorted pixel measurements (2xN)
+   * @param points Un-distorted points in image coordinates (2xN)
+   */
+  void undistort(const Mat2X &pixels, Mat2X &points) const;
+};
+
+/** @} group camera */
+} // namespace gvio
+#endif // GVIO_CAMERA_UNDISTORT_GRID_HPP
@@ -0,0 +1,96 @@
+/**
+ * @file
+ * @ingroup camera
+ */
+#ifndef GVIO_CAMERA_UNDISTORT_MAP_HPP
+#define GVIO_CAMERA_UNDISTORT_MAP_HPP
+
+#include <opencv2/calib3d/calib3d.hpp>
+
+#include "gvio/util/util.hpp"
+#include "gvio/util/thread_pool.hpp"
+
+namespace gvio {
+/**
+ * @addtogroup camera
+ * @{
+ */
+
+/**
+ * Precomputed undistortion map
+ *
+ * Building the remap tables is by far the most expensive part of undistorting
+ * an image, this class builds fixed-point (`CV_16SC2`) tables once per
+ * (distortion model, K, D, image size, balance) and only applies `cv::remap`
+ * on subsequent calls.
+ */
+class UndistortMap {
+public:
+  bool configured = false;
+
+  std::string distortion_model;
+  Mat3 K = Mat3::Zero(); ///< Camera intrinsics matrix
+  VecX D;                ///< Distortion coefficients
+  cv::Size image_size;   ///< Image size
+  double balance = 0.0;  ///< Balance (between 0.0 and 1.0)
+
+  cv::Mat K_ud; ///< Camera intrinsics matrix of undistorted image
+  cv::Mat map1; ///< Fixed-point remap table (CV_16SC2)
+  cv::Mat map2; ///< Interpolation table (CV_16UC1)
+
+  UndistortMap() {}
+  virtual ~UndistortMap() {}
+
+  /**
+   * Build undistortion map
+   *
+   * @param distortion_model Distortion model ("equidistant" or
+   * "radial-tangential")
+   * @param K Camera intrinsics matrix
+   * @param D Distortion coefficients
+   * @param image_size Image size
+   * @param balance Balance (between 0.0 and 1.0), only used by the equidistant
+   * model
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int configure(const std::string &distortion_model,
+                const Mat3 &K,
+                const VecX &D,
+                const cv::Size &image_size,
+                const double balance);
+
+  /**
+   * Check whether map was built for the given parameters
+   *
+   * @param distortion_model Distortion model
+   * @param K Camera intrinsics matrix
+   * @param D Distortion coefficients
+   * @param image_size Image size
+   * @param balance Balance (between 0.0 and 1.0)
+   *
+   * @returns True if map matches the parameters, else false
+   */
+  bool matches(const std::string &distortion_model,
+               const Mat3 &K,
+               const VecX &D,
+               const cv::Size &image_size,
+               const double balance) const;
+
+  /**
+   * Undistort image
+   *
+   * @param image Input image
+   * @param image_ud Undistorted image
+   * @param pool Thread pool to remap row bands in parallel (optional)
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int undistort(const cv::Mat &image,
+                cv::Mat &image_ud,
+                ThreadPool *pool = nullptr) const;
+};
+
+/** @} group camera */
+} // namespace gvio
+#endif // GVIO_CAMERA_UNDISTORT_MAP_HPP
@@ -16,6 +16,8 @@
 
 #include <linux/i2c-dev.h>
 
+#include <map>
+
 #include "gvio/util/log.hpp"
 
 namespace gvio {
@@ -30,9 +32,35 @@ namespace gvio {
 // DEFINES
 #define I2C_BUF_MAX 1024
 
+/**
+ * Simulated I2C slave, a 256 byte register map
+ *
+ * Burst reads and writes auto-increment the register address like most I2C
+ * sensors do. Devices with special registers (e.g. a FIFO data register that
+ * does not auto-increment) override `read()` / `write()`.
+ */
+class I2CRegisterMap {
+public:
+  uint8_t registers[256] = {0};
+
+  virtual ~I2CRegisterMap() {}
+  virtual int read(const uint8_t reg_addr, uint8_t *data, const size_t length);
+  virtual int write(const uint8_t reg_addr,
+                    const uint8_t *data,
+                    const size_t length);
+};
+
+/**
+ * I2C bus
+ *
+ * If `sim` has any slaves the bus is simulated, transfers go to the register
+ * map of the selected slave and no device is opened.
+ */
 class I2C {
 public:
   int fd = -1;
+  char slave_addr = 0;
+  std::map<char, I2CRegisterMap *> sim; ///< Simulated slaves (not owned)
 
   I2C() {}
   ~I2C() {
@@ -53,7 +53,12 @@ public:
   /**
    * Configure
    *
+   * Loads `show_matches` and the camera model under `camera_model`,
+   * including the optional `distortion_model` and `distortion_coeffs` used
+   * to un-distort the keypoints of lost tracks.
+   *
    * @param config_file Path to config file
+   * @returns 0 for success, -1 for failure
    */
   virtual int configure(const std::string &config_file);
 
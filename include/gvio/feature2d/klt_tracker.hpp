@@ -5,6 +5,8 @@
 #ifndef GVIO_FEATURE2D_KLT_TRACKER_HPP
 #define GVIO_FEATURE2D_KLT_TRACKER_HPP
 
+#include <memory>
+
 #include "gvio/feature2d/feature_tracker.hpp"
 #include "gvio/feature2d/feature_container.hpp"
 #include "gvio/camera/camera_model.hpp"
@@ -35,6 +37,7 @@ public:
   int image_height = 0;
 
   const CameraModel *camera_model = nullptr;
+  std::unique_ptr<PinholeModel> pinhole_model; ///< Loaded by `configure()`
 
   KLTTracker() {}
 
@@ -47,6 +50,18 @@ public:
       : max_corners{max_corners}, quality_level{quality_level},
         min_distance{min_distance}, camera_model{camera_model} {}
 
+  /**
+   * Configure
+   *
+   * Loads the feature detector settings and the camera model under
+   * `camera_model`, including the optional `distortion_model` and
+   * `distortion_coeffs` used to un-distort the keypoints of lost tracks.
+   *
+   * @param config_file Path to config file
+   * @returns 0 for success, -1 for failure
+   */
+  int configure(const std::string &config_file);
+
   /**
    * Get lost feature tracks
    */
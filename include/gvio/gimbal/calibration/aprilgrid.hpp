@@ -9,7 +9,9 @@
 #include <apriltags_mit/Tag36h11.h>
 
 #include "gvio/util/util.hpp"
+#include "gvio/util/thread_pool.hpp"
 #include "gvio/camera/distortion.hpp"
+#include "gvio/gimbal/calibration/detection_cache.hpp"
 
 namespace gvio {
 
@@ -46,6 +48,20 @@ public:
   AprilTags::TagDetector detector =
       AprilTags::TagDetector(AprilTags::tagCodes36h11);
 
+  /// Detection cache (optional, not owned)
+  DetectionCache *cache = nullptr;
+
+  /// Tiled detection pool (optional, not owned), if set the image is split
+  /// into overlapping tiles that are detected in parallel
+  ThreadPool *thread_pool = nullptr;
+  int tile_rows = 2;      ///< Number of tiles in y-dir
+  int tile_cols = 2;      ///< Number of tiles in x-dir
+  int tile_overlap = 128; ///< Tile overlap [px], should exceed the tag size
+  std::vector<AprilTags::TagDetector> tile_detectors; ///< One per task
+
+  bool subpix = false;   ///< Refine tag corners to sub-pixel accuracy
+  int subpix_window = 2; ///< Half size of sub-pixel search window [px]
+
   AprilGrid();
   AprilGrid(const int rows,
             const int cols,
@@ -61,9 +77,36 @@ public:
    */
   int detect(cv::Mat &image);
 
+  /**
+   * Target configuration used to key the detection cache
+   */
+  std::string config() const;
+
+  /**
+   * Run the tag detector over the whole image, or over overlapping tiles in
+   * parallel if a thread pool is set. A tag seen by several tiles is kept
+   * once, from the tile where it is furthest from the tile border.
+   *
+   * @param image_gray Gray-scale input image
+   * @returns Tag detections sorted by tag id
+   */
+  std::vector<AprilTags::TagDetection> detectTags(const cv::Mat &image_gray);
+
+  /**
+   * Refine the corners of all tags to sub-pixel accuracy in one batch
+   *
+   * @param image_gray Gray-scale input image
+   * @param tags Observed AprilGrid tags
+   */
+  void refineCorners(const cv::Mat &image_gray,
+                     std::map<int, std::vector<cv::Point2f>> &tags);
+
   /**
    * Extract tags
    *
+   * If a detection cache is set, the tags of an image that was seen before
+   * are returned without running the detector.
+   *
    * @param image Input image
    * @param tags Observed AprilGrid tags
    * @return 0 for success, -1 for failure
@@ -35,8 +35,25 @@ struct CalibTarget {
  */
 std::ostream &operator<<(std::ostream &os, const CalibTarget &target);
 
+/**
+ * AprilGrid detections of a single measurement
+ */
+struct CalibDetection {
+  bool detected = false;
+  std::map<int, std::vector<cv::Point2f>> tags0;
+  std::map<int, std::vector<cv::Point2f>> tags1;
+  std::map<int, std::vector<cv::Point2f>> tags2;
+  std::vector<int> common_ids;
+};
+
 /**
  * Preprocess calibration data
+ *
+ * Measurements are processed on a worker pool, each worker task owns its own
+ * `AprilGrid` (and therefore its own `AprilTags::TagDetector`). Detections
+ * are stored in measurement order. If `cache_file` is set, all detections of
+ * the dataset are kept in a `DetectionCache` there and reused on the next
+ * run, including after an interrupted run.
  */
 class CalibPreprocessor {
 public:
@@ -45,6 +62,10 @@ public:
   int nb_measurements = 0;
   MatX joint_data;
 
+  int nb_workers = 0;     ///< Number of workers (0 for hardware concurrency)
+  std::string cache_file; ///< Dataset detection cache (optional)
+  std::vector<CalibDetection> detections;
+
   CalibPreprocessor();
   virtual ~CalibPreprocessor();
 
@@ -96,6 +117,21 @@ public:
                  const std::map<int, std::vector<cv::Point2f>> &tags1,
                  const std::map<int, std::vector<cv::Point2f>> &tags2);
 
+  /**
+   * Detect AprilGrid in the images of a single measurement
+   *
+   * Undistortion maps of cam1 and cam2 have to be built beforehand, this
+   * function only reads them so it can run concurrently.
+   *
+   * @param grid AprilGrid detector owned by the caller
+   * @param image_paths Paths to cam0, cam1 and cam2 images
+   * @param detection Detection
+   * @returns 0 for success, -1 for failure
+   */
+  int detectMeasurement(AprilGrid &grid,
+                        const std::vector<std::string> &image_paths,
+                        CalibDetection &detection);
+
   /**
    * Preprocess calibration data
    *
@@ -5,6 +5,8 @@
 #ifndef GVIO_GIMBAL_CALIBRATION_CALIB_VALIDATOR_HPP
 #define GVIO_GIMBAL_CALIBRATION_CALIB_VALIDATOR_HPP
 
+#include <opencv2/video/tracking.hpp>
+
 #include "gvio/util/util.hpp"
 #include "gvio/camera/distortion.hpp"
 #include "gvio/gimbal/gimbal_model.hpp"
@@ -17,8 +19,64 @@ namespace gvio {
  * @{
  */
 
+/**
+ * Running reprojection error statistics
+ */
+struct ReprojectionStats {
+  long nb_frames = 0;   ///< Number of frames
+  long nb_points = 0;   ///< Number of points
+  double sum_sq = 0.0;  ///< Sum of squared errors
+  double max = 0.0;     ///< Max error
+  double last = 0.0;    ///< RMSE of the last frame
+
+  /**
+   * Add reprojection errors of a frame
+   *
+   * @param measured Measured pixels
+   * @param predicted Predicted pixels (2 x N)
+   */
+  void update(const std::vector<cv::Point2f> &measured,
+              const MatX &predicted);
+
+  /**
+   * RMSE over all frames
+   */
+  double rmse() const;
+
+  /**
+   * Reset statistics
+   */
+  void reset();
+};
+
+/**
+ * ReprojectionStats to string
+ */
+std::ostream &operator<<(std::ostream &os, const ReprojectionStats &stats);
+
+/**
+ * Chessboard corners tracked between frames of one camera
+ */
+struct CornerTrack {
+  cv::Mat prev_gray;                 ///< Previous gray-scale image
+  std::vector<cv::Point2f> corners;  ///< Corners in previous image
+  int nb_tracked = 0;                ///< Frames tracked since detection
+  bool valid = false;                ///< Corners are valid
+  cv::Mat rvec;                      ///< Last target pose (rotation)
+  cv::Mat tvec;                      ///< Last target pose (translation)
+};
+
 /**
  * Calibration validator
+ *
+ * Besides the per-frame `validate*()` functions, which detect and draw, the
+ * validator has a streaming mode for live camera rates. The `*Stream()`
+ * functions track the chessboard corners between frames with pyramidal
+ * Lucas-Kanade and only re-detect when tracking fails or every
+ * `redetect_interval` frames. Target poses are warm-started from the
+ * previous frame, the gimbal transform is only recomputed when the joint
+ * angles change, and reprojection errors are aggregated into running
+ * statistics instead of being drawn.
  */
 class CalibValidator {
 public:
@@ -26,6 +84,18 @@ public:
   Chessboard chessboard;
   GimbalModel gimbal_model;
 
+  // Streaming mode
+  int redetect_interval = 30;     ///< Max frames tracked before re-detecting
+  double max_track_error = 0.5;   ///< Max forward-backward track error [px]
+  std::vector<CornerTrack> tracks; ///< Corner tracks per camera
+  Mat4 T_C0_C1 = I(4);            ///< Cached inverse of T_C1_C0
+  Mat4 T_ds = I(4);               ///< Cached gimbal transform
+  Vec2 T_ds_joints{NAN, NAN};     ///< Joint angles of cached gimbal transform
+  ReprojectionStats stereo_stats; ///< Errors between cam0 and cam1
+  ReprojectionStats gimbal_stats; ///< Errors of cam0 and cam1 in cam2
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
   CalibValidator();
   virtual ~CalibValidator();
 
@@ -124,6 +194,101 @@ public:
                            const cv::Mat &img2,
                            const double joint_roll,
                            const double joint_pitch);
+
+  /**
+   * Track chessboard corners, re-detects when tracking is lost
+   *
+   * @param camera_index Camera index
+   * @param image Image
+   * @param corners Chessboard corners
+   *
+   * @returns
+   * - 0 for no chessboard detected
+   * - 1 for chessboard detected or tracked
+   * - -1 for failure
+   */
+  int trackCorners(const int camera_index,
+                   const cv::Mat &image,
+                   std::vector<cv::Point2f> &corners);
+
+  /**
+   * Calculate 3D chessboard corner positions from tracked corners, the
+   * target pose is warm-started from the previous frame
+   *
+   * @param camera_index Camera index
+   * @param corners Chessboard corners
+   * @param X 3D position of chessboard corners (3 x N)
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int cornerPositions(const int camera_index,
+                      const std::vector<cv::Point2f> &corners,
+                      MatX &X);
+
+  /**
+   * Gimbal transform, only recomputed if the joint angles change
+   *
+   * @param joint_roll Joint roll angle (radians)
+   * @param joint_pitch Joint pitch angle (radians)
+   * @returns Transform from static to dynamic camera
+   */
+  const Mat4 &gimbalTransform(const double joint_roll,
+                              const double joint_pitch);
+
+  /**
+   * Update stereo statistics by projecting the corners observed by cam0 into
+   * cam1 and vice versa
+   *
+   * @param corners0 Chessboard corners in cam0
+   * @param corners1 Chessboard corners in cam1
+   * @param X0 3D position of chessboard corners in cam0 frame (3 x N)
+   * @param X1 3D position of chessboard corners in cam1 frame (3 x N)
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int stereoStats(const std::vector<cv::Point2f> &corners0,
+                  const std::vector<cv::Point2f> &corners1,
+                  const MatX &X0,
+                  const MatX &X1);
+
+  /**
+   * Validate stereo calibration in streaming mode, updates `stereo_stats`
+   *
+   * @param img0 Input image from cam0
+   * @param img1 Input image from cam1
+   *
+   * @returns
+   * - 0 for no chessboard detected
+   * - 1 for statistics updated
+   * - -1 for failure
+   */
+  int validateStereoStream(const cv::Mat &img0, const cv::Mat &img1);
+
+  /**
+   * Validate stereo + gimbal calibration in streaming mode, updates
+   * `stereo_stats` and `gimbal_stats`
+   *
+   * @param img0 Input image from cam0
+   * @param img1 Input image from cam1
+   * @param img2 Input image from cam2
+   * @param joint_roll Joint roll angle (radians)
+   * @param joint_pitch Joint pitch angle (radians)
+   *
+   * @returns
+   * - 0 for no chessboard detected
+   * - 1 for statistics updated
+   * - -1 for failure
+   */
+  int validateTriclopsStream(const cv::Mat &img0,
+                             const cv::Mat &img1,
+                             const cv::Mat &img2,
+                             const double joint_roll,
+                             const double joint_pitch);
+
+  /**
+   * Reset streaming state and statistics
+   */
+  void resetStream();
 };
 
 /**
@@ -6,7 +6,9 @@
 #define GVIO_GIMBAL_CALIBRATION_CAMERA_PROPERTY_HPP
 
 #include "gvio/util/util.hpp"
+#include "gvio/util/thread_pool.hpp"
 #include "gvio/camera/distortion.hpp"
+#include "gvio/camera/undistort_map.hpp"
 
 namespace gvio {
 /**
@@ -22,6 +24,9 @@ struct CameraProperty {
   VecX intrinsics;
   Vec2 resolution;
 
+  UndistortMap undistort_map;        ///< Cached undistortion map
+  ThreadPool *thread_pool = nullptr; ///< Optional pool for undistortImage
+
   /**
    * Camera intrinsics matrix K
    * @returns Camera intrinsics matrix K
@@ -47,6 +52,10 @@ struct CameraProperty {
   /**
    * Undistort image
    *
+   * The undistortion map is built on the first call and reused until the
+   * intrinsics, distortion coefficients, image size or balance change. If
+   * `thread_pool` is set the image is remapped by row bands in parallel.
+   *
    * @param image Image
    * @param balance Balance (between 0.0 and 1.0)
    * @param image_ud Undistorted image
@@ -8,6 +8,7 @@
 #include <opencv2/calib3d/calib3d.hpp>
 
 #include "gvio/util/util.hpp"
+#include "gvio/gimbal/calibration/detection_cache.hpp"
 
 namespace gvio {
 /**
@@ -23,6 +24,7 @@ struct Chessboard {
   int nb_cols = 10;
   double square_size = 0.1;
   std::vector<cv::Point3f> object_points;
+  DetectionCache *cache = nullptr; ///< Detection cache (optional, not owned)
 
   Chessboard();
   virtual ~Chessboard();
@@ -47,9 +49,17 @@ struct Chessboard {
    */
   std::vector<cv::Point3f> createObjectPoints();
 
+  /**
+   * Target configuration used to key the detection cache
+   */
+  std::string config() const;
+
   /**
    * Detect chessboard corners
    *
+   * If a detection cache is set, the corners of an image that was seen
+   * before are returned without running the detector.
+   *
    * @param image Input image
    * @param corners Detected chessboard corners
    * @returns 0 for success, -1 for failure
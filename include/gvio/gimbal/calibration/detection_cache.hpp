@@ -0,0 +1,108 @@
+/**
+ * @file
+ * @ingroup gimbal
+ */
+#ifndef GVIO_GIMBAL_CALIBRATION_DETECTION_CACHE_HPP
+#define GVIO_GIMBAL_CALIBRATION_DETECTION_CACHE_HPP
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "gvio/util/util.hpp"
+
+namespace gvio {
+/**
+ * @addtogroup gimbal
+ * @{
+ */
+
+/** Magic bytes at the start of a detection cache file **/
+#define DETECTION_CACHE_MAGIC "GVIODET1"
+
+/**
+ * Cached calibration target detection
+ */
+struct DetectionCacheEntry {
+  int retval = 0; ///< Return value of the detector
+  std::map<int, std::vector<cv::Point2f>> points; ///< Points by tag id
+};
+
+/**
+ * Persistent calibration target detection cache
+ *
+ * Detections are keyed by a hash of the image content and the target
+ * configuration, so changing either invalidates the entry. All entries of a
+ * dataset live in one binary file. The file is an append-only log, every
+ * insert is written immediately, so an interrupted run resumes with all the
+ * detections that were made so far. Lookups and inserts are thread-safe.
+ */
+class DetectionCache {
+public:
+  std::string path;
+  FILE *fp = nullptr;
+  std::unordered_map<uint64_t, DetectionCacheEntry> entries;
+  std::mutex mutex;
+
+  DetectionCache() {}
+  virtual ~DetectionCache();
+
+  DetectionCache(const DetectionCache &) = delete;
+  DetectionCache &operator=(const DetectionCache &) = delete;
+
+  /**
+   * Open cache file, existing entries are loaded and new entries are
+   * appended
+   *
+   * @param path Path to cache file
+   * @returns 0 for success, -1 for failure
+   */
+  int open(const std::string &path);
+
+  /**
+   * Close cache file
+   */
+  void close();
+
+  /**
+   * Number of cached entries
+   */
+  size_t size();
+
+  /**
+   * Form cache key
+   *
+   * @param image Image the detector runs on
+   * @param config Target configuration
+   * @returns Cache key
+   */
+  static uint64_t key(const cv::Mat &image, const std::string &config);
+
+  /**
+   * Lookup entry
+   *
+   * @param key Cache key
+   * @param entry Cached entry
+   * @returns True if found, else false
+   */
+  bool lookup(const uint64_t key, DetectionCacheEntry &entry);
+
+  /**
+   * Insert entry and append it to the cache file
+   *
+   * @param key Cache key
+   * @param entry Entry
+   * @returns 0 for success, -1 for failure
+   */
+  int insert(const uint64_t key, const DetectionCacheEntry &entry);
+};
+
+/** @} group gimbal */
+} // namespace gvio
+#endif // GVIO_GIMBAL_CALIBRATION_DETECTION_CACHE_HPP
@@ -23,6 +23,16 @@ public:
   CalibData data;
   CalibParams params;
 
+  /// One analytic cost function per measurement instead of one autodiff
+  /// cost function per corner
+  bool per_measurement = true;
+
+  /// Ceres linear solver type, e.g. SPARSE_SCHUR or DENSE_SCHUR
+  std::string linear_solver = "SPARSE_SCHUR";
+  int nb_threads = 0;        ///< Number of threads (0 for all cores)
+  int max_iterations = 1000; ///< Max number of solver iterations
+  bool verbose = true;       ///< Print solver progress and full report
+
   ceres::Problem problem;
   ceres::Solver::Options options;
   ceres::Solver::Summary summary;
@@ -30,6 +40,14 @@ public:
   GimbalCalib();
   virtual ~GimbalCalib();
 
+  /**
+   * Configure solver
+   *
+   * @param config_file Path to solver config file
+   * @return 0 for success, -1 for failure
+   */
+  int configure(const std::string &config_file);
+
   /**
    * Load data
    *
@@ -38,8 +56,31 @@ public:
    */
   int load(const std::string &data_dir);
 
+  /**
+   * Setup optimization problem from loaded data and params
+   *
+   * @return 0 for success, -1 for failure
+   */
+  int setup();
+
+  /**
+   * Setup solver options from the solver settings
+   *
+   * The joint angles `Lambda1[i]` of every measurement are eliminated first
+   * by the Schur based solvers. `Lambda2[i]` shares residuals with
+   * `Lambda1[i]` so it stays in the reduced system together with the global
+   * parameters, which gives an arrow-head shaped reduced system that grows
+   * linearly with the number of measurements. Blocks that are not in the
+   * problem or held constant are left out of the ordering.
+   *
+   * @return 0 for success, -1 for failure
+   */
+  int setupSolver();
+
   /**
    * Calibrate gimbal
+   *
+   * @return 0 for success, -1 for failure
    */
   int calibrate();
 };
@@ -124,6 +124,48 @@ std::ostream &operator<<(std::ostream &os, const GimbalCalibResidual &residual);
  */
 std::ostream &operator<<(std::ostream &os, const GimbalCalibResidual *residual);
 
+/**
+ * Gimbal calibration residual of a whole measurement
+ *
+ * Evaluates the reprojection errors of all corners observed in one
+ * measurement, which share the joint angles and camera intrinsics. The
+ * transform between the static and dynamic camera and its derivatives w.r.t.
+ * the calibration parameters are formed once per evaluation, the projection
+ * Jacobians of every corner are analytic. The parameter blocks are the same
+ * as `GimbalCalibResidual`.
+ */
+class GimbalCalibMeasurementResidual : public ceres::CostFunction {
+public:
+  MatX P_s; ///< Observed 3d points in static camera (N x 3)
+  MatX P_d; ///< Observed 3d points in dynamic camera (N x 3)
+  MatX Q_s; ///< Observed pixels in static camera (N x 2)
+  MatX Q_d; ///< Observed pixels in dynamic camera (N x 2)
+  Mat3 K_s = I(3); ///< Static camera intrinsics
+  Mat3 K_d = I(3); ///< Dynamic camera intrinsics
+  Vec4 D_s = zeros(4, 1); ///< Static camera distortion coefficients
+  Vec4 D_d = zeros(4, 1); ///< Dynamic camera distortion coefficients
+
+  /// Kinematic chain shared with the per-corner residual
+  GimbalCalibResidual chain;
+
+  GimbalCalibMeasurementResidual(const MatX &P_s,
+                                 const MatX &P_d,
+                                 const MatX &Q_s,
+                                 const MatX &Q_d,
+                                 const Mat3 &K_s,
+                                 const Mat3 &K_d,
+                                 const Vec4 &D_s,
+                                 const Vec4 &D_d);
+  virtual ~GimbalCalibMeasurementResidual();
+
+  /// Calculate residuals and Jacobians
+  virtual bool Evaluate(double const *const *params,
+                        double *residuals,
+                        double **jacobians) const override;
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
 /**
  * Gimbal calibration numerical residual
  */
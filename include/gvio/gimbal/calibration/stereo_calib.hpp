@@ -15,6 +15,8 @@ class StereoCalib {
 public:
   Camchain camchain;
   Chessboard chessboard;
+  int nb_workers = 0;     ///< Number of workers (0 for hardware concurrency)
+  std::string cache_file; ///< Dataset detection cache (optional)
 
   std::vector<std::vector<cv::Point3f>> object_points;
   std::vector<std::vector<cv::Point2f>> imgpts0;
@@ -27,6 +29,10 @@ public:
   /**
    * Preprocess data
    *
+   * Images are loaded and searched for chessboard corners in parallel, the
+   * detections are collected in image order. If `cache_file` is set,
+   * detections are reused from and added to the dataset detection cache.
+   *
    * @param data_path Path to data
    * @returns 0 for success, -1 for failure
    */
@@ -8,8 +8,10 @@
 #include <opencv2/core/core.hpp>
 #include <opencv2/highgui/highgui.hpp>
 #include <opencv2/imgproc/imgproc.hpp>
+#include <Eigen/Sparse>
+#include <Eigen/SparseCholesky>
 
-#include "gvio/gimbal/gmr/slic.hpp"
+#include "gvio/gimbal/gmr/superpixel.hpp"
 
 using namespace std;
 typedef unsigned int UINT;
@@ -24,31 +26,81 @@ public:
   // Get saliency map of an input image
   cv::Mat GetSal(cv::Mat &img);
 
+  // Get saliency map of the next image in a sequence. Superpixel seeds carry
+  // over from the previous frame and only refine_iterations SLIC iterations
+  // run. If the superpixel graph is unchanged only the edges of superpixels
+  // whose mean Lab colour moved more than lab_threshold are updated, and if
+  // none moved the previous ranking is reused.
+  cv::Mat Update(cv::Mat &img);
+
+  // Reset the session, the next Update() starts from scratch
+  void Reset();
+
+  int refine_iterations; // SLIC iterations when seeds carry over
+  float lab_threshold;   // Lab change of a superpixel that updates its edges
+  int nb_changed;        // superpixels updated by the last Update()
+  bool graph_reused;     // graph was reused by the last Update()
+
 private:
-  int spcount;        // superpxiels number
-  double compactness; // superpixels compactness
-  float alpha;        // balance the fittness and smoothness
-  float delta;        // contral the edge weight
-  int spcounta;       // actual superpixel number
+  int spcount;         // superpxiels number
+  double compactness;  // superpixels compactness
+  float alpha;         // balance the fittness and smoothness
+  float delta;         // contral the edge weight
+  int spcounta;        // actual superpixel number
+  SuperpixelSLIC slic; // superpixel engine, reuses its buffers per frame
 
 private:
-  // Get the superpixels of the image
-  cv::Mat GetSup(const cv::Mat &img);
+  typedef Eigen::SparseMatrix<double> SpMat;
+  typedef std::vector<std::vector<int>> AdjList;
+
+  SpMat A;                           // ranking system D - alpha * W
+  Eigen::SimplicialLDLT<SpMat> ldlt; // factorization of A
+  bool analyzed;                     // symbolic factorization is valid
+  std::vector<double> Ainv_diag;     // cached diagonal of A^-1
+
+  vector<cv::Vec3f> supmean;         // Lab mean per superpixel of the graph
+  vector<pair<int, int>> edges;      // graph edges
+  vector<float> edge_dist;           // Lab distance per edge
+  Eigen::VectorXd salf;              // last ranking
+  bool session;                      // previous frame state is valid
+  cv::Size session_size;             // previous frame size
+  AdjList session_adj;               // previous frame adjacency lists
+
+  // Get the superpixels of the image, refine starts from the previous seeds
+  cv::Mat GetSup(const cv::Mat &img, bool refine = false);
 
-  // Get the adjacent matrix
-  cv::Mat GetAdjLoop(const cv::Mat &supLab);
+  // Get the adjacency lists, superpixels on the image boundary are all
+  // connected to each other
+  AdjList GetAdjLoop(const cv::Mat &supLab);
 
-  // Get the affinity matrix of edges
-  cv::Mat GetWeight(const cv::Mat &img,
-                    const cv::Mat &supLab,
-                    const cv::Mat &adj);
+  // Get the Lab mean of each superpixel
+  vector<cv::Vec3f> GetSupMean(const cv::Mat &img, const cv::Mat &supLab);
 
-  // Get the optimal affinity matrix learned by minifold ranking (e.q. 3 in
-  // paper)
-  cv::Mat GetOptAff(const cv::Mat &W);
+  // Get the edges between adjacent superpixels and superpixels two hops
+  // apart, and their Lab distances
+  void GetEdges(const AdjList &adj);
+
+  // Get the sparse affinity matrix of the edges
+  SpMat GetWeight();
+
+  // Form and factorize the ranking system D - alpha * W (e.q. 3 in paper),
+  // the symbolic factorization is reused if the sparsity pattern is unchanged
+  int GetOptAff(const SpMat &W);
+
+  // Rank superpixels against query y, f = (D - alpha * W)^-1 y without the
+  // self-affinity of each query node
+  Eigen::VectorXd Rank(const Eigen::VectorXd &y);
 
   // Get the indicator vector based on boundary prior
-  cv::Mat GetBdQuery(const cv::Mat &supLab, int type);
+  Eigen::VectorXd GetBdQuery(const cv::Mat &supLab, int type);
+
+  // Get the ranking of each superpixel against the foreground query
+  Eigen::VectorXd GetRanking(const cv::Mat &supLab);
+
+  // Get the saliency map from the superpixel ranking
+  cv::Mat GetSalMap(const cv::Mat &supLab,
+                    const Eigen::VectorXd &f,
+                    const int *wcut);
 
   // Remove the obvious frame of the image
   cv::Mat RemoveFrame(const cv::Mat &img, int *wcut);
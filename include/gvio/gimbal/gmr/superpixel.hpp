@@ -0,0 +1,161 @@
+/**
+ * @file
+ * @ingroup gimbal
+ */
+#ifndef GVIO_GIMBAL_GMR_SUPERPIXEL_HPP
+#define GVIO_GIMBAL_GMR_SUPERPIXEL_HPP
+
+#include <cfloat>
+#include <cmath>
+#include <functional>
+#include <vector>
+
+#include <opencv2/core/core.hpp>
+
+#include "gvio/util/util.hpp"
+#include "gvio/util/thread_pool.hpp"
+
+namespace gvio {
+/**
+ * @addtogroup gimbal
+ * @{
+ */
+
+/** Number of entries in the Lab cube-root lookup table **/
+#define SLIC_CBRT_LUT_SIZE 4096
+
+/**
+ * SLIC superpixel seed
+ */
+struct SLICSeed {
+  float l = 0.0f; ///< CIELAB L
+  float a = 0.0f; ///< CIELAB a
+  float b = 0.0f; ///< CIELAB b
+  float x = 0.0f; ///< Column
+  float y = 0.0f; ///< Row
+};
+
+/**
+ * SLIC seed accumulator, used to recalculate the seed centroids
+ */
+struct SLICSeedSum {
+  double l = 0.0;
+  double a = 0.0;
+  double b = 0.0;
+  double x = 0.0;
+  double y = 0.0;
+  long n = 0;
+};
+
+/**
+ * SLIC superpixel segmentation
+ *
+ * Re-implementation of the SLIC engine in `slic.hpp` (Achanta et al, "SLIC
+ * Superpixels", 2010) for per-frame use. It works directly on a row-major
+ * 8-bit BGR `cv::Mat`, converts to CIELAB in float with lookup tables for
+ * the sRGB gamma and the cube-root, and keeps all its buffers between frames
+ * so segmenting images of the same size does not allocate. If `thread_pool`
+ * is set the Lab conversion and the assignment step are split into row
+ * bands, each band accumulates its own seed sums which are then reduced.
+ */
+class SuperpixelSLIC {
+public:
+  int nb_superpixels = 200;  ///< Desired number of superpixels
+  double compactness = 20.0; ///< Superpixel compactness
+  int max_iterations = 10;   ///< Number of k-means iterations
+  bool perturb_seeds = true; ///< Move seeds to lowest gradient position
+  ThreadPool *thread_pool = nullptr; ///< Optional pool for row bands
+  int step = 0; ///< Step size between seeds of the last segmentation
+
+  // Buffers, reused between frames
+  cv::Mat lab;                  ///< CIELAB image (CV_32FC3)
+  cv::Mat dist;                 ///< Distance to assigned seed (CV_32FC1)
+  cv::Mat klabels;              ///< SLIC labels (CV_32SC1)
+  std::vector<SLICSeed> seeds;  ///< Seeds
+  std::vector<std::vector<SLICSeedSum>> band_sums; ///< Seed sums per band
+  std::vector<int> segment_x;   ///< Connectivity work buffer
+  std::vector<int> segment_y;   ///< Connectivity work buffer
+
+  SuperpixelSLIC();
+  virtual ~SuperpixelSLIC() {}
+
+  /**
+   * Convert 8-bit BGR image to CIELAB, result is stored in `lab`
+   *
+   * @param image Input image (CV_8UC3, BGR)
+   * @returns 0 for success, -1 for failure
+   */
+  int convertLab(const cv::Mat &image);
+
+  /**
+   * Segment image into superpixels
+   *
+   * @param image Input image (CV_8UC3, BGR)
+   * @param labels Superpixel labels (CV_32SC1), labels are in
+   * [0, nb_labels)
+   * @param nb_labels Number of superpixels
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int segment(const cv::Mat &image, cv::Mat &labels, int &nb_labels);
+
+  /**
+   * Segment image into superpixels starting from the seeds of the previous
+   * segmentation, for consecutive frames that only changed slightly. Falls
+   * back to `segment()` if there is no previous segmentation of the same
+   * image size and number of superpixels.
+   *
+   * @param image Input image (CV_8UC3, BGR)
+   * @param labels Superpixel labels (CV_32SC1), labels are in
+   * [0, nb_labels)
+   * @param nb_labels Number of superpixels
+   * @param nb_iterations Number of k-means iterations
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int refine(const cv::Mat &image,
+             cv::Mat &labels,
+             int &nb_labels,
+             const int nb_iterations);
+
+private:
+  float gamma_lut[256];                  ///< sRGB to linear RGB
+  float cbrt_lut[SLIC_CBRT_LUT_SIZE + 1]; ///< Cube-root over [0, 1]
+
+  /**
+   * Run `func(band, start, stop)` over row bands, in parallel if a thread
+   * pool is set
+   */
+  void forEachBand(const int rows,
+                   const std::function<void(int, int, int)> &func);
+
+  /**
+   * Step size between seeds for `nb_superpixels` on an image of `size`
+   */
+  int seedStep(const cv::Size &size) const;
+
+  /**
+   * Place seeds on a regular grid with step size `step`
+   */
+  void initSeeds(const int step);
+
+  /**
+   * Colour gradient magnitude at pixel (row, col)
+   */
+  float gradient(const int row, const int col) const;
+
+  /**
+   * Assign pixels to the nearest seed and recalculate seed centroids
+   */
+  void iterate(const int step);
+
+  /**
+   * Relabel disjoint segments and merge segments smaller than a quarter of
+   * the expected superpixel size into an adjacent segment
+   */
+  int enforceConnectivity(const int step, cv::Mat &labels);
+};
+
+/** @} group gimbal */
+} // namespace gvio
+#endif // GVIO_GIMBAL_GMR_SUPERPIXEL_HPP
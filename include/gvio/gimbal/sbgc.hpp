@@ -7,10 +7,13 @@
 
 #include <errno.h>
 #include <fcntl.h>
+#include <poll.h>
 #include <string.h>
+#include <sys/epoll.h>
 #include <termios.h>
 #include <unistd.h>
 
+#include <functional>
 #include <iostream>
 
 #include "gvio/util/util.hpp"
@@ -28,6 +31,8 @@ namespace gvio {
 #define DEG_SEC_PER_BIT 0.1220740379 // deg/sec per bit
 #define ACC_UNIT (1.0 / 512.0)       // G
 #define GYRO_UNIT 0.06103701895      // deg per sec
+#define SBGC_RX_BUFFER_SIZE 1024     // must be a power of 2
+#define SBGC_TIMEOUT_MS 500          // read / write timeout
 
 // CMD ID
 #define CMD_READ_PARAMS 82
@@ -136,6 +141,53 @@ public:
   int parseFrame(uint8_t *data);
 };
 
+/**
+ * Streaming SBGC frame parser
+ *
+ * Received bytes are pushed into a ring buffer and complete frames are popped
+ * out. Bytes that do not start a frame with valid checksums are dropped one
+ * at a time up to the next `>` start byte, so the parser resynchronises
+ * after line noise or a partial frame.
+ */
+class SBGCParser {
+public:
+  uint8_t buffer[SBGC_RX_BUFFER_SIZE];
+  size_t head = 0;       ///< Read index
+  size_t tail = 0;       ///< Write index
+  size_t nb_dropped = 0; ///< Bytes dropped while resynchronising
+
+  /**
+   * Number of buffered bytes
+   */
+  size_t size() const;
+
+  /**
+   * Push received bytes, bytes that do not fit are discarded
+   *
+   * @param data Received bytes
+   * @param length Number of received bytes
+   * @returns Number of bytes pushed
+   */
+  size_t push(const uint8_t *data, const size_t length);
+
+  /**
+   * Pop next complete frame, the frame data is allocated with `malloc()`
+   * and has to be freed by the caller
+   *
+   * @param frame Frame
+   * @returns 1 if a frame was popped, 0 if more bytes are needed
+   */
+  int pop(SBGCFrame &frame);
+
+  /**
+   * Discard all buffered bytes
+   */
+  void clear();
+
+private:
+  uint8_t at(const size_t i) const;
+};
+
 class SBGCRealtimeData {
 public:
   Vec3 accel;
@@ -154,6 +206,17 @@ public:
   void printData();
 };
 
+/**
+ * SimpleBGC serial protocol client
+ *
+ * The serial port is non-blocking. Every frame is sent with a single write,
+ * responses are read into an `SBGCParser` and matched by command id, so
+ * commands such as `setAngle()` return as soon as they are written and can
+ * be issued at the rate the link allows. Realtime data can also be
+ * requested without waiting (`requestRealtimeData()`) and received by
+ * calling `spinOnce()` from an event loop, which dispatches every realtime
+ * data frame to `on_realtime_data`.
+ */
 class SBGC {
 public:
   bool connected;
@@ -161,6 +224,10 @@ public:
   SBGCRealtimeData data;
   std::string port;
   int serial;
+  int epoll_fd = -1;
+  int timeout_ms = SBGC_TIMEOUT_MS;
+  SBGCParser parser;
+  std::function<void(const SBGCRealtimeData &)> on_realtime_data;
 
   uint8_t board_version;
   uint16_t firmware_version;
@@ -174,6 +241,57 @@ public:
   int disconnect();
   int sendFrame(const SBGCFrame &cmd);
   int readFrame(const uint8_t read_length, SBGCFrame &frame);
+
+  /**
+   * Read all available bytes from the serial port into the parser
+   *
+   * @returns Number of bytes read, -1 for failure
+   */
+  int receive();
+
+  /**
+   * Wait for a frame, other frames received in the meantime are dispatched
+   *
+   * @param cmd_id Expected command id (-1 for any)
+   * @param frame Frame, data has to be freed by the caller
+   * @returns 0 for success, -1 for failure or timeout
+   */
+  int waitFrame(const int cmd_id, SBGCFrame &frame);
+
+  /**
+   * Dispatch a frame that nobody waits for, realtime data frames update
+   * `data` and are passed to `on_realtime_data`
+   *
+   * @param frame Frame
+   * @returns 1 if dispatched, 0 if ignored
+   */
+  int dispatchFrame(const SBGCFrame &frame);
+
+  /**
+   * Wait for the serial port to become readable and dispatch all received
+   * frames, meant to be called from an event loop
+   *
+   * @param timeout_ms Timeout in milliseconds (-1 to block)
+   * @returns Number of frames dispatched, -1 for failure
+   */
+  int spinOnce(const int timeout_ms);
+
+  /**
+   * Parse realtime data frame (`CMD_REALTIME_DATA_3` or
+   * `CMD_REALTIME_DATA_4`) into `data`
+   *
+   * @param frame Frame
+   * @returns 0 for success, -1 for failure
+   */
+  int parseRealtimeData(const SBGCFrame &frame);
+
+  /**
+   * Request realtime data without waiting for the response
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int requestRealtimeData();
+
   int on();
   int off();
   int reset();
@@ -136,6 +136,25 @@ namespace gvio {
 #define MPU6050_RA_FIFO_R_W 0x74
 #define MPU6050_RA_WHO_AM_I 0x75
 
+// FIFO
+#define MPU6050_FIFO_SIZE 1024       // FIFO size in bytes
+#define MPU6050_FIFO_PACKET_SIZE 12  // accel xyz + gyro xyz, 16-bit each
+#define MPU6050_FIFO_EN_ACCEL 0x08   // FIFO_EN: accel xyz
+#define MPU6050_FIFO_EN_GYRO 0x70    // FIFO_EN: gyro x, y and z
+#define MPU6050_USER_CTRL_FIFO_EN 0x40
+#define MPU6050_USER_CTRL_FIFO_RESET 0x04
+#define MPU6050_INT_STATUS_FIFO_OFLOW 0x10
+#define MPU6050_SAMPLE_QUEUE_SIZE 4096
+
+/**
+ * MPU6050 sample read from the FIFO
+ */
+struct MPU6050Sample {
+  double timestamp = 0.0; ///< Reconstructed timestamp [s]
+  float accel[3] = {0.0f, 0.0f, 0.0f}; ///< Accelerometer [m/s^2]
+  float gyro[3] = {0.0f, 0.0f, 0.0f};  ///< Gyroscope [rad/s]
+};
+
 /**
  * Invensense MPU6050 I2C Driver
  */
@@ -146,6 +165,14 @@ public:
   int8_t dplf_config = 0;
   clock_t last_updated = 0;
 
+  // FIFO acquisition
+  bool fifo_enabled = false;
+  double fifo_timestamp = -1.0; ///< Timestamp of last sample read [s]
+  double fifo_clock_gain = 0.01; ///< Clock drift correction gain
+  size_t nb_overflows = 0;       ///< FIFO overflows (samples lost)
+  size_t nb_dropped = 0;         ///< Samples dropped, queue was full
+  SPSCQueue<MPU6050Sample> samples{MPU6050_SAMPLE_QUEUE_SIZE};
+
   MPU6050() {}
 
   /**
@@ -168,6 +195,53 @@ public:
    */
   virtual int getData() override;
 
+  /**
+   * Enable FIFO acquisition
+   *
+   * The accelerometer and gyroscope are written to the on-chip FIFO at the
+   * sample rate, `readFIFO()` drains it in one burst. Uses the sensitivities
+   * and `sample_rate` that are configured at the time of the call.
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int enableFIFO();
+
+  /**
+   * Disable FIFO acquisition
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int disableFIFO();
+
+  /**
+   * Drain FIFO into `samples`
+   *
+   * Samples are timestamped by counting sample periods from the previous
+   * read, the timeline is slowly pulled towards `read_time` (by
+   * `fifo_clock_gain`) to follow the drift between the sensor clock and the
+   * host clock. On overflow the FIFO is reset and the timeline restarts.
+   *
+   * @param read_time Host time of read [s]
+   * @returns Number of samples read, -1 for failure, -2 for FIFO overflow
+   */
+  int readFIFO(const double read_time);
+
+  /**
+   * Drain FIFO into `samples`, timestamped with the host clock
+   *
+   * @returns Number of samples read, -1 for failure, -2 for FIFO overflow
+   */
+  int readFIFO();
+
+  /**
+   * Pop sample read from the FIFO, may be called from a different thread
+   * than `readFIFO()`
+   *
+   * @param sample Sample
+   * @returns True if a sample was popped, false if there was none
+   */
+  bool popSample(MPU6050Sample &sample);
+
   /**
    * Set DPLF
    *
@@ -6,19 +6,24 @@
 #include <fstream>
 
 #include "gvio/util/util.hpp"
+#include "gvio/util/async_writer.hpp"
 #include "gvio/msckf/msckf.hpp"
 
 namespace gvio {
 
 /**
  * BlackBox
+ *
+ * Records are queued to an `AsyncWriter`, so recording never blocks on disk
+ * I/O. All record functions must be called from the same thread.
  */
 class BlackBox {
 public:
-  std::ofstream est_file;
-  std::ofstream mea_file;
-  std::ofstream gnd_file;
-  std::ofstream win_file;
+  AsyncWriter writer;
+  int est_stream = -1;
+  int mea_stream = -1;
+  int gnd_stream = -1;
+  int win_stream = -1;
 
   BlackBox();
   virtual ~BlackBox();
@@ -28,10 +33,23 @@ public:
    *
    * @param output_path Output path
    * @param base_name Output file basename
+   * @param binary Record in binary format (see `async_writer_bin2csv()`)
    *
    * @returns 0 for success, -1 for failure
    */
-  int configure(const std::string &output_path, const std::string &base_name);
+  int configure(const std::string &output_path,
+                const std::string &base_name,
+                const bool binary = false);
+
+  /**
+   * Close blackbox, writes all queued records and closes the files
+   *
+   * Must be called before reading the recorded files back, recording after
+   * closing fails.
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int close();
 
   /**
    * Record MSCKF
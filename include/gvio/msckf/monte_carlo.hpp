@@ -0,0 +1,107 @@
+/**
+ * @file
+ * @ingroup msckf
+ */
+#ifndef GVIO_MSCKF_MONTE_CARLO_HPP
+#define GVIO_MSCKF_MONTE_CARLO_HPP
+
+#include <libgen.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gvio/util/util.hpp"
+#include "gvio/quaternion/jpl.hpp"
+#include "gvio/sim/world.hpp"
+#include "gvio/msckf/msckf.hpp"
+
+namespace gvio {
+/**
+ * @addtogroup msckf
+ * @{
+ */
+
+/**
+ * Result of one Monte Carlo run
+ */
+struct MonteCarloRun {
+  int index = -1;
+  int retval = -1;   ///< 0 for success, -1 if the filter diverged
+  double ate = 0.0;  ///< Absolute trajectory error, position RMSE [m]
+  double rpe = 0.0;  ///< Relative pose error, translation drift RMSE [m]
+  double nees = 0.0; ///< Mean position NEES
+  std::vector<double> frame_times; ///< Filter update time per frame [ms]
+};
+
+/**
+ * Monte Carlo evaluation of the MSCKF in simulation
+ *
+ * Every run simulates its own `SimWorld` and filter. The filter predicts
+ * with `SimIMU` measurements at `imu.rate` and updates with keypoint tracks
+ * every `dt`. IMU and keypoint noise are drawn from random number generators
+ * that are seeded from `seed` and the run index only, so results do not
+ * depend on the number of threads or the order runs are scheduled in. Runs
+ * are distributed over a thread pool.
+ */
+class MSCKFMonteCarlo {
+public:
+  std::string msckf_config;  ///< MSCKF config file
+  int nb_runs = 10;          ///< Number of runs
+  int seed = 0;              ///< Base seed
+  int nb_threads = 0;        ///< Number of threads (0: hardware threads)
+  double dt = 0.1;           ///< Simulation time step [s]
+  double duration = 10.0;    ///< Simulated time per run [s]
+  int nb_features = 1000;    ///< Number of 3D features in world
+  double pixel_noise = 0.0;  ///< Keypoint noise std dev [px]
+  double rpe_interval = 1.0; ///< Relative pose error interval [s]
+  SimIMU imu; ///< IMU model of every run, reseeded per run
+
+  MSCKF msckf; ///< Configured filter every run starts from
+  std::vector<MonteCarloRun> runs;
+  double wall_time = 0.0; ///< Wall time of last `run()` [s]
+
+  MSCKFMonteCarlo() {}
+  virtual ~MSCKFMonteCarlo() {}
+
+  /**
+   * Configure
+   *
+   * @param config_file Path to configuration file
+   * @returns 0 for success, -1 for failure
+   */
+  int configure(const std::string &config_file);
+
+  /**
+   * Simulate one run
+   *
+   * @param index Run index
+   * @param run Run result, `run.retval` is -1 if the filter diverged
+   * @returns 0 for success, -1 if the run could not be set up
+   */
+  int simulate(const int index, MonteCarloRun &run) const;
+
+  /**
+   * Simulate all runs in parallel
+   *
+   * @returns Number of runs where the filter diverged
+   */
+  int run();
+
+  /**
+   * Print summary of all runs
+   */
+  void printReport() const;
+
+  /**
+   * Save per run results as CSV
+   *
+   * @param output_path Output file path
+   * @returns 0 for success, -1 for failure
+   */
+  int saveResults(const std::string &output_path) const;
+};
+
+/** @} group msckf */
+} // namespace gvio
+#endif // GVIO_MSCKF_MONTE_CARLO_HPP
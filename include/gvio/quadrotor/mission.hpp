@@ -68,8 +68,28 @@ public:
  */
 std::ostream &operator<<(std::ostream &out, const Waypoint &wp);
 
+/**
+ * Mission segment between two local waypoints, with its geometry cached
+ */
+struct MissionSegment {
+  Vec3 start{0.0, 0.0, 0.0};
+  Vec3 end{0.0, 0.0, 0.0};
+  Vec3 direction{0.0, 0.0, 0.0}; ///< Unit vector from start to end
+  Vec3 normal{0.0, 0.0, 0.0};    ///< Horizontal unit normal, left of track
+  double length = 0.0;           ///< Length
+  double heading = 0.0;          ///< Heading in NWU frame
+
+  MissionSegment() {}
+  MissionSegment(const Vec3 &start, const Vec3 &end);
+};
+
 /**
  * Mission
+ *
+ * Waypoints are converted to the local frame once, and the geometry of every
+ * segment between consecutive waypoints is precomputed. Per update only the
+ * active segment `wp_start` to `wp_end` is evaluated, so the cost does not
+ * depend on the number of waypoints.
  */
 class Mission {
 public:
@@ -88,9 +108,11 @@ public:
 
   std::vector<Vec3> gps_waypoints;
   std::vector<Vec3> local_waypoints;
+  std::vector<MissionSegment> segments; ///< Segments between local waypoints
   int waypoint_index = 0;
   Vec3 wp_start = Vec3::Zero();
   Vec3 wp_end = Vec3::Zero();
+  MissionSegment segment; ///< Geometry of `wp_start` to `wp_end`
 
   Mission() {}
 
@@ -143,6 +165,20 @@ public:
    */
   int setGPSHomePoint(const double home_lat, const double home_lon);
 
+  /**
+   * Precompute segments between local waypoints and activate the first
+   *
+   * @return 0 for success, -1 if there are less than two local waypoints
+   */
+  int buildSegments();
+
+  /**
+   * Active segment, recomputed only if `wp_start` or `wp_end` changed
+   *
+   * @return Active segment
+   */
+  const MissionSegment &activeSegment();
+
   /**
    * Calculate closest point
    *
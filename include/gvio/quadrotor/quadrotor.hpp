@@ -9,6 +9,7 @@
 #include "gvio/quadrotor/control/position_controller.hpp"
 #include "gvio/quadrotor/control/waypoint_controller.hpp"
 #include "gvio/quadrotor/mission.hpp"
+#include "gvio/quadrotor/quadrotor_batch.hpp"
 #include "gvio/quadrotor/quadrotor_model.hpp"
 
 #endif
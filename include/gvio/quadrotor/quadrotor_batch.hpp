@@ -0,0 +1,177 @@
+/**
+ * @file
+ * @ingroup quadrotor
+ */
+#ifndef GVIO_QUADROTOR_QUADROTOR_BATCH_HPP
+#define GVIO_QUADROTOR_QUADROTOR_BATCH_HPP
+
+#include <vector>
+
+#include "gvio/util/util.hpp"
+#include "gvio/quadrotor/control/attitude_controller.hpp"
+#include "gvio/quadrotor/control/position_controller.hpp"
+
+namespace gvio {
+/**
+ * @addtogroup quadrotor
+ * @{
+ */
+
+/**
+ * Quadrotor batch state index
+ */
+enum QuadrotorBatchStateIndex {
+  QB_ROLL,
+  QB_PITCH,
+  QB_YAW,
+  QB_P,
+  QB_Q,
+  QB_R,
+  QB_X,
+  QB_Y,
+  QB_Z,
+  QB_VX,
+  QB_VY,
+  QB_VZ,
+  QB_STATE_SIZE
+};
+
+/**
+ * Quadrotor batch integrator
+ */
+enum QuadrotorBatchIntegrator { QB_EULER, QB_RK4 };
+
+/**
+ * Batch of quadrotors sharing the `QuadrotorModel` dynamics
+ *
+ * Rolls out many vehicles at once, e.g. for controller tuning or trajectory
+ * search. The state is stored as structure of arrays, `state[i * N + k]` is
+ * state `i` (see `QuadrotorBatchStateIndex`) of vehicle `k`, so the
+ * dynamics loop reads each state across vehicles from contiguous memory.
+ * Per step and integration stage the trigonometric terms of each vehicle
+ * are computed once, and motor inputs are mixed into thrust and torques
+ * when they are set.
+ *
+ * With `QB_EULER` a vehicle follows the same trajectory as a
+ * `QuadrotorModel` with the same controllers and inputs. Body frame
+ * acceleration and angular velocity are not computed.
+ */
+class QuadrotorBatch {
+public:
+  size_t nb_vehicles = 0;
+  QuadrotorBatchIntegrator integrator = QB_EULER;
+
+  double Ix = 0.0963; ///< Moment of inertia in x-axis
+  double Iy = 0.0963; ///< Moment of inertia in y-axis
+  double Iz = 0.1927; ///< Moment of inertia in z-axis
+
+  double kr = 0.1; ///< Rotation drag constant
+  double kt = 0.2; ///< Translation drag constant
+
+  double l = 0.9; ///< Quadrotor arm length
+  double d = 1.0; ///< drag constant
+
+  double m = 1.0;  ///< Mass
+  double g = 9.81; ///< Gravity
+
+  std::vector<double> state; ///< State, QB_STATE_SIZE x N
+  std::vector<double> tau;   ///< Thrust, roll, pitch, yaw torque, 4 x N
+
+  std::vector<Vec3> position_setpoints; ///< Position setpoints
+  std::vector<Vec4> attitude_setpoints; ///< Attitude setpoints
+  std::vector<PositionController> position_controllers;
+  std::vector<AttitudeController> attitude_controllers;
+
+  // Integration buffers, QB_STATE_SIZE x N each
+  std::vector<double> k1;
+  std::vector<double> k2;
+  std::vector<double> k3;
+  std::vector<double> k4;
+  std::vector<double> x_tmp;
+
+  QuadrotorBatch() {}
+  virtual ~QuadrotorBatch() {}
+
+  /**
+   * Configure
+   *
+   * @param nb_vehicles Number of vehicles
+   * @returns 0 for success, -1 for failure
+   */
+  int configure(const size_t nb_vehicles);
+
+  /**
+   * Set vehicle pose, resets velocities
+   *
+   * @param k Vehicle index
+   * @param rpy_G Attitude in global frame
+   * @param p_G Position in global frame
+   */
+  void setPose(const size_t k, const Vec3 &rpy_G, const Vec3 &p_G);
+
+  /**
+   * Set vehicle motor inputs
+   *
+   * @param k Vehicle index
+   * @param motor_inputs Motor inputs (m1, m2, m3, m4)
+   */
+  void setMotorInputs(const size_t k, const Vec4 &motor_inputs);
+
+  /**
+   * Vehicle attitude in global frame
+   */
+  Vec3 attitude(const size_t k) const;
+
+  /**
+   * Vehicle position in global frame
+   */
+  Vec3 position(const size_t k) const;
+
+  /**
+   * Vehicle velocity in global frame
+   */
+  Vec3 velocity(const size_t k) const;
+
+  /**
+   * Run attitude controller of every vehicle and set motor inputs
+   *
+   * @param dt Time difference (s)
+   */
+  void attitudeControl(const double dt);
+
+  /**
+   * Run position and attitude controller of every vehicle and set motor
+   * inputs
+   *
+   * @param dt Time difference (s)
+   */
+  void positionControl(const double dt);
+
+  /**
+   * Integrate dynamics of all vehicles with the current motor inputs
+   *
+   * @param dt Time difference (s)
+   */
+  void integrate(const double dt);
+
+  /**
+   * Run position control and integrate, same as `QuadrotorModel::update()`
+   * in position control mode
+   *
+   * @param dt Time difference (s)
+   * @returns 0 for success, -1 for failure
+   */
+  int update(const double dt);
+
+  /**
+   * Evaluate state derivative of all vehicles
+   *
+   * @param x State, QB_STATE_SIZE x N
+   * @param dx State derivative, QB_STATE_SIZE x N
+   */
+  void dynamics(const double *x, double *dx) const;
+};
+
+/** @} group quadrotor */
+} // namespace gvio
+#endif // GVIO_QUADROTOR_QUADROTOR_BATCH_HPP
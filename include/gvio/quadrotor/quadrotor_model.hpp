@@ -19,6 +19,11 @@ namespace gvio {
  * @{
  */
 
+/**
+ * Quadrotor control mode
+ */
+enum QuadrotorControlMode { POS_CTRL_MODE, ATT_CTRL_MODE, WP_CTRL_MODE };
+
 /**
  * Quadrotor model
  */
@@ -46,7 +51,10 @@ public:
   double m = 1.0;  ///< Mass
   double g = 9.81; ///< Gravity
 
-  std::string ctrl_mode = "POS_CTRL_MODE";
+  QuadrotorControlMode ctrl_mode = POS_CTRL_MODE;
+  double attitude_rate = 500.0; ///< Attitude control and dynamics rate [Hz]
+  double position_rate = 100.0; ///< Position control rate [Hz]
+  double waypoint_rate = 10.0;  ///< Waypoint control rate [Hz]
   Vec4 attitude_setpoints{0.0, 0.0, 0.0, 0.5}; ///< Attitude setpoints
   Vec3 position_setpoints{0.0, 0.0, 0.0};      ///< Position setpoints
   Mission mission;                             ///< Mission
@@ -82,6 +90,20 @@ public:
    */
   int update(const double dt);
 
+  /**
+   * Add control loops to executor
+   *
+   * Adds the waypoint controller at `waypoint_rate`, the position
+   * controller at `position_rate` and the attitude controller together with
+   * the model dynamics at `attitude_rate`, in that order of priority, so
+   * outer loops update their setpoints before the inner loop uses them. The
+   * position and waypoint controllers only run in their control mode.
+   *
+   * @param executor Periodic executor
+   * @returns 0 for success, -1 for failure
+   */
+  int addTasks(PeriodicExecutor &executor);
+
   /**
    * Update attitude controller
    *
@@ -64,6 +64,70 @@ T bezier_tangent(const std::vector<T> &points, const float t);
 template <typename T>
 T decasteljau(const std::vector<T> &points, const float t);
 
+/**
+ * Bezier curve with precomputed derivatives
+ *
+ * The control points and the control points of the first and second
+ * derivative are converted once to power basis coefficients, so position,
+ * velocity and acceleration at any t only cost a Horner evaluation. The
+ * batch `evaluate()` makes a single pass over a vector of times, evaluating
+ * the precomputed coefficients with Horner's scheme at each time.
+ *
+ * Converting to power basis loses precision for high degree curves, it is
+ * meant for the low degree curves used as trajectories (degree < ~15).
+ */
+class BezierCurve {
+public:
+  std::vector<Vec3> points; ///< Control points
+
+  // Power basis coefficients, column k is the coefficient of t^k
+  Mat3X coeffs_pos;
+  Mat3X coeffs_vel;
+  Mat3X coeffs_acc;
+
+  BezierCurve() {}
+  BezierCurve(const std::vector<Vec3> &points);
+  virtual ~BezierCurve() {}
+
+  /**
+   * Configure
+   *
+   * @param points Bezier curve control points in order
+   * @returns 0 for success, -1 for failure
+   */
+  int configure(const std::vector<Vec3> &points);
+
+  /**
+   * Curve degree
+   */
+  int degree() const { return (int) this->points.size() - 1; }
+
+  /**
+   * Position at t
+   */
+  Vec3 position(const double t) const;
+
+  /**
+   * Velocity (first derivative) at t
+   */
+  Vec3 velocity(const double t) const;
+
+  /**
+   * Acceleration (second derivative) at t
+   */
+  Vec3 acceleration(const double t) const;
+
+  /**
+   * Evaluate curve at a vector of times
+   *
+   * @param t Curve parameters
+   * @param pos Positions, one column per t (can be nullptr)
+   * @param vel Velocities, one column per t (can be nullptr)
+   * @param acc Accelerations, one column per t (can be nullptr)
+   */
+  void evaluate(const VecX &t, Mat3X *pos, Mat3X *vel, Mat3X *acc) const;
+};
+
 /** @} group sim */
 } // namespace gvio
 
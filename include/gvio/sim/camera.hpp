@@ -7,6 +7,7 @@
 
 #include "gvio/util/util.hpp"
 #include "gvio/camera/pinhole_model.hpp"
+#include "gvio/sim/feature_grid.hpp"
 
 namespace gvio {
 /**
@@ -20,6 +21,8 @@ namespace gvio {
 class VirtualCamera {
 public:
   PinholeModel camera_model;
+  double min_depth = 1.0; ///< Features closer than this are not observed
+  std::vector<int> cells; ///< Grid cells of last frustum query
 
   VirtualCamera() {}
   VirtualCamera(const int image_width,
@@ -49,6 +52,38 @@ public:
                         const Vec3 &rpy_G,
                         const Vec3 &t_G,
                         std::vector<int> &feature_ids);
+
+  /**
+   * Return features observed by camera, only features in grid cells that
+   * intersect the camera frustum are projected
+   *
+   * Same result as `observedFeatures()` on the matrix the grid was built
+   * from, except feature ids are in grid order instead of ascending.
+   *
+   * @param grid Feature grid
+   * @param rpy_G Orientation as roll, pitch  yaw. Note: x is forward
+   * @param t_G Translation. Note: x is forward
+   * @param feature_ids Features observed
+   * @param keypoints Observed features in the image plane (pixels)
+   */
+  void observedFeatures(const FeatureGrid &grid,
+                        const Vec3 &rpy_G,
+                        const Vec3 &t_G,
+                        std::vector<int> &feature_ids,
+                        Mat2X &keypoints);
+
+  /**
+   * Camera frustum in the global frame
+   *
+   * @param rpy_G Orientation as roll, pitch  yaw. Note: x is forward
+   * @param t_G Translation. Note: x is forward
+   * @param max_depth Far plane distance
+   *
+   * @returns Frustum
+   */
+  Frustum frustum(const Vec3 &rpy_G,
+                  const Vec3 &t_G,
+                  const double max_depth) const;
 };
 
 /** @} group sim */
@@ -0,0 +1,103 @@
+/**
+ * @file
+ * @ingroup sim
+ */
+#ifndef GVIO_SIM_FEATURE_GRID_HPP
+#define GVIO_SIM_FEATURE_GRID_HPP
+
+#include <vector>
+
+#include "gvio/util/util.hpp"
+
+namespace gvio {
+/**
+ * @addtogroup sim
+ * @{
+ */
+
+/** Target number of features per cell if features were spread uniformly **/
+#define FEATURE_GRID_CELL_FEATURES 8
+
+/** Maximum number of cells along one axis **/
+#define FEATURE_GRID_MAX_CELLS 256
+
+/**
+ * View frustum bounded by near, far and four side planes
+ *
+ * A point p is inside if `planes[i].head(3).dot(p) + planes[i](3) >= 0` for
+ * all planes. `box_min` and `box_max` bound the volume.
+ */
+struct Frustum {
+  Vec4 planes[6];
+  Vec3 box_min{0.0, 0.0, 0.0};
+  Vec3 box_max{0.0, 0.0, 0.0};
+
+  /**
+   * Check if axis aligned box intersects frustum, conservative: may return
+   * true for boxes just outside near the edges of the frustum
+   *
+   * @param box_min Box minimum corner
+   * @param box_max Box maximum corner
+   * @returns True if box intersects frustum, else false
+   */
+  bool intersects(const Vec3 &box_min, const Vec3 &box_max) const;
+};
+
+/**
+ * Uniform grid index over static 3D features
+ *
+ * Features are bucketed into cubic cells and stored sorted by cell in flat
+ * arrays, so all features of a cell are contiguous in memory. A query
+ * returns the cells that intersect a frustum, the caller then only has to
+ * test the features in those cells.
+ */
+class FeatureGrid {
+public:
+  Vec3 grid_min{0.0, 0.0, 0.0};
+  Vec3 grid_max{0.0, 0.0, 0.0};
+  double cell_size = 0.0;
+  int nb_cells[3] = {0, 0, 0};
+
+  std::vector<int> cell_start; ///< Offset of first feature per cell
+  std::vector<int> ids;        ///< Feature ids sorted by cell
+  std::vector<Vec3> points;    ///< Feature positions sorted by cell
+
+  FeatureGrid() {}
+  virtual ~FeatureGrid() {}
+
+  /**
+   * Build grid
+   *
+   * @param features Feature matrix with N features per row (i.e. Nx3 matrix)
+   * @param cell_size Cell size, if 0 it is chosen so that there are about
+   * `FEATURE_GRID_CELL_FEATURES` features per cell
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int build(const MatX &features, const double cell_size = 0.0);
+
+  /**
+   * Number of features in grid
+   */
+  size_t size() const { return this->ids.size(); }
+
+  /**
+   * Cell index
+   */
+  int cellIndex(const int i, const int j, const int k) const {
+    return (k * this->nb_cells[1] + j) * this->nb_cells[0] + i;
+  }
+
+  /**
+   * Find non-empty cells that intersect the frustum
+   *
+   * @param frustum Frustum
+   * @param cells Indices of cells, features of cell c are in
+   * [cell_start[c], cell_start[c + 1])
+   */
+  void query(const Frustum &frustum, std::vector<int> &cells) const;
+};
+
+/** @} group sim */
+} // namespace gvio
+#endif // GVIO_SIM_FEATURE_GRID_HPP
@@ -0,0 +1,69 @@
+/**
+ * @file
+ * @ingroup sim
+ */
+#ifndef GVIO_SIM_IMU_HPP
+#define GVIO_SIM_IMU_HPP
+
+#include <random>
+
+#include "gvio/util/util.hpp"
+
+namespace gvio {
+/**
+ * @addtogroup sim
+ * @{
+ */
+
+/**
+ * Simulated IMU
+ *
+ * Turns the true body acceleration and angular velocity into accelerometer
+ * and gyroscope measurements with white noise and a bias random walk. The
+ * noise parameters are continuous time densities as found in IMU datasheets
+ * and Kalibr / EuRoC sensor configs, they are discretized with the period
+ * between measurements.
+ */
+class SimIMU {
+public:
+  double rate = 0.0;                ///< Rate [Hz], 0 disables the IMU
+  double accel_noise_density = 0.0; ///< [m/s^2/sqrt(Hz)]
+  double gyro_noise_density = 0.0;  ///< [rad/s/sqrt(Hz)]
+  double accel_random_walk = 0.0;   ///< [m/s^3/sqrt(Hz)]
+  double gyro_random_walk = 0.0;    ///< [rad/s^2/sqrt(Hz)]
+  Vec3 g_G{0.0, 0.0, -9.81};        ///< Gravity in global frame [m/s^2]
+
+  unsigned int seed = std::mt19937::default_seed; ///< Seed of `rng`
+  std::mt19937 rng; ///< Random number generator, seeded by `reset()`
+  Vec3 b_a{0.0, 0.0, 0.0}; ///< Accelerometer bias [m/s^2]
+  Vec3 b_g{0.0, 0.0, 0.0}; ///< Gyroscope bias [rad/s]
+
+  SimIMU() {}
+  virtual ~SimIMU() {}
+
+  /**
+   * Reseed random number generator and zero biases
+   */
+  void reset();
+
+  /**
+   * Simulate measurement
+   *
+   * @param dt Time since last measurement [s]
+   * @param R_GB Rotation from body to global frame
+   * @param a_G True acceleration in global frame [m/s^2]
+   * @param w_B True angular velocity in body frame [rad/s]
+   * @param a_m Measured acceleration (specific force) in body frame [m/s^2]
+   * @param w_m Measured angular velocity in body frame [rad/s]
+   */
+  void measure(const double dt,
+               const Mat3 &R_GB,
+               const Vec3 &a_G,
+               const Vec3 &w_B,
+               Vec3 &a_m,
+               Vec3 &w_m);
+};
+
+/** @} group sim */
+} // namespace gvio
+#endif // GVIO_SIM_IMU_HPP
@@ -6,6 +6,8 @@
 #define GVIO_SIM_HPP
 
 #include "gvio/sim/camera.hpp"
+#include "gvio/sim/feature_grid.hpp"
+#include "gvio/sim/imu.hpp"
 #include "gvio/sim/twowheel.hpp"
 #include "gvio/sim/world.hpp"
 
@@ -5,14 +5,17 @@
 #ifndef GVIO_SIM_WORLD_HPP
 #define GVIO_SIM_WORLD_HPP
 
+#include <functional>
+#include <random>
 #include <vector>
-#include <map>
 
 #include "gvio/util/util.hpp"
 #include "gvio/camera/pinhole_model.hpp"
 #include "gvio/feature2d/feature_container.hpp"
 #include "gvio/sim/twowheel.hpp"
 #include "gvio/sim/camera.hpp"
+#include "gvio/sim/feature_grid.hpp"
+#include "gvio/sim/imu.hpp"
 
 namespace gvio {
 /**
@@ -29,6 +32,16 @@ struct feature_bounds {
   double z_max = 0.0;
 };
 
+/**
+ * Simulated world
+ *
+ * A two wheel robot drives a circle inside a perimeter of 3D features and a
+ * virtual camera tracks the features every `dt`. If `imu.rate` is set the
+ * robot is integrated at the IMU rate instead and an IMU measurement is
+ * simulated for every sub-step. Like `MAVDataset`, `step()` passes the
+ * measurements in time order to `imu_cb` and `camera_cb`, IMU measurements
+ * before the camera frame with the same timestamp.
+ */
 class SimWorld {
 public:
   double t = 0.0;
@@ -38,19 +51,41 @@ public:
 
   TwoWheelRobot robot;
   VirtualCamera camera;
+  SimIMU imu;
+
+  unsigned int seed = std::mt19937::default_seed; ///< Seed of `rng`
+  std::mt19937 rng; ///< Random number generator, seeded by `configure()`
+  double pixel_noise = 0.0; ///< Keypoint noise standard deviation [px]
 
   Vec3 origin{0.0, 0.0, 0.0};
   Vec3 dimensions{30.0, 30.0, 60.0};
   size_t nb_features = 1000;
   MatX features3d;
+  FeatureGrid grid; ///< Spatial index over `features3d`
 
+  // Tracking state in flat arrays, `features_tracking[i]` is the feature id
+  // of `tracks_tracking[i]`, `feature_track[id]` the index of the track of a
+  // feature (-1 if not tracked) and `feature_seen[id]` the last detection it
+  // was observed in
   std::vector<int> features_tracking;
-  std::map<int, FeatureTrack> tracks_tracking;
+  FeatureTracks tracks_tracking;
   FeatureTracks tracks_lost;
+  std::vector<int> feature_track;
+  std::vector<size_t> feature_seen;
+  size_t nb_detections = 0;
+
+  // Detection buffers, reused between steps
+  std::vector<int> observed_ids;
+  Mat2X keypoints;
 
   std::ofstream trajectory_file;
   std::ofstream feature3d_file;
 
+  // clang-format off
+  std::function<int(const Vec3 &a_m, const Vec3 &w_m, const long ts)> imu_cb;
+  std::function<int(const FeatureTracks &tracks, const long ts)> camera_cb;
+  // clang-format on
+
   SimWorld() {}
   virtual ~SimWorld() {}
 
@@ -85,6 +120,14 @@ public:
                                 const Vec3 &dimensions,
                                 const size_t nb_features);
 
+  /**
+   * Build spatial index over `features3d` and reset tracking state, called
+   * by `configure()` and whenever the number of features changed
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int buildIndex();
+
   /**
    * Detect features
    */
@@ -98,11 +141,38 @@ public:
   FeatureTracks removeLostTracks();
 
   /**
-   * Step simulation
+   * Simulate IMU measurement of the current robot state and pass it to
+   * `imu_cb`
    *
+   * @param dt Time since last IMU measurement [s]
+   * @param ts Timestamp [ns]
    * @returns 0 for success, -1 for failure
    */
+  int measureIMU(const double dt, const long ts);
+
+  /**
+   * Step simulation
+   *
+   * If `camera_cb` is set the tracks lost in this frame are removed and
+   * passed to it.
+   *
+   * @returns
+   * - 0 for success
+   * - -2 for imu callback failure
+   * - -3 for camera callback failure
+   */
   int step();
+
+  /**
+   * Run simulation until `t_end`, in `round((t_end - t) / dt)` steps
+   *
+   * @returns
+   * - 0 for success
+   * - -1 for invalid time step
+   * - -2 for imu callback failure
+   * - -3 for camera callback failure
+   */
+  int run();
 };
 
 /** @} group sim */
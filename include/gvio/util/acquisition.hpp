@@ -0,0 +1,237 @@
+/**
+ * @file
+ * @defgroup acquisition acquisition
+ * @ingroup util
+ */
+#ifndef GVIO_UTIL_ACQUISITION_HPP
+#define GVIO_UTIL_ACQUISITION_HPP
+
+#include <stdint.h>
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gvio/util/async_writer.hpp"
+#include "gvio/util/log.hpp"
+#include "gvio/util/spsc_queue.hpp"
+#include "gvio/util/stats.hpp"
+#include "gvio/util/time.hpp"
+#include "gvio/util/vision.hpp"
+
+namespace gvio {
+/**
+ * @addtogroup acquisition
+ * @{
+ */
+
+/** Maximum number of values per sensor event **/
+#define SENSOR_EVENT_MAX_VALUES 16
+
+/**
+ * Sensor event type
+ */
+enum SensorEventType {
+  SENSOR_IMU_EVENT,
+  SENSOR_CAMERA_EVENT,
+  SENSOR_GIMBAL_EVENT
+};
+
+/**
+ * Sensor event
+ *
+ * IMU events hold the accelerometer followed by the gyroscope measurement in
+ * `values`, gimbal events the joint angles and camera events the image.
+ */
+struct SensorEvent {
+  SensorEventType type = SENSOR_IMU_EVENT;
+  int sensor_id = -1;           ///< Index of sensor in acquisition service
+  uint64_t seq = 0;             ///< Sequence number of sensor event
+  int64_t timestamp = 0;        ///< Monotonic clock timestamp [ns]
+  int64_t sensor_timestamp = 0; ///< Sensor (hardware) timestamp, 0 if none
+  int nb_values = 0;
+  double values[SENSOR_EVENT_MAX_VALUES];
+  cv::Mat image;
+};
+
+/**
+ * Sensor read function
+ *
+ * Blocks until the next measurement is available and fills in the event. If
+ * the event timestamp is left at 0 the acquisition service stamps it with the
+ * monotonic clock as soon as the function returns, drivers that know when
+ * the measurement was taken (e.g. exposure start) should set it themselves.
+ *
+ * Returns 0 for success, 1 if no measurement was available (e.g. time out)
+ * and -1 for failure, which stops the sensor thread.
+ */
+typedef std::function<int(SensorEvent &event)> SensorReadFunc;
+
+/**
+ * Sensor managed by the acquisition service
+ */
+struct AcquisitionSensor {
+  std::string name;
+  SensorEventType type = SENSOR_IMU_EVENT;
+  SensorReadFunc read;
+  double period = 0.0; ///< Nominal period [s], 0 to use the mean period
+
+  int data_stream = -1;  ///< Async writer data stream, -1 if none
+  int image_stream = -1; ///< Async writer image stream, -1 if none
+  std::string image_dir; ///< Image output directory
+
+  SPSCQueue<SensorEvent> queue;
+  std::thread thread;
+  std::atomic<uint64_t> nb_events{0};
+  std::atomic<uint64_t> nb_dropped{0};
+  std::atomic<bool> failed{false};
+
+  // Statistics, only touched by the merger thread (histograms in ms)
+  int64_t prev_timestamp = 0;
+  int64_t last_timestamp = 0;
+  double period_sum = 0.0;
+  uint64_t nb_periods = 0;
+  Histogram latency{0.0, 50.0, 100};
+  Histogram jitter{0.0, 10.0, 100};
+  Histogram skew{-50.0, 50.0, 100};
+
+  AcquisitionSensor(const size_t capacity) : queue{capacity} {}
+};
+
+/**
+ * Multi-sensor acquisition service
+ *
+ * Every sensor is read by its own thread, which timestamps the measurement
+ * with the monotonic clock right after the read returns and pushes it into a
+ * lock-free queue owned by that sensor. A merger thread drains the queues
+ * into a min-heap and emits events in timestamp order to `on_event` and the
+ * async writer. An event is only emitted once every sensor has reported a
+ * later measurement, or once it is older than `max_latency`, so a slow or
+ * silent sensor delays the output by at most `max_latency`.
+ *
+ * Per sensor the merger records the latency from timestamp to emission, the
+ * jitter of the period between measurements, and the skew to the most
+ * recent measurement of the first sensor added.
+ */
+class AcquisitionService {
+public:
+  double max_latency = 0.05;    ///< Max time waiting for other sensors [s]
+  double merge_period = 0.001;  ///< Merger loop period [s]
+  size_t queue_capacity = 1024; ///< Events per sensor queue
+
+  AsyncWriter *writer = nullptr; ///< Writer to record events to (not owned)
+  std::function<void(const SensorEvent &event)> on_event; ///< Event output
+
+  std::vector<std::unique_ptr<AcquisitionSensor>> sensors;
+  std::vector<SensorEvent> heap;
+  std::thread merger;
+  std::atomic<bool> sensors_running{false};
+  std::atomic<bool> merger_running{false};
+
+  uint64_t nb_emitted = 0;
+  uint64_t nb_late = 0; ///< Events emitted after a later event
+  int64_t last_emitted = 0;
+
+  AcquisitionService() {}
+  virtual ~AcquisitionService();
+
+  AcquisitionService(const AcquisitionService &) = delete;
+  AcquisitionService &operator=(const AcquisitionService &) = delete;
+
+  /**
+   * Add sensor, must be called before `start()`
+   *
+   * @param name Sensor name
+   * @param type Sensor event type
+   * @param read Sensor read function
+   * @param period Nominal sensor period [s], 0 if unknown
+   *
+   * @returns Sensor id, else -1 for failure
+   */
+  int addSensor(const std::string &name,
+                const SensorEventType type,
+                const SensorReadFunc &read,
+                const double period = 0.0);
+
+  /**
+   * Record sensor events with async writer, must be called before `start()`
+   *
+   * @param sensor_id Sensor id
+   * @param data_stream Data stream for event values, -1 if none
+   * @param image_stream Image stream for event images, -1 if none
+   * @param image_dir Directory images are written to as `<timestamp>.png`
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int record(const int sensor_id,
+             const int data_stream,
+             const int image_stream = -1,
+             const std::string &image_dir = "");
+
+  /**
+   * Start sensor and merger threads
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int start();
+
+  /**
+   * Stop sensor threads, then emit all remaining events and stop the merger
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int stop();
+
+  /**
+   * Check if any sensor thread stopped due to a read failure
+   */
+  bool failed() const;
+
+  /**
+   * Print per sensor statistics
+   */
+  void printStats() const;
+
+  /**
+   * Drain sensor queues into the heap, called by the merger thread
+   */
+  void drain();
+
+  /**
+   * Emit all events up to a timestamp, called by the merger thread
+   *
+   * @param watermark Timestamp [ns]
+   * @returns Number of events emitted
+   */
+  int merge(const int64_t watermark);
+
+private:
+  void sensorLoop(AcquisitionSensor &sensor, const int sensor_id);
+  void mergeLoop();
+  int64_t watermark() const;
+  void emit(const SensorEvent &event);
+};
+
+/**
+ * Synthetic sensor, produces events at a fixed rate
+ *
+ * Values are `seq + i` for value i, if `image_size` is not empty the image is
+ * a single channel image filled with `seq % 256`.
+ *
+ * @param rate Rate [Hz]
+ * @param nb_values Number of values per event
+ * @param image_size Image size
+ *
+ * @returns Sensor read function
+ */
+SensorReadFunc synthetic_sensor(const double rate,
+                                const int nb_values,
+                                const cv::Size &image_size = cv::Size(0, 0));
+
+/** @} group acquisition */
+} // namespace gvio
+#endif // GVIO_UTIL_ACQUISITION_HPP
@@ -0,0 +1,274 @@
+/**
+ * @file
+ * @defgroup async_writer async_writer
+ * @ingroup util
+ */
+#ifndef GVIO_UTIL_ASYNC_WRITER_HPP
+#define GVIO_UTIL_ASYNC_WRITER_HPP
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gvio/util/log.hpp"
+#include "gvio/util/spsc_queue.hpp"
+#include "gvio/util/vision.hpp"
+
+namespace gvio {
+/**
+ * @addtogroup async_writer
+ * @{
+ */
+
+/** Maximum number of fields per data record **/
+#define ASYNC_WRITER_MAX_FIELDS 16
+
+/** Maximum number of integer timestamps per data record **/
+#define ASYNC_WRITER_MAX_TIMESTAMPS 2
+
+/** Magic bytes at the start of a binary record file **/
+#define ASYNC_WRITER_BIN_MAGIC "GVIOBIN1"
+
+/**
+ * Data record
+ */
+struct DataRecord {
+  int64_t timestamps[ASYNC_WRITER_MAX_TIMESTAMPS] = {0};
+  double values[ASYNC_WRITER_MAX_FIELDS];
+};
+
+/**
+ * Image record
+ */
+struct ImageRecord {
+  std::string path;
+  cv::Mat image;
+};
+
+/**
+ * Stream written by the async writer
+ *
+ * A stream is owned by a single producer thread, so the queue between the
+ * producer and the writer thread is single-producer single-consumer.
+ */
+struct AsyncStream {
+  bool image_stream = false;
+  std::string path;
+  FILE *fp = nullptr;
+  bool binary = false;
+  int nb_timestamps = 0;
+  int nb_fields = 0;
+  int precision = 6;
+
+  SPSCQueue<DataRecord> data_queue;
+  SPSCQueue<ImageRecord> image_queue;
+  std::string buffer; ///< Pending bytes of the current batch
+
+  std::atomic<uint64_t> nb_written{0};
+  std::atomic<uint64_t> nb_dropped{0};
+
+  AsyncStream(const size_t data_capacity, const size_t image_capacity)
+      : data_queue{data_capacity}, image_queue{image_capacity} {}
+};
+
+/**
+ * Asynchronous batched writer
+ *
+ * Sensor threads push fixed-size records into per-stream lock-free queues
+ * and never touch the disk. A writer thread drains the data queues every
+ * `flush_period` seconds, formats the records and writes each stream's batch
+ * with a single `fwrite` followed by a flush. Image streams are encoded by a
+ * separate thread so that slow PNG compression does not hold back the data
+ * streams. If a queue is full the record
+ * is dropped and counted instead of blocking the producer, unless
+ * `drop_when_full` is disabled for offline recording where every record
+ * matters more than latency.
+ *
+ * Data streams are either CSV or a compact binary format, binary files can
+ * be converted to the same CSV layout with `async_writer_bin2csv()`.
+ */
+class AsyncWriter {
+public:
+  double flush_period = 0.05;   ///< Max time between flushes [s]
+  size_t queue_capacity = 4096; ///< Records per data stream queue
+  size_t image_capacity = 32;   ///< Records per image stream queue
+  bool drop_when_full = true;   ///< Drop records instead of waiting
+
+  std::vector<std::unique_ptr<AsyncStream>> streams;
+  std::thread writer;
+  std::thread image_writer;
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool running = false;
+  bool stopped = false; ///< Files closed by `stop()`, no more writes
+
+  AsyncWriter() {}
+  virtual ~AsyncWriter();
+
+  AsyncWriter(const AsyncWriter &) = delete;
+  AsyncWriter &operator=(const AsyncWriter &) = delete;
+
+  /**
+   * Add data stream, must be called before `start()`
+   *
+   * @param path Output file path
+   * @param header CSV header
+   * @param nb_fields Number of fields per record
+   * @param nb_timestamps Number of integer timestamps prefixing every row
+   * @param binary Write compact binary records instead of CSV
+   *
+   * @returns Stream id, else -1 for failure
+   */
+  int addStream(const std::string &path,
+                const std::string &header,
+                const int nb_fields,
+                const int nb_timestamps = 0,
+                const bool binary = false);
+
+  /**
+   * Add image stream, must be called before `start()`
+   *
+   * @returns Stream id, else -1 for failure
+   */
+  int addImageStream();
+
+  /**
+   * Start writer threads, fails once the writer was stopped
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int start();
+
+  /**
+   * Stop writer threads, drains all queues and closes the files
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int stop();
+
+  /**
+   * Queue data record
+   *
+   * @param stream_id Stream id
+   * @param values Record values (`nb_fields` of the stream)
+   * @param timestamp Timestamp (only used if stream has timestamps)
+   *
+   * @returns 0 for success, -1 if record was dropped, invalid stream or
+   * writer stopped
+   */
+  int write(const int stream_id,
+            const double *values,
+            const int64_t timestamp = 0);
+
+  /**
+   * Queue data record
+   *
+   * @param stream_id Stream id
+   * @param values Record values (`nb_fields` of the stream)
+   * @param timestamps Timestamps (`nb_timestamps` of the stream)
+   *
+   * @returns 0 for success, -1 if record was dropped, invalid stream or
+   * writer stopped
+   */
+  int write(const int stream_id,
+            const double *values,
+            const int64_t *timestamps);
+
+  /**
+   * Queue data record
+   *
+   * @param stream_id Stream id
+   * @param values Record values (`nb_fields` of the stream)
+   * @param timestamp Timestamp (only used if stream has timestamps)
+   *
+   * @returns 0 for success, -1 if record was dropped, writer stopped,
+   * invalid stream or number of values does not match the stream
+   */
+  int write(const int stream_id,
+            const std::initializer_list<double> &values,
+            const int64_t timestamp = 0);
+
+  /**
+   * Queue data record with multiple integer timestamps
+   *
+   * Use for nanosecond timestamps that do not fit in a double exactly.
+   *
+   * @param stream_id Stream id
+   * @param values Record values (`nb_fields` of the stream)
+   * @param timestamps Timestamps (`nb_timestamps` of the stream)
+   *
+   * @returns 0 for success, -1 if record was dropped, writer stopped,
+   * invalid stream or number of values or timestamps does not match the stream
+   */
+  int write(const int stream_id,
+            const std::initializer_list<double> &values,
+            const std::initializer_list<int64_t> &timestamps);
+
+  /**
+   * Queue image to be written with `cv::imwrite`
+   *
+   * The image is not copied, the producer must not modify it afterwards.
+   *
+   * @param stream_id Stream id
+   * @param path Image path
+   * @param image Image
+   *
+   * @returns 0 for success, -1 if image was dropped, invalid stream or
+   * writer stopped
+   */
+  int writeImage(const int stream_id,
+                 const std::string &path,
+                 const cv::Mat &image);
+
+  /**
+   * Number of records dropped on a stream
+   *
+   * @param stream_id Stream id
+   * @returns Number of records dropped, -1 for invalid stream
+   */
+  int64_t dropped(const int stream_id) const;
+
+  /**
+   * Drain data and image queues and write batches
+   */
+  void drain();
+
+  /**
+   * Drain data queues and write batches, called by the writer thread
+   */
+  void drainData();
+
+  /**
+   * Drain image queues and write images, called by the image writer thread
+   */
+  void drainImages();
+
+private:
+  AsyncStream *getStream(const int stream_id, const bool image_stream) const;
+  void run(const bool images);
+};
+
+/**
+ * Convert binary record file to CSV
+ *
+ * @param bin_path Binary record file
+ * @param csv_path Output CSV file
+ * @param precision Number of significant digits
+ *
+ * @returns 0 for success, -1 for failure
+ */
+int async_writer_bin2csv(const std::string &bin_path,
+                         const std::string &csv_path,
+                         const int precision = 6);
+
+/** @} group async_writer */
+} // namespace gvio
+#endif // GVIO_UTIL_ASYNC_WRITER_HPP
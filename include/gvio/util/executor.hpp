@@ -0,0 +1,161 @@
+/**
+ * @file
+ * @defgroup executor executor
+ * @ingroup util
+ */
+#ifndef GVIO_UTIL_EXECUTOR_HPP
+#define GVIO_UTIL_EXECUTOR_HPP
+
+#include <errno.h>
+#include <stdint.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gvio/util/log.hpp"
+#include "gvio/util/stats.hpp"
+#include "gvio/util/time.hpp"
+
+namespace gvio {
+/**
+ * @addtogroup executor
+ * @{
+ */
+
+/**
+ * Executor task function
+ *
+ * Called with the time since the task last ran [s] (the period on the
+ * first run), returns 0 for success and -1 for failure, which stops the
+ * executor.
+ */
+typedef std::function<int(const double dt)> ExecutorTaskFunc;
+
+/**
+ * Periodic executor task
+ */
+struct ExecutorTask {
+  std::string name;
+  int priority = 0;   ///< Tasks due at the same time run highest first
+  int64_t period = 0; ///< Period [ns]
+  ExecutorTaskFunc func;
+
+  int64_t release = 0;     ///< Next release time [ns]
+  int64_t last_start = -1; ///< Start time of last run [ns], -1 if none
+  uint64_t nb_runs = 0;
+  uint64_t nb_misses = 0;  ///< Runs that finished after their deadline
+  uint64_t nb_skipped = 0; ///< Releases dropped because the task fell behind
+
+  // Statistics [ms]
+  Histogram jitter{0.0, 1.0, 1000};    ///< Start time after release
+  Histogram exec_time{0.0, 1.0, 1000}; ///< Execution time
+};
+
+/**
+ * Fixed rate executor
+ *
+ * Runs tasks periodically from a single thread. Task k is released at
+ * `start + n * period_k` and has to finish before its next release. The
+ * executor sleeps with `clock_nanosleep()` until the earliest release, as an
+ * absolute `CLOCK_MONOTONIC` deadline so sleep errors do not accumulate, and
+ * then runs all released tasks in order of priority.
+ *
+ * If a run finishes after its deadline it counts as a miss. If a task falls
+ * more than a period behind, the releases in between are dropped instead of
+ * run back to back, so the task stays in phase.
+ *
+ * In simulated mode the executor does not sleep but jumps its clock to the
+ * next release, tasks can call `advance()` to model their execution time.
+ * This makes schedules deterministic for tests and faster than real time
+ * simulation.
+ */
+class PeriodicExecutor {
+public:
+  bool simulated = false;           ///< Simulated time mode
+  std::vector<ExecutorTask> tasks;  ///< Tasks ordered by priority
+  int64_t start_time = 0;           ///< Start time [ns]
+  int64_t sim_time = 0;             ///< Simulated clock [ns]
+  std::atomic<bool> running{false};
+
+  PeriodicExecutor() {}
+  PeriodicExecutor(const bool simulated) : simulated{simulated} {}
+  virtual ~PeriodicExecutor() {}
+
+  /**
+   * Add task, must be called before `start()`
+   *
+   * @param name Task name
+   * @param rate Rate [Hz]
+   * @param priority Priority, higher runs first
+   * @param func Task function
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int addTask(const std::string &name,
+              const double rate,
+              const int priority,
+              const ExecutorTaskFunc &func);
+
+  /**
+   * Current time [ns], monotonic clock or simulated clock
+   */
+  int64_t now() const;
+
+  /**
+   * Time since start [s]
+   */
+  double elapsed() const;
+
+  /**
+   * Advance simulated clock
+   *
+   * @param dt Time [s]
+   * @returns 0 for success, -1 if not in simulated mode
+   */
+  int advance(const double dt);
+
+  /**
+   * Start executor, all tasks are released at the current time
+   *
+   * @returns 0 for success, -1 for failure
+   */
+  int start();
+
+  /**
+   * Wait for the next release and run all released tasks
+   *
+   * @returns 0 for success, -1 if a task failed
+   */
+  int step();
+
+  /**
+   * Start and run tasks until `duration` elapsed or `stop()` is called
+   *
+   * @param duration Duration [s]
+   * @returns 0 for success, -1 if a task failed
+   */
+  int run(const double duration);
+
+  /**
+   * Stop `run()`, can be called from a task or another thread
+   */
+  void stop();
+
+  /**
+   * Print per task statistics
+   */
+  void printStats() const;
+
+private:
+  void sleepUntil(const int64_t t);
+};
+
+/** @} group executor */
+} // namespace gvio
+#endif // GVIO_UTIL_EXECUTOR_HPP
@@ -7,8 +7,10 @@
 #define GVIO_UTIL_MATH_HPP
 
 #include <iostream>
+#include <random>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <Eigen/Dense>
 #include <Eigen/Geometry>
@@ -33,6 +35,9 @@ typedef Eigen::Matrix3d Mat3;
 typedef Eigen::Matrix4d Mat4;
 typedef Eigen::MatrixXd MatX;
 typedef Eigen::Matrix<double, 3, 4> Mat34;
+typedef Eigen::Matrix<double, 2, Eigen::Dynamic> Mat2X;
+typedef Eigen::Matrix<double, 3, Eigen::Dynamic> Mat3X;
+typedef Eigen::Array<double, 1, Eigen::Dynamic> RowArrayX;
 
 typedef Eigen::Quaterniond Quaternion;
 #endif
@@ -132,6 +137,26 @@ int randi(const int ub, const int lb);
  */
 double randf(const double ub, const double lb);
 
+/**
+ * Create random double from a seeded generator
+ *
+ * @param rng Random number generator
+ * @param ub Upper bound
+ * @param lb Lower bound
+ * @return Random floating point
+ */
+double randf(std::mt19937 &rng, const double ub, const double lb);
+
+/**
+ * Create normally distributed random double from a seeded generator
+ *
+ * @param rng Random number generator
+ * @param mean Mean
+ * @param stddev Standard deviation
+ * @return Random floating point
+ */
+double randn(std::mt19937 &rng, const double mean, const double stddev);
+
 /**
  * Sign of number
  *
@@ -0,0 +1,103 @@
+/**
+ * @file
+ * @defgroup spsc_queue spsc_queue
+ * @ingroup util
+ */
+#ifndef GVIO_UTIL_SPSC_QUEUE_HPP
+#define GVIO_UTIL_SPSC_QUEUE_HPP
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+namespace gvio {
+/**
+ * @addtogroup spsc_queue
+ * @{
+ */
+
+/**
+ * Bounded lock-free single-producer single-consumer queue
+ *
+ * Exactly one thread may call `push()` and exactly one other thread may call
+ * `pop()`. Neither call ever blocks, `push()` fails when the queue is full.
+ */
+template <typename T>
+class SPSCQueue {
+public:
+  explicit SPSCQueue(const size_t capacity) : slots(capacity + 1) {}
+
+  SPSCQueue(const SPSCQueue &) = delete;
+  SPSCQueue &operator=(const SPSCQueue &) = delete;
+
+  /**
+   * Push item
+   *
+   * @param item Item
+   * @returns True if item was queued, false if queue is full
+   */
+  bool push(const T &item) {
+    const size_t tail = this->tail.load(std::memory_order_relaxed);
+    const size_t next = this->increment(tail);
+    if (next == this->head.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    this->slots[tail] = item;
+    this->tail.store(next, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Pop item
+   *
+   * @param item Item
+   * @returns True if an item was popped, false if queue is empty
+   */
+  bool pop(T &item) {
+    const size_t head = this->head.load(std::memory_order_relaxed);
+    if (head == this->tail.load(std::memory_order_acquire)) {
+      return false;
+    }
+
+    item = std::move(this->slots[head]);
+    this->head.store(this->increment(head), std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Approximate number of queued items
+   */
+  size_t size() const {
+    const size_t head = this->head.load(std::memory_order_acquire);
+    const size_t tail = this->tail.load(std::memory_order_acquire);
+    return (tail >= head) ? tail - head : this->slots.size() - head + tail;
+  }
+
+  /**
+   * Check if queue is empty
+   */
+  bool empty() const { return this->size() == 0; }
+
+  /**
+   * Queue capacity
+   */
+  size_t capacity() const { return this->slots.size() - 1; }
+
+private:
+  std::vector<T> slots;
+
+  // Head and tail on separate cache lines to avoid false sharing
+  char pad0[64];
+  std::atomic<size_t> head{0};
+  char pad1[64];
+  std::atomic<size_t> tail{0};
+
+  size_t increment(const size_t index) const {
+    return (index + 1 == this->slots.size()) ? 0 : index + 1;
+  }
+};
+
+/** @} group spsc_queue */
+} // namespace gvio
+#endif // GVIO_UTIL_SPSC_QUEUE_HPP
@@ -6,6 +6,10 @@
 #ifndef GVIO_UTIL_STATS_HPP
 #define GVIO_UTIL_STATS_HPP
 
+#include <algorithm>
+#include <ostream>
+#include <vector>
+
 #include "gvio/util/math.hpp"
 
 namespace gvio {
@@ -16,6 +20,62 @@ namespace gvio {
 
 int linreg(std::vector<Eigen::Vector2d> pts, double *m, double *b, double *r);
 
+/**
+ * Fixed bin histogram
+ *
+ * Samples outside of [min, max) are counted in the first or last bin, the
+ * mean, standard deviation and extrema are exact.
+ */
+class Histogram {
+public:
+  double min = 0.0;
+  double max = 1.0;
+  std::vector<size_t> bins;
+
+  size_t nb_samples = 0;
+  double sum = 0.0;
+  double sum_sq = 0.0;
+  double min_value = 0.0;
+  double max_value = 0.0;
+
+  Histogram() {}
+  Histogram(const double min, const double max, const int nb_bins)
+      : min{min}, max{max}, bins(nb_bins, 0) {}
+
+  /**
+   * Add sample
+   */
+  void add(const double x);
+
+  /**
+   * Clear all samples
+   */
+  void clear();
+
+  /**
+   * Mean of samples, 0 if there are none
+   */
+  double mean() const;
+
+  /**
+   * Standard deviation of samples, 0 if there are less than two
+   */
+  double stddev() const;
+
+  /**
+   * Percentile of samples at bin resolution
+   *
+   * @param p Percentile [0, 100]
+   * @returns Upper edge of the bin the percentile falls in
+   */
+  double percentile(const double p) const;
+};
+
+/**
+ * Histogram to output stream
+ */
+std::ostream &operator<<(std::ostream &os, const Histogram &hist);
+
 /** @} group stats */
 } // namespace gvio
 #endif // GVIO_UTIL_STATS_HPP
@@ -0,0 +1,106 @@
+/**
+ * @file
+ * @defgroup thread_pool thread_pool
+ * @ingroup util
+ */
+#ifndef GVIO_UTIL_THREAD_POOL_HPP
+#define GVIO_UTIL_THREAD_POOL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace gvio {
+/**
+ * @addtogroup thread_pool
+ * @{
+ */
+
+/**
+ * Fixed size pool of worker threads
+ */
+class ThreadPool {
+public:
+  ThreadPool();
+  explicit ThreadPool(const size_t nb_threads);
+  virtual ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /**
+   * Number of worker threads
+   *
+   * @returns Number of worker threads
+   */
+  size_t size() const;
+
+  /**
+   * Enqueue task
+   *
+   * @param task Task to run on a worker thread
+   * @returns Future that becomes ready once the task has run
+   */
+  std::future<void> enqueue(const std::function<void()> &task);
+
+  /**
+   * Split range [begin, end) into contiguous bands and run `func(start, stop)`
+   * on each band in parallel, blocks until all bands have been processed
+   *
+   * If called from one of this pool's own workers the range is processed
+   * inline on the calling thread, waiting on the pool from inside it would
+   * deadlock once every worker is blocked.
+   *
+   * @param begin Start of range
+   * @param end End of range (exclusive)
+   * @param func Function to run on each band
+   * @param nb_bands Number of bands (defaults to number of threads)
+   */
+  void parallelFor(const int begin,
+                   const int end,
+                   const std::function<void(int, int)> &func,
+                   const int nb_bands = 0);
+
+  /**
+   * Run `func(task, i)` for every i in [begin, end), indices are handed out
+   * one at a time to `nb_tasks` tasks so uneven work is balanced. The task
+   * index is in [0, nb_tasks) and lets each task own per-task state (e.g. a
+   * detector), blocks until all indices have been processed
+   *
+   * As with `parallelFor()`, calling this from one of the pool's workers
+   * runs inline as a single task.
+   *
+   * @param begin Start of range
+   * @param end End of range (exclusive)
+   * @param func Function to run on each index
+   * @param nb_tasks Number of tasks (defaults to number of threads)
+   */
+  void parallelForDynamic(const int begin,
+                          const int end,
+                          const std::function<void(int, int)> &func,
+                          const int nb_tasks = 0);
+
+  /**
+   * Check whether the calling thread is one of this pool's workers
+   */
+  bool inWorker() const;
+
+private:
+  std::vector<std::thread> workers;
+  std::queue<std::packaged_task<void()>> tasks;
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool stop = false;
+
+  void work();
+};
+
+/** @} group thread_pool */
+} // namespace gvio
+#endif // GVIO_UTIL_THREAD_POOL_HPP
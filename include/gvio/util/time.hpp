@@ -6,6 +6,7 @@
 #ifndef GVIO_UTIL_TIME_HPP
 #define GVIO_UTIL_TIME_HPP
 
+#include <stdint.h>
 #include <sys/time.h>
 #include <time.h>
 
@@ -24,6 +25,12 @@ float mtoc(struct timespec *tic);
  */
 double time_now();
 
+/**
+ * Get monotonic clock time in nanoseconds, unaffected by changes to the
+ * system time and therefore suitable for timestamping sensor data
+ */
+int64_t time_monotonic_ns();
+
 /** @} group time */
 } // namespace gvio
 #endif // GVIO_UTIL_TIME_HPP
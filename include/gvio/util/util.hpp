@@ -5,15 +5,20 @@
 #ifndef GVIO_UTIL_UTIL_HPP
 #define GVIO_UTIL_UTIL_HPP
 
+#include "gvio/util/acquisition.hpp"
+#include "gvio/util/async_writer.hpp"
 #include "gvio/util/config.hpp"
 #include "gvio/util/data.hpp"
 #include "gvio/util/euler.hpp"
+#include "gvio/util/executor.hpp"
 #include "gvio/util/file.hpp"
 #include "gvio/util/gps.hpp"
 #include "gvio/util/linalg.hpp"
 #include "gvio/util/log.hpp"
 #include "gvio/util/math.hpp"
+#include "gvio/util/spsc_queue.hpp"
 #include "gvio/util/stats.hpp"
+#include "gvio/util/thread_pool.hpp"
 #include "gvio/util/time.hpp"
 #include "gvio/util/vision.hpp"
 
@@ -18,6 +18,13 @@ int BaseDetector::configure(const std::string &config_file) {
   parser.addParam("windowing", &this->windowing);
   parser.addParam("window_padding", &this->window_padding);
   parser.addParam("imshow", &this->imshow);
+  parser.addParam("tracking", &this->tracking, true);
+  parser.addParam("roi_padding", &this->roi_padding, true);
+  parser.addParam("full_search_interval", &this->full_search_interval, true);
+  parser.addParam("full_search_decimation",
+                  &this->full_search_decimation,
+                  true);
+  parser.addParam("max_missed", &this->max_missed, true);
   if (parser.load(config_file) != 0) {
     return -1;
   }
@@ -138,7 +145,7 @@ int BaseDetector::calculateTagCorners(const cv::Mat &image,
                                       Vec2 &btm_right) {
   // get tag size according to tag id
   double tag_size;
-  if (this->getTagSize(prev_tag, &tag_size) != 0) {
+  if (this->getTagSize(tag_pose, &tag_size) != 0) {
     return -1;
   }
 
@@ -254,6 +261,108 @@ int BaseDetector::cropImage(const TagPose &prev_tag,
   return 0;
 }
 
+int BaseDetector::predictROI(const cv::Mat &image,
+                             const TagTrack &track,
+                             cv::Rect &roi) {
+  // get tag size according to tag id
+  TagPose tag_pose;
+  tag_pose.id = track.id;
+  double tag_size;
+  if (this->getTagSize(tag_pose, &tag_size) != 0) {
+    return -2;
+  }
+
+  // camera intrinsics
+  double fx, fy, px, py, image_width, image_height;
+  this->getCameraIntrinsics(&fx, &fy, &px, &py, &image_width, &image_height);
+  if (image_width != image.cols || image_height != image.rows) {
+    LOG_ERROR("Expected image vs input image mismatch!");
+    return -3;
+  }
+
+  // predict tag position in camera frame
+  const int nb_frames = track.nb_missed + 1;
+  const Vec3 p = track.position + track.velocity * nb_frames;
+  if (p(2) < tag_size) {
+    return -1;
+  }
+
+  // project tag center and padded half width into image frame
+  const double padding = this->roi_padding + 0.5 * track.nb_missed;
+  const double half_size = tag_size * (0.5 + padding);
+  const double u = (fx * p(0) / p(2)) + px;
+  const double v = (fy * p(1) / p(2)) + py;
+  const double du = fx * half_size / p(2);
+  const double dv = fy * half_size / p(2);
+
+  // clip to image
+  roi = cv::Rect(cv::Point(u - du, v - dv), cv::Point(u + du, v + dv));
+  roi &= cv::Rect(0, 0, image.cols, image.rows);
+  if (roi.width < 8 || roi.height < 8) {
+    return -1;
+  }
+
+  return 0;
+}
+
+std::vector<cv::Rect> BaseDetector::predictROIs(const cv::Mat &image) {
+  std::vector<cv::Rect> rois;
+  for (const auto &kv : this->tracks) {
+    cv::Rect roi;
+    if (this->predictROI(image, kv.second, roi) == 0) {
+      rois.push_back(roi);
+    }
+  }
+
+  // merge overlapping regions until none overlap
+  bool merged = true;
+  while (merged) {
+    merged = false;
+    for (size_t i = 0; i < rois.size() && merged == false; i++) {
+      for (size_t j = i + 1; j < rois.size(); j++) {
+        if ((rois[i] & rois[j]).area() > 0) {
+          rois[i] |= rois[j];
+          rois.erase(rois.begin() + j);
+          merged = true;
+          break;
+        }
+      }
+    }
+  }
+
+  return rois;
+}
+
+void BaseDetector::updateTracks(const std::vector<TagPose> &tags) {
+  // mark all tracks as missed, detected tracks are reset below
+  for (auto &kv : this->tracks) {
+    kv.second.nb_missed++;
+  }
+
+  for (const auto &tag : tags) {
+    auto it = this->tracks.find(tag.id);
+    if (it == this->tracks.end()) {
+      this->tracks[tag.id] = TagTrack(tag);
+      continue;
+    }
+
+    // velocity is averaged over the frames the tag was missed
+    TagTrack &track = it->second;
+    track.velocity = (tag.position - track.position) / track.nb_missed;
+    track.position = tag.position;
+    track.nb_missed = 0;
+  }
+
+  // drop lost tracks
+  for (auto it = this->tracks.begin(); it != this->tracks.end();) {
+    if (it->second.nb_missed > this->max_missed) {
+      it = this->tracks.erase(it);
+    } else {
+      it++;
+    }
+  }
+}
+
 int BaseDetector::getRelativePose(const Vec2 &p1,
                                   const Vec2 &p2,
                                   const Vec2 &p3,
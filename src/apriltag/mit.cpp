@@ -22,6 +22,11 @@ int MITDetector::extractTags(cv::Mat &image, std::vector<TagPose> &tags) {
     this->illuminationInvariantTransform(image);
   }
 
+  // Tracking mode
+  if (this->tracking) {
+    return this->trackTags(image, tags);
+  }
+
   // Mask image if tag was last detected
   cv::Mat cropped_image;
   if (this->prev_tag.detected && this->windowing) {
@@ -86,4 +91,144 @@ int MITDetector::extractTags(cv::Mat &image, std::vector<TagPose> &tags) {
   return 0;
 }
 
+void MITDetector::detectROI(const cv::Mat &image,
+                            const cv::Rect &roi,
+                            const int decimation,
+                            std::vector<AprilTags::TagDetection> &detections) {
+  // Decimate region of interest
+  cv::Mat roi_image = image(roi);
+  if (decimation > 1) {
+    const double scale = 1.0 / decimation;
+    cv::resize(roi_image,
+               this->roi_buffer,
+               cv::Size(),
+               scale,
+               scale,
+               cv::INTER_AREA);
+    roi_image = this->roi_buffer;
+  }
+
+  // Convert to gray-scale
+  if (roi_image.channels() == 3) {
+    cv::cvtColor(roi_image, this->roi_gray, cv::COLOR_BGR2GRAY);
+  } else {
+    // Copy since the detector expects continuous image data
+    roi_image.copyTo(this->roi_gray);
+  }
+
+  // Extract tags and transform corners back to full image coordinates
+  const float d = decimation;
+  auto to_image = [&](std::pair<float, float> &p) {
+    p.first = (p.first + 0.5f) * d - 0.5f + roi.x;
+    p.second = (p.second + 0.5f) * d - 0.5f + roi.y;
+  };
+  for (auto &detection : this->detector->extractTags(this->roi_gray)) {
+    for (int i = 0; i < 4; i++) {
+      to_image(detection.p[i]);
+    }
+    to_image(detection.cxy);
+    detections.push_back(detection);
+  }
+}
+
+int MITDetector::trackTags(cv::Mat &image, std::vector<TagPose> &tags) {
+  const cv::Rect image_rect(0, 0, image.cols, image.rows);
+  this->image_cropped = false;
+
+  // Search around tracked tags at full resolution
+  std::vector<AprilTags::TagDetection> detections;
+  for (const auto &roi : this->predictROIs(image)) {
+    this->detectROI(image, roi, 1, detections);
+  }
+
+  // Decimated full-frame search on schedule, or if nothing is tracked
+  this->frames_since_search++;
+  this->full_search = false;
+  if (this->tracks.empty() ||
+      this->frames_since_search >= this->full_search_interval) {
+    this->frames_since_search = 0;
+    this->full_search = true;
+
+    const int decimation = std::max(this->full_search_decimation, 1);
+    std::vector<AprilTags::TagDetection> coarse;
+    this->detectROI(image, image_rect, decimation, coarse);
+
+    for (const auto &detection : coarse) {
+      bool known = false;
+      for (const auto &d : detections) {
+        known |= (d.id == detection.id);
+      }
+      if (known) {
+        continue;
+      } else if (decimation == 1) {
+        detections.push_back(detection);
+        continue;
+      }
+
+      // Re-detect new tag at full resolution around its coarse corners
+      float x_min = FLT_MAX, y_min = FLT_MAX;
+      float x_max = -FLT_MAX, y_max = -FLT_MAX;
+      for (int i = 0; i < 4; i++) {
+        x_min = std::min(x_min, detection.p[i].first);
+        y_min = std::min(y_min, detection.p[i].second);
+        x_max = std::max(x_max, detection.p[i].first);
+        y_max = std::max(y_max, detection.p[i].second);
+      }
+      const float pad = std::max(x_max - x_min, y_max - y_min) * 0.5f;
+      const cv::Rect roi = cv::Rect(cv::Point(x_min - pad, y_min - pad),
+                                    cv::Point(x_max + pad, y_max + pad)) &
+                           image_rect;
+
+      std::vector<AprilTags::TagDetection> fine;
+      if (roi.area() > 0) {
+        this->detectROI(image, roi, 1, fine);
+      }
+      bool refined = false;
+      for (const auto &d : fine) {
+        if (d.id == detection.id && refined == false) {
+          detections.push_back(d);
+          refined = true;
+        }
+      }
+      if (refined == false) {
+        detections.push_back(detection);
+      }
+    }
+  }
+
+  // Calculate tag poses, one per tag id
+  std::vector<TagPose> detected;
+  for (const auto &detection : detections) {
+    bool duplicate = false;
+    for (const auto &tag : detected) {
+      duplicate |= (tag.id == detection.id);
+    }
+    if (duplicate) {
+      continue;
+    }
+
+    TagPose tag_pose;
+    tag_pose.id = detection.id;
+    const Vec2 p1{detection.p[0].first, detection.p[0].second};
+    const Vec2 p2{detection.p[1].first, detection.p[1].second};
+    const Vec2 p3{detection.p[2].first, detection.p[2].second};
+    const Vec2 p4{detection.p[3].first, detection.p[3].second};
+    if (this->getRelativePose(p1, p2, p3, p4, tag_pose) == 0) {
+      detected.push_back(tag_pose);
+    }
+  }
+  this->updateTracks(detected);
+  tags.insert(tags.end(), detected.begin(), detected.end());
+
+  // Keep track of last tag
+  this->prev_tag.detected = false;
+  if (detected.size()) {
+    this->prev_tag = detected[0];
+    this->prev_tag_image_width = image.cols;
+    this->prev_tag_image_height = image.rows;
+  }
+
+  return 0;
+}
+
 } // namespace gvio
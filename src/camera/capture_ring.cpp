@@ -0,0 +1,227 @@
+#include "gvio/camera/capture_ring.hpp"
+
+namespace gvio {
+
+CaptureRing::CaptureRing(CaptureBackend *backend) : backend{backend} {
+  this->held.resize(backend->captureBuffers(), false);
+}
+
+CaptureRing::~CaptureRing() {
+  if (this->started) {
+    this->stop();
+  }
+}
+
+int CaptureRing::start() {
+  if (this->held.size() < 2) {
+    LOG_ERROR("Capture ring requires at least 2 buffers!");
+    return -1;
+  }
+
+  if (this->backend->startCapture() != 0) {
+    LOG_ERROR("Failed to start capture!");
+    return -1;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->has_seq = false;
+  this->started = true;
+  return 0;
+}
+
+int CaptureRing::stop() {
+  // Unlock any buffers still held by the consumer
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (size_t i = 0; i < this->held.size(); i++) {
+    if (this->held[i]) {
+      this->backend->unlockFrame(i);
+      this->held[i] = false;
+    }
+  }
+  this->capture_stats.buffers_held = 0;
+  this->started = false;
+
+  if (this->backend->stopCapture() != 0) {
+    LOG_ERROR("Failed to stop capture!");
+    return -1;
+  }
+
+  return 0;
+}
+
+int CaptureRing::grab(CaptureFrame &frame, const int timeout_ms) {
+  // Always leave one buffer to the driver
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->started == false) {
+      LOG_ERROR("Capture ring not started!");
+      return -1;
+    }
+
+    const int nb_buffers = this->held.size();
+    if (this->capture_stats.buffers_held >= nb_buffers - 1) {
+      LOG_ERROR("Consumer holds all capture buffers!");
+      return -1;
+    }
+  }
+
+  // Wait for frame
+  const int retval = this->backend->waitFrame(timeout_ms, frame);
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (retval == 1) {
+    this->capture_stats.timeouts++;
+    return 1;
+  } else if (retval != 0) {
+    LOG_ERROR("Failed to wait for frame!");
+    return -1;
+  }
+
+  // Book keeping, gaps in the sequence number are frames the driver dropped
+  if (this->has_seq && frame.seq > this->last_seq + 1) {
+    this->capture_stats.frames_dropped += frame.seq - this->last_seq - 1;
+  }
+  this->has_seq = true;
+  this->last_seq = frame.seq;
+  this->held[frame.buffer_index] = true;
+  this->capture_stats.buffers_held++;
+  this->capture_stats.frames_grabbed++;
+
+  return 0;
+}
+
+int CaptureRing::release(CaptureFrame &frame) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  const int index = frame.buffer_index;
+  if (index < 0 || index >= (int) this->held.size() ||
+      this->held[index] == false) {
+    LOG_ERROR("Frame is not held by consumer!");
+    return -1;
+  }
+
+  if (this->backend->unlockFrame(index) != 0) {
+    LOG_ERROR("Failed to unlock buffer [%d]!", index);
+    return -1;
+  }
+  this->held[index] = false;
+  this->capture_stats.buffers_held--;
+
+  // Invalidate frame, the header must not outlive the buffer lock
+  frame.image.release();
+  frame.buffer_index = -1;
+
+  return 0;
+}
+
+CaptureStats CaptureRing::stats() const {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->capture_stats;
+}
+
+FakeCaptureBackend::FakeCaptureBackend(const int nb_buffers,
+                                       const int image_width,
+                                       const int image_height,
+                                       const int image_type)
+    : image_width{image_width}, image_height{image_height},
+      image_type{image_type} {
+  for (int i = 0; i < nb_buffers; i++) {
+    this->buffers.emplace_back(image_height, image_width, image_type);
+  }
+  this->states.resize(nb_buffers, FREE);
+  this->timestamps.resize(nb_buffers, 0);
+  this->seqs.resize(nb_buffers, 0);
+}
+
+int FakeCaptureBackend::publish(const cv::Mat &image, const long timestamp) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->seq++;
+  if (this->capturing == false) {
+    return -1;
+  }
+
+  // Find next free buffer in sequence
+  const int nb_buffers = this->buffers.size();
+  int index = -1;
+  for (int i = 0; i < nb_buffers; i++) {
+    const int candidate = (this->next_index + i) % nb_buffers;
+    if (this->states[candidate] == FREE) {
+      index = candidate;
+      break;
+    }
+  }
+  if (index == -1) {
+    return -1;
+  }
+
+  // Fill buffer
+  image.copyTo(this->buffers[index]);
+  this->states[index] = QUEUED;
+  this->timestamps[index] = timestamp;
+  this->seqs[index] = this->seq;
+  this->queue.push_back(index);
+  this->next_index = (index + 1) % nb_buffers;
+  this->ready.notify_one();
+
+  return 0;
+}
+
+int FakeCaptureBackend::captureBuffers() const {
+  return this->buffers.size();
+}
+
+int FakeCaptureBackend::startCapture() {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->capturing = true;
+  return 0;
+}
+
+int FakeCaptureBackend::stopCapture() {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->capturing = false;
+  for (auto index : this->queue) {
+    this->states[index] = FREE;
+  }
+  this->queue.clear();
+  this->ready.notify_all();
+  return 0;
+}
+
+int FakeCaptureBackend::waitFrame(const int timeout_ms, CaptureFrame &frame) {
+  std::unique_lock<std::mutex> lock(this->mutex);
+  const bool filled =
+      this->ready.wait_for(lock, std::chrono::milliseconds(timeout_ms), [&] {
+        return this->queue.empty() == false || this->capturing == false;
+      });
+  if (this->capturing == false) {
+    return -1;
+  } else if (filled == false) {
+    return 1;
+  }
+
+  // Lock buffer and wrap its memory without copying
+  const int index = this->queue.front();
+  this->queue.pop_front();
+  this->states[index] = LOCKED;
+
+  const cv::Mat &buffer = this->buffers[index];
+  frame.image = cv::Mat(buffer.rows,
+                        buffer.cols,
+                        buffer.type(),
+                        buffer.data,
+                        buffer.step);
+  frame.timestamp = this->timestamps[index];
+  frame.seq = this->seqs[index];
+  frame.buffer_index = index;
+
+  return 0;
+}
+
+int FakeCaptureBackend::unlockFrame(const int buffer_index) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->states[buffer_index] != LOCKED) {
+    return -1;
+  }
+  this->states[buffer_index] = FREE;
+  return 0;
+}
+
+} // namespace gvio
@@ -143,25 +143,94 @@ void equi_undistort(const double k1,
   p(1) *= scaling;
 }
 
+void radtan_undistort(const double k1,
+                      const double k2,
+                      const double k3,
+                      const double p1,
+                      const double p2,
+                      const Vec2 &p_d,
+                      Vec2 &p,
+                      const int max_iter) {
+  double x = p(0);
+  double y = p(1);
+
+  for (int i = 0; i < max_iter; i++) {
+    // Radial distortion factor and its derivative w.r.t. r^2
+    const double x2 = x * x;
+    const double y2 = y * y;
+    const double xy = x * y;
+    const double r2 = x2 + y2;
+    const double r4 = r2 * r2;
+    const double radial = 1 + (k1 * r2) + (k2 * r4) + (k3 * r4 * r2);
+    const double dradial = k1 + (2 * k2 * r2) + (3 * k3 * r4);
+
+    // Residual between distorted estimate and measurement
+    // clang-format off
+    const double ex = x * radial + (2 * p1 * xy + p2 * (r2 + 2 * x2)) - p_d(0);
+    const double ey = y * radial + (p1 * (r2 + 2 * y2) + 2 * p2 * xy) - p_d(1);
+    // clang-format on
+
+    // Jacobian of distortion w.r.t. undistorted point
+    const double J00 = radial + 2 * x2 * dradial + 2 * p1 * y + 6 * p2 * x;
+    const double J01 = 2 * xy * dradial + 2 * p1 * x + 2 * p2 * y;
+    const double J10 = J01;
+    const double J11 = radial + 2 * y2 * dradial + 6 * p1 * y + 2 * p2 * x;
+
+    // Newton step, solve 2x2 system in closed form
+    const double det = J00 * J11 - J01 * J10;
+    if (fabs(det) < 1e-12) {
+      break;
+    }
+    x -= (J11 * ex - J01 * ey) / det;
+    y -= (-J10 * ex + J00 * ey) / det;
+  }
+
+  p(0) = x;
+  p(1) = y;
+}
+
+void equi_undistort(const double k1,
+                    const double k2,
+                    const double k3,
+                    const double k4,
+                    const Vec2 &p_d,
+                    Vec2 &p,
+                    const int max_iter) {
+  const double thetad = sqrt(p_d(0) * p_d(0) + p_d(1) * p_d(1));
+  if (thetad < 1e-12) {
+    p = p_d;
+    return;
+  }
+
+  // Newton iterations on theta, seeded from the initial guess
+  double theta = atan(sqrt(p(0) * p(0) + p(1) * p(1)));
+  for (int i = 0; i < max_iter; i++) {
+    const double th2 = theta * theta;
+    const double th4 = th2 * th2;
+    const double th6 = th4 * th2;
+    const double th8 = th4 * th4;
+    // clang-format off
+    const double f = theta * (1 + k1 * th2 + k2 * th4 + k3 * th6 + k4 * th8) - thetad;
+    const double df = 1 + 3 * k1 * th2 + 5 * k2 * th4 + 7 * k3 * th6 + 9 * k4 * th8;
+    // clang-format on
+    if (fabs(df) < 1e-12) {
+      break;
+    }
+    theta -= f / df;
+  }
+
+  const double scaling = tan(theta) / thetad;
+  p(0) = p_d(0) * scaling;
+  p(1) = p_d(1) * scaling;
+}
+
 cv::Mat pinhole_equi_undistort_image(const Mat3 &K,
                                      const VecX &D,
                                      const cv::Mat &image,
                                      const double balance,
                                      cv::Mat &Knew) {
-  // Estimate new camera matrix first
-  const cv::Mat R = cv::Mat::eye(3, 3, CV_64F);
-  cv::fisheye::estimateNewCameraMatrixForUndistortRectify(convert(K),
-                                                          convert(D),
-                                                          image.size(),
-                                                          R,
-                                                          Knew,
-                                                          balance);
-
-  // Undistort image
-  cv::Mat image_ud;
-  cv::fisheye::undistortImage(image, image_ud, convert(K), convert(D), Knew);
-
-  return image_ud;
+  UndistortMap map;
+  return pinhole_equi_undistort_image(K, D, image, balance, map, Knew);
 }
 
 cv::Mat pinhole_equi_undistort_image(const Mat3 &K,
@@ -171,6 +240,32 @@ cv::Mat pinhole_equi_undistort_image(const Mat3 &K,
   return pinhole_equi_undistort_image(K, D, image, 0.0, Knew);
 }
 
+cv::Mat pinhole_equi_undistort_image(const Mat3 &K,
+                                     const VecX &D,
+                                     const cv::Mat &image,
+                                     const double balance,
+                                     UndistortMap &map,
+                                     cv::Mat &Knew) {
+  // Build undistortion map if not already built
+  const std::string model = "equidistant";
+  if (map.matches(model, K, D, image.size(), balance) == false) {
+    if (map.configure(model, K, D, image.size(), balance) != 0) {
+      LOG_ERROR("Failed to build equidistant undistortion map!");
+      return cv::Mat();
+    }
+  }
+
+  // Undistort image
+  cv::Mat image_ud;
+  if (map.undistort(image, image_ud) != 0) {
+    LOG_ERROR("Failed to undistort image!");
+    return cv::Mat();
+  }
+  Knew = map.K_ud.clone();
+
+  return image_ud;
+}
+
 Vec2 project_pinhole_radtan(const Mat3 &K, const VecX &D, const Vec3 &X) {
   // Apply equi distortion
   const double k1 = D(0);
@@ -204,4 +299,77 @@ Vec2 project_pinhole_equi(const Mat3 &K, const Vec4 &D, const Vec3 &X) {
   return pixel;
 }
 
+int project_pinhole_radtan(const Mat3 &K,
+                           const VecX &D,
+                           const Mat3X &X,
+                           Mat2X &pixels) {
+  if (D.size() != 5) {
+    LOG_ERROR("Expecting 5 radial-tangential distortion coefficients!");
+    return -1;
+  }
+  const double k1 = D(0);
+  const double k2 = D(1);
+  const double p1 = D(2);
+  const double p2 = D(3);
+  const double k3 = D(4);
+
+  // Normalize points
+  const RowArrayX inv_z = X.row(2).array().inverse();
+  const RowArrayX x = X.row(0).array() * inv_z;
+  const RowArrayX y = X.row(1).array() * inv_z;
+
+  // Apply radial and tangential distortion
+  // clang-format off
+  const RowArrayX x2 = x.square();
+  const RowArrayX y2 = y.square();
+  const RowArrayX xy = x * y;
+  const RowArrayX r2 = x2 + y2;
+  const RowArrayX radial = 1.0 + r2 * (k1 + r2 * (k2 + r2 * k3));
+  const RowArrayX x_ddash = x * radial + 2.0 * p1 * xy + p2 * (r2 + 2.0 * x2);
+  const RowArrayX y_ddash = y * radial + p1 * (r2 + 2.0 * y2) + 2.0 * p2 * xy;
+  // clang-format on
+
+  // Project distorted points to image plane
+  pixels.resize(2, X.cols());
+  pixels.row(0) = (K(0, 0) * x_ddash + K(0, 2)).matrix();
+  pixels.row(1) = (K(1, 1) * y_ddash + K(1, 2)).matrix();
+
+  return 0;
+}
+
+int project_pinhole_equi(const Mat3 &K,
+                         const VecX &D,
+                         const Mat3X &X,
+                         Mat2X &pixels) {
+  if (D.size() != 4) {
+    LOG_ERROR("Expecting 4 equidistant distortion coefficients!");
+    return -1;
+  }
+  const double k1 = D(0);
+  const double k2 = D(1);
+  const double k3 = D(2);
+  const double k4 = D(3);
+
+  // Normalize points
+  const RowArrayX inv_z = X.row(2).array().inverse();
+  const RowArrayX x = X.row(0).array() * inv_z;
+  const RowArrayX y = X.row(1).array() * inv_z;
+  const RowArrayX r = (x.square() + y.square()).sqrt();
+
+  // Apply equi distortion, points on the optical axis are not scaled
+  // clang-format off
+  const RowArrayX theta = r.atan();
+  const RowArrayX th2 = theta.square();
+  const RowArrayX theta_d = theta * (1.0 + th2 * (k1 + th2 * (k2 + th2 * (k3 + th2 * k4))));
+  const RowArrayX scaling = (r > 1e-12).select(theta_d / r, 1.0);
+  // clang-format on
+
+  // Project distorted points to image plane
+  pixels.resize(2, X.cols());
+  pixels.row(0) = (K(0, 0) * scaling * x + K(0, 2)).matrix();
+  pixels.row(1) = (K(1, 1) * scaling * y + K(1, 2)).matrix();
+
+  return 0;
+}
+
 } // namespace gvio
@@ -293,6 +293,25 @@ void ueye_print_camera_info(const CAMINFO &info) {
   }
 }
 
+int raw2cvtype(const int channels, const int bpp) {
+  if (bpp == 8) {
+    switch (channels) {
+      case 1: return CV_8UC1;
+      case 3: return CV_8UC3;
+      default: LOG_ERROR("Not implemented!"); return -1;
+    }
+  } else if (bpp == 16) {
+    switch (channels) {
+      case 1: return CV_16UC1;
+      case 3: return CV_16UC3;
+      default: LOG_ERROR("Not implemented!"); return -1;
+    }
+  }
+
+  LOG_ERROR("Not implemented!");
+  return -1;
+}
+
 int raw2cvmat(void *image_data,
               const int image_width,
               const int image_height,
@@ -306,21 +325,8 @@ int raw2cvmat(void *image_data,
   const size_t row_bytes = image_size / image_rows;
 
   // Get cv::Mat type
-  int cv_type = -1;
-  if (bpp == 8) {
-    switch (channels) {
-      case 1: cv_type = CV_8UC1; break;
-      case 3: cv_type = CV_8UC3; break;
-      default: LOG_ERROR("Not implemented!"); return -1;
-    }
-  } else if (bpp == 16) {
-    switch (channels) {
-      case 1: cv_type = CV_16UC1; break;
-      case 3: cv_type = CV_16UC3; break;
-      default: LOG_ERROR("Not implemented!"); return -1;
-    }
-  } else {
-    LOG_ERROR("Not implemented!");
+  const int cv_type = raw2cvtype(channels, bpp);
+  if (cv_type == -1) {
     return -1;
   }
 
@@ -651,12 +657,12 @@ int IDSCamera::allocBuffers(const int nb_buffers, const int bpp) {
       return -1;
     }
 
-    // Activate buffer
-    retval = is_SetImageMem(this->camera_handle,
-                            this->buffers[i],
-                            this->buffer_id[i]);
+    // Add buffer to the capture sequence
+    retval = is_AddToSequence(this->camera_handle,
+                              this->buffers[i],
+                              this->buffer_id[i]);
     if (retval != IS_SUCCESS) {
-      LOG_ERROR("Failed to set memory for frame buffers!");
+      LOG_ERROR("Failed to add frame buffer to sequence!");
       return -1;
     }
   }
@@ -665,6 +671,12 @@ int IDSCamera::allocBuffers(const int nb_buffers, const int bpp) {
 }
 
 int IDSCamera::freeBuffers() {
+  if (this->buffers.size() > 0 &&
+      is_ClearSequence(this->camera_handle) != IS_SUCCESS) {
+    LOG_ERROR("Failed to clear frame buffer sequence!");
+    return -1;
+  }
+
   for (size_t i = 0; i < this->buffers.size(); i++) {
     if (is_FreeImageMem(this->camera_handle,
                         this->buffers[i],
@@ -1221,6 +1233,106 @@ int IDSCamera::getFrame(cv::Mat &image) {
   return 0;
 }
 
+int IDSCamera::captureBuffers() const {
+  return this->buffers.size();
+}
+
+int IDSCamera::startCapture() {
+  if (is_InitImageQueue(this->camera_handle, 0) != IS_SUCCESS) {
+    LOG_ERROR("Failed to initialize image queue!");
+    return -1;
+  }
+
+  return 0;
+}
+
+int IDSCamera::stopCapture() {
+  if (is_ExitImageQueue(this->camera_handle) != IS_SUCCESS) {
+    LOG_ERROR("Failed to exit image queue!");
+    return -1;
+  }
+
+  return 0;
+}
+
+int IDSCamera::waitFrame(const int timeout_ms, CaptureFrame &frame) {
+  assert(this->configured);
+
+  // Wait for next image in queue, the buffer is locked by the driver
+  char *image_data = nullptr;
+  int image_id = 0;
+  int retval = is_WaitForNextImage(this->camera_handle,
+                                   timeout_ms,
+                                   &image_data,
+                                   &image_id);
+  if (retval == IS_TIMED_OUT) {
+    return 1;
+  } else if (retval != IS_SUCCESS) {
+    LOG_ERROR("Failed to wait for next image!");
+    return -1;
+  }
+
+  // Find buffer index
+  int index = -1;
+  for (size_t i = 0; i < this->buffer_id.size(); i++) {
+    if (this->buffer_id[i] == image_id) {
+      index = i;
+      break;
+    }
+  }
+  if (index == -1) {
+    LOG_ERROR("Unknown image buffer [%d]!", image_id);
+    is_UnlockSeqBuf(this->camera_handle, image_id, image_data);
+    return -1;
+  }
+
+  // Hardware timestamp (in 0.1 us) and frame number
+  UEYEIMAGEINFO image_info;
+  retval = is_GetImageInfo(this->camera_handle,
+                           image_id,
+                           &image_info,
+                           sizeof(image_info));
+  if (retval != IS_SUCCESS) {
+    LOG_ERROR("Failed to get image info!");
+    this->unlockFrame(index);
+    return -1;
+  }
+
+  // Wrap buffer memory in cv::Mat header without copying
+  int pitch = 0;
+  is_GetImageMemPitch(this->camera_handle, &pitch);
+  const int channels = ueye_colormode2channels(this->color_mode);
+  const int bpp = ueye_colormode2bpp(this->color_mode);
+  const int cv_type = raw2cvtype(channels, bpp);
+  if (cv_type == -1) {
+    this->unlockFrame(index);
+    return -1;
+  }
+
+  frame.image = cv::Mat(image_info.dwImageHeight,
+                        image_info.dwImageWidth,
+                        cv_type,
+                        image_data,
+                        pitch);
+  frame.timestamp = image_info.u64TimestampDevice * 100;
+  frame.seq = image_info.u64FrameNumber;
+  frame.buffer_index = index;
+
+  return 0;
+}
+
+int IDSCamera::unlockFrame(const int buffer_index) {
+  const int retval = is_UnlockSeqBuf(this->camera_handle,
+                                     this->buffer_id[buffer_index],
+                                     this->buffers[buffer_index]);
+  if (retval != IS_SUCCESS) {
+    LOG_ERROR("Failed to unlock image buffer!");
+    return -1;
+  }
+
+  return 0;
+}
+
 // int IDSCamera::run() {
 //   return 0;
 // }
@@ -3,6 +3,9 @@
 namespace gvio {
 
 int PinholeModel::configure(const std::string &config_file) {
+  std::string distortion_model = "none";
+  VecX distortion_coeffs;
+
   // Load config file
   ConfigParser parser;
   parser.addParam("image_width", &this->image_width);
@@ -11,6 +14,8 @@ int PinholeModel::configure(const std::string &config_file) {
   parser.addParam("fy", &this->fy);
   parser.addParam("cx", &this->cx);
   parser.addParam("cy", &this->cy);
+  parser.addParam("distortion_model", &distortion_model, true);
+  parser.addParam("distortion_coeffs", &distortion_coeffs, true);
   if (parser.load(config_file) != 0) {
     LOG_ERROR("Failed to load config file [%s]!", config_file.c_str());
     return -1;
@@ -24,6 +29,31 @@ int PinholeModel::configure(const std::string &config_file) {
   K(1, 2) = cy;
   K(2, 2) = 1.0;
 
+  // Setup distortion model
+  if (this->setDistortion(distortion_model, distortion_coeffs) != 0) {
+    return -1;
+  }
+
+  return 0;
+}
+
+int PinholeModel::setDistortion(const std::string &distortion_model,
+                                const VecX &distortion_coeffs) {
+  const int retval = this->undistort_grid.configure(distortion_model,
+                                                    distortion_coeffs,
+                                                    this->fx,
+                                                    this->fy,
+                                                    this->cx,
+                                                    this->cy,
+                                                    this->image_width,
+                                                    this->image_height);
+  if (retval != 0) {
+    return -1;
+  }
+
+  this->distortion_model = distortion_model;
+  this->distortion_coeffs = distortion_coeffs;
+
   return 0;
 }
 
@@ -79,6 +109,46 @@ Vec3 PinholeModel::project(const Vec4 &X, const Mat3 &R, const Vec3 &t) {
   return x;
 }
 
+void PinholeModel::project(const Mat3X &X,
+                           const Mat3 &R,
+                           const Vec3 &t,
+                           Mat2X &pixels,
+                           VecX &depths) const {
+  // Transform points to camera frame
+  const Mat3X X_C = R * (X.colwise() - t);
+
+  // Project points to image plane
+  const RowArrayX inv_z = X_C.row(2).array().inverse();
+  pixels.resize(2, X.cols());
+  pixels.row(0) = (this->fx * X_C.row(0).array() * inv_z + this->cx).matrix();
+  pixels.row(1) = (this->fy * X_C.row(1).array() * inv_z + this->cy).matrix();
+  depths = X_C.row(2).transpose();
+}
+
+int PinholeModel::projectDistorted(const Mat3X &X,
+                                   const Mat3 &R,
+                                   const Vec3 &t,
+                                   Mat2X &pixels,
+                                   VecX &depths) const {
+  const bool radtan = (this->distortion_model == "radial-tangential");
+  const bool equi = (this->distortion_model == "equidistant");
+  if (radtan == false && equi == false) {
+    this->project(X, R, t, pixels, depths);
+    return 0;
+  }
+
+  // Transform points to camera frame
+  const Mat3X X_C = R * (X.colwise() - t);
+  depths = X_C.row(2).transpose();
+
+  // Project points to image plane
+  const VecX &D = this->distortion_coeffs;
+  if (radtan) {
+    return project_pinhole_radtan(this->K, D, X_C, pixels);
+  }
+  return project_pinhole_equi(this->K, D, X_C, pixels);
+}
+
 Vec2 PinholeModel::pixel2image(const Vec2 &pixel) {
   Vec2 pt((pixel(0) - this->cx) / this->fx, (pixel(1) - this->cy) / this->fy);
   return pt;
@@ -105,6 +175,37 @@ Vec2 PinholeModel::pixel2image(const cv::KeyPoint &kp) const {
   return this->pixel2image(Vec2{kp.pt.x, kp.pt.y});
 }
 
+void PinholeModel::pixel2image(const Mat2X &pixels, Mat2X &points) const {
+  points.resize(2, pixels.cols());
+  points.row(0) = ((pixels.row(0).array() - this->cx) / this->fx).matrix();
+  points.row(1) = ((pixels.row(1).array() - this->cy) / this->fy).matrix();
+}
+
+void PinholeModel::undistortPoints(const std::vector<cv::Point2f> &pixels,
+                                   std::vector<cv::Point2f> &points) const {
+  // No distortion model set, only convert to image coordinates
+  if (this->undistort_grid.configured == false) {
+    points.resize(pixels.size());
+    for (size_t i = 0; i < pixels.size(); i++) {
+      points[i].x = (pixels[i].x - this->cx) / this->fx;
+      points[i].y = (pixels[i].y - this->cy) / this->fy;
+    }
+    return;
+  }
+
+  this->undistort_grid.undistort(pixels, points);
+}
+
+void PinholeModel::undistortPoints(const Mat2X &pixels, Mat2X &points) const {
+  // No distortion model set, only convert to image coordinates
+  if (this->undistort_grid.configured == false) {
+    this->pixel2image(pixels, points);
+    return;
+  }
+
+  this->undistort_grid.undistort(pixels, points);
+}
+
 Vec2 pinhole_project(const Mat3 &K, const Vec3 &X) {
   const Vec3 x = K * X;
   return Vec2{x(0) / x(2), x(1) / x(2)};
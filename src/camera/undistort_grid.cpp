@@ -0,0 +1,150 @@
+#include "gvio/camera/undistort_grid.hpp"
+
+namespace gvio {
+
+int UndistortGrid::configure(const std::string &distortion_model,
+                             const VecX &D,
+                             const double fx,
+                             const double fy,
+                             const double cx,
+                             const double cy,
+                             const int image_width,
+                             const int image_height) {
+  this->configured = false;
+
+  // Check distortion model
+  if (distortion_model == "radial-tangential" && D.size() != 5) {
+    LOG_ERROR("Expecting 5 radial-tangential distortion coefficients!");
+    return -1;
+  } else if (distortion_model == "equidistant" && D.size() != 4) {
+    LOG_ERROR("Expecting 4 equidistant distortion coefficients!");
+    return -1;
+  } else if (distortion_model != "none" &&
+             distortion_model != "radial-tangential" &&
+             distortion_model != "equidistant") {
+    LOG_ERROR("Unsupported distortion model [%s]!", distortion_model.c_str());
+    return -1;
+  }
+
+  this->distortion_model = distortion_model;
+  this->D = D;
+  this->fx = fx;
+  this->fy = fy;
+  this->cx = cx;
+  this->cy = cy;
+
+  // Precompute un-distorted image coordinates at grid nodes, the last node
+  // in each axis is placed at or beyond the image border
+  this->grid_x.clear();
+  this->grid_y.clear();
+  this->grid_cols = 0;
+  this->grid_rows = 0;
+  if (distortion_model != "none" && image_width > 0 && image_height > 0) {
+    const int cs = this->cell_size;
+    this->grid_cols = (image_width + cs - 1) / cs + 1;
+    this->grid_rows = (image_height + cs - 1) / cs + 1;
+    this->grid_x.resize(this->grid_cols * this->grid_rows);
+    this->grid_y.resize(this->grid_cols * this->grid_rows);
+
+    for (int i = 0; i < this->grid_rows; i++) {
+      for (int j = 0; j < this->grid_cols; j++) {
+        const double px = j * this->cell_size;
+        const double py = i * this->cell_size;
+        const Vec2 p_d{(px - cx) / fx, (py - cy) / fy};
+        Vec2 p = p_d;
+        this->undistortPoint(p_d, p, this->max_iter_init);
+
+        const int idx = i * this->grid_cols + j;
+        this->grid_x[idx] = p(0);
+        this->grid_y[idx] = p(1);
+      }
+    }
+  }
+
+  this->configured = true;
+  return 0;
+}
+
+void UndistortGrid::undistortPoint(const Vec2 &p_d,
+                                   Vec2 &p,
+                                   const int max_iter) const {
+  if (this->distortion_model == "radial-tangential") {
+    const double k1 = this->D(0);
+    const double k2 = this->D(1);
+    const double p1 = this->D(2);
+    const double p2 = this->D(3);
+    const double k3 = this->D(4);
+    radtan_undistort(k1, k2, k3, p1, p2, p_d, p, max_iter);
+
+  } else if (this->distortion_model == "equidistant") {
+    const double k1 = this->D(0);
+    const double k2 = this->D(1);
+    const double k3 = this->D(2);
+    const double k4 = this->D(3);
+    equi_undistort(k1, k2, k3, k4, p_d, p, max_iter);
+
+  } else {
+    p = p_d;
+  }
+}
+
+Vec2 UndistortGrid::undistortPixel(const double px, const double py) const {
+  // Pixel to distorted image coordinates
+  const Vec2 p_d{(px - this->cx) / this->fx, (py - this->cy) / this->fy};
+
+  // No distortion
+  if (this->distortion_model == "none") {
+    return p_d;
+  }
+
+  // Initial guess from grid (bilinear interpolation)
+  const double gx = px / this->cell_size;
+  const double gy = py / this->cell_size;
+  const int j0 = (int) floor(gx);
+  const int i0 = (int) floor(gy);
+  Vec2 p = p_d;
+  int iterations = this->max_iter_init;
+
+  if (j0 >= 0 && i0 >= 0 && j0 + 1 < this->grid_cols &&
+      i0 + 1 < this->grid_rows) {
+    const double ax = gx - j0;
+    const double ay = gy - i0;
+    const int idx00 = i0 * this->grid_cols + j0;
+    const int idx01 = idx00 + 1;
+    const int idx10 = idx00 + this->grid_cols;
+    const int idx11 = idx10 + 1;
+
+    const double w00 = (1.0 - ax) * (1.0 - ay);
+    const double w01 = ax * (1.0 - ay);
+    const double w10 = (1.0 - ax) * ay;
+    const double w11 = ax * ay;
+    p(0) = w00 * this->grid_x[idx00] + w01 * this->grid_x[idx01] +
+           w10 * this->grid_x[idx10] + w11 * this->grid_x[idx11];
+    p(1) = w00 * this->grid_y[idx00] + w01 * this->grid_y[idx01] +
+           w10 * this->grid_y[idx10] + w11 * this->grid_y[idx11];
+    iterations = this->max_iter;
+  }
+
+  // Refine with Newton iterations
+  this->undistortPoint(p_d, p, iterations);
+  return p;
+}
+
+void UndistortGrid::undistort(const std::vector<cv::Point2f> &pixels,
+                              std::vector<cv::Point2f> &points) const {
+  points.resize(pixels.size());
+  for (size_t i = 0; i < pixels.size(); i++) {
+    const Vec2 p = this->undistortPixel(pixels[i].x, pixels[i].y);
+    points[i].x = p(0);
+    points[i].y = p(1);
+  }
+}
+
+void UndistortGrid::undistort(const Mat2X &pixels, Mat2X &points) const {
+  points.resize(2, pixels.cols());
+  for (long i = 0; i < pixels.cols(); i++) {
+    points.col(i) = this->undistortPixel(pixels(0, i), pixels(1, i));
+  }
+}
+
+} // namespace gvio
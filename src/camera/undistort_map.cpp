@@ -0,0 +1,132 @@
+#include "gvio/camera/undistort_map.hpp"
+
+namespace gvio {
+
+int UndistortMap::configure(const std::string &distortion_model,
+                            const Mat3 &K,
+                            const VecX &D,
+                            const cv::Size &image_size,
+                            const double balance) {
+  // Reset maps, they may share their data with a copy of this object
+  this->configured = false;
+  this->K_ud = cv::Mat();
+  this->map1 = cv::Mat();
+  this->map2 = cv::Mat();
+
+  const cv::Mat K_cv = convert(K);
+  const cv::Mat D_cv = convert(D);
+  const cv::Mat R = cv::Mat::eye(3, 3, CV_64F);
+
+  if (distortion_model == "equidistant") {
+    // Estimate new camera matrix first
+    cv::fisheye::estimateNewCameraMatrixForUndistortRectify(K_cv,
+                                                            D_cv,
+                                                            image_size,
+                                                            R,
+                                                            this->K_ud,
+                                                            balance);
+
+    // Build remap tables
+    cv::fisheye::initUndistortRectifyMap(K_cv,
+                                         D_cv,
+                                         R,
+                                         this->K_ud,
+                                         image_size,
+                                         CV_16SC2,
+                                         this->map1,
+                                         this->map2);
+
+  } else if (distortion_model == "radial-tangential") {
+    // Build remap tables
+    this->K_ud = K_cv.clone();
+    cv::initUndistortRectifyMap(K_cv,
+                                D_cv,
+                                R,
+                                this->K_ud,
+                                image_size,
+                                CV_16SC2,
+                                this->map1,
+                                this->map2);
+
+  } else {
+    LOG_ERROR("Unsupported distortion model [%s]!", distortion_model.c_str());
+    return -1;
+  }
+
+  this->distortion_model = distortion_model;
+  this->K = K;
+  this->D = D;
+  this->image_size = image_size;
+  this->balance = balance;
+  this->configured = true;
+
+  return 0;
+}
+
+bool UndistortMap::matches(const std::string &distortion_model,
+                           const Mat3 &K,
+                           const VecX &D,
+                           const cv::Size &image_size,
+                           const double balance) const {
+  if (this->configured == false) {
+    return false;
+  } else if (this->distortion_model != distortion_model) {
+    return false;
+  } else if (this->image_size != image_size) {
+    return false;
+  } else if (this->balance != balance) {
+    return false;
+  } else if (this->K != K) {
+    return false;
+  } else if (this->D.size() != D.size() || this->D != D) {
+    return false;
+  }
+
+  return true;
+}
+
+int UndistortMap::undistort(const cv::Mat &image,
+                            cv::Mat &image_ud,
+                            ThreadPool *pool) const {
+  // Pre-check
+  if (this->configured == false) {
+    LOG_ERROR("Undistort map not configured!");
+    return -1;
+  } else if (image.size() != this->image_size) {
+    LOG_ERROR("Image size [%dx%d] != map size [%dx%d]!",
+              image.cols,
+              image.rows,
+              this->image_size.width,
+              this->image_size.height);
+    return -1;
+  }
+
+  // Undistort whole image in one go
+  if (pool == nullptr) {
+    cv::remap(image,
+              image_ud,
+              this->map1,
+              this->map2,
+              cv::INTER_LINEAR,
+              cv::BORDER_CONSTANT);
+    return 0;
+  }
+
+  // Undistort image by row bands, each band only writes to its own rows of
+  // the output image so no synchronization is required
+  cv::Mat output(image.size(), image.type());
+  pool->parallelFor(0, image.rows, [&](int start, int stop) {
+    cv::Mat band = output.rowRange(start, stop);
+    cv::remap(image,
+              band,
+              this->map1.rowRange(start, stop),
+              this->map2.rowRange(start, stop),
+              cv::INTER_LINEAR,
+              cv::BORDER_CONSTANT);
+  });
+  image_ud = output;
+
+  return 0;
+}
+
+} // namespace gvio
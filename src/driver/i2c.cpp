@@ -2,11 +2,36 @@
 
 namespace gvio {
 
+int I2CRegisterMap::read(const uint8_t reg_addr,
+                         uint8_t *data,
+                         const size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    data[i] = this->registers[(reg_addr + i) & 0xff];
+  }
+
+  return 0;
+}
+
+int I2CRegisterMap::write(const uint8_t reg_addr,
+                          const uint8_t *data,
+                          const size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    this->registers[(reg_addr + i) & 0xff] = data[i];
+  }
+
+  return 0;
+}
+
 int I2C::setup() {
   int fd;
   int adapter_nr;
   char filename[20];
 
+  // Simulated bus
+  if (this->sim.size()) {
+    return 0;
+  }
+
   // Setup
   adapter_nr = 1; // probably dynamically determined
   memset(filename, '\0', sizeof(char) * 20);
@@ -24,27 +49,30 @@ int I2C::setup() {
 }
 
 int I2C::setSlave(const char slave_addr) {
+  this->slave_addr = slave_addr;
+  if (this->sim.size()) {
+    return (this->sim.count(slave_addr)) ? 0 : -1;
+  }
+
   return ioctl(this->fd, I2C_SLAVE, slave_addr);
 }
 
 int I2C::readByte(const char reg_addr, char *data) {
-  char buf[1];
-
-  buf[0] = reg_addr;
-  if (write(this->fd, buf, 1) != 1) {
-    return -1;
-  }
-
-  if (read(this->fd, data, 1) != 1) {
-    return -2;
-  }
-
-  return 0;
+  return this->readBytes(reg_addr, data, 1);
 }
 
 int I2C::readBytes(const char reg_addr, char *data, size_t length) {
   char buf[1];
 
+  // Simulated bus
+  if (this->sim.size()) {
+    auto slave = this->sim.find(this->slave_addr);
+    if (slave == this->sim.end()) {
+      return -1;
+    }
+    return slave->second->read(reg_addr, (uint8_t *) data, length);
+  }
+
   buf[0] = reg_addr;
   if (write(this->fd, buf, 1) != 1) {
     return -1;
@@ -58,18 +86,15 @@ int I2C::readBytes(const char reg_addr, char *data, size_t length) {
 }
 
 int I2C::writeByte(const char reg_addr, const char byte) {
-  char buf[2];
-
-  buf[0] = reg_addr;
-  buf[1] = byte;
-  if (write(this->fd, buf, 2) != 1) {
-    return -1;
-  }
-
-  return 0;
+  return this->writeBytes(reg_addr, &byte, 1);
 }
 
 int I2C::writeRawByte(const char byte) {
+  // Simulated bus, there is no register to write to
+  if (this->sim.size()) {
+    return (this->sim.count(this->slave_addr)) ? 0 : -1;
+  }
+
   if (write(this->fd, &byte, 1) != 1) {
     return -1;
   }
@@ -83,15 +108,27 @@ int I2C::writeBytes(const char reg_addr,
   int i;
   char buf[I2C_BUF_MAX];
 
+  // Simulated bus
+  if (this->sim.size()) {
+    auto slave = this->sim.find(this->slave_addr);
+    if (slave == this->sim.end()) {
+      return -1;
+    }
+    return slave->second->write(reg_addr, (const uint8_t *) data, length);
+  }
+
   // Create buf
+  if (length + 1 > I2C_BUF_MAX) {
+    return -1;
+  }
   memset(buf, '\0', sizeof(char) * I2C_BUF_MAX);
   buf[0] = reg_addr;
   for (i = 1; i < (int) length + 1; i++) {
-    buf[i] = data[i];
+    buf[i] = data[i - 1];
   }
 
   // Write bytes
-  if (write(this->fd, buf, length + 1) != 1) {
+  if (write(this->fd, buf, length + 1) != (ssize_t)(length + 1)) {
     return -1;
   }
 
@@ -2,46 +2,59 @@
 
 namespace gvio {
 
-// int KLTTracker::configure(const std::string &config_file) {
-//   std::string camera_model;
-//   int image_width = 0;
-//   int image_height = 0;
-//   double fx = 0.0;
-//   double fy = 0.0;
-//   double cx = 0.0;
-//   double cy = 0.0;
-//
-//   // Load config file
-//   ConfigParser parser;
-//   // -- Load feature detector settings
-//   parser.addParam("max_corners", &this->max_corners);
-//   parser.addParam("quality_level", &this->quality_level);
-//   parser.addParam("min_distance", &this->min_distance);
-//   parser.addParam("show_matches", &this->show_matches);
-//   // -- Load camera model settings
-//   parser.addParam("camera_model.type", &camera_model, true);
-//   parser.addParam("camera_model.image_width", &image_width, true);
-//   parser.addParam("camera_model.image_height", &image_height, true);
-//   parser.addParam("camera_model.fx", &fx, true);
-//   parser.addParam("camera_model.fy", &fy, true);
-//   parser.addParam("camera_model.cx", &cx, true);
-//   parser.addParam("camera_model.cy", &cy, true);
-//   if (parser.load(config_file) != 0) {
-//     LOG_ERROR("Failed to load config file [%s]!", config_file.c_str());
-//     return -1;
-//   }
-//
-//   // Load camera model
-//   if (camera_model == "pinhole") {
-//     this->camera_model =
-//         new PinholeModel{image_width, image_height, fx, fy, cx, cy};
-//   } else {
-//     LOG_ERROR("Invalid camera model [%s]!", camera_model.c_str());
-//     return -1;
-//   }
-//
-//   return 0;
-// }
+int KLTTracker::configure(const std::string &config_file) {
+  std::string camera_model;
+  int image_width = 0;
+  int image_height = 0;
+  double fx = 0.0;
+  double fy = 0.0;
+  double cx = 0.0;
+  double cy = 0.0;
+  std::string distortion_model = "none";
+  VecX distortion_coeffs;
+
+  // Load config file
+  ConfigParser parser;
+  // -- Load feature detector settings
+  parser.addParam("max_corners", &this->max_corners);
+  parser.addParam("quality_level", &this->quality_level);
+  parser.addParam("min_distance", &this->min_distance);
+  parser.addParam("show_matches", &this->show_matches);
+  // -- Load camera model settings
+  parser.addParam("camera_model.type", &camera_model, true);
+  parser.addParam("camera_model.image_width", &image_width, true);
+  parser.addParam("camera_model.image_height", &image_height, true);
+  parser.addParam("camera_model.fx", &fx, true);
+  parser.addParam("camera_model.fy", &fy, true);
+  parser.addParam("camera_model.cx", &cx, true);
+  parser.addParam("camera_model.cy", &cy, true);
+  parser.addParam("camera_model.distortion_model", &distortion_model, true);
+  parser.addParam("camera_model.distortion_coeffs", &distortion_coeffs, true);
+  if (parser.load(config_file) != 0) {
+    LOG_ERROR("Failed to load config file [%s]!", config_file.c_str());
+    return -1;
+  }
+
+  // Load camera model
+  if (camera_model == "pinhole") {
+    std::unique_ptr<PinholeModel> pinhole_model{
+        new PinholeModel{image_width, image_height, fx, fy, cx, cy}};
+    const int retval =
+        pinhole_model->setDistortion(distortion_model, distortion_coeffs);
+    if (retval != 0) {
+      return -1;
+    }
+    this->pinhole_model = std::move(pinhole_model);
+    this->camera_model = this->pinhole_model.get();
+  } else if (camera_model == "none") {
+    LOG_INFO("Not loading any camera model!");
+  } else {
+    LOG_ERROR("Invalid camera model [%s]!", camera_model.c_str());
+    return -1;
+  }
+
+  return 0;
+}
 
 std::vector<FeatureTrack> KLTTracker::getLostTracks() {
   // Get lost tracks
@@ -51,13 +64,32 @@ std::vector<FeatureTrack> KLTTracker::getLostTracks() {
     return tracks;
   }
 
+  // Gather keypoints of all lost tracks
+  long nb_keypoints = 0;
+  for (const auto &track : tracks) {
+    nb_keypoints += track.track.size();
+  }
+  Mat2X pixels{2, nb_keypoints};
+  long index = 0;
+  for (const auto &track : tracks) {
+    for (const auto &feature : track.track) {
+      pixels(0, index) = feature.kp.pt.x;
+      pixels(1, index) = feature.kp.pt.y;
+      index++;
+    }
+  }
+
+  // Un-distort and convert pixel coordinates to image coordinates
+  Mat2X points;
+  this->camera_model->undistortPoints(pixels, points);
+
   // Transform keypoints
+  index = 0;
   for (auto &track : tracks) {
     for (auto &feature : track.track) {
-      // Convert pixel coordinates to image coordinates
-      const Vec2 pt = this->camera_model->pixel2image(feature.kp.pt);
-      feature.kp.pt.x = pt(0);
-      feature.kp.pt.y = pt(1);
+      feature.kp.pt.x = points(0, index);
+      feature.kp.pt.y = points(1, index);
+      index++;
     }
   }
 
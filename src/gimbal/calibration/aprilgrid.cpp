@@ -70,7 +70,7 @@ int AprilGrid::detect(cv::Mat &image) {
 
   // Extract corners
   std::vector<AprilTags::TagDetection> detections;
-  detections = this->detector.extractTags(image_gray);
+  detections = this->detectTags(image_gray);
   if (detections.size() == 0) {
     return -1;
   }
@@ -89,6 +89,135 @@ int AprilGrid::detect(cv::Mat &image) {
   return 0;
 }
 
+std::string AprilGrid::config() const {
+  std::ostringstream ss;
+  ss << "aprilgrid_36h11";
+  ss << " " << this->tag_rows << " " << this->tag_cols;
+  ss << " " << this->tag_size << " " << this->tag_spacing;
+  if (this->subpix) {
+    ss << " subpix " << this->subpix_window;
+  }
+  return ss.str();
+}
+
+std::vector<AprilTags::TagDetection>
+AprilGrid::detectTags(const cv::Mat &image_gray) {
+  const int nb_tiles = this->tile_rows * this->tile_cols;
+  if (this->thread_pool == nullptr || nb_tiles <= 1) {
+    std::vector<AprilTags::TagDetection> detections;
+    detections = this->detector.extractTags(image_gray);
+    std::sort(detections.begin(),
+              detections.end(),
+              [](const AprilTags::TagDetection &a,
+                 const AprilTags::TagDetection &b) { return a.id < b.id; });
+    return detections;
+  }
+
+  // Form overlapping tiles
+  const int W = image_gray.cols;
+  const int H = image_gray.rows;
+  const int pad = this->tile_overlap / 2;
+  std::vector<cv::Rect> tiles;
+  for (int r = 0; r < this->tile_rows; r++) {
+    for (int c = 0; c < this->tile_cols; c++) {
+      const int x0 = std::max(c * W / this->tile_cols - pad, 0);
+      const int y0 = std::max(r * H / this->tile_rows - pad, 0);
+      const int x1 = std::min((c + 1) * W / this->tile_cols + pad, W);
+      const int y1 = std::min((r + 1) * H / this->tile_rows + pad, H);
+      tiles.emplace_back(x0, y0, x1 - x0, y1 - y0);
+    }
+  }
+
+  // One detector per task, the detector is not thread-safe
+  const int nb_tasks = std::min((int) this->thread_pool->size(), nb_tiles);
+  while ((int) this->tile_detectors.size() < nb_tasks) {
+    this->tile_detectors.push_back(this->detector);
+  }
+
+  // Detect tags in every tile. The detector indexes the image data as if it
+  // was continuous, so each tile is copied out of the image.
+  std::vector<std::vector<AprilTags::TagDetection>> results(nb_tiles);
+  auto detect_tile = [&](int task, int i) {
+    const cv::Rect &tile = tiles[i];
+    const cv::Mat tile_image = image_gray(tile).clone();
+    results[i] = this->tile_detectors[task].extractTags(tile_image);
+
+    // Transform to image coordinates
+    for (auto &det : results[i]) {
+      for (int j = 0; j < 4; j++) {
+        det.p[j].first += tile.x;
+        det.p[j].second += tile.y;
+      }
+      det.cxy.first += tile.x;
+      det.cxy.second += tile.y;
+    }
+  };
+  this->thread_pool->parallelForDynamic(0, nb_tiles, detect_tile, nb_tasks);
+
+  // Merge duplicates in the overlaps, keep the detection furthest from a
+  // tile border that is not also an image border
+  std::map<int, std::pair<float, AprilTags::TagDetection>> merged;
+  for (int i = 0; i < nb_tiles; i++) {
+    const cv::Rect &tile = tiles[i];
+    const float left = (tile.x > 0) ? tile.x : -FLT_MAX;
+    const float top = (tile.y > 0) ? tile.y : -FLT_MAX;
+    const float right = (tile.x + tile.width < W) ? tile.x + tile.width
+                                                  : FLT_MAX;
+    const float bottom = (tile.y + tile.height < H) ? tile.y + tile.height
+                                                    : FLT_MAX;
+
+    for (const auto &det : results[i]) {
+      float margin = FLT_MAX;
+      for (int j = 0; j < 4; j++) {
+        margin = std::min(margin, det.p[j].first - left);
+        margin = std::min(margin, det.p[j].second - top);
+        margin = std::min(margin, right - det.p[j].first);
+        margin = std::min(margin, bottom - det.p[j].second);
+      }
+
+      auto it = merged.find(det.id);
+      if (it == merged.end() || margin > it->second.first) {
+        merged[det.id] = {margin, det};
+      }
+    }
+  }
+
+  std::vector<AprilTags::TagDetection> detections;
+  for (const auto &kv : merged) {
+    detections.push_back(kv.second.second);
+  }
+  return detections;
+}
+
+void AprilGrid::refineCorners(const cv::Mat &image_gray,
+                              std::map<int, std::vector<cv::Point2f>> &tags) {
+  // Gather corners of all tags
+  std::vector<cv::Point2f> corners;
+  for (const auto &tag : tags) {
+    corners.insert(corners.end(), tag.second.begin(), tag.second.end());
+  }
+  if (corners.size() == 0) {
+    return;
+  }
+
+  // Refine
+  const cv::Size win_size(this->subpix_window, this->subpix_window);
+  const cv::Size zero_zone(-1, -1);
+  const cv::TermCriteria criteria(cv::TermCriteria::EPS +
+                                      cv::TermCriteria::COUNT,
+                                  30,
+                                  0.01);
+  cv::cornerSubPix(image_gray, corners, win_size, zero_zone, criteria);
+
+  // Scatter corners back to their tags
+  size_t i = 0;
+  for (auto &tag : tags) {
+    for (auto &corner : tag.second) {
+      corner = corners[i++];
+    }
+  }
+}
+
 int AprilGrid::extractTags(cv::Mat &image,
                            std::map<int, std::vector<cv::Point2f>> &tags) {
   assert(this->detector.thisTagFamily.blackBorder == 2);
@@ -102,27 +231,49 @@ int AprilGrid::extractTags(cv::Mat &image,
   cv::Mat image_gray;
   cv::cvtColor(image, image_gray, CV_BGR2GRAY);
 
-  // Extract corners
-  std::vector<AprilTags::TagDetection> detections;
-  detections = this->detector.extractTags(image_gray);
+  // Lookup detection cache
+  uint64_t key = 0;
+  DetectionCacheEntry entry;
+  if (this->cache != nullptr) {
+    key = DetectionCache::key(image_gray, this->config());
+  }
+  if (this->cache != nullptr && this->cache->lookup(key, entry)) {
+    for (const auto &tag : entry.points) {
+      tags.emplace(tag.first, tag.second);
+    }
+  } else {
+    // Extract corners
+    std::vector<AprilTags::TagDetection> detections;
+    detections = this->detectTags(image_gray);
+
+    // Iterate through detections
+    for (auto &det : detections) {
+      const cv::Point2f p0{det.p[0].first, det.p[0].second};
+      const cv::Point2f p1{det.p[1].first, det.p[1].second};
+      const cv::Point2f p2{det.p[2].first, det.p[2].second};
+      const cv::Point2f p3{det.p[3].first, det.p[3].second};
+      const std::vector<cv::Point2f> corners = {p0, p1, p2, p3};
+      entry.points.emplace(det.id, corners);
+    }
+
+    // Refine corners
+    if (this->subpix) {
+      this->refineCorners(image_gray, entry.points);
+    }
+    for (const auto &tag : entry.points) {
+      tags.emplace(tag.first, tag.second);
+    }
+
+    // Update detection cache
+    if (this->cache != nullptr) {
+      this->cache->insert(key, entry);
+    }
+  }
 
   // Make an RGB version of the input image
   cv::Mat image_rgb(image_gray.size(), CV_8UC3);
-  image_rgb = image.clone();
   cv::cvtColor(image_gray, image_rgb, CV_GRAY2RGB);
-
-  // Iterate through detections
-  for (auto &det : detections) {
-    const cv::Point2f p0{det.p[0].first, det.p[0].second};
-    const cv::Point2f p1{det.p[1].first, det.p[1].second};
-    const cv::Point2f p2{det.p[2].first, det.p[2].second};
-    const cv::Point2f p3{det.p[3].first, det.p[3].second};
-    const std::vector<cv::Point2f> corners = {p0, p1, p2, p3};
-    tags.emplace(det.id, corners);
-
-    // det.draw(image_rgb);
-  }
-  image = image_rgb.clone();
+  image = image_rgb;
 
   return 0;
 }
@@ -106,6 +106,44 @@ std::vector<int> CalibPreprocessor::findCommonTags(
   return common_tags;
 }
 
+int CalibPreprocessor::detectMeasurement(
+    AprilGrid &grid,
+    const std::vector<std::string> &image_paths,
+    CalibDetection &detection) {
+  // Load images
+  cv::Mat img0 = cv::imread(image_paths[0]);
+  cv::Mat img1 = cv::imread(image_paths[1]);
+  cv::Mat img2 = cv::imread(image_paths[2]);
+  if (img0.empty() || img1.empty() || img2.empty()) {
+    LOG_ERROR("Failed to load images [%s]!", image_paths[0].c_str());
+    return -1;
+  }
+
+  // Undistort image 1 and 2, only reads the prebuilt maps
+  cv::Mat img1_ud;
+  cv::Mat img2_ud;
+  if (this->camera_properties[1].undistort_map.undistort(img1, img1_ud) != 0 ||
+      this->camera_properties[2].undistort_map.undistort(img2, img2_ud) != 0) {
+    LOG_ERROR("Failed to undistort images [%s]!", image_paths[0].c_str());
+    return -1;
+  }
+
+  // Extract tags
+  detection.tags0.clear();
+  detection.tags1.clear();
+  detection.tags2.clear();
+  grid.extractTags(img0, detection.tags0);
+  grid.extractTags(img1_ud, detection.tags1);
+  grid.extractTags(img2_ud, detection.tags2);
+
+  // Find common tags between the images
+  detection.common_ids =
+      this->findCommonTags(detection.tags0, detection.tags1, detection.tags2);
+  detection.detected = (detection.common_ids.size() > 0);
+
+  return 0;
+}
+
 int CalibPreprocessor::preprocess(const std::string &dir_path) {
   // Load target file
   const std::string target_file = dir_path + "/target.yaml";
@@ -151,92 +189,74 @@ int CalibPreprocessor::preprocess(const std::string &dir_path) {
     return -1;
   }
 
-  // Iterate through images
-  AprilGrid grid{this->target.rows,
-                 this->target.cols,
-                 this->target.square_size,
-                 this->target.spacing};
-
-  for (int i = 0; i < this->nb_measurements; i++) {
-    // Load images
-    cv::Mat img0 = cv::imread(cam0_path + "/" + cam0_files[i]);
-    cv::Mat img1 = cv::imread(cam1_path + "/" + cam1_files[i]);
-    cv::Mat img2 = cv::imread(cam2_path + "/" + cam2_files[i]);
-
-    // Undistort image 0
-    const cv::Mat K0 = convert(this->camera_properties[0].K());
-    const cv::Mat D0 = convert(this->camera_properties[0].D());
-    cv::Mat img0_ud;
-    this->camera_properties[0].undistortImage(img0, 0.0, img0_ud);
-
-    // Undistort image 1
-    const cv::Mat K1 = convert(this->camera_properties[1].K());
-    const cv::Mat D1 = convert(this->camera_properties[1].D());
-    cv::Mat img1_ud;
-    this->camera_properties[1].undistortImage(img1, 0.0, img1_ud);
-
-    // Undistort image 2
-    const cv::Mat K2 = convert(this->camera_properties[2].K());
-    const cv::Mat D2 = convert(this->camera_properties[2].D());
-    cv::Mat img2_ud;
-    this->camera_properties[2].undistortImage(img2, 0.0, img2_ud);
-
-    // Extract tags
-    std::map<int, std::vector<cv::Point2f>> tags0;
-    std::map<int, std::vector<cv::Point2f>> tags1;
-    std::map<int, std::vector<cv::Point2f>> tags2;
-    grid.extractTags(img0, tags0);
-    grid.extractTags(img1_ud, tags1);
-    grid.extractTags(img2_ud, tags2);
-
-    // Find common tags between the images
-    std::vector<int> common_ids = this->findCommonTags(tags0, tags1, tags2);
-    // -- Estimated 3d position of tag corners
-    MatX P_c0 = zeros(common_ids.size() * 4, 3);
-    MatX P_c1 = zeros(common_ids.size() * 4, 3);
-    MatX P_c2 = zeros(common_ids.size() * 4, 3);
-    // -- Observed 2d pixel measurements of tag corners
-    MatX Q_c0 = zeros(common_ids.size() * 4, 2);
-    MatX Q_c1 = zeros(common_ids.size() * 4, 2);
-    MatX Q_c2 = zeros(common_ids.size() * 4, 2);
-
-    MatX grid_points;
-    grid.solvePnP(tags0, K0, grid_points);
-
-    for (long i = 0; i < grid_points.rows(); i++) {
-      const Vec3 pt = grid_points.row(i).transpose();
-      const Mat3 K = this->camera_properties[0].K();
-      Vec3 pixel = K * pt;
-      pixel(0) = pixel(0) / pixel(2);
-      pixel(1) = pixel(1) / pixel(2);
-      std::cout << pixel.transpose() << std::endl;
-
-      cv::circle(img0_ud,
-                 cv::Point(pixel(0), pixel(1)),
-                 5,
-                 cv::Scalar(0, 0, 255),
-                 1,
-                 8);
+  // Check number of images
+  if (this->nb_measurements == 0) {
+    LOG_ERROR("No joint measurements in [%s]!", dir_path.c_str());
+    return -1;
+  } else if ((int) cam0_files.size() < this->nb_measurements ||
+      (int) cam1_files.size() < this->nb_measurements ||
+      (int) cam2_files.size() < this->nb_measurements) {
+    LOG_ERROR("Less images than joint measurements in [%s]!", dir_path.c_str());
+    return -1;
+  }
+
+  // Open detection cache
+  DetectionCache cache;
+  const bool use_cache = (this->cache_file.empty() == false);
+  if (use_cache && cache.open(this->cache_file) != 0) {
+    LOG_ERROR("Failed to open detection cache [%s]!",
+              this->cache_file.c_str());
+    return -1;
+  }
+  const size_t nb_cached = cache.size();
+
+  // Build undistortion maps up front, workers only read them
+  for (int c = 1; c < 3; c++) {
+    const std::string path = dir_path + "/cam" + std::to_string(c) + "/";
+    const std::string &file = (c == 1) ? cam1_files[0] : cam2_files[0];
+    const cv::Mat image = cv::imread(path + file);
+    cv::Mat image_ud;
+    if (this->camera_properties[c].undistortImage(image, 0.0, image_ud) != 0) {
+      LOG_ERROR("Failed to build undistortion map for cam%d!", c);
+      return -1;
     }
+  }
 
-    // int index = 0;
-    // for (auto &id : common_ids) {
-    //   for (int i = 0; i < 4; i++) {
-    //     // Q_c0.block(index, 0, 1, 2) = tags0[id][i].transpose();
-    //     // Q_c1.block(index, 0, 1, 2) = tags1[id][i].transpose();
-    //     // Q_c2.block(index, 0, 1, 2) = tags2[id][i].transpose();
-    //     index++;
-    //   }
-    // }
-
-    // // Visualize detected AprilTags
-    cv::imshow("img0", img0_ud);
-    // cv::imshow("img1", img1_ud);
-    // cv::imshow("img2", img2_ud);
-    //
-    cv::waitKey();
+  // Worker pool, every task owns its own AprilGrid detector
+  const size_t nb_threads = (this->nb_workers > 0)
+                                ? this->nb_workers
+                                : std::thread::hardware_concurrency();
+  ThreadPool pool{nb_threads};
+  std::vector<AprilGrid> grids;
+  grids.reserve(pool.size());
+  for (size_t i = 0; i < pool.size(); i++) {
+    grids.emplace_back(this->target.rows,
+                       this->target.cols,
+                       this->target.square_size,
+                       this->target.spacing);
+    grids.back().cache = (use_cache) ? &cache : nullptr;
   }
 
+  // Detect AprilGrid in every measurement
+  this->detections.clear();
+  this->detections.resize(this->nb_measurements);
+  std::atomic<int> nb_failed{0};
+  pool.parallelForDynamic(0, this->nb_measurements, [&](int task, int i) {
+    const std::vector<std::string> image_paths = {
+        cam0_path + "/" + cam0_files[i],
+        cam1_path + "/" + cam1_files[i],
+        cam2_path + "/" + cam2_files[i]};
+    CalibDetection &detection = this->detections[i];
+    if (this->detectMeasurement(grids[task], image_paths, detection) != 0) {
+      nb_failed++;
+    }
+  });
+
+  LOG_INFO("Preprocessed %d measurements (%zu images cached, %d failed)",
+           this->nb_measurements,
+           nb_cached,
+           nb_failed.load());
+
   return 0;
 }
 
@@ -2,6 +2,49 @@
 
 namespace gvio {
 
+void ReprojectionStats::update(const std::vector<cv::Point2f> &measured,
+                               const MatX &predicted) {
+  assert(measured.size() == (size_t) predicted.cols());
+
+  double frame_sum_sq = 0.0;
+  for (size_t i = 0; i < measured.size(); i++) {
+    const double dx = measured[i].x - predicted(0, i);
+    const double dy = measured[i].y - predicted(1, i);
+    const double sq = dx * dx + dy * dy;
+    frame_sum_sq += sq;
+    this->max = std::max(this->max, sqrt(sq));
+  }
+
+  this->nb_frames++;
+  this->nb_points += measured.size();
+  this->sum_sq += frame_sum_sq;
+  this->last = sqrt(frame_sum_sq / measured.size());
+}
+
+double ReprojectionStats::rmse() const {
+  if (this->nb_points == 0) {
+    return 0.0;
+  }
+  return sqrt(this->sum_sq / this->nb_points);
+}
+
+void ReprojectionStats::reset() {
+  this->nb_frames = 0;
+  this->nb_points = 0;
+  this->sum_sq = 0.0;
+  this->max = 0.0;
+  this->last = 0.0;
+}
+
+std::ostream &operator<<(std::ostream &os, const ReprojectionStats &stats) {
+  os << "nb_frames: " << stats.nb_frames << std::endl;
+  os << "nb_points: " << stats.nb_points << std::endl;
+  os << "rmse: " << stats.rmse() << std::endl;
+  os << "max: " << stats.max << std::endl;
+  os << "last: " << stats.last << std::endl;
+  return os;
+}
+
 CalibValidator::CalibValidator() {}
 
 CalibValidator::~CalibValidator() {}
@@ -33,6 +76,12 @@ int CalibValidator::load(const int nb_cameras,
   this->gimbal_model.theta1_offset = this->camchain.theta1_offset;
   this->gimbal_model.theta2_offset = this->camchain.theta2_offset;
 
+  // Streaming state
+  this->tracks.clear();
+  this->tracks.resize(nb_cameras);
+  this->T_C0_C1 = this->camchain.T_C1_C0.inverse();
+  this->T_ds_joints = Vec2{NAN, NAN};
+
   return 0;
 }
 
@@ -253,7 +302,7 @@ cv::Mat CalibValidator::validateTriclops(const cv::Mat &img0,
   retval = this->detect(0, img0, X0);
   retval += this->detect(1, img1, X1);
   retval += this->detect(2, img2, X2);
-  if (retval != 0) {
+  if (retval != 3) {
     cv::Mat img02;
     cv::hconcat(img0, img2, img02);
     cv::Mat img021;
@@ -295,4 +344,263 @@ cv::Mat CalibValidator::validateTriclops(const cv::Mat &img0,
   return img021;
 }
 
+int CalibValidator::trackCorners(const int camera_index,
+                                 const cv::Mat &image,
+                                 std::vector<cv::Point2f> &corners) {
+  assert(camera_index >= 0);
+  assert(camera_index < (int) this->tracks.size());
+  CornerTrack &track = this->tracks[camera_index];
+
+  // Convert image to grayscale
+  cv::Mat image_gray;
+  if (image.channels() != 1) {
+    cv::cvtColor(image, image_gray, cv::COLOR_BGR2GRAY);
+  } else {
+    image_gray = image;
+  }
+
+  // Track corners from previous frame, all corners have to pass a
+  // forward-backward check else the chessboard is re-detected
+  bool tracked = false;
+  if (track.valid && track.nb_tracked < this->redetect_interval &&
+      track.prev_gray.size() == image_gray.size()) {
+    std::vector<cv::Point2f> fwd;
+    std::vector<cv::Point2f> bwd;
+    std::vector<uchar> fwd_status;
+    std::vector<uchar> bwd_status;
+    std::vector<float> err;
+    cv::calcOpticalFlowPyrLK(track.prev_gray,
+                             image_gray,
+                             track.corners,
+                             fwd,
+                             fwd_status,
+                             err);
+    cv::calcOpticalFlowPyrLK(image_gray,
+                             track.prev_gray,
+                             fwd,
+                             bwd,
+                             bwd_status,
+                             err);
+
+    tracked = true;
+    const double max_sq = this->max_track_error * this->max_track_error;
+    for (size_t i = 0; i < track.corners.size(); i++) {
+      const cv::Point2f diff = bwd[i] - track.corners[i];
+      if (fwd_status[i] == 0 || bwd_status[i] == 0 ||
+          diff.dot(diff) > max_sq) {
+        tracked = false;
+        break;
+      }
+    }
+
+    if (tracked) {
+      track.corners = fwd;
+      track.nb_tracked++;
+    }
+  }
+
+  // Re-detect chessboard
+  if (tracked == false) {
+    track.nb_tracked = 0;
+    track.valid = (this->chessboard.detect(image_gray, track.corners) == 0);
+    if (track.valid == false) {
+      track.corners.clear();
+      track.rvec.release();
+      track.tvec.release();
+      track.prev_gray.release();
+      return 0;
+    }
+  }
+
+  // Keep a copy, the caller may reuse the image buffer
+  image_gray.copyTo(track.prev_gray);
+  corners = track.corners;
+
+  return 1;
+}
+
+int CalibValidator::cornerPositions(const int camera_index,
+                                    const std::vector<cv::Point2f> &corners,
+                                    MatX &X) {
+  assert(camera_index >= 0);
+  assert(camera_index < (int) this->tracks.size());
+  CornerTrack &track = this->tracks[camera_index];
+
+  // Undistort points
+  std::vector<cv::Point2f> corners_ud;
+  if (this->camchain.cam[camera_index].undistortPoints(corners, corners_ud) !=
+      0) {
+    return -1;
+  }
+
+  // Solve PnP in ideal coordinates, warm-started from the last pose
+  const bool use_guess = (track.rvec.empty() == false);
+  if (use_guess == false) {
+    track.rvec = cv::Mat(3, 1, cv::DataType<double>::type);
+    track.tvec = cv::Mat(3, 1, cv::DataType<double>::type);
+  }
+  const cv::Mat K = convert(I(3));
+  const cv::Mat D;
+  if (cv::solvePnP(this->chessboard.object_points,
+                   corners_ud,
+                   K,
+                   D,
+                   track.rvec,
+                   track.tvec,
+                   use_guess,
+                   cv::SOLVEPNP_ITERATIVE) == false) {
+    track.rvec.release();
+    track.tvec.release();
+    return -1;
+  }
+
+  // Calculate corner positions in 3D
+  cv::Mat R_cv;
+  cv::Rodrigues(track.rvec, R_cv);
+  const Mat3 R = convert(R_cv);
+  const Vec3 t{track.tvec.at<double>(0),
+               track.tvec.at<double>(1),
+               track.tvec.at<double>(2)};
+
+  const int nb_pts = this->chessboard.object_points.size();
+  X.resize(3, nb_pts);
+  for (int i = 0; i < nb_pts; i++) {
+    const cv::Point3f &p = this->chessboard.object_points[i];
+    X.col(i) = R * Vec3{p.x, p.y, p.z} + t;
+  }
+
+  return 0;
+}
+
+const Mat4 &CalibValidator::gimbalTransform(const double joint_roll,
+                                            const double joint_pitch) {
+  if (joint_roll != this->T_ds_joints(0) ||
+      joint_pitch != this->T_ds_joints(1)) {
+    this->gimbal_model.Lambda1 = joint_roll;
+    this->gimbal_model.Lambda2 = joint_pitch;
+    this->T_ds = this->gimbal_model.T_ds();
+    this->T_ds_joints = Vec2{joint_roll, joint_pitch};
+  }
+
+  return this->T_ds;
+}
+
+int CalibValidator::stereoStats(const std::vector<cv::Point2f> &corners0,
+                                const std::vector<cv::Point2f> &corners1,
+                                const MatX &X0,
+                                const MatX &X1) {
+  // Project points observed from cam1 to cam0 image and vice versa
+  MatX pixels0, pixels1;
+  const Mat4 &T_C1_C0 = this->camchain.T_C1_C0;
+  const MatX X0_cal = (this->T_C0_C1 * X1.colwise().homogeneous()).topRows(3);
+  const MatX X1_cal = (T_C1_C0 * X0.colwise().homogeneous()).topRows(3);
+  if (this->camchain.cam[0].project(X0_cal, pixels0) != 0 ||
+      this->camchain.cam[1].project(X1_cal, pixels1) != 0) {
+    return -1;
+  }
+
+  // Update statistics
+  std::vector<cv::Point2f> measured = corners0;
+  measured.insert(measured.end(), corners1.begin(), corners1.end());
+  MatX predicted(2, pixels0.cols() + pixels1.cols());
+  predicted << pixels0, pixels1;
+  this->stereo_stats.update(measured, predicted);
+
+  return 0;
+}
+
+int CalibValidator::validateStereoStream(const cv::Mat &img0,
+                                         const cv::Mat &img1) {
+  // Pre-check
+  assert(img0.empty() == false);
+  assert(img1.empty() == false);
+  assert(this->tracks.size() >= 2);
+
+  // Track chessboard corners
+  std::vector<cv::Point2f> corners0, corners1;
+  int retval = 0;
+  retval += this->trackCorners(0, img0, corners0);
+  retval += this->trackCorners(1, img1, corners1);
+  if (retval != 2) {
+    return 0;
+  }
+
+  // Calculate 3d corner positions
+  MatX X0, X1;
+  if (this->cornerPositions(0, corners0, X0) != 0 ||
+      this->cornerPositions(1, corners1, X1) != 0) {
+    return -1;
+  }
+
+  // Update statistics
+  if (this->stereoStats(corners0, corners1, X0, X1) != 0) {
+    return -1;
+  }
+
+  return 1;
+}
+
+int CalibValidator::validateTriclopsStream(const cv::Mat &img0,
+                                           const cv::Mat &img1,
+                                           const cv::Mat &img2,
+                                           const double joint_roll,
+                                           const double joint_pitch) {
+  // Pre-check
+  assert(img0.empty() == false);
+  assert(img1.empty() == false);
+  assert(img2.empty() == false);
+  assert(this->tracks.size() >= 3);
+
+  // Track chessboard corners
+  std::vector<cv::Point2f> corners0, corners1, corners2;
+  int retval = 0;
+  retval += this->trackCorners(0, img0, corners0);
+  retval += this->trackCorners(1, img1, corners1);
+  retval += this->trackCorners(2, img2, corners2);
+  if (retval != 3) {
+    return 0;
+  }
+
+  // Calculate 3d corner positions
+  MatX X0, X1;
+  if (this->cornerPositions(0, corners0, X0) != 0 ||
+      this->cornerPositions(1, corners1, X1) != 0) {
+    return -1;
+  }
+
+  // Update stereo statistics
+  if (this->stereoStats(corners0, corners1, X0, X1) != 0) {
+    return -1;
+  }
+
+  // Project points observed from cam0 and cam1 to cam2 image
+  MatX pixels0, pixels1;
+  const Mat4 &T_ds = this->gimbalTransform(joint_roll, joint_pitch);
+  const Mat4 T_ds_C1 = T_ds * this->T_C0_C1;
+  const MatX X2_cal0 = (T_ds * X0.colwise().homogeneous()).topRows(3);
+  const MatX X2_cal1 = (T_ds_C1 * X1.colwise().homogeneous()).topRows(3);
+  if (this->camchain.cam[2].project(X2_cal0, pixels0) != 0 ||
+      this->camchain.cam[2].project(X2_cal1, pixels1) != 0) {
+    return -1;
+  }
+
+  // Update gimbal statistics
+  std::vector<cv::Point2f> measured = corners2;
+  measured.insert(measured.end(), corners2.begin(), corners2.end());
+  MatX predicted(2, pixels0.cols() + pixels1.cols());
+  predicted << pixels0, pixels1;
+  this->gimbal_stats.update(measured, predicted);
+
+  return 1;
+}
+
+void CalibValidator::resetStream() {
+  const size_t nb_cameras = this->tracks.size();
+  this->tracks.clear();
+  this->tracks.resize(nb_cameras);
+  this->T_ds_joints = Vec2{NAN, NAN};
+  this->stereo_stats.reset();
+  this->gimbal_stats.reset();
+}
+
 } // namespace gvio
@@ -72,34 +72,22 @@ int CameraProperty::undistortImage(const cv::Mat &image,
                                    const double balance,
                                    cv::Mat &image_ud,
                                    cv::Mat &K_ud) {
-  const cv::Mat K = convert(this->K());
-  const cv::Mat D = convert(this->D());
-
-  if (distortion_model == "equidistant") {
-    // Estimate new camera matrix first
-    const cv::Size img_size = {image.cols, image.rows};
-    const cv::Mat R = cv::Mat::eye(3, 3, CV_64F);
-    cv::fisheye::estimateNewCameraMatrixForUndistortRectify(K,
-                                                            D,
-                                                            img_size,
-                                                            R,
-                                                            K_ud,
-                                                            balance);
-
-    // Undistort image
-    cv::fisheye::undistortImage(image, image_ud, K, D, K_ud);
-
-  } else if (distortion_model == "radial-tangential") {
-    // Undistort image
-    K_ud = K.clone();
-    cv::undistort(image, image_ud, K, D, K_ud);
-
-  } else {
-    LOG_ERROR("Unsupported distortion model [%s]!", distortion_model.c_str());
-    return -1;
+  const Mat3 K = this->K();
+  const VecX D = this->D();
+  const cv::Size img_size = {image.cols, image.rows};
+
+  // Build undistortion map only if camera parameters changed
+  if (this->undistort_map.matches(
+          distortion_model, K, D, img_size, balance) == false) {
+    if (this->undistort_map.configure(
+            distortion_model, K, D, img_size, balance) != 0) {
+      return -1;
+    }
   }
 
-  return 0;
+  // Undistort image
+  K_ud = this->undistort_map.K_ud.clone();
+  return this->undistort_map.undistort(image, image_ud, this->thread_pool);
 }
 
 int CameraProperty::undistortImage(const cv::Mat &image,
@@ -110,26 +98,23 @@ int CameraProperty::undistortImage(const cv::Mat &image,
 }
 
 int CameraProperty::project(const MatX &X, MatX &pixels) {
-  pixels.resize(2, X.cols());
+  Mat2X distorted;
 
   if (this->distortion_model == "equidistant") {
-    for (long i = 0; i < X.cols(); i++) {
-      const Vec3 p = X.col(i);
-      const Vec2 pixel = project_pinhole_equi(this->K(), this->D(), p);
-      pixels.col(i) = pixel;
+    if (project_pinhole_equi(this->K(), this->D(), X, distorted) != 0) {
+      return -1;
     }
 
   } else if (distortion_model == "radial-tangential") {
-    for (long i = 0; i < X.cols(); i++) {
-      const Vec3 p = X.col(i);
-      const Vec2 pixel = project_pinhole_radtan(this->K(), this->D(), p);
-      pixels.col(i) = pixel;
+    if (project_pinhole_radtan(this->K(), this->D(), X, distorted) != 0) {
+      return -1;
     }
 
   } else {
     LOG_ERROR("Unsupported distortion model [%s]!", distortion_model.c_str());
     return -1;
   }
+  pixels = distorted;
 
   return 0;
 }
@@ -49,6 +49,12 @@ std::vector<cv::Point3f> Chessboard::createObjectPoints() {
   return object_points;
 }
 
+std::string Chessboard::config() const {
+  std::ostringstream ss;
+  ss << "chessboard " << this->nb_rows << " " << this->nb_cols;
+  return ss.str();
+}
+
 int Chessboard::detect(const cv::Mat &image,
                        std::vector<cv::Point2f> &corners) {
   // Find the chessboard corners
@@ -59,20 +65,37 @@ int Chessboard::detect(const cv::Mat &image,
   } else {
     image_gray = image.clone();
   }
+  // -- Lookup detection cache
+  uint64_t key = 0;
+  DetectionCacheEntry entry;
+  if (this->cache != nullptr) {
+    key = DetectionCache::key(image_gray, this->config());
+    if (this->cache->lookup(key, entry)) {
+      corners = entry.points[0];
+      return entry.retval;
+    }
+  }
   // -- Detect chessboard corners
   cv::Size size(this->nb_cols, this->nb_rows);
   if (cv::findChessboardCorners(image_gray, size, corners) == false) {
-    return -1;
+    entry.retval = -1;
+  } else {
+    // -- Refine corner locations
+    cv::Size win_size(11, 11);
+    cv::Size zero_zone(-1, -1);
+    cv::TermCriteria criteria(cv::TermCriteria::EPS + cv::TermCriteria::COUNT,
+                              (int) 1.0e10,
+                              1.0e-10);
+    cv::cornerSubPix(image_gray, corners, win_size, zero_zone, criteria);
+    entry.retval = 0;
+  }
+  // -- Update detection cache, failed detections are cached as well
+  if (this->cache != nullptr) {
+    entry.points[0] = corners;
+    this->cache->insert(key, entry);
   }
-  // -- Refine corner locations
-  cv::Size win_size(11, 11);
-  cv::Size zero_zone(-1, -1);
-  cv::TermCriteria criteria(cv::TermCriteria::EPS + cv::TermCriteria::COUNT,
-                            (int) 1.0e10,
-                            1.0e-10);
-  cv::cornerSubPix(image_gray, corners, win_size, zero_zone, criteria);
 
-  return 0;
+  return entry.retval;
 }
 
 int Chessboard::drawCorners(cv::Mat &image) {
@@ -0,0 +1,200 @@
+#include "gvio/gimbal/calibration/detection_cache.hpp"
+
+namespace gvio {
+
+// 64-bit FNV-1a
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+static uint64_t fnv1a(const uint8_t *data, const size_t len, uint64_t hash) {
+  for (size_t i = 0; i < len; i++) {
+    hash ^= data[i];
+    hash *= FNV_PRIME;
+  }
+  return hash;
+}
+
+static int write_entry(FILE *fp,
+                       const uint64_t key,
+                       const DetectionCacheEntry &entry) {
+  const int32_t retval = entry.retval;
+  const uint32_t nb_ids = entry.points.size();
+  if (fwrite(&key, sizeof(key), 1, fp) != 1 ||
+      fwrite(&retval, sizeof(retval), 1, fp) != 1 ||
+      fwrite(&nb_ids, sizeof(nb_ids), 1, fp) != 1) {
+    return -1;
+  }
+
+  for (const auto &kv : entry.points) {
+    const int32_t id = kv.first;
+    const uint32_t nb_points = kv.second.size();
+    if (fwrite(&id, sizeof(id), 1, fp) != 1 ||
+        fwrite(&nb_points, sizeof(nb_points), 1, fp) != 1) {
+      return -1;
+    }
+    for (const auto &p : kv.second) {
+      const float xy[2] = {p.x, p.y};
+      if (fwrite(xy, sizeof(float), 2, fp) != 2) {
+        return -1;
+      }
+    }
+  }
+
+  return 0;
+}
+
+static int read_entry(FILE *fp, uint64_t &key, DetectionCacheEntry &entry) {
+  int32_t retval = 0;
+  uint32_t nb_ids = 0;
+  if (fread(&key, sizeof(key), 1, fp) != 1 ||
+      fread(&retval, sizeof(retval), 1, fp) != 1 ||
+      fread(&nb_ids, sizeof(nb_ids), 1, fp) != 1) {
+    return -1;
+  }
+  entry.retval = retval;
+  entry.points.clear();
+
+  for (uint32_t i = 0; i < nb_ids; i++) {
+    int32_t id = 0;
+    uint32_t nb_points = 0;
+    if (fread(&id, sizeof(id), 1, fp) != 1 ||
+        fread(&nb_points, sizeof(nb_points), 1, fp) != 1) {
+      return -1;
+    }
+
+    std::vector<cv::Point2f> points;
+    for (uint32_t j = 0; j < nb_points; j++) {
+      float xy[2];
+      if (fread(xy, sizeof(float), 2, fp) != 2) {
+        return -1;
+      }
+      points.emplace_back(xy[0], xy[1]);
+    }
+    entry.points.emplace(id, points);
+  }
+
+  return 0;
+}
+
+DetectionCache::~DetectionCache() {
+  this->close();
+}
+
+int DetectionCache::open(const std::string &path) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->fp != nullptr) {
+    fclose(this->fp);
+    this->fp = nullptr;
+  }
+  this->path = path;
+  this->entries.clear();
+
+  // Load existing entries, a truncated last entry (interrupted run) is
+  // dropped and overwritten
+  long valid_size = 0;
+  FILE *fp = fopen(path.c_str(), "rb");
+  if (fp != NULL && fgetc(fp) != EOF) {
+    char magic[8];
+    rewind(fp);
+    if (fread(magic, 1, 8, fp) != 8 ||
+        memcmp(magic, DETECTION_CACHE_MAGIC, 8) != 0) {
+      LOG_ERROR("Invalid detection cache file [%s]!", path.c_str());
+      fclose(fp);
+      return -1;
+    }
+    valid_size = ftell(fp);
+
+    uint64_t key = 0;
+    DetectionCacheEntry entry;
+    while (read_entry(fp, key, entry) == 0) {
+      this->entries[key] = entry;
+      valid_size = ftell(fp);
+    }
+  }
+  if (fp != NULL) {
+    fclose(fp);
+  }
+
+  // Open for appending
+  if (valid_size == 0) {
+    this->fp = fopen(path.c_str(), "wb");
+    if (this->fp != NULL) {
+      fwrite(DETECTION_CACHE_MAGIC, 1, 8, this->fp);
+      fflush(this->fp);
+    }
+  } else {
+    this->fp = fopen(path.c_str(), "r+b");
+    if (this->fp != NULL &&
+        (ftruncate(fileno(this->fp), valid_size) != 0 ||
+         fseek(this->fp, valid_size, SEEK_SET) != 0)) {
+      fclose(this->fp);
+      this->fp = nullptr;
+    }
+  }
+  if (this->fp == NULL) {
+    LOG_ERROR("Failed to open detection cache [%s]!", path.c_str());
+    return -1;
+  }
+
+  return 0;
+}
+
+void DetectionCache::close() {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (this->fp != nullptr) {
+    fclose(this->fp);
+    this->fp = nullptr;
+  }
+}
+
+size_t DetectionCache::size() {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->entries.size();
+}
+
+uint64_t DetectionCache::key(const cv::Mat &image, const std::string &config) {
+  uint64_t hash = FNV_OFFSET;
+
+  // Target configuration
+  hash = fnv1a((const uint8_t *) config.data(), config.size(), hash);
+
+  // Image header and content
+  const int32_t header[4] = {image.rows, image.cols, image.type(), 0};
+  hash = fnv1a((const uint8_t *) header, sizeof(header), hash);
+  const size_t row_bytes = image.cols * image.elemSize();
+  for (int i = 0; i < image.rows; i++) {
+    hash = fnv1a(image.ptr<uint8_t>(i), row_bytes, hash);
+  }
+
+  return hash;
+}
+
+bool DetectionCache::lookup(const uint64_t key, DetectionCacheEntry &entry) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto it = this->entries.find(key);
+  if (it == this->entries.end()) {
+    return false;
+  }
+
+  entry = it->second;
+  return true;
+}
+
+int DetectionCache::insert(const uint64_t key,
+                           const DetectionCacheEntry &entry) {
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->entries[key] = entry;
+
+  // Append to file
+  if (this->fp != nullptr) {
+    if (write_entry(this->fp, key, entry) != 0 || fflush(this->fp) != 0) {
+      LOG_ERROR("Failed to write to detection cache [%s]!",
+                this->path.c_str());
+      return -1;
+    }
+  }
+
+  return 0;
+}
+
+} // namespace gvio
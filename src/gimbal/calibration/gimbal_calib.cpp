@@ -6,6 +6,20 @@ GimbalCalib::GimbalCalib() {}
 
 GimbalCalib::~GimbalCalib() {}
 
+int GimbalCalib::configure(const std::string &config_file) {
+  ConfigParser parser;
+  parser.addParam("linear_solver", &this->linear_solver, true);
+  parser.addParam("nb_threads", &this->nb_threads, true);
+  parser.addParam("max_iterations", &this->max_iterations, true);
+  parser.addParam("verbose", &this->verbose, true);
+  if (parser.load(config_file) != 0) {
+    LOG_ERROR("Failed to load config file [%s]!", config_file.c_str());
+    return -1;
+  }
+
+  return 0;
+}
+
 int GimbalCalib::load(const std::string &data_dir) {
   // Load calibration data
   if (this->data.load(data_dir) != 0) {
@@ -21,6 +35,16 @@ int GimbalCalib::load(const std::string &data_dir) {
     return -1;
   }
 
+  return this->setup();
+}
+
+int GimbalCalib::setup() {
+  // Pre-check
+  if (this->data.nb_measurements > this->params.nb_measurements) {
+    LOG_ERROR("Less joint angles than calibration measurements!");
+    return -1;
+  }
+
   // Setup optimization problem
   const Mat3 K_s = this->params.camchain.cam[0].K();
   const Mat3 K_d = this->params.camchain.cam[2].K();
@@ -28,7 +52,28 @@ int GimbalCalib::load(const std::string &data_dir) {
   const Vec4 D_d = this->params.camchain.cam[2].D();
 
   for (int i = 0; i < this->data.nb_measurements; i++) {
-    // Form residual
+    // Form a single residual for all corners of the measurement
+    if (this->per_measurement) {
+      auto cost_func = new GimbalCalibMeasurementResidual(this->data.P_s[i],
+                                                          this->data.P_d[i],
+                                                          this->data.Q_s[i],
+                                                          this->data.Q_d[i],
+                                                          K_s,
+                                                          K_d,
+                                                          D_s,
+                                                          D_d);
+      this->problem.AddResidualBlock(cost_func, // Cost function
+                                     NULL,      // Loss function
+                                     this->params.tau_s,
+                                     this->params.tau_d,
+                                     this->params.w1,
+                                     this->params.w2,
+                                     &this->params.Lambda1[i],
+                                     &this->params.Lambda2[i]);
+      continue;
+    }
+
+    // Form residual per corner
     for (int j = 0; j < this->data.P_s[i].rows(); j++) {
       const Vec3 P_s = this->data.P_s[i].row(j);
       const Vec3 P_d = this->data.P_d[i].row(j);
@@ -66,27 +111,92 @@ int GimbalCalib::load(const std::string &data_dir) {
   return 0;
 }
 
-int GimbalCalib::calibrate() {
-  // Set options
-  this->options.max_num_iterations = 1000;
-  // this->options.use_nonmonotonic_steps = false;
-  // this->options.use_inner_iterations = true;
-  // this->options.preconditioner_type = ceres::SCHUR_JACOBI;
-  // this->options.linear_solver_type = ceres::SPARSE_SCHUR;
-  // this->options.minimizer_type = ceres::LINE_SEARCH;
+int GimbalCalib::setupSolver() {
+  // Linear solver
+  ceres::LinearSolverType solver_type;
+  if (ceres::StringToLinearSolverType(this->linear_solver, &solver_type) ==
+      false) {
+    LOG_ERROR("Invalid linear solver [%s]!", this->linear_solver.c_str());
+    return -1;
+  }
+  this->options.linear_solver_type = solver_type;
+
+  // Parameter ordering, eliminate per-measurement joint angles first. Only
+  // blocks that are in the problem and free to move can be ordered.
+  auto ordering = new ceres::ParameterBlockOrdering();
+  auto add_block = [&](double *block, const int group) {
+    if (this->problem.HasParameterBlock(block) &&
+        this->problem.IsParameterBlockConstant(block) == false) {
+      ordering->AddElementToGroup(block, group);
+    }
+  };
+  for (int i = 0; i < this->data.nb_measurements; i++) {
+    add_block(&this->params.Lambda1[i], 0);
+    add_block(&this->params.Lambda2[i], 1);
+  }
+  add_block(this->params.tau_s, 1);
+  add_block(this->params.tau_d, 1);
+  add_block(this->params.w1, 1);
+  add_block(this->params.w2, 1);
+
+  // Let ceres pick the ordering if no joint angle can be eliminated
+  if (ordering->NumGroups() == 2) {
+    this->options.linear_solver_ordering.reset(ordering);
+  } else {
+    this->options.linear_solver_ordering.reset();
+    delete ordering;
+  }
+
+  // Threads
+  const int nb_threads = (this->nb_threads > 0)
+                             ? this->nb_threads
+                             : std::thread::hardware_concurrency();
+  this->options.num_threads = std::max(nb_threads, 1);
+  this->options.num_linear_solver_threads = std::max(nb_threads, 1);
+
+  // Termination criteria
+  this->options.max_num_iterations = this->max_iterations;
   this->options.function_tolerance = 1e-12;
   this->options.parameter_tolerance = 1e-12;
-  this->options.num_threads = 8;
-  this->options.num_linear_solver_threads = 8;
-  this->options.minimizer_progress_to_stdout = true;
+  this->options.minimizer_progress_to_stdout = this->verbose;
+
+  // Check options, e.g. sparse solvers need a sparse linear algebra library
+  std::string error;
+  if (this->options.IsValid(&error) == false) {
+    LOG_ERROR("Invalid solver options: %s", error.c_str());
+    return -1;
+  }
+
+  return 0;
+}
+
+int GimbalCalib::calibrate() {
+  // Set options
+  if (this->setupSolver() != 0) {
+    return -1;
+  }
 
   // Solve
-  std::cout << this->params << std::endl;
+  if (this->verbose) {
+    std::cout << this->params << std::endl;
+  }
   ceres::Solve(this->options, &this->problem, &this->summary);
-  std::cout << summary.FullReport() << std::endl;
-  std::cout << this->params << std::endl;
+  if (this->verbose) {
+    std::cout << summary.FullReport() << std::endl;
+    std::cout << this->params << std::endl;
+  }
 
-  return 0;
+  // Report solve time
+  LOG_INFO("Solved %d measurements with %s on %d threads: "
+           "%.3fs total, %.3fs linear solver, %d iterations",
+           this->data.nb_measurements,
+           this->linear_solver.c_str(),
+           this->options.num_threads,
+           this->summary.total_time_in_seconds,
+           this->summary.linear_solver_time_in_seconds,
+           (int) this->summary.iterations.size());
+
+  return (this->summary.IsSolutionUsable()) ? 0 : -1;
 }
 
 } // namespace gvio
@@ -46,13 +46,13 @@ GimbalCalibResidual::GimbalCalibResidual(const Vec3 &P_s,
   this->k1_s = D_s(0);
   this->k2_s = D_s(1);
   this->k3_s = D_s(2);
-  this->k4_s = D_s(2);
+  this->k4_s = D_s(3);
 
   // Dynamic camera distortion coefficients
   this->k1_d = D_d(0);
   this->k2_d = D_d(1);
   this->k3_d = D_d(2);
-  this->k4_d = D_d(2);
+  this->k4_d = D_d(3);
 }
 
 std::ostream &operator<<(std::ostream &os,
@@ -73,6 +73,199 @@ std::ostream &operator<<(std::ostream &os,
   return os;
 }
 
+// Number of calibration parameters: tau_s, tau_d, w1, w2, Lambda1, Lambda2
+#define GIMBAL_CALIB_NB_PARAMS 20
+
+typedef ceres::Jet<double, GIMBAL_CALIB_NB_PARAMS> ParamJet;
+typedef Eigen::Matrix<double, 2, GIMBAL_CALIB_NB_PARAMS> Mat2P;
+typedef Eigen::Matrix<double, 3, GIMBAL_CALIB_NB_PARAMS> Mat3P;
+
+static const int gimbal_calib_block_sizes[6] = {6, 6, 3, 3, 1, 1};
+
+/**
+ * Rigid transform and its derivatives w.r.t. the calibration parameters
+ */
+struct ParamTransform {
+  Mat3 R;
+  Vec3 t;
+  Mat3P dR[3]; ///< Derivative of each column of R
+  Mat3P dt;    ///< Derivative of t
+
+  ParamTransform(const Eigen::Matrix<ParamJet, 3, 3> &R,
+                 const Eigen::Matrix<ParamJet, 3, 1> &t) {
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        this->R(i, j) = R(i, j).a;
+        this->dR[j].row(i) = R(i, j).v.transpose();
+      }
+      this->t(i) = t(i).a;
+      this->dt.row(i) = t(i).v.transpose();
+    }
+  }
+
+  /// Transform point, optionally with the derivative of the result
+  Vec3 transform(const Vec3 &p, Mat3P *dx) const {
+    if (dx != nullptr) {
+      *dx = this->dR[0] * p(0) + this->dR[1] * p(1) + this->dR[2] * p(2);
+      *dx += this->dt;
+    }
+    return this->R * p + this->t;
+  }
+
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+/**
+ * Project 3D point using pinhole-equi with the analytic Jacobian w.r.t. the
+ * point
+ */
+static Vec2 project_equi_jacobian(const Mat3 &K,
+                                  const Vec4 &D,
+                                  const Vec3 &X,
+                                  Eigen::Matrix<double, 2, 3> &J) {
+  const double z = X(2);
+  const double x = X(0) / z;
+  const double y = X(1) / z;
+  const double r2 = x * x + y * y;
+  const double r = sqrt(r2);
+
+  // Distortion scale s = thetad / r, and (ds / dr) / r
+  double s = 1.0;
+  double ds_r = 0.0;
+  if (r > 1e-8) {
+    const double theta = atan(r);
+    const double th2 = theta * theta;
+    const double th4 = th2 * th2;
+    const double th6 = th4 * th2;
+    const double th8 = th4 * th4;
+    const double k1 = D(0);
+    const double k2 = D(1);
+    const double k3 = D(2);
+    const double k4 = D(3);
+    // clang-format off
+    const double thetad = theta * (1.0 + k1 * th2 + k2 * th4 + k3 * th6 + k4 * th8);
+    const double dthetad_dtheta = 1.0 + 3.0 * k1 * th2 + 5.0 * k2 * th4 + 7.0 * k3 * th6 + 9.0 * k4 * th8;
+    // clang-format on
+    const double dthetad_dr = dthetad_dtheta / (1.0 + r2);
+    s = thetad / r;
+    ds_r = (dthetad_dr - s) / r2;
+  }
+
+  // Jacobian of distorted point w.r.t. normalized point
+  const double dxd_dx = s + x * x * ds_r;
+  const double dxd_dy = x * y * ds_r;
+  const double dyd_dx = dxd_dy;
+  const double dyd_dy = s + y * y * ds_r;
+
+  // Chain with Jacobian of normalized point w.r.t. X and intrinsics
+  const double fx = K(0, 0);
+  const double fy = K(1, 1);
+  const double cx = K(0, 2);
+  const double cy = K(1, 2);
+  J(0, 0) = fx * dxd_dx / z;
+  J(0, 1) = fx * dxd_dy / z;
+  J(0, 2) = -fx * (dxd_dx * x + dxd_dy * y) / z;
+  J(1, 0) = fy * dyd_dx / z;
+  J(1, 1) = fy * dyd_dy / z;
+  J(1, 2) = -fy * (dyd_dx * x + dyd_dy * y) / z;
+
+  return Vec2{fx * s * x + cx, fy * s * y + cy};
+}
+
+/**
+ * Copy 2 rows of the stacked parameter Jacobian into the Ceres Jacobian
+ * blocks
+ */
+static void scatter_jacobian(const Mat2P &J, const int row, double **jacs) {
+  int offset = 0;
+  for (int b = 0; b < 6; b++) {
+    const int size = gimbal_calib_block_sizes[b];
+    if (jacs[b] != nullptr) {
+      for (int i = 0; i < 2; i++) {
+        for (int j = 0; j < size; j++) {
+          jacs[b][(row + i) * size + j] = J(i, offset + j);
+        }
+      }
+    }
+    offset += size;
+  }
+}
+
+GimbalCalibMeasurementResidual::GimbalCalibMeasurementResidual(
+    const MatX &P_s,
+    const MatX &P_d,
+    const MatX &Q_s,
+    const MatX &Q_d,
+    const Mat3 &K_s,
+    const Mat3 &K_d,
+    const Vec4 &D_s,
+    const Vec4 &D_d)
+    : P_s{P_s}, P_d{P_d}, Q_s{Q_s}, Q_d{Q_d}, K_s{K_s}, K_d{K_d}, D_s{D_s},
+      D_d{D_d} {
+  this->set_num_residuals(4 * P_s.rows());
+  for (int b = 0; b < 6; b++) {
+    this->mutable_parameter_block_sizes()->push_back(
+        gimbal_calib_block_sizes[b]);
+  }
+}
+
+GimbalCalibMeasurementResidual::~GimbalCalibMeasurementResidual() {}
+
+bool GimbalCalibMeasurementResidual::Evaluate(double const *const *params,
+                                              double *residuals,
+                                              double **jacobians) const {
+  // Seed every calibration parameter with its own derivative
+  ParamJet p[GIMBAL_CALIB_NB_PARAMS];
+  int k = 0;
+  for (int b = 0; b < 6; b++) {
+    for (int j = 0; j < gimbal_calib_block_sizes[b]; j++) {
+      p[k] = ParamJet(params[b][j], k);
+      k++;
+    }
+  }
+
+  // Form the transform from static to dynamic camera once for all corners,
+  // and its inverse
+  const Eigen::Matrix<ParamJet, 4, 4> T_ds =
+      this->chain.T_ds(&p[0], &p[6], &p[12], &p[15], &p[18], &p[19]);
+  const Eigen::Matrix<ParamJet, 3, 3> R_ds = T_ds.block(0, 0, 3, 3);
+  const Eigen::Matrix<ParamJet, 3, 1> t_ds = T_ds.block(0, 3, 3, 1);
+  const Eigen::Matrix<ParamJet, 3, 3> R_sd = R_ds.transpose();
+  const Eigen::Matrix<ParamJet, 3, 1> t_sd = -(R_sd * t_ds);
+  const ParamTransform ds{R_ds, t_ds};
+  const ParamTransform sd{R_sd, t_sd};
+
+  // Reprojection errors of every corner
+  Mat3P dX;
+  Mat3P *dX_ptr = (jacobians != nullptr) ? &dX : nullptr;
+  Eigen::Matrix<double, 2, 3> J_proj;
+  for (long i = 0; i < this->P_s.rows(); i++) {
+    double *r = residuals + 4 * i;
+
+    // Project 3D world point observed in dynamic camera to static camera
+    const Vec3 P_s_cal = sd.transform(this->P_d.row(i).transpose(), dX_ptr);
+    const Vec2 Q_s_cal =
+        project_equi_jacobian(this->K_s, this->D_s, P_s_cal, J_proj);
+    r[0] = this->Q_s(i, 0) - Q_s_cal(0);
+    r[1] = this->Q_s(i, 1) - Q_s_cal(1);
+    if (jacobians != nullptr) {
+      scatter_jacobian(-J_proj * dX, 4 * i, jacobians);
+    }
+
+    // Project 3D world point observed in static camera to dynamic camera
+    const Vec3 P_d_cal = ds.transform(this->P_s.row(i).transpose(), dX_ptr);
+    const Vec2 Q_d_cal =
+        project_equi_jacobian(this->K_d, this->D_d, P_d_cal, J_proj);
+    r[2] = this->Q_d(i, 0) - Q_d_cal(0);
+    r[3] = this->Q_d(i, 1) - Q_d_cal(1);
+    if (jacobians != nullptr) {
+      scatter_jacobian(-J_proj * dX, 4 * i + 2, jacobians);
+    }
+  }
+
+  return true;
+}
+
 Mat4 GimbalCalibNumericalResidual::T_ds(const VecX &tau_s,
                                         const double Lambda1,
                                         const Vec3 &w1,
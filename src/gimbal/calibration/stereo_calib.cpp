@@ -16,7 +16,7 @@ int StereoCalib::preprocessData(const std::string &data_path) {
   }
 
   // Get cam1 images
-  const std::string cam1_dir = data_path + "/cam0";
+  const std::string cam1_dir = data_path + "/cam1";
   std::vector<std::string> cam1_files;
   if (list_dir(cam1_dir, cam1_files) != 0) {
     LOG_ERROR("Failed to walk [%s]!", cam1_dir.c_str());
@@ -44,32 +44,59 @@ int StereoCalib::preprocessData(const std::string &data_path) {
   this->chessboard.square_size = 0.0285;
   this->chessboard.object_points = this->chessboard.createObjectPoints();
 
-  // Detect chessboard corners
-  for (size_t i = 0; i < cam0_files.size(); i++) {
+  // Open detection cache
+  DetectionCache cache;
+  if (this->cache_file.empty() == false) {
+    if (cache.open(this->cache_file) != 0) {
+      LOG_ERROR("Failed to open detection cache [%s]!",
+                this->cache_file.c_str());
+      return -1;
+    }
+    this->chessboard.cache = &cache;
+  }
+
+  // Detect chessboard corners from cam0 and cam1 on a worker pool, every
+  // task owns its own copy of the chessboard detector
+  const int nb_images = cam0_files.size();
+  const size_t nb_threads = (this->nb_workers > 0)
+                                ? this->nb_workers
+                                : std::thread::hardware_concurrency();
+  ThreadPool pool{nb_threads};
+  std::vector<Chessboard> chessboards(pool.size(), this->chessboard);
+  std::vector<std::vector<cv::Point2f>> corners0(nb_images);
+  std::vector<std::vector<cv::Point2f>> corners1(nb_images);
+  std::vector<cv::Size> image_sizes(nb_images);
+  std::vector<int> detected(nb_images, 0);
+
+  pool.parallelForDynamic(0, nb_images, [&](int task, int i) {
     // Load images
     const std::string img0_file = data_path + "/cam0/" + cam0_files[i];
     const std::string img1_file = data_path + "/cam1/" + cam1_files[i];
     const cv::Mat img0 = cv::imread(img0_file);
     const cv::Mat img1 = cv::imread(img1_file);
-    this->image_size = cv::Size(img0.cols, img0.rows);
-    std::cout << "Loading file [" << img0_file.c_str() << "]" << std::endl;
-    std::cout << "Loading file [" << img1_file.c_str() << "]" << std::endl;
+    image_sizes[i] = cv::Size(img0.cols, img0.rows);
 
     // Detect chessboard corners from cam0 and cam1
-    int retval = 0;
-    std::vector<cv::Point2f> corners0, corners1;
-    retval = this->chessboard.detect(img1, corners1);
-    retval = this->chessboard.detect(img0, corners0);
-    if (retval != 0) {
-      LOG_ERROR("Failed to detect chessboard in both images [%d]!", (int) i);
-      continue;
+    Chessboard &chessboard = chessboards[task];
+    if (chessboard.detect(img0, corners0[i]) != 0 ||
+        chessboard.detect(img1, corners1[i]) != 0) {
+      LOG_ERROR("Failed to detect chessboard in both images [%d]!", i);
+      return;
     }
+    detected[i] = 1;
+  });
 
-    // Update book keeping
+  // Update book keeping in image order
+  for (int i = 0; i < nb_images; i++) {
+    this->image_size = image_sizes[i];
+    if (detected[i] == 0) {
+      continue;
+    }
     this->object_points.push_back(this->chessboard.object_points);
-    this->imgpts0.push_back(corners0);
-    this->imgpts1.push_back(corners1);
+    this->imgpts0.push_back(corners0[i]);
+    this->imgpts1.push_back(corners1[i]);
   }
+  this->chessboard.cache = nullptr;
 
   // cv::Mat image_rgb = image.clone();
   // this->chessboard.drawCorners(image_rgb);
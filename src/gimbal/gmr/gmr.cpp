@@ -8,208 +8,226 @@ GMR::GMR() {
   alpha = 0.99f;
   delta = 0.1f;
   spcounta = 0;
+  analyzed = false;
+
+  refine_iterations = 2;
+  lab_threshold = 2.0f;
+  nb_changed = 0;
+  graph_reused = false;
+  session = false;
 }
 
 GMR::~GMR() {}
 
-cv::Mat GMR::GetSup(const cv::Mat &image) {
-  int width = image.cols;
-  int height = image.rows;
-  int sz = width * height;
-  UINT *img = new UINT[sz * 3];
-  for (int c = 0; c < 3; c++) {
-    for (int i = 0; i < width; i++) {
-      for (int j = 0; j < height; j++)
-
-        img[c * (width * height) + i * height + j] =
-            cv::saturate_cast<unsigned int>(image.at<cv::Vec3b>(j, i)[2 - c]);
-    }
-  }
-  int *labels = new int[sz];
-
-  SLIC slic;
-  slic.DoSuperpixelSegmentation_ForGivenNumberOfSuperpixels(img,
-                                                            height,
-                                                            width,
-                                                            labels,
-                                                            spcounta,
-                                                            spcount,
-                                                            compactness);
-
-  cv::Mat supLab(image.size(), CV_16U);
-  for (int i = 0; i < supLab.rows; i++) {
-    for (int j = 0; j < supLab.cols; j++) {
-      supLab.at<ushort>(i, j) = labels[i + j * supLab.rows];
-    }
+cv::Mat GMR::GetSup(const cv::Mat &image, bool refine) {
+  slic.nb_superpixels = spcount;
+  slic.compactness = compactness;
+
+  cv::Mat labels;
+  int retval = 0;
+  if (refine)
+    retval = slic.refine(image, labels, spcounta, refine_iterations);
+  else
+    retval = slic.segment(image, labels, spcounta);
+  if (retval != 0) {
+    spcounta = 0;
+    return cv::Mat(image.size(), CV_16U, cv::Scalar(0));
   }
 
-  if (labels)
-    delete[] labels;
-  if (img)
-    delete[] img;
-
+  cv::Mat supLab;
+  labels.convertTo(supLab, CV_16U);
   return supLab;
 }
 
-cv::Mat GMR::GetAdjLoop(const cv::Mat &supLab) {
-  cv::Mat adj(cv::Size(spcounta, spcounta), CV_16U, cv::Scalar(0));
+GMR::AdjList GMR::GetAdjLoop(const cv::Mat &supLab) {
+  AdjList adj(spcounta);
+  auto link = [&adj](const ushort i, const ushort j) {
+    if (i != j) {
+      adj[i].push_back(j);
+      adj[j].push_back(i);
+    }
+  };
+
+  // Superpixels touching each other
   for (int i = 0; i < supLab.rows - 1; i++) {
+    const ushort *row0 = supLab.ptr<ushort>(i);
+    const ushort *row1 = supLab.ptr<ushort>(i + 1);
     for (int j = 0; j < supLab.cols - 1; j++) {
-      if (supLab.at<ushort>(i, j) != supLab.at<ushort>(i + 1, j)) {
-        adj.at<ushort>(supLab.at<ushort>(i, j), supLab.at<ushort>(i + 1, j)) =
-            1;
-        adj.at<ushort>(supLab.at<ushort>(i + 1, j), supLab.at<ushort>(i, j)) =
-            1;
-      }
-      if (supLab.at<ushort>(i, j) != supLab.at<ushort>(i, j + 1)) {
-        adj.at<ushort>(supLab.at<ushort>(i, j), supLab.at<ushort>(i, j + 1)) =
-            1;
-        adj.at<ushort>(supLab.at<ushort>(i, j + 1), supLab.at<ushort>(i, j)) =
-            1;
-      }
-      if (supLab.at<ushort>(i, j) != supLab.at<ushort>(i + 1, j + 1)) {
-        adj.at<ushort>(supLab.at<ushort>(i, j),
-                       supLab.at<ushort>(i + 1, j + 1)) = 1;
-        adj.at<ushort>(supLab.at<ushort>(i + 1, j + 1),
-                       supLab.at<ushort>(i, j)) = 1;
-      }
-      if (supLab.at<ushort>(i + 1, j) != supLab.at<ushort>(i, j + 1)) {
-        adj.at<ushort>(supLab.at<ushort>(i + 1, j),
-                       supLab.at<ushort>(i, j + 1)) = 1;
-        adj.at<ushort>(supLab.at<ushort>(i, j + 1),
-                       supLab.at<ushort>(i + 1, j)) = 1;
-      }
+      link(row0[j], row1[j]);
+      link(row0[j], row0[j + 1]);
+      link(row0[j], row1[j + 1]);
+      link(row1[j], row0[j + 1]);
     }
   }
-  vector<ushort> bd;
-  vector<ushort>::iterator result;
-  for (int i = 0; i < supLab.cols; i++) {
-    result = find(bd.begin(), bd.end(), supLab.at<ushort>(0, i));
-    if (result == bd.end())
-      bd.push_back(supLab.at<ushort>(0, i));
-  }
+
+  // Superpixels on the image boundary
+  vector<bool> is_bd(spcounta, false);
   for (int i = 0; i < supLab.cols; i++) {
-    result = find(bd.begin(), bd.end(), supLab.at<ushort>(supLab.rows - 1, i));
-    if (result == bd.end())
-      bd.push_back(supLab.at<ushort>(supLab.rows - 1, i));
+    is_bd[supLab.at<ushort>(0, i)] = true;
+    is_bd[supLab.at<ushort>(supLab.rows - 1, i)] = true;
   }
   for (int i = 0; i < supLab.rows; i++) {
-    result = find(bd.begin(), bd.end(), supLab.at<ushort>(i, 0));
-    if (result == bd.end())
-      bd.push_back(supLab.at<ushort>(i, 0));
+    is_bd[supLab.at<ushort>(i, 0)] = true;
+    is_bd[supLab.at<ushort>(i, supLab.cols - 1)] = true;
   }
-  for (int i = 0; i < supLab.rows; i++) {
-    result = find(bd.begin(), bd.end(), supLab.at<ushort>(i, supLab.cols - 1));
-    if (result == bd.end())
-      bd.push_back(supLab.at<ushort>(i, supLab.cols - 1));
+  vector<int> bd;
+  for (int i = 0; i < spcounta; i++) {
+    if (is_bd[i])
+      bd.push_back(i);
   }
-  vector<ushort>::iterator bdi = bd.begin();
-  vector<ushort>::iterator bdj;
-  for (; bdi != bd.end(); bdi++) {
-    for (bdj = bdi + 1; bdj != bd.end(); bdj++) {
-      adj.at<ushort>(*bdi, *bdj) = 1;
-      adj.at<ushort>(*bdj, *bdi) = 1;
+  for (size_t i = 0; i < bd.size(); i++) {
+    for (size_t j = i + 1; j < bd.size(); j++) {
+      link(bd[i], bd[j]);
     }
   }
 
+  // Remove duplicates
+  for (auto &nbrs : adj) {
+    sort(nbrs.begin(), nbrs.end());
+    nbrs.erase(unique(nbrs.begin(), nbrs.end()), nbrs.end());
+  }
+
   return adj;
 }
 
-cv::Mat GMR::GetWeight(const cv::Mat &img,
-                       const cv::Mat &supLab,
-                       const cv::Mat &adj) {
-  vector<float> supL(spcounta, 0);
-  vector<float> supa(spcounta, 0);
-  vector<float> supb(spcounta, 0);
+vector<cv::Vec3f> GMR::GetSupMean(const cv::Mat &img,
+                                  const cv::Mat &supLab) {
+  vector<cv::Vec3f> supmean(spcounta, cv::Vec3f(0, 0, 0));
   vector<float> pcount(spcounta, 0);
   for (int i = 0; i < img.rows; i++) {
-    const float *labp = img.ptr<float>(i);
-    for (int j = 0; j < img.cols; j++, labp += 3) {
-      supL[supLab.at<ushort>(i, j)] += labp[0];
-      supa[supLab.at<ushort>(i, j)] += labp[1];
-      supb[supLab.at<ushort>(i, j)] += labp[2];
-      pcount[supLab.at<ushort>(i, j)] += 1.;
+    const cv::Vec3f *labp = img.ptr<cv::Vec3f>(i);
+    const ushort *sup = supLab.ptr<ushort>(i);
+    for (int j = 0; j < img.cols; j++) {
+      supmean[sup[j]] += labp[j];
+      pcount[sup[j]] += 1.;
     }
   }
   for (int i = 0; i < spcounta; i++) {
-    supL[i] /= pcount[i];
-    supa[i] /= pcount[i];
-    supb[i] /= pcount[i];
+    supmean[i] /= pcount[i];
   }
-  cv::Mat w(adj.size(), CV_32F, cv::Scalar(-1));
-  float minw = (float) numeric_limits<float>::max(),
-        maxw = (float) numeric_limits<float>::min();
+  return supmean;
+}
+
+void GMR::GetEdges(const AdjList &adj) {
+  // Connect each superpixel to its neighbours and its neighbours' neighbours
+  edges.clear();
+  vector<int> visited(spcounta, -1);
   for (int i = 0; i < spcounta; i++) {
-    for (int j = 0; j < spcounta; j++) {
-      if (adj.at<ushort>(i, j) == 1) {
-        float dist =
-            sqrt(pow((supL[i] - supL[j]), 2) + pow((supa[i] - supa[j]), 2) +
-                 pow((supb[i] - supb[j]), 2));
-        w.at<float>(i, j) = dist;
-        if (minw > dist)
-          minw = dist;
-        if (maxw < dist)
-          maxw = dist;
-        for (int k = 0; k < spcounta; k++) {
-          if (adj.at<ushort>(j, k) == 1 && k != i) {
-            float dist =
-                sqrt(pow((supL[i] - supL[k]), 2) + pow((supa[i] - supa[k]), 2) +
-                     pow((supb[i] - supb[k]), 2));
-            w.at<float>(i, k) = dist;
-            if (minw > dist)
-              minw = dist;
-            if (maxw < dist)
-              maxw = dist;
-          }
-        }
+    visited[i] = i;
+    for (const int j : adj[i]) {
+      for (int h = -1; h < (int) adj[j].size(); h++) {
+        const int k = (h < 0) ? j : adj[j][h];
+        if (visited[k] == i)
+          continue;
+        visited[k] = i;
+        edges.emplace_back(i, k);
       }
     }
   }
-  for (int i = 0; i < spcounta; i++) {
-    for (int j = 0; j < spcounta; j++) {
-      if (w.at<float>(i, j) > -1)
-        w.at<float>(i, j) =
-            exp(-(w.at<float>(i, j) - minw) / ((maxw - minw) * delta));
-      else
-        w.at<float>(i, j) = 0;
-    }
+
+  edge_dist.resize(edges.size());
+  for (size_t e = 0; e < edges.size(); e++) {
+    edge_dist[e] = cv::norm(supmean[edges[e].first] - supmean[edges[e].second]);
+  }
+}
+
+GMR::SpMat GMR::GetWeight() {
+  float minw = (float) numeric_limits<float>::max(),
+        maxw = (float) numeric_limits<float>::min();
+  for (const float dist : edge_dist) {
+    if (minw > dist)
+      minw = dist;
+    if (maxw < dist)
+      maxw = dist;
   }
+
+  const float range = (maxw > minw) ? (maxw - minw) : 1.0f;
+  vector<Eigen::Triplet<double>> triplets;
+  triplets.reserve(edges.size());
+  for (size_t e = 0; e < edges.size(); e++) {
+    const double w = exp(-(edge_dist[e] - minw) / (range * delta));
+    triplets.emplace_back(edges[e].first, edges[e].second, w);
+  }
+
+  SpMat w(spcounta, spcounta);
+  w.setFromTriplets(triplets.begin(), triplets.end());
   return w;
 }
 
-cv::Mat GMR::GetOptAff(const cv::Mat &W) {
-
-  cv::Mat dd(cv::Size(W.rows, 1), CV_32F);
-  reduce(W, dd, 1, CV_REDUCE_SUM);
-  cv::Mat D(W.size(), CV_32F);
-  D = cv::Mat::diag(dd);
-  cv::Mat optAff(W.size(), CV_32F);
-  optAff = (D - alpha * W);
-  optAff = optAff.inv();
-  cv::Mat B = cv::Mat::ones(optAff.size(), CV_32F) -
-              cv::Mat::eye(optAff.size(), CV_32F);
-  optAff = optAff.mul(B);
-  return optAff;
+int GMR::GetOptAff(const SpMat &W) {
+  // A = D - alpha * W
+  const Eigen::VectorXd dd = W * Eigen::VectorXd::Ones(W.cols());
+  SpMat D(W.rows(), W.cols());
+  D.reserve(Eigen::VectorXi::Constant(W.cols(), 1));
+  for (int i = 0; i < W.rows(); i++) {
+    D.insert(i, i) = dd(i);
+  }
+  SpMat optAff = D - alpha * W;
+  optAff.makeCompressed();
+
+  // Reuse symbolic factorization if the sparsity pattern is unchanged
+  const bool same_pattern =
+      analyzed && optAff.rows() == A.rows() &&
+      optAff.nonZeros() == A.nonZeros() &&
+      equal(optAff.outerIndexPtr(),
+            optAff.outerIndexPtr() + optAff.outerSize() + 1,
+            A.outerIndexPtr()) &&
+      equal(optAff.innerIndexPtr(),
+            optAff.innerIndexPtr() + optAff.nonZeros(),
+            A.innerIndexPtr());
+  A = optAff;
+  if (same_pattern == false) {
+    ldlt.analyzePattern(A);
+    analyzed = true;
+  }
+  ldlt.factorize(A);
+  Ainv_diag.assign(A.rows(), -1.0);
+
+  if (ldlt.info() != Eigen::Success) {
+    analyzed = false;
+    return -1;
+  }
+  return 0;
+}
+
+Eigen::VectorXd GMR::Rank(const Eigen::VectorXd &y) {
+  Eigen::VectorXd f = ldlt.solve(y);
+
+  // Remove self-affinity of the query nodes, only the diagonal entries of
+  // A^-1 that are needed are computed
+  Eigen::VectorXd e = Eigen::VectorXd::Zero(y.size());
+  for (int i = 0; i < y.size(); i++) {
+    if (y(i) == 0.0)
+      continue;
+    if (Ainv_diag[i] < 0.0) {
+      e(i) = 1.0;
+      Ainv_diag[i] = ldlt.solve(e)(i);
+      e(i) = 0.0;
+    }
+    f(i) -= Ainv_diag[i] * y(i);
+  }
+
+  return f;
 }
 
-cv::Mat GMR::GetBdQuery(const cv::Mat &supLab, int type) {
-  cv::Mat y(cv::Size(1, spcounta), CV_32F, cv::Scalar(0));
+Eigen::VectorXd GMR::GetBdQuery(const cv::Mat &supLab, int type) {
+  Eigen::VectorXd y = Eigen::VectorXd::Zero(spcounta);
   switch (type) {
     case 1:
       for (int i = 0; i < supLab.cols; i++)
-        y.at<float>(supLab.at<ushort>(0, i)) = 1;
+        y(supLab.at<ushort>(0, i)) = 1;
       break;
     case 2:
       for (int i = 0; i < supLab.cols; i++)
-        y.at<float>(supLab.at<ushort>(supLab.rows - 1, i)) = 1;
+        y(supLab.at<ushort>(supLab.rows - 1, i)) = 1;
       break;
     case 3:
       for (int i = 0; i < supLab.rows; i++)
-        y.at<float>(supLab.at<ushort>(i, 0)) = 1;
+        y(supLab.at<ushort>(i, 0)) = 1;
       break;
     case 4:
       for (int i = 0; i < supLab.rows; i++)
-        y.at<float>(supLab.at<ushort>(i, supLab.cols - 1)) = 1;
+        y(supLab.at<ushort>(i, supLab.cols - 1)) = 1;
       break;
     default: printf("error");
   }
@@ -295,6 +313,49 @@ cv::Mat GMR::RemoveFrame(const cv::Mat &img, int *wcut) {
   return outimg;
 }
 
+Eigen::VectorXd GMR::GetRanking(const cv::Mat &supLab) {
+  if (GetOptAff(GetWeight()) != 0)
+    return Eigen::VectorXd::Zero(spcounta);
+
+  // Rank against each image boundary, normalized to [0, 1]
+  Eigen::VectorXd salb = Eigen::VectorXd::Ones(spcounta);
+  for (int type = 1; type <= 4; type++) {
+    const Eigen::VectorXd f = Rank(GetBdQuery(supLab, type));
+    const double fmin = f.minCoeff();
+    const double frange = f.maxCoeff() - fmin;
+    Eigen::VectorXd sal = Eigen::VectorXd::Zero(spcounta);
+    if (frange > 0)
+      sal = (f.array() - fmin) / frange;
+    salb = salb.cwiseProduct(Eigen::VectorXd::Ones(spcounta) - sal);
+  }
+
+  // Rank against the foreground
+  double thr = salb.mean();
+  Eigen::VectorXd fgy = (salb.array() > thr).cast<double>();
+  return Rank(fgy);
+}
+
+cv::Mat GMR::GetSalMap(const cv::Mat &supLab,
+                       const Eigen::VectorXd &f,
+                       const int *wcut) {
+  cv::Mat salMap(supLab.size(), CV_32F);
+  for (int i = 0; i < salMap.rows; i++) {
+    const ushort *sup = supLab.ptr<ushort>(i);
+    float *sal = salMap.ptr<float>(i);
+    for (int j = 0; j < salMap.cols; j++) {
+      sal[j] = f(sup[j]);
+    }
+  }
+
+  normalize(salMap, salMap, 0, 1, cv::NORM_MINMAX);
+
+  cv::Mat outMap(cv::Size(wcut[1], wcut[0]), CV_32F, cv::Scalar(0));
+  cv::Mat subMap =
+      outMap(cv::Range(wcut[2], wcut[3]), cv::Range(wcut[4], wcut[5]));
+  salMap.convertTo(subMap, subMap.type());
+  return outMap;
+}
+
 cv::Mat GMR::GetSal(cv::Mat &img) {
 
   int wcut[6];
@@ -302,70 +363,80 @@ cv::Mat GMR::GetSal(cv::Mat &img) {
 
   cv::Mat suplabel(img.size(), CV_16U);
   suplabel = GetSup(img);
+  if (spcounta <= 1)
+    return cv::Mat(cv::Size(wcut[1], wcut[0]), CV_32F, cv::Scalar(0));
 
-  cv::Mat adj(cv::Size(spcounta, spcounta), CV_16U);
-  adj = GetAdjLoop(suplabel);
-
-  cv::Mat tImg;
-  img.convertTo(tImg, CV_32FC3, 1.0 / 255);
-  cvtColor(tImg, tImg, CV_BGR2Lab);
+  AdjList adj = GetAdjLoop(suplabel);
 
-  cv::Mat W(adj.size(), CV_32F);
-  W = GetWeight(tImg, suplabel, adj);
+  // The superpixel engine already converted the image to CIELAB
+  supmean = GetSupMean(slic.lab, suplabel);
+  GetEdges(adj);
 
-  cv::Mat optAff(W.size(), CV_32F);
-  optAff = GetOptAff(W);
+  // The frame is not tracked by a session
+  session = false;
 
-  cv::Mat salt, sald, sall, salr;
-  cv::Mat bdy;
-
-  bdy = GetBdQuery(suplabel, 1);
-  salt = optAff * bdy;
-  normalize(salt, salt, 0, 1, cv::NORM_MINMAX);
-  salt = 1 - salt;
-
-  bdy = GetBdQuery(suplabel, 2);
-  sald = optAff * bdy;
-  normalize(sald, sald, 0, 1, cv::NORM_MINMAX);
-  sald = 1 - sald;
-
-  bdy = GetBdQuery(suplabel, 3);
-  sall = optAff * bdy;
-  normalize(sall, sall, 0, 1, cv::NORM_MINMAX);
-  sall = 1 - sall;
+  return GetSalMap(suplabel, GetRanking(suplabel), wcut);
+}
 
-  bdy = GetBdQuery(suplabel, 4);
-  salr = optAff * bdy;
-  normalize(salr, salr, 0, 1, cv::NORM_MINMAX);
-  salr = 1 - salr;
+cv::Mat GMR::Update(cv::Mat &img) {
 
-  cv::Mat salb;
-  salb = salt;
-  salb = salb.mul(sald);
-  salb = salb.mul(sall);
-  salb = salb.mul(salr);
+  int wcut[6];
+  img = RemoveFrame(img, wcut);
 
-  double thr = mean(salb)[0];
-  cv::Mat fgy;
-  threshold(salb, fgy, thr, 1, cv::THRESH_BINARY);
+  // Superpixels, seeds carry over from the previous frame
+  const bool resume = session && img.size() == session_size;
+  cv::Mat suplabel = GetSup(img, resume);
+  if (spcounta <= 1) {
+    Reset();
+    return cv::Mat(cv::Size(wcut[1], wcut[0]), CV_32F, cv::Scalar(0));
+  }
 
-  cv::Mat salf;
-  salf = optAff * fgy;
+  AdjList adj = GetAdjLoop(suplabel);
+  const vector<cv::Vec3f> mean = GetSupMean(slic.lab, suplabel);
+
+  // Graph changed, rebuild
+  if (resume == false || adj != session_adj) {
+    supmean = mean;
+    GetEdges(adj);
+    salf = GetRanking(suplabel);
+    session_adj.swap(adj);
+    session_size = img.size();
+    session = true;
+    nb_changed = spcounta;
+    graph_reused = false;
+    return GetSalMap(suplabel, salf, wcut);
+  }
 
-  cv::Mat salMap(img.size(), CV_32F);
-  for (int i = 0; i < salMap.rows; i++) {
-    for (int j = 0; j < salMap.cols; j++) {
-      salMap.at<float>(i, j) = salf.at<float>(suplabel.at<ushort>(i, j));
+  // Same graph, only update the edges of superpixels whose colour changed
+  vector<bool> changed(spcounta, false);
+  nb_changed = 0;
+  for (int i = 0; i < spcounta; i++) {
+    if (cv::norm(mean[i] - supmean[i]) > lab_threshold) {
+      supmean[i] = mean[i];
+      changed[i] = true;
+      nb_changed++;
+    }
+  }
+  graph_reused = true;
+
+  if (nb_changed > 0) {
+    for (size_t e = 0; e < edges.size(); e++) {
+      const int i = edges[e].first;
+      const int k = edges[e].second;
+      if (changed[i] || changed[k])
+        edge_dist[e] = cv::norm(supmean[i] - supmean[k]);
     }
+    salf = GetRanking(suplabel);
   }
 
-  normalize(salMap, salMap, 0, 1, cv::NORM_MINMAX);
+  return GetSalMap(suplabel, salf, wcut);
+}
 
-  cv::Mat outMap(cv::Size(wcut[1], wcut[0]), CV_32F, cv::Scalar(0));
-  cv::Mat subMap =
-      outMap(cv::Range(wcut[2], wcut[3]), cv::Range(wcut[4], wcut[5]));
-  salMap.convertTo(subMap, subMap.type());
-  return outMap;
+void GMR::Reset() {
+  session = false;
+  session_adj.clear();
+  nb_changed = 0;
+  graph_reused = false;
 }
 
 } // namespace gvio
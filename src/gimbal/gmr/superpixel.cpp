@@ -0,0 +1,437 @@
+#include "gvio/gimbal/gmr/superpixel.hpp"
+
+namespace gvio {
+
+// CIE standard
+#define LAB_EPSILON 0.008856f
+#define LAB_KAPPA 903.3f
+
+// D65 reference white
+#define LAB_XR 0.950456f
+#define LAB_YR 1.0f
+#define LAB_ZR 1.088754f
+
+SuperpixelSLIC::SuperpixelSLIC() {
+  // sRGB gamma expansion
+  for (int i = 0; i < 256; i++) {
+    const double c = i / 255.0;
+    if (c <= 0.04045) {
+      this->gamma_lut[i] = c / 12.92;
+    } else {
+      this->gamma_lut[i] = pow((c + 0.055) / 1.055, 2.4);
+    }
+  }
+
+  // Cube-root, interpolated linearly between entries
+  for (int i = 0; i <= SLIC_CBRT_LUT_SIZE; i++) {
+    this->cbrt_lut[i] = cbrt((double) i / SLIC_CBRT_LUT_SIZE);
+  }
+}
+
+int SuperpixelSLIC::convertLab(const cv::Mat &image) {
+  if (image.type() != CV_8UC3) {
+    LOG_ERROR("Expected a CV_8UC3 BGR image!");
+    return -1;
+  }
+  this->lab.create(image.size(), CV_32FC3);
+
+  // Lab transfer function f(t)
+  const float *cbrt_lut = this->cbrt_lut;
+  auto f = [cbrt_lut](const float t) {
+    if (t <= LAB_EPSILON) {
+      return (LAB_KAPPA * t + 16.0f) / 116.0f;
+    }
+
+    const float pos = std::min(t, 1.0f) * SLIC_CBRT_LUT_SIZE;
+    const int i = std::min((int) pos, SLIC_CBRT_LUT_SIZE - 1);
+    const float frac = pos - i;
+    return cbrt_lut[i] + frac * (cbrt_lut[i + 1] - cbrt_lut[i]);
+  };
+
+  this->forEachBand(image.rows, [&](int band, int start, int stop) {
+    UNUSED(band);
+
+    for (int row = start; row < stop; row++) {
+      const uchar *bgr = image.ptr<uchar>(row);
+      float *lab = this->lab.ptr<float>(row);
+
+      for (int col = 0; col < image.cols; col++, bgr += 3, lab += 3) {
+        const float b = this->gamma_lut[bgr[0]];
+        const float g = this->gamma_lut[bgr[1]];
+        const float r = this->gamma_lut[bgr[2]];
+
+        // sRGB to XYZ
+        const float X = r * 0.4124564f + g * 0.3575761f + b * 0.1804375f;
+        const float Y = r * 0.2126729f + g * 0.7151522f + b * 0.0721750f;
+        const float Z = r * 0.0193339f + g * 0.1191920f + b * 0.9503041f;
+
+        // XYZ to Lab
+        const float fx = f(X / LAB_XR);
+        const float fy = f(Y / LAB_YR);
+        const float fz = f(Z / LAB_ZR);
+        lab[0] = 116.0f * fy - 16.0f;
+        lab[1] = 500.0f * (fx - fy);
+        lab[2] = 200.0f * (fy - fz);
+      }
+    }
+  });
+
+  return 0;
+}
+
+int SuperpixelSLIC::segment(const cv::Mat &image,
+                            cv::Mat &labels,
+                            int &nb_labels) {
+  // Pre-check
+  if (image.empty()) {
+    LOG_ERROR("Image is empty!");
+    return -1;
+  } else if (this->nb_superpixels <= 0) {
+    LOG_ERROR("Invalid number of superpixels [%d]!", this->nb_superpixels);
+    return -1;
+  }
+
+  // Convert to CIELAB
+  if (this->convertLab(image) != 0) {
+    return -1;
+  }
+
+  // Step size between seeds
+  this->step = this->seedStep(image.size());
+
+  // Cluster
+  this->klabels.create(image.size(), CV_32SC1);
+  this->klabels.setTo(-1);
+  this->dist.create(image.size(), CV_32FC1);
+  this->initSeeds(this->step);
+  for (int i = 0; i < this->max_iterations; i++) {
+    this->iterate(this->step);
+  }
+
+  // Post-process
+  nb_labels = this->enforceConnectivity(this->step, labels);
+
+  return 0;
+}
+
+int SuperpixelSLIC::refine(const cv::Mat &image,
+                           cv::Mat &labels,
+                           int &nb_labels,
+                           const int nb_iterations) {
+  // No previous segmentation to start from, or the number of superpixels
+  // changed so the previous seeds are spaced for a different step size
+  if (this->seeds.empty() || this->step <= 0 ||
+      this->klabels.size() != image.size() || this->nb_superpixels <= 0 ||
+      this->seedStep(image.size()) != this->step) {
+    return this->segment(image, labels, nb_labels);
+  }
+
+  // Convert to CIELAB
+  if (this->convertLab(image) != 0) {
+    return -1;
+  }
+
+  // Cluster, the first assignment uses the previous frame's seeds
+  for (int i = 0; i < nb_iterations; i++) {
+    this->iterate(this->step);
+  }
+
+  // Post-process
+  nb_labels = this->enforceConnectivity(this->step, labels);
+
+  return 0;
+}
+
+void SuperpixelSLIC::forEachBand(
+    const int rows, const std::function<void(int, int, int)> &func) {
+  const int nb_threads = (this->thread_pool) ? this->thread_pool->size() : 1;
+  const int nb_bands = std::max(1, std::min(nb_threads, rows));
+  const int band_size = rows / nb_bands;
+  const int remainder = rows % nb_bands;
+  if (this->band_sums.size() != (size_t) nb_bands) {
+    this->band_sums.resize(nb_bands);
+  }
+
+  auto run = [&](const int band) {
+    const int start = band * band_size + std::min(band, remainder);
+    const int stop = start + band_size + ((band < remainder) ? 1 : 0);
+    func(band, start, stop);
+  };
+
+  if (nb_bands == 1) {
+    run(0);
+    return;
+  }
+
+  // One band per task, so each band knows its own index
+  this->thread_pool->parallelFor(0,
+                                 nb_bands,
+                                 [&](int begin, int end) {
+                                   for (int band = begin; band < end; band++) {
+                                     run(band);
+                                   }
+                                 },
+                                 nb_bands);
+}
+
+int SuperpixelSLIC::seedStep(const cv::Size &size) const {
+  const double sz = size.height * size.width;
+  const int superpixel_size = 0.5 + sz / this->nb_superpixels;
+  return std::max(1, (int) (sqrt(superpixel_size) + 0.5));
+}
+
+void SuperpixelSLIC::initSeeds(const int step) {
+  const int width = this->lab.cols;
+  const int height = this->lab.rows;
+
+  // Uniform grid, residual pixels are spread evenly between strips
+  int xstrips = 0.5 + (double) width / step;
+  int ystrips = 0.5 + (double) height / step;
+  int xerr = width - step * xstrips;
+  if (xerr < 0) {
+    xstrips--;
+    xerr = width - step * xstrips;
+  }
+  int yerr = height - step * ystrips;
+  if (yerr < 0) {
+    ystrips--;
+    yerr = height - step * ystrips;
+  }
+  xstrips = std::max(xstrips, 1);
+  ystrips = std::max(ystrips, 1);
+  const double xerr_per_strip = (double) xerr / xstrips;
+  const double yerr_per_strip = (double) yerr / ystrips;
+  const int offset = step / 2;
+
+  this->seeds.resize(xstrips * ystrips);
+  int n = 0;
+  for (int y = 0; y < ystrips; y++) {
+    const int ye = y * yerr_per_strip;
+    for (int x = 0; x < xstrips; x++) {
+      const int xe = x * xerr_per_strip;
+      int col = std::min(x * step + offset + xe, width - 1);
+      int row = std::min(y * step + offset + ye, height - 1);
+
+      // Move seed to the lowest gradient position in its 3x3 neighbourhood
+      if (this->perturb_seeds) {
+        const int dx8[8] = {-1, -1, 0, 1, 1, 1, 0, -1};
+        const int dy8[8] = {0, -1, -1, -1, 0, 1, 1, 1};
+        const int col0 = col;
+        const int row0 = row;
+        float min_grad = this->gradient(row0, col0);
+
+        for (int i = 0; i < 8; i++) {
+          const int nx = col0 + dx8[i];
+          const int ny = row0 + dy8[i];
+          if (nx < 0 || nx >= width || ny < 0 || ny >= height) {
+            continue;
+          }
+
+          const float grad = this->gradient(ny, nx);
+          if (grad < min_grad) {
+            min_grad = grad;
+            col = nx;
+            row = ny;
+          }
+        }
+      }
+
+      const float *lab = this->lab.ptr<float>(row) + 3 * col;
+      SLICSeed &seed = this->seeds[n++];
+      seed.l = lab[0];
+      seed.a = lab[1];
+      seed.b = lab[2];
+      seed.x = col;
+      seed.y = row;
+    }
+  }
+}
+
+float SuperpixelSLIC::gradient(const int row, const int col) const {
+  if (row < 1 || row >= this->lab.rows - 1 || col < 1 ||
+      col >= this->lab.cols - 1) {
+    return 0.0f;
+  }
+
+  const float *left = this->lab.ptr<float>(row) + 3 * (col - 1);
+  const float *right = left + 6;
+  const float *up = this->lab.ptr<float>(row - 1) + 3 * col;
+  const float *down = this->lab.ptr<float>(row + 1) + 3 * col;
+
+  float dx = 0.0f;
+  float dy = 0.0f;
+  for (int i = 0; i < 3; i++) {
+    dx += (left[i] - right[i]) * (left[i] - right[i]);
+    dy += (up[i] - down[i]) * (up[i] - down[i]);
+  }
+
+  return dx * dx + dy * dy;
+}
+
+void SuperpixelSLIC::iterate(const int step) {
+  const int width = this->lab.cols;
+  const int height = this->lab.rows;
+  const int nb_seeds = this->seeds.size();
+  const float inv_wt = 1.0 / ((step / this->compactness) *
+                              (step / this->compactness));
+
+  // Assign pixels to seeds and accumulate seed sums. Each band only writes
+  // its own rows of `dist` and `klabels` and its own seed sums.
+  this->forEachBand(height, [&](int band, int start, int stop) {
+    for (int row = start; row < stop; row++) {
+      float *dist = this->dist.ptr<float>(row);
+      std::fill(dist, dist + width, FLT_MAX);
+    }
+
+    for (int n = 0; n < nb_seeds; n++) {
+      const SLICSeed &seed = this->seeds[n];
+      const int y1 = std::max((float) start, std::max(0.0f, seed.y - step));
+      const int y2 = std::min((float) stop, seed.y + step);
+      const int x1 = std::max(0.0f, seed.x - step);
+      const int x2 = std::min((float) width, seed.x + step);
+
+      for (int row = y1; row < y2; row++) {
+        const float *lab = this->lab.ptr<float>(row) + 3 * x1;
+        float *dist = this->dist.ptr<float>(row);
+        int *label = this->klabels.ptr<int>(row);
+        const float dy = row - seed.y;
+
+        for (int col = x1; col < x2; col++, lab += 3) {
+          const float dl = lab[0] - seed.l;
+          const float da = lab[1] - seed.a;
+          const float db = lab[2] - seed.b;
+          const float dx = col - seed.x;
+          const float d = dl * dl + da * da + db * db +
+                          (dx * dx + dy * dy) * inv_wt;
+          if (d < dist[col]) {
+            dist[col] = d;
+            label[col] = n;
+          }
+        }
+      }
+    }
+
+    std::vector<SLICSeedSum> &sums = this->band_sums[band];
+    sums.assign(nb_seeds, SLICSeedSum());
+    for (int row = start; row < stop; row++) {
+      const float *lab = this->lab.ptr<float>(row);
+      const int *label = this->klabels.ptr<int>(row);
+
+      for (int col = 0; col < width; col++, lab += 3) {
+        if (label[col] < 0) {
+          continue;
+        }
+
+        SLICSeedSum &sum = sums[label[col]];
+        sum.l += lab[0];
+        sum.a += lab[1];
+        sum.b += lab[2];
+        sum.x += col;
+        sum.y += row;
+        sum.n++;
+      }
+    }
+  });
+
+  // Reduce seed sums and move seeds to their centroids, seeds without any
+  // pixels are left where they are
+  for (int n = 0; n < nb_seeds; n++) {
+    SLICSeedSum total;
+    for (const auto &sums : this->band_sums) {
+      total.l += sums[n].l;
+      total.a += sums[n].a;
+      total.b += sums[n].b;
+      total.x += sums[n].x;
+      total.y += sums[n].y;
+      total.n += sums[n].n;
+    }
+    if (total.n == 0) {
+      continue;
+    }
+
+    const double inv = 1.0 / total.n;
+    SLICSeed &seed = this->seeds[n];
+    seed.l = total.l * inv;
+    seed.a = total.a * inv;
+    seed.b = total.b * inv;
+    seed.x = total.x * inv;
+    seed.y = total.y * inv;
+  }
+}
+
+int SuperpixelSLIC::enforceConnectivity(const int step, cv::Mat &labels) {
+  const int dx4[4] = {-1, 0, 1, 0};
+  const int dy4[4] = {0, -1, 0, 1};
+
+  const int width = this->klabels.cols;
+  const int height = this->klabels.rows;
+  const int sz = width * height;
+  const int K = std::max(1, sz / (step * step));
+  const int min_size = (sz / K) >> 2;
+
+  labels.create(this->klabels.size(), CV_32SC1);
+  labels.setTo(-1);
+  this->segment_x.resize(sz);
+  this->segment_y.resize(sz);
+  int *xvec = this->segment_x.data();
+  int *yvec = this->segment_y.data();
+
+  int label = 0;
+  int adj_label = 0;
+  for (int j = 0; j < height; j++) {
+    for (int k = 0; k < width; k++) {
+      if (labels.at<int>(j, k) >= 0) {
+        continue;
+      }
+
+      // Start a new segment
+      const int klabel = this->klabels.at<int>(j, k);
+      labels.at<int>(j, k) = label;
+      xvec[0] = k;
+      yvec[0] = j;
+
+      // Find an adjacent label for use later if needed
+      for (int n = 0; n < 4; n++) {
+        const int x = k + dx4[n];
+        const int y = j + dy4[n];
+        if (x >= 0 && x < width && y >= 0 && y < height &&
+            labels.at<int>(y, x) >= 0) {
+          adj_label = labels.at<int>(y, x);
+        }
+      }
+
+      // Flood fill segment
+      int count = 1;
+      for (int c = 0; c < count; c++) {
+        for (int n = 0; n < 4; n++) {
+          const int x = xvec[c] + dx4[n];
+          const int y = yvec[c] + dy4[n];
+          if (x < 0 || x >= width || y < 0 || y >= height) {
+            continue;
+          }
+
+          int &nlabel = labels.at<int>(y, x);
+          if (nlabel < 0 && this->klabels.at<int>(y, x) == klabel) {
+            xvec[count] = x;
+            yvec[count] = y;
+            nlabel = label;
+            count++;
+          }
+        }
+      }
+
+      // Merge small segments into the adjacent segment
+      if (count <= min_size) {
+        for (int c = 0; c < count; c++) {
+          labels.at<int>(yvec[c], xvec[c]) = adj_label;
+        }
+        label--;
+      }
+      label++;
+    }
+  }
+
+  return label;
+}
+
+} // namespace gvio
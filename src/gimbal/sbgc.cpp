@@ -17,6 +17,8 @@ int set_interface_attribs(int fd, int speed, int parity) {
   // disable IGNBRK for mismatched speed tests; otherwise receive break
   // as \000 chars
   tty.c_iflag &= ~IGNBRK; // disable break processing
+  // binary protocol, no input translation or stripping
+  tty.c_iflag &= ~(BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL);
   tty.c_lflag = 0;        // no signaling chars, no echo,
   // no canonical processing
   tty.c_oflag = 0;     // no remapping, no delays
@@ -169,6 +171,67 @@ int SBGCFrame::parseFrame(uint8_t *data) {
   return 0;
 }
 
+size_t SBGCParser::size() const {
+  return this->tail - this->head;
+}
+
+uint8_t SBGCParser::at(const size_t i) const {
+  return this->buffer[(this->head + i) & (SBGC_RX_BUFFER_SIZE - 1)];
+}
+
+size_t SBGCParser::push(const uint8_t *data, const size_t length) {
+  const size_t n = std::min(length, SBGC_RX_BUFFER_SIZE - this->size());
+  for (size_t i = 0; i < n; i++) {
+    this->buffer[this->tail & (SBGC_RX_BUFFER_SIZE - 1)] = data[i];
+    this->tail++;
+  }
+  return n;
+}
+
+int SBGCParser::pop(SBGCFrame &frame) {
+  while (this->size() >= MIN_FRAME_SIZE) {
+    // resynchronise on start byte and header checksum
+    const uint8_t cmd_id = this->at(1);
+    const uint8_t data_size = this->at(2);
+    const uint8_t header_checksum = this->at(3);
+    const uint8_t expected_checksum = (cmd_id + data_size) % 256;
+    const bool header_valid =
+        (this->at(0) == '>') && (header_checksum == expected_checksum);
+    if (header_valid == false) {
+      this->head++;
+      this->nb_dropped++;
+      continue;
+    }
+
+    // wait for rest of frame
+    const size_t frame_size = data_size + MIN_FRAME_SIZE;
+    if (this->size() < frame_size) {
+      return 0;
+    }
+
+    // copy frame out of the ring and parse
+    uint8_t data[SBGC_CMD_MAX_BYTES + MIN_FRAME_SIZE];
+    for (size_t i = 0; i < frame_size; i++) {
+      data[i] = this->at(i);
+    }
+    if (frame.parseFrame(data) != 0) {
+      this->head++;
+      this->nb_dropped++;
+      continue;
+    }
+    this->head += frame_size;
+
+    return 1;
+  }
+
+  return 0;
+}
+
+void SBGCParser::clear() {
+  this->head = 0;
+  this->tail = 0;
+}
+
 void SBGCRealtimeData::printData() {
   // ACCELEROMOETER AND GYROSCOPE
   printf("accelerometer: %.2f\t%.2f\t%.2f\n",
@@ -230,14 +293,28 @@ SBGC::SBGC(const std::string &port) {
 
 int SBGC::connect() {
   // Open serial port
-  this->serial = open(this->port.c_str(), O_RDWR | O_NOCTTY | O_SYNC);
+  this->serial = open(this->port.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
   if (this->serial < 0) {
     return -1;
   }
 
   // Configure serial commnication
   set_interface_attribs(this->serial, B115200, 0);
-  set_blocking(this->serial, 1);
+  set_blocking(this->serial, 0);
+  this->parser.clear();
+
+  // Event loop
+  this->epoll_fd = epoll_create1(0);
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN;
+  event.data.fd = this->serial;
+  if (this->epoll_fd < 0 ||
+      epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, this->serial, &event) != 0) {
+    LOG_ERROR("Failed to setup epoll for SBGC!");
+    close(this->serial);
+    return -1;
+  }
   LOG_INFO("Connected to SBGC!");
 
   this->connected = true;
@@ -245,6 +322,12 @@ int SBGC::connect() {
 }
 
 int SBGC::disconnect() {
+  this->connected = false;
+  if (this->epoll_fd >= 0) {
+    close(this->epoll_fd);
+    this->epoll_fd = -1;
+  }
+
   if (close(this->serial) != 0) {
     LOG_ERROR("Failed to disconnect from SBGC!");
     return -1;
@@ -268,23 +351,36 @@ int SBGC::sendFrame(const SBGCFrame &cmd) {
     return -1;
   }
 
-  // Header
-  ssize_t retval = 0;
-  const uint8_t start = 0x3E; // ">" character
-  retval += write(this->serial, &start, 1);
-  retval += write(this->serial, &cmd.cmd_id, 1);
-  retval += write(this->serial, &cmd.data_size, 1);
-
-  // Body
-  retval += write(this->serial, &cmd.header_checksum, 1);
-  retval += write(this->serial, cmd.data, cmd.data_size);
-  retval += write(this->serial, &cmd.data_checksum, 1);
-
-  // Flush
-  tcflush(this->serial, TCIOFLUSH); // very critical
-  usleep(10 * 1000);
-  if (retval != (5 + cmd.data_size)) {
-    LOG_ERROR("Opps! frame wasn't sent completely!");
+  // Form frame
+  uint8_t buffer[SBGC_CMD_MAX_BYTES];
+  buffer[0] = 0x3E; // ">" character
+  buffer[1] = cmd.cmd_id;
+  buffer[2] = cmd.data_size;
+  buffer[3] = cmd.header_checksum;
+  if (cmd.data_size > 0) {
+    memcpy(&buffer[4], cmd.data, cmd.data_size);
+  }
+  buffer[4 + cmd.data_size] = cmd.data_checksum;
+
+  // Write frame, waiting for the port if its output buffer is full
+  const size_t length = 5 + cmd.data_size;
+  size_t nb_written = 0;
+  while (nb_written < length) {
+    const ssize_t retval =
+        write(this->serial, &buffer[nb_written], length - nb_written);
+    if (retval > 0) {
+      nb_written += retval;
+      continue;
+    } else if (retval < 0 && errno != EAGAIN && errno != EINTR) {
+      LOG_ERROR("Failed to write SBGC frame!");
+      return -1;
+    }
+
+    struct pollfd pfd = {this->serial, POLLOUT, 0};
+    if (::poll(&pfd, 1, this->timeout_ms) <= 0) {
+      LOG_ERROR("Opps! frame wasn't sent completely!");
+      return -1;
+    }
   }
 
   return 0;
@@ -296,24 +392,122 @@ int SBGC::readFrame(const uint8_t read_length, SBGCFrame &frame) {
     return -1;
   }
 
-  // Send query
-  uint8_t buffer[150];
-  int16_t nb_bytes = read(this->serial, buffer, read_length);
-  if (nb_bytes <= 0 || nb_bytes != read_length) {
+  // Wait for next frame
+  if (this->waitFrame(-1, frame) != 0) {
     // LOG_ERROR("Failed to read SBGC frame!");
     return -1;
   }
 
-  // Parse sbgc frame
-  int retval = frame.parseFrame(buffer);
-  if (retval == -1) {
-    // LOG_ERROR("Failed to parse SBGC frame!");
+  // Check frame length
+  if ((frame.data_size + MIN_FRAME_SIZE) != read_length) {
+    free(frame.data);
+    frame.data = NULL;
     return -1;
   }
 
   return 0;
 }
 
+int SBGC::receive() {
+  uint8_t buffer[256];
+  int nb_bytes = 0;
+
+  while (true) {
+    const ssize_t retval = read(this->serial, buffer, sizeof(buffer));
+    if (retval > 0) {
+      this->parser.push(buffer, retval);
+      nb_bytes += retval;
+    } else if (retval < 0 && errno == EINTR) {
+      continue;
+    } else if (retval < 0 && errno != EAGAIN) {
+      LOG_ERROR("Failed to read from SBGC!");
+      return -1;
+    } else {
+      break;
+    }
+  }
+
+  return nb_bytes;
+}
+
+int SBGC::waitFrame(const int cmd_id, SBGCFrame &frame) {
+  // Check connection
+  if (this->connected == false) {
+    return -1;
+  }
+
+  const double deadline = time_now() + this->timeout_ms * 1e-3;
+  while (true) {
+    // Parse buffered frames
+    while (this->parser.pop(frame) == 1) {
+      if (cmd_id == -1 || frame.cmd_id == cmd_id) {
+        return 0;
+      }
+      this->dispatchFrame(frame);
+      free(frame.data);
+    }
+
+    // Wait for more bytes
+    const int remaining_ms = (deadline - time_now()) * 1e3;
+    struct pollfd pfd = {this->serial, POLLIN, 0};
+    if (remaining_ms <= 0 || ::poll(&pfd, 1, remaining_ms) <= 0) {
+      return -1;
+    }
+    if (this->receive() < 0) {
+      return -1;
+    }
+  }
+}
+
+int SBGC::dispatchFrame(const SBGCFrame &frame) {
+  if (frame.cmd_id != CMD_REALTIME_DATA_3 &&
+      frame.cmd_id != CMD_REALTIME_DATA_4) {
+    return 0;
+  }
+
+  if (this->parseRealtimeData(frame) != 0) {
+    return 0;
+  }
+  if (this->on_realtime_data) {
+    this->on_realtime_data(this->data);
+  }
+
+  return 1;
+}
+
+int SBGC::spinOnce(const int timeout_ms) {
+  // Check connection
+  if (this->connected == false) {
+    return -1;
+  }
+
+  // Wait for serial port
+  struct epoll_event event;
+  const int nb_events = epoll_wait(this->epoll_fd, &event, 1, timeout_ms);
+  if (nb_events < 0 && errno != EINTR) {
+    LOG_ERROR("Failed to wait on SBGC!");
+    return -1;
+  } else if (nb_events > 0 && this->receive() < 0) {
+    return -1;
+  }
+
+  // Dispatch frames
+  int nb_dispatched = 0;
+  SBGCFrame frame;
+  while (this->parser.pop(frame) == 1) {
+    nb_dispatched += this->dispatchFrame(frame);
+    free(frame.data);
+  }
+
+  return nb_dispatched;
+}
+
+int SBGC::requestRealtimeData() {
+  SBGCFrame frame;
+  frame.buildFrame(CMD_REALTIME_DATA_3);
+  return this->sendFrame(frame);
+}
+
 int SBGC::on() {
   SBGCFrame cmd;
   cmd.buildFrame(CMD_MOTORS_ON);
@@ -378,7 +572,7 @@ int SBGC::getBoardInfo() {
   }
 
   // Obtain board info
-  retval = this->readFrame(CMD_BOARD_INFO_FRAME_SIZE, frame);
+  retval = this->waitFrame(CMD_BOARD_INFO, frame);
   if (retval == -1) {
     LOG_ERROR("Failed to parse SBGC frame for board info!");
     return -1;
@@ -397,23 +591,12 @@ int SBGC::getBoardInfo() {
   return 0;
 }
 
-int SBGC::getRealtimeData4() {
-  int retval;
-
-  // Request real time data
-  SBGCFrame frame;
-  frame.buildFrame(CMD_REALTIME_DATA_4);
-  retval = this->sendFrame(frame);
-  if (retval == -1) {
-    // LOG_ERROR("Failed to request SBGC realtime data!");
-    return -1;
-  }
-
-  // Obtain real time data
-  retval = this->readFrame(129, frame);
-  if (retval == -1) {
-    // LOG_ERROR("Failed to parse SBGC frame for realtime data!" <<
-    // std::endl;
+int SBGC::parseRealtimeData(const SBGCFrame &frame) {
+  // Check frame
+  const bool is_rt3 = (frame.cmd_id == CMD_REALTIME_DATA_3);
+  const bool is_rt4 = (frame.cmd_id == CMD_REALTIME_DATA_4);
+  if ((is_rt3 && frame.data_size < 63) || (is_rt4 && frame.data_size < 69) ||
+      (is_rt3 == false && is_rt4 == false)) {
     return -1;
   }
 
@@ -447,10 +630,6 @@ int SBGC::getRealtimeData4() {
   this->data.rc_angles(1) = S16BIT(frame.data, 47, 45);
   this->data.rc_angles(2) = S16BIT(frame.data, 49, 46);
 
-  this->data.encoder_angles(0) = S16BIT(frame.data, 64, 63);
-  this->data.encoder_angles(1) = S16BIT(frame.data, 66, 65);
-  this->data.encoder_angles(2) = S16BIT(frame.data, 68, 67);
-
   this->data.camera_angles(0) = (DEG_PER_BIT) * this->data.camera_angles(0);
   this->data.camera_angles(1) = (DEG_PER_BIT) * this->data.camera_angles(1);
   this->data.camera_angles(2) = (DEG_PER_BIT) * this->data.camera_angles(2);
@@ -463,9 +642,16 @@ int SBGC::getRealtimeData4() {
   this->data.rc_angles(1) = (DEG_PER_BIT) * this->data.rc_angles(1);
   this->data.rc_angles(2) = (DEG_PER_BIT) * this->data.rc_angles(2);
 
-  this->data.encoder_angles(0) = (DEG_PER_BIT) * this->data.encoder_angles(0);
-  this->data.encoder_angles(1) = (DEG_PER_BIT) * this->data.encoder_angles(1);
-  this->data.encoder_angles(2) = (DEG_PER_BIT) * this->data.encoder_angles(2);
+  // Encoder angles (CMD_REALTIME_DATA_4 only)
+  if (is_rt4) {
+    this->data.encoder_angles(0) = S16BIT(frame.data, 64, 63);
+    this->data.encoder_angles(1) = S16BIT(frame.data, 66, 65);
+    this->data.encoder_angles(2) = S16BIT(frame.data, 68, 67);
+
+    this->data.encoder_angles(0) = (DEG_PER_BIT) * this->data.encoder_angles(0);
+    this->data.encoder_angles(1) = (DEG_PER_BIT) * this->data.encoder_angles(1);
+    this->data.encoder_angles(2) = (DEG_PER_BIT) * this->data.encoder_angles(2);
+  }
 
   // Misc
   this->data.cycle_time = U16BIT(frame.data, 51, 50);
@@ -473,80 +659,59 @@ int SBGC::getRealtimeData4() {
   this->data.system_error = U16BIT(frame.data, 15, 14);
   this->data.battery_level = U16BIT(frame.data, 56, 55);
 
-  // this->data.printData();
-
   return 0;
 }
-int SBGC::getRealtimeData() {
+
+int SBGC::getRealtimeData4() {
   int retval;
-  SBGCFrame frame;
 
   // Request real time data
-  frame.buildFrame(CMD_REALTIME_DATA_3);
+  SBGCFrame frame;
+  frame.buildFrame(CMD_REALTIME_DATA_4);
   retval = this->sendFrame(frame);
   if (retval == -1) {
-    LOG_ERROR("Failed to request SBGC realtime data!");
+    // LOG_ERROR("Failed to request SBGC realtime data!");
     return -1;
   }
 
   // Obtain real time data
-  retval = this->readFrame(68, frame);
+  retval = this->waitFrame(CMD_REALTIME_DATA_4, frame);
   if (retval == -1) {
-    LOG_ERROR("Failed to parse SBGC frame for realtime data!");
+    // LOG_ERROR("Failed to parse SBGC frame for realtime data!" <<
+    // std::endl;
     return -1;
   }
 
   // Parse real time data
-  // Accelerometer and gyroscope
-  this->data.accel(0) = S16BIT(frame.data, 1, 0);
-  this->data.gyro(0) = S16BIT(frame.data, 3, 2);
-  this->data.accel(1) = S16BIT(frame.data, 5, 4);
-  this->data.gyro(1) = S16BIT(frame.data, 7, 6);
-  this->data.accel(2) = S16BIT(frame.data, 9, 8);
-  this->data.gyro(2) = S16BIT(frame.data, 11, 10);
-
-  this->data.accel(0) = (ACC_UNIT) * this->data.accel(0);
-  this->data.accel(1) = (ACC_UNIT) * this->data.accel(1);
-  this->data.accel(2) = (ACC_UNIT) * this->data.accel(2);
-
-  this->data.gyro(0) = (GYRO_UNIT) * this->data.gyro(0);
-  this->data.gyro(1) = (GYRO_UNIT) * this->data.gyro(1);
-  this->data.gyro(2) = (GYRO_UNIT) * this->data.gyro(2);
-
-  // Angles
-  this->data.camera_angles(0) = S16BIT(frame.data, 33, 32);
-  this->data.camera_angles(1) = S16BIT(frame.data, 35, 34);
-  this->data.camera_angles(2) = S16BIT(frame.data, 37, 36);
-
-  this->data.frame_angles(0) = S16BIT(frame.data, 39, 38);
-  this->data.frame_angles(1) = S16BIT(frame.data, 41, 40);
-  this->data.frame_angles(2) = S16BIT(frame.data, 43, 42);
-
-  this->data.rc_angles(0) = S16BIT(frame.data, 45, 44);
-  this->data.rc_angles(1) = S16BIT(frame.data, 47, 45);
-  this->data.rc_angles(2) = S16BIT(frame.data, 49, 46);
+  retval = this->parseRealtimeData(frame);
+  free(frame.data);
 
-  this->data.camera_angles(0) = (DEG_PER_BIT) * this->data.camera_angles(0);
-  this->data.camera_angles(1) = (DEG_PER_BIT) * this->data.camera_angles(1);
-  this->data.camera_angles(2) = (DEG_PER_BIT) * this->data.camera_angles(2);
+  return retval;
+}
 
-  this->data.frame_angles(0) = (DEG_PER_BIT) * this->data.frame_angles(0);
-  this->data.frame_angles(1) = (DEG_PER_BIT) * this->data.frame_angles(1);
-  this->data.frame_angles(2) = (DEG_PER_BIT) * this->data.frame_angles(2);
+int SBGC::getRealtimeData() {
+  int retval;
 
-  this->data.rc_angles(0) = (DEG_PER_BIT) * this->data.rc_angles(0);
-  this->data.rc_angles(1) = (DEG_PER_BIT) * this->data.rc_angles(1);
-  this->data.rc_angles(2) = (DEG_PER_BIT) * this->data.rc_angles(2);
+  // Request real time data
+  retval = this->requestRealtimeData();
+  if (retval == -1) {
+    LOG_ERROR("Failed to request SBGC realtime data!");
+    return -1;
+  }
 
-  // misc
-  this->data.cycle_time = U16BIT(frame.data, 51, 50);
-  this->data.i2c_error_count = U16BIT(frame.data, 53, 52);
-  this->data.system_error = U16BIT(frame.data, 15, 14);
-  this->data.battery_level = U16BIT(frame.data, 56, 55);
+  // Obtain real time data
+  SBGCFrame frame;
+  retval = this->waitFrame(CMD_REALTIME_DATA_3, frame);
+  if (retval == -1) {
+    LOG_ERROR("Failed to parse SBGC frame for realtime data!");
+    return -1;
+  }
 
-  // this->data.printData();
+  // Parse real time data
+  retval = this->parseRealtimeData(frame);
+  free(frame.data);
 
-  return 0;
+  return retval;
 }
 
 int SBGC::getAnglesExt() {
@@ -563,7 +728,7 @@ int SBGC::getAnglesExt() {
   }
 
   // Obtain real time data
-  retval = this->readFrame(54, frame);
+  retval = this->waitFrame(CMD_GET_ANGLES_EXT, frame);
   if (retval == -1) {
     LOG_ERROR("Failed to parse SBGC frame for realtime data!");
     return -1;
@@ -596,6 +761,7 @@ int SBGC::getAnglesExt() {
   this->data.encoder_angles(2) = (DEG_PER_BIT) * this->data.encoder_angles(2);
 
   this->data.printData();
+  free(frame.data);
 
   return 0;
 }
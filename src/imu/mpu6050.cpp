@@ -136,6 +136,150 @@ int MPU6050::getData() {
   return 0;
 }
 
+int MPU6050::enableFIFO() {
+  // Check configuration
+  if (this->accel.sensitivity <= 0.0 || this->gyro.sensitivity <= 0.0 ||
+      this->sample_rate <= 0.0f) {
+    LOG_ERROR("MPU6050 is not configured!");
+    return -1;
+  }
+
+  // Write accel and gyro to FIFO
+  this->i2c.setSlave(MPU6050_ADDRESS);
+  const char fifo_en = MPU6050_FIFO_EN_ACCEL | MPU6050_FIFO_EN_GYRO;
+  if (this->i2c.writeByte(MPU6050_RA_FIFO_EN, fifo_en) != 0) {
+    LOG_ERROR("Failed to enable MPU6050 FIFO!");
+    return -1;
+  }
+
+  // Reset and enable FIFO
+  char user_ctrl = 0x00;
+  if (this->i2c.readByte(MPU6050_RA_USER_CTRL, &user_ctrl) != 0) {
+    LOG_ERROR("Failed to enable MPU6050 FIFO!");
+    return -1;
+  }
+  user_ctrl |= MPU6050_USER_CTRL_FIFO_EN | MPU6050_USER_CTRL_FIFO_RESET;
+  if (this->i2c.writeByte(MPU6050_RA_USER_CTRL, user_ctrl) != 0) {
+    LOG_ERROR("Failed to enable MPU6050 FIFO!");
+    return -1;
+  }
+
+  this->fifo_enabled = true;
+  this->fifo_timestamp = -1.0;
+  return 0;
+}
+
+int MPU6050::disableFIFO() {
+  // Disable FIFO
+  this->i2c.setSlave(MPU6050_ADDRESS);
+  char user_ctrl = 0x00;
+  if (this->i2c.readByte(MPU6050_RA_USER_CTRL, &user_ctrl) != 0) {
+    return -1;
+  }
+  user_ctrl &= ~MPU6050_USER_CTRL_FIFO_EN;
+  if (this->i2c.writeByte(MPU6050_RA_USER_CTRL, user_ctrl) != 0 ||
+      this->i2c.writeByte(MPU6050_RA_FIFO_EN, 0x00) != 0) {
+    return -1;
+  }
+
+  this->fifo_enabled = false;
+  return 0;
+}
+
+int MPU6050::readFIFO(const double read_time) {
+  // Pre-check
+  if (this->fifo_enabled == false) {
+    return -1;
+  }
+
+  // Get FIFO count
+  uint8_t count_data[2] = {0x00, 0x00};
+  this->i2c.setSlave(MPU6050_ADDRESS);
+  if (this->i2c.readBytes(MPU6050_RA_FIFO_COUNTH, (char *) count_data, 2)) {
+    return -1;
+  }
+  const int count = (count_data[0] << 8) | count_data[1];
+
+  // A full FIFO has overflowed, the oldest bytes were overwritten and the
+  // packets are no longer aligned
+  if (count >= MPU6050_FIFO_SIZE) {
+    char user_ctrl = 0x00;
+    this->i2c.readByte(MPU6050_RA_USER_CTRL, &user_ctrl);
+    user_ctrl |= MPU6050_USER_CTRL_FIFO_RESET;
+    this->i2c.writeByte(MPU6050_RA_USER_CTRL, user_ctrl);
+    this->fifo_timestamp = -1.0;
+    this->nb_overflows++;
+    return -2;
+  }
+
+  // Burst read complete packets
+  const int nb_samples = count / MPU6050_FIFO_PACKET_SIZE;
+  if (nb_samples == 0) {
+    return 0;
+  }
+  uint8_t data[MPU6050_FIFO_SIZE];
+  const size_t length = nb_samples * MPU6050_FIFO_PACKET_SIZE;
+  if (this->i2c.readBytes(MPU6050_RA_FIFO_R_W, (char *) data, length)) {
+    return -1;
+  }
+
+  // Reconstruct timeline, the last sample was taken just before the read
+  const double dt = 1.0 / this->sample_rate;
+  if (this->fifo_timestamp < 0.0) {
+    this->fifo_timestamp = read_time - nb_samples * dt;
+  } else {
+    const double predicted = this->fifo_timestamp + nb_samples * dt;
+    this->fifo_timestamp += this->fifo_clock_gain * (read_time - predicted);
+  }
+
+  // Convert samples
+  const float g = 9.81; // Gravitational constant
+  const float accel_scale = g / this->accel.sensitivity;
+  const float gyro_scale = deg2rad(1.0) / this->gyro.sensitivity;
+  const float accel_offset[3] = {(float) this->accel.offset_x,
+                                 (float) this->accel.offset_y,
+                                 (float) this->accel.offset_z};
+  const float gyro_offset[3] = {(float) this->gyro.offset_x,
+                                (float) this->gyro.offset_y,
+                                (float) this->gyro.offset_z};
+
+  MPU6050Sample sample;
+  for (int i = 0; i < nb_samples; i++) {
+    const uint8_t *packet = &data[i * MPU6050_FIFO_PACKET_SIZE];
+    sample.timestamp = this->fifo_timestamp + (i + 1) * dt;
+    for (int j = 0; j < 3; j++) {
+      const int16_t a = (packet[2 * j] << 8) | packet[2 * j + 1];
+      const int16_t w = (packet[6 + 2 * j] << 8) | packet[6 + 2 * j + 1];
+      sample.accel[j] = a * accel_scale - accel_offset[j];
+      sample.gyro[j] = w * gyro_scale - gyro_offset[j];
+    }
+
+    if (this->samples.push(sample) == false) {
+      this->nb_dropped++;
+    }
+  }
+  this->fifo_timestamp += nb_samples * dt;
+
+  // Keep latest sample
+  this->accel.x = sample.accel[0];
+  this->accel.y = sample.accel[1];
+  this->accel.z = sample.accel[2];
+  this->gyro.x = sample.gyro[0];
+  this->gyro.y = sample.gyro[1];
+  this->gyro.z = sample.gyro[2];
+  this->last_updated = clock();
+
+  return nb_samples;
+}
+
+int MPU6050::readFIFO() {
+  return this->readFIFO(time_now());
+}
+
+bool MPU6050::popSample(MPU6050Sample &sample) {
+  return this->samples.pop(sample);
+}
+
 int MPU6050::setDPLF(const int setting) {
   /*
       DPLF_CFG    Accelerometer
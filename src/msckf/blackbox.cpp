@@ -4,111 +4,86 @@ namespace gvio {
 
 BlackBox::BlackBox() {}
 
-BlackBox::~BlackBox() {
-  // Estimation file
-  if (this->est_file.good()) {
-    this->est_file.close();
-  }
-
-  // Measurement file
-  if (this->mea_file.good()) {
-    this->est_file.close();
-  }
-
-  // Ground truth file
-  if (this->gnd_file.good()) {
-    this->est_file.close();
-  }
-
-  // Sliding window file
-  if (this->win_file.good()) {
-    this->win_file.close();
-  }
-}
+BlackBox::~BlackBox() {}
 
 int BlackBox::configure(const std::string &output_path,
-                        const std::string &base_name) {
+                        const std::string &base_name,
+                        const bool binary) {
   // Make directory if it does not exist already
   if (dir_exists(output_path) == false && dir_create(output_path) != 0) {
     LOG_ERROR("Failed to create directory [%s] for blackbox!",
               output_path.c_str());
     return -1;
   }
+  const std::string prefix = output_path + "/" + base_name;
+  const std::string ext = (binary) ? ".bin" : ".dat";
+
+  // Offline recording, wait for the writer rather than dropping records
+  this->writer.drop_when_full = false;
 
   // Estimation file
-  this->est_file.open(output_path + "/" + base_name + "_est.dat");
-  if (this->est_file.good() == false) {
+  // clang-format off
+  const std::string est_header = "t,x,y,z,vx,vy,vz,roll,pitch,yaw";
+  this->est_stream = this->writer.addStream(prefix + "_est" + ext, est_header, 10, 0, binary);
+  // clang-format on
+  if (this->est_stream == -1) {
     LOG_ERROR("Failed to open estimate file for recording [%s]",
               output_path.c_str());
     return -1;
   }
 
   // Measurement file
-  this->mea_file.open(output_path + "/" + base_name + "_mea.dat");
-  if (this->mea_file.good() == false) {
+  // clang-format off
+  const std::string mea_header = "t,ax_B,ay_B,az_B,wx_B,wy_B,wz_B";
+  this->mea_stream = this->writer.addStream(prefix + "_mea" + ext, mea_header, 7, 0, binary);
+  // clang-format on
+  if (this->mea_stream == -1) {
     LOG_ERROR("Failed to open measurement file for recording [%s]",
               output_path.c_str());
     return -1;
   }
 
   // Ground truth file
-  this->gnd_file.open(output_path + "/" + base_name + "_gnd.dat");
-  if (this->gnd_file.good() == false) {
+  // clang-format off
+  const std::string gnd_header = "t,x,y,z,vx,vy,vz,roll,pitch,yaw";
+  this->gnd_stream = this->writer.addStream(prefix + "_gnd" + ext, gnd_header, 10, 0, binary);
+  // clang-format on
+  if (this->gnd_stream == -1) {
     LOG_ERROR("Failed to open ground truth file for recording [%s]",
               output_path.c_str());
     return -1;
   }
 
   // Sliding window file
-  this->win_file.open(output_path + "/" + base_name + "_win.dat");
-  if (this->win_file.good() == false) {
+  // clang-format off
+  const std::string win_header = "x,y,z,roll,pitch,yaw";
+  this->win_stream = this->writer.addStream(prefix + "_win" + ext, win_header, 6, 0, binary);
+  // clang-format on
+  if (this->win_stream == -1) {
     LOG_ERROR("Failed to open ground truth file for recording [%s]",
               output_path.c_str());
     return -1;
   }
 
-  // Write header
-  // clang-format off
-  const std::string est_header = "t,x,y,z,vx,vy,vz,roll,pitch,yaw";
-  this->est_file << est_header << std::endl;
-
-  const std::string mea_header = "t,ax_B,ay_B,az_B,wx_B,wy_B,wz_B";
-  this->mea_file << mea_header << std::endl;
-
-  const std::string gnd_header = "t,x,y,z,vx,vy,vz,roll,pitch,yaw";
-  this->gnd_file << gnd_header << std::endl;
-
-  const std::string win_header = "x,y,z,roll,pitch,yaw";
-  this->win_file << win_header << std::endl;
-  // clang-format on
+  // Start writer thread
+  if (this->writer.start() != 0) {
+    LOG_ERROR("Failed to start blackbox writer!");
+    return -1;
+  }
 
   return 0;
 }
 
-int BlackBox::recordMSCKF(const double time, const MSCKF &msckf) {
-  // Pre-check
-  if (this->est_file.good() == false) {
-    LOG_ERROR("BlackBox not configured!");
-    return -1;
-  }
+int BlackBox::close() {
+  return this->writer.stop();
+}
 
-  // -- Time
-  this->est_file << time << ",";
-  // -- Position
-  this->est_file << msckf.imu_state.p_G(0) << ",";
-  this->est_file << msckf.imu_state.p_G(1) << ",";
-  this->est_file << msckf.imu_state.p_G(2) << ",";
-  // -- Velocity
-  this->est_file << msckf.imu_state.v_G(0) << ",";
-  this->est_file << msckf.imu_state.v_G(1) << ",";
-  this->est_file << msckf.imu_state.v_G(2) << ",";
-  // -- Roll, pitch and yaw
+int BlackBox::recordMSCKF(const double time, const MSCKF &msckf) {
   const Vec3 rpy_G = quat2euler(msckf.imu_state.q_IG);
-  this->est_file << rpy_G(0) << ",";
-  this->est_file << rpy_G(1) << ",";
-  this->est_file << rpy_G(2) << std::endl;
-
-  return 0;
+  return this->recordEstimate(time,
+                              msckf.imu_state.p_G,
+                              msckf.imu_state.v_G,
+                              rpy_G);
 }
 
 int BlackBox::recordEstimate(const double time,
@@ -116,50 +91,35 @@ int BlackBox::recordEstimate(const double time,
                              const Vec3 &v_G,
                              const Vec3 &rpy_G) {
   // Pre-check
-  if (this->est_file.good() == false) {
+  if (this->est_stream == -1) {
     LOG_ERROR("BlackBox not configured!");
     return -1;
   }
 
-  // -- Time
-  this->est_file << time << ",";
-  // -- Position
-  this->est_file << p_G(0) << ",";
-  this->est_file << p_G(1) << ",";
-  this->est_file << p_G(2) << ",";
-  // -- Velocity
-  this->est_file << v_G(0) << ",";
-  this->est_file << v_G(1) << ",";
-  this->est_file << v_G(2) << ",";
-  // -- Roll, pitch and yaw
-  this->est_file << rpy_G(0) << ",";
-  this->est_file << rpy_G(1) << ",";
-  this->est_file << rpy_G(2) << std::endl;
-
-  return 0;
+  // clang-format off
+  const double record[10] = {time,
+                             p_G(0), p_G(1), p_G(2),
+                             v_G(0), v_G(1), v_G(2),
+                             rpy_G(0), rpy_G(1), rpy_G(2)};
+  // clang-format on
+  return this->writer.write(this->est_stream, record);
 }
 
 int BlackBox::recordMeasurement(const double time,
                                 const Vec3 &a_B,
                                 const Vec3 &w_B) {
   // Pre-check
-  if (this->mea_file.good() == false) {
+  if (this->mea_stream == -1) {
     LOG_ERROR("BlackBox not configured!");
     return -1;
   }
 
-  // -- Time
-  this->mea_file << time << ",";
-  // -- Acceleration
-  this->mea_file << a_B(0) << ",";
-  this->mea_file << a_B(1) << ",";
-  this->mea_file << a_B(2) << ",";
-  // -- Angular velocity
-  this->mea_file << w_B(0) << ",";
-  this->mea_file << w_B(1) << ",";
-  this->mea_file << w_B(2) << std::endl;
-
-  return 0;
+  // clang-format off
+  const double record[7] = {time,
+                            a_B(0), a_B(1), a_B(2),
+                            w_B(0), w_B(1), w_B(2)};
+  // clang-format on
+  return this->writer.write(this->mea_stream, record);
 }
 
 int BlackBox::recordGroundTruth(const double time,
@@ -167,47 +127,38 @@ int BlackBox::recordGroundTruth(const double time,
                                 const Vec3 &v_G,
                                 const Vec3 &rpy_G) {
   // Pre-check
-  if (this->gnd_file.good() == false) {
+  if (this->gnd_stream == -1) {
     LOG_ERROR("BlackBox not configured!");
     return -1;
   }
 
-  // -- Time
-  this->gnd_file << time << ",";
-  // -- Position
-  this->gnd_file << p_G(0) << ",";
-  this->gnd_file << p_G(1) << ",";
-  this->gnd_file << p_G(2) << ",";
-  // -- Velocity
-  this->gnd_file << v_G(0) << ",";
-  this->gnd_file << v_G(1) << ",";
-  this->gnd_file << v_G(2) << ",";
-  // -- Roll, pitch and yaw
-  this->gnd_file << rpy_G(0) << ",";
-  this->gnd_file << rpy_G(1) << ",";
-  this->gnd_file << rpy_G(2) << std::endl;
-
-  return 0;
+  // clang-format off
+  const double record[10] = {time,
+                             p_G(0), p_G(1), p_G(2),
+                             v_G(0), v_G(1), v_G(2),
+                             rpy_G(0), rpy_G(1), rpy_G(2)};
+  // clang-format on
+  return this->writer.write(this->gnd_stream, record);
 }
 
 int BlackBox::recordCameraStates(const MSCKF &msckf) {
   // Pre-check
-  if (this->win_file.good() == false) {
+  if (this->win_stream == -1) {
     LOG_ERROR("BlackBox not configured!");
     return -1;
   }
 
+  const Vec3 rpy_G = quat2euler(msckf.imu_state.q_IG);
   for (auto cam_state : msckf.cam_states) {
-    // -- Position
-    this->win_file << cam_state.p_G(0) << ",";
-    this->win_file << cam_state.p_G(1) << ",";
-    this->win_file << cam_state.p_G(2) << ",";
-
-    // -- Roll, pitch and yaw
-    const Vec3 rpy_G = quat2euler(msckf.imu_state.q_IG);
-    this->win_file << rpy_G(0) << ",";
-    this->win_file << rpy_G(1) << ",";
-    this->win_file << rpy_G(2) << std::endl;
+    // clang-format off
+    const double record[6] = {cam_state.p_G(0),
+                              cam_state.p_G(1),
+                              cam_state.p_G(2),
+                              rpy_G(0), rpy_G(1), rpy_G(2)};
+    // clang-format on
+    if (this->writer.write(this->win_stream, record) != 0) {
+      return -1;
+    }
   }
 
   return 0;
@@ -220,16 +171,24 @@ int BlackBox::recordTimeStep(const double time,
                              const Vec3 &gnd_p_G,
                              const Vec3 &gnd_v_G,
                              const Vec3 &gnd_rpy_G) {
+  int retval = 0;
+
   // Estimated
-  this->recordMSCKF(time, msckf);
+  if (this->recordMSCKF(time, msckf) != 0) {
+    retval = -1;
+  }
 
   // Measurements
-  this->recordMeasurement(time, mea_a_B, mea_w_B);
+  if (this->recordMeasurement(time, mea_a_B, mea_w_B) != 0) {
+    retval = -1;
+  }
 
   // Ground truth
-  this->recordGroundTruth(time, gnd_p_G, gnd_v_G, gnd_rpy_G);
+  if (this->recordGroundTruth(time, gnd_p_G, gnd_v_G, gnd_rpy_G) != 0) {
+    retval = -1;
+  }
 
-  return 0;
+  return retval;
 }
 
 } // namespace gvio
@@ -0,0 +1,229 @@
+#include "gvio/msckf/monte_carlo.hpp"
+
+namespace gvio {
+
+int MSCKFMonteCarlo::configure(const std::string &config_file) {
+  // Load config file
+  ConfigParser parser;
+  parser.addParam("msckf_config", &this->msckf_config);
+  parser.addParam("nb_runs", &this->nb_runs);
+  parser.addParam("seed", &this->seed);
+  parser.addParam("nb_threads", &this->nb_threads, true);
+  parser.addParam("dt", &this->dt);
+  parser.addParam("duration", &this->duration);
+  parser.addParam("nb_features", &this->nb_features);
+  parser.addParam("noise.pixel", &this->pixel_noise);
+  parser.addParam("imu.rate", &this->imu.rate);
+  parser.addParam("imu.accel_noise_density", &this->imu.accel_noise_density);
+  parser.addParam("imu.gyro_noise_density", &this->imu.gyro_noise_density);
+  parser.addParam("imu.accel_random_walk", &this->imu.accel_random_walk);
+  parser.addParam("imu.gyro_random_walk", &this->imu.gyro_random_walk);
+  parser.addParam("rpe_interval", &this->rpe_interval, true);
+  if (parser.load(config_file) != 0) {
+    LOG_ERROR("Failed to load config file [%s]!", config_file.c_str());
+    return -1;
+  } else if (this->dt <= 0.0) {
+    LOG_ERROR("Invalid time step [%f]!", this->dt);
+    return -1;
+  } else if (this->imu.rate <= 0.0) {
+    LOG_ERROR("Invalid IMU rate [%f]!", this->imu.rate);
+    return -1;
+  }
+
+  // MSCKF config path is relative to config file
+  char str_buffer[1024];
+  memset(str_buffer, 0, sizeof(str_buffer));
+  config_file.copy(str_buffer, sizeof(str_buffer) - 1, 0);
+  const std::string config_dir(dirname(str_buffer));
+  paths_combine(config_dir, this->msckf_config, this->msckf_config);
+
+  // Configure filter every run starts from
+  if (this->msckf.configure(this->msckf_config) != 0) {
+    LOG_ERROR("Failed to configure MSCKF [%s]!", this->msckf_config.c_str());
+    return -1;
+  }
+
+  return 0;
+}
+
+int MSCKFMonteCarlo::simulate(const int index, MonteCarloRun &run) const {
+  run.index = index;
+  run.retval = -1;
+  run.frame_times.clear();
+
+  // Seeds depend only on the base seed and the run index
+  std::seed_seq seq{(unsigned int) this->seed, (unsigned int) index};
+  unsigned int seeds[2];
+  seq.generate(seeds, seeds + 2);
+
+  // Setup world
+  SimWorld world;
+  world.seed = seeds[0];
+  world.imu = this->imu;
+  world.imu.seed = seeds[1];
+  world.nb_features = this->nb_features;
+  world.pixel_noise = this->pixel_noise;
+  if (world.configure(this->dt) != 0) {
+    LOG_ERROR("Failed to configure world for run [%d]!", index);
+    return -1;
+  }
+
+  // Setup MSCKF
+  MSCKF msckf = this->msckf;
+  msckf.initialize(0,
+                   euler2quat(world.robot.rpy_G),
+                   euler321ToRot(world.robot.rpy_G) * world.robot.v_B,
+                   world.robot.p_G);
+
+  // IMU measurements between camera frames drive the prediction update
+  double frame_time = 0.0;
+  world.imu_cb = [&](const Vec3 &a_m, const Vec3 &w_m, const long ts) {
+    struct timespec start = tic();
+    const int retval = msckf.predictionUpdate(a_m, w_m, ts);
+    frame_time += mtoc(&start);
+    return retval;
+  };
+
+  // Simulate
+  const int nb_frames = (int) round(this->duration / this->dt);
+  std::vector<Vec3> p_est;
+  std::vector<Vec3> p_true;
+  double nees_sum = 0.0;
+  for (int k = 1; k <= nb_frames; k++) {
+    // Step simulation
+    frame_time = 0.0;
+    if (world.step() != 0) {
+      LOG_ERROR("Prediction failed in run [%d] at frame [%d]!", index, k);
+      return 0;
+    }
+    FeatureTracks tracks = world.removeLostTracks();
+
+    // MSCKF
+    struct timespec frame_start = tic();
+    msckf.measurementUpdate(tracks);
+    frame_time += mtoc(&frame_start);
+    run.frame_times.push_back(frame_time);
+
+    // Position error and NEES
+    const Vec3 p_G = msckf.imu_state.p_G;
+    const Vec3 e = world.robot.p_G - p_G;
+    const Mat3 P_pp = msckf.imu_state.P.block(12, 12, 3, 3);
+    const double nees = e.transpose() * P_pp.ldlt().solve(e);
+    if (p_G.allFinite() == false || std::isfinite(nees) == false) {
+      LOG_ERROR("MSCKF diverged in run [%d] at frame [%d]!", index, k);
+      return 0;
+    }
+    p_est.push_back(p_G);
+    p_true.push_back(world.robot.p_G);
+    nees_sum += nees;
+  }
+
+  // Absolute trajectory error
+  const size_t nb_poses = p_est.size();
+  double ate_sum = 0.0;
+  for (size_t i = 0; i < nb_poses; i++) {
+    ate_sum += (p_est[i] - p_true[i]).squaredNorm();
+  }
+
+  // Relative pose error
+  const size_t delta = std::max(1, (int) round(this->rpe_interval / this->dt));
+  double rpe_sum = 0.0;
+  size_t nb_rpe = 0;
+  for (size_t i = 0; i + delta < nb_poses; i++) {
+    const Vec3 dp_est = p_est[i + delta] - p_est[i];
+    const Vec3 dp_true = p_true[i + delta] - p_true[i];
+    rpe_sum += (dp_est - dp_true).squaredNorm();
+    nb_rpe++;
+  }
+
+  run.ate = (nb_poses) ? sqrt(ate_sum / nb_poses) : 0.0;
+  run.rpe = (nb_rpe) ? sqrt(rpe_sum / nb_rpe) : 0.0;
+  run.nees = (nb_poses) ? nees_sum / nb_poses : 0.0;
+  run.retval = 0;
+
+  return 0;
+}
+
+int MSCKFMonteCarlo::run() {
+  this->runs.clear();
+  this->runs.resize(this->nb_runs);
+
+  // Simulate runs in parallel
+  struct timespec start = tic();
+  ThreadPool pool{(this->nb_threads > 0)
+                      ? (size_t) this->nb_threads
+                      : (size_t) std::thread::hardware_concurrency()};
+  pool.parallelForDynamic(0, this->nb_runs, [&](const int, const int i) {
+    this->simulate(i, this->runs[i]);
+  });
+  this->wall_time = toc(&start);
+
+  // Count diverged runs
+  int nb_failed = 0;
+  for (const auto &run : this->runs) {
+    nb_failed += (run.retval != 0);
+  }
+
+  return nb_failed;
+}
+
+void MSCKFMonteCarlo::printReport() const {
+  // Aggregate accuracy over runs that did not diverge
+  Histogram ate{0.0, 10.0, 1000};
+  Histogram rpe{0.0, 10.0, 1000};
+  Histogram nees{0.0, 100.0, 1000};
+  Histogram frame_time{0.0, 100.0, 1000};
+  double cpu_time = 0.0;
+  for (const auto &run : this->runs) {
+    for (const double t : run.frame_times) {
+      frame_time.add(t);
+      cpu_time += t * 1e-3;
+    }
+    if (run.retval != 0) {
+      continue;
+    }
+    ate.add(run.ate);
+    rpe.add(run.rpe);
+    nees.add(run.nees);
+  }
+
+  const int nb_failed = this->runs.size() - ate.nb_samples;
+  printf("runs: %zu  diverged: %d  ", this->runs.size(), nb_failed);
+  printf("wall time: %.2fs  filter time: %.2fs\n", this->wall_time, cpu_time);
+  std::cout << "ATE [m]: " << ate << std::endl;
+  std::cout << "RPE [m]: " << rpe << std::endl;
+  std::cout << "NEES: " << nees << std::endl;
+  std::cout << "frame time [ms]: " << frame_time << std::endl;
+}
+
+int MSCKFMonteCarlo::saveResults(const std::string &output_path) const {
+  std::ofstream output_file(output_path);
+  if (output_file.good() == false) {
+    LOG_ERROR("Failed to open file [%s] for writing!", output_path.c_str());
+    return -1;
+  }
+
+  output_file << "run,retval,ate,rpe,nees,frame_time_mean,frame_time_max";
+  output_file << std::endl;
+  for (const auto &run : this->runs) {
+    double sum = 0.0;
+    double max = 0.0;
+    for (const double t : run.frame_times) {
+      sum += t;
+      max = std::max(max, t);
+    }
+    const size_t nb_frames = run.frame_times.size();
+
+    output_file << run.index << ",";
+    output_file << run.retval << ",";
+    output_file << run.ate << ",";
+    output_file << run.rpe << ",";
+    output_file << run.nees << ",";
+    output_file << ((nb_frames) ? sum / nb_frames : 0.0) << ",";
+    output_file << max << std::endl;
+  }
+
+  return 0;
+}
+
+} // namespace gvio
@@ -11,6 +11,22 @@ std::ostream &operator<<(std::ostream &out, const Waypoint &wp) {
   return out;
 }
 
+MissionSegment::MissionSegment(const Vec3 &start, const Vec3 &end)
+    : start{start}, end{end} {
+  const Vec3 v = end - start;
+  this->length = v.norm();
+  if (this->length > 0.0) {
+    this->direction = v / this->length;
+  }
+
+  // Horizontal normal, points left of the track
+  const double horiz_length = sqrt(v(0) * v(0) + v(1) * v(1));
+  if (horiz_length > 0.0) {
+    this->normal = Vec3{-v(1) / horiz_length, v(0) / horiz_length, 0.0};
+  }
+  this->heading = atan2(v(1), v(0));
+}
+
 int Mission::configure(const std::string &config_file) {
   ConfigParser parser;
   std::vector<double> wp_data;
@@ -84,17 +100,15 @@ int Mission::loadGPSWaypoints(const std::vector<double> &waypoint_data) {
 
 int Mission::loadLocalWaypoints(const std::vector<double> &waypoint_data) {
   // Load local waypoints
+  this->local_waypoints.clear();
   for (size_t i = 0; i < waypoint_data.size(); i += 3) {
     const Vec3 wp{waypoint_data[i], waypoint_data[i + 1], waypoint_data[i + 2]};
-    std::cout << "Adding local waypoint: " << wp.transpose() << std::endl;
     this->local_waypoints.emplace_back(wp);
   }
+  LOG_INFO("Loaded %d local waypoints", (int) this->local_waypoints.size());
 
-  // Set first pair of waypoints
-  this->wp_start = this->local_waypoints[0];
-  this->wp_end = this->local_waypoints[1];
-
-  return 0;
+  // Precompute segments and set first pair of waypoints
+  return this->buildSegments();
 }
 
 int Mission::checkGPSWaypoints() {
@@ -134,7 +148,8 @@ int Mission::setGPSHomePoint(double home_lat, double home_lon) {
   }
 
   // Convert
-  for (auto gps : this->gps_waypoints) {
+  this->local_waypoints.clear();
+  for (const auto &gps : this->gps_waypoints) {
     // Convert lat lon to local frame
     const double lat = gps(0);
     const double lon = gps(1);
@@ -144,40 +159,67 @@ int Mission::setGPSHomePoint(double home_lat, double home_lon) {
 
     // Add to local waypoints in NWU
     const Vec3 nwu{dist_N, -1.0 * dist_E, alt};
-    std::cout << "Adding local waypoint (nwu): " << nwu.transpose();
-    std::cout << std::endl;
     this->local_waypoints.push_back(nwu);
   }
+  LOG_INFO("Converted %d GPS waypoints to local frame (nwu)",
+           (int) this->local_waypoints.size());
+
+  // Precompute segments and set first pair of waypoints
+  return this->buildSegments();
+}
+
+int Mission::buildSegments() {
+  // Pre-check
+  if (this->local_waypoints.size() < 2) {
+    LOG_ERROR("Mission needs at least two waypoints!");
+    return -1;
+  }
+
+  // Segments between consecutive waypoints
+  this->segments.clear();
+  this->segments.reserve(this->local_waypoints.size() - 1);
+  for (size_t i = 0; i + 1 < this->local_waypoints.size(); i++) {
+    this->segments.emplace_back(this->local_waypoints[i],
+                                this->local_waypoints[i + 1]);
+  }
 
   // Set first pair of waypoints
-  this->wp_start = this->local_waypoints[0];
-  this->wp_end = this->local_waypoints[1];
+  this->waypoint_index = 0;
+  this->segment = this->segments[0];
+  this->wp_start = this->segment.start;
+  this->wp_end = this->segment.end;
 
   return 0;
 }
 
+const MissionSegment &Mission::activeSegment() {
+  if (this->segment.start != this->wp_start ||
+      this->segment.end != this->wp_end) {
+    this->segment = MissionSegment(this->wp_start, this->wp_end);
+  }
+
+  return this->segment;
+}
+
 Vec3 Mission::closestPoint(const Vec3 &p_G) {
-  // Calculate closest point
-  const Vec3 v1 = p_G - this->wp_start;
-  const Vec3 v2 = this->wp_end - this->wp_start;
-  const double t = v1.dot(v2) / v2.squaredNorm();
+  const MissionSegment &seg = this->activeSegment();
+
+  // Project position onto segment
+  const double t = (p_G - seg.start).dot(seg.direction);
 
   // Make sure the point is between wp_start and wp_end
   if (t < 0) {
-    return this->wp_start;
-  } else if (t > 1) {
-    return this->wp_end;
+    return seg.start;
+  } else if (t > seg.length) {
+    return seg.end;
   }
 
-  return this->wp_start + t * v2;
+  return seg.start + t * seg.direction;
 }
 
 int Mission::pointLineSide(const Vec3 &p_G) {
-  const Vec3 a = this->wp_start;
-  const Vec3 b = this->wp_end;
-  const Vec3 c = p_G;
-  const double s =
-      ((b(0) - a(0)) * (c(1) - a(1)) - (b(1) - a(1)) * (c(0) - a(0)));
+  const MissionSegment &seg = this->activeSegment();
+  const double s = (p_G - seg.start).dot(seg.normal);
 
   // Position is colinear with waypoint track
   if (fltcmp(s, 0.0) == 0) {
@@ -194,17 +236,16 @@ int Mission::pointLineSide(const Vec3 &p_G) {
 }
 
 double Mission::crossTrackError(const Vec3 &p_G, int mode) {
-  Vec3 BA = this->wp_start - p_G;
-  Vec3 BC = this->wp_start - this->wp_end;
+  const MissionSegment &seg = this->activeSegment();
+  const Vec3 d = p_G - seg.start;
 
-  // Only calculate horizontal crosstrack error by setting z to 0
+  // Horizontal crosstrack error is the signed distance along the normal
   if (mode == CTRACK_HORIZ) {
-    BA(2) = 0.0;
-    BC(2) = 0.0;
+    return d.dot(seg.normal);
   }
 
   // Crosstrack error
-  const double error = (BA.cross(BC)).norm() / BC.norm();
+  const double error = (d - d.dot(seg.direction) * seg.direction).norm();
 
   // Check which side the point is on
   const int side = this->pointLineSide(p_G);
@@ -212,29 +253,14 @@ double Mission::crossTrackError(const Vec3 &p_G, int mode) {
   return error * side;
 }
 
-double Mission::waypointHeading() {
-  const double dx = this->wp_end(0) - this->wp_start(0);
-  const double dy = this->wp_end(1) - this->wp_start(1);
-
-  // Calculate heading
-  double heading = atan2(dy, dx);
-  if (heading > M_PI) {
-    heading -= 2 * M_PI;
-  } else if (heading < -M_PI) {
-    heading += 2 * M_PI;
-  }
-
-  return heading;
-}
+double Mission::waypointHeading() { return this->activeSegment().heading; }
 
 Vec3 Mission::waypointInterpolate(const Vec3 &p_G, const double r) {
   // Get closest point
   const Vec3 pt_on_line = this->closestPoint(p_G);
 
   // Calculate waypoint between wp_start and wp_end
-  const Vec3 v = this->wp_end - this->wp_start;
-  const Vec3 u = v / v.norm();
-  return pt_on_line + r * u;
+  return pt_on_line + r * this->segment.direction;
 }
 
 int Mission::waypointReached(const Vec3 &p_G) {
@@ -280,9 +306,12 @@ int Mission::update(const Vec3 &p_G, Vec3 &waypoint) {
       return -2;
 
     } else {
-      this->wp_start = this->local_waypoints[this->waypoint_index + 1];
-      this->wp_end = this->local_waypoints[this->waypoint_index + 2];
       this->waypoint_index++;
+      if (this->waypoint_index < (int) this->segments.size()) {
+        this->segment = this->segments[this->waypoint_index];
+      }
+      this->wp_start = this->local_waypoints[this->waypoint_index];
+      this->wp_end = this->local_waypoints[this->waypoint_index + 1];
     }
   }
 
@@ -0,0 +1,214 @@
+#include "gvio/quadrotor/quadrotor_batch.hpp"
+
+namespace gvio {
+
+int QuadrotorBatch::configure(const size_t nb_vehicles) {
+  if (nb_vehicles == 0) {
+    LOG_ERROR("Number of vehicles must be > 0!");
+    return -1;
+  }
+  this->nb_vehicles = nb_vehicles;
+
+  const size_t N = nb_vehicles;
+  this->state.assign(QB_STATE_SIZE * N, 0.0);
+  this->tau.assign(4 * N, 0.0);
+  this->position_setpoints.assign(N, Vec3{0.0, 0.0, 0.0});
+  this->attitude_setpoints.assign(N, Vec4{0.0, 0.0, 0.0, 0.5});
+  this->position_controllers.assign(N, PositionController());
+  this->attitude_controllers.assign(N, AttitudeController());
+
+  this->k1.assign(QB_STATE_SIZE * N, 0.0);
+  this->k2.assign(QB_STATE_SIZE * N, 0.0);
+  this->k3.assign(QB_STATE_SIZE * N, 0.0);
+  this->k4.assign(QB_STATE_SIZE * N, 0.0);
+  this->x_tmp.assign(QB_STATE_SIZE * N, 0.0);
+
+  return 0;
+}
+
+void QuadrotorBatch::setPose(const size_t k,
+                             const Vec3 &rpy_G,
+                             const Vec3 &p_G) {
+  const size_t N = this->nb_vehicles;
+  for (int i = 0; i < QB_STATE_SIZE; i++) {
+    this->state[i * N + k] = 0.0;
+  }
+  for (int i = 0; i < 3; i++) {
+    this->state[(QB_ROLL + i) * N + k] = rpy_G(i);
+    this->state[(QB_X + i) * N + k] = p_G(i);
+  }
+}
+
+void QuadrotorBatch::setMotorInputs(const size_t k, const Vec4 &motor_inputs) {
+  // Motor mixing, see `QuadrotorModel::update()`
+  const size_t N = this->nb_vehicles;
+  const double m1 = motor_inputs(0);
+  const double m2 = motor_inputs(1);
+  const double m3 = motor_inputs(2);
+  const double m4 = motor_inputs(3);
+  this->tau[0 * N + k] = m1 + m2 + m3 + m4;
+  this->tau[1 * N + k] = this->l * (m4 - m2);
+  this->tau[2 * N + k] = this->l * (m3 - m1);
+  this->tau[3 * N + k] = this->d * (-m1 + m2 - m3 + m4);
+}
+
+Vec3 QuadrotorBatch::attitude(const size_t k) const {
+  const size_t N = this->nb_vehicles;
+  return Vec3{this->state[QB_ROLL * N + k],
+              this->state[QB_PITCH * N + k],
+              this->state[QB_YAW * N + k]};
+}
+
+Vec3 QuadrotorBatch::position(const size_t k) const {
+  const size_t N = this->nb_vehicles;
+  return Vec3{this->state[QB_X * N + k],
+              this->state[QB_Y * N + k],
+              this->state[QB_Z * N + k]};
+}
+
+Vec3 QuadrotorBatch::velocity(const size_t k) const {
+  const size_t N = this->nb_vehicles;
+  return Vec3{this->state[QB_VX * N + k],
+              this->state[QB_VY * N + k],
+              this->state[QB_VZ * N + k]};
+}
+
+void QuadrotorBatch::attitudeControl(const double dt) {
+  for (size_t k = 0; k < this->nb_vehicles; k++) {
+    const Vec3 rpy_G = this->attitude(k);
+    const Vec4 actual_attitude{rpy_G(0), // roll
+                               rpy_G(1), // pitch
+                               rpy_G(2), // yaw
+                               this->state[QB_Z * this->nb_vehicles + k]};
+    const Vec4 motor_inputs =
+        this->attitude_controllers[k].update(this->attitude_setpoints[k],
+                                             actual_attitude,
+                                             dt);
+    this->setMotorInputs(k, motor_inputs);
+  }
+}
+
+void QuadrotorBatch::positionControl(const double dt) {
+  for (size_t k = 0; k < this->nb_vehicles; k++) {
+    const Vec3 p_G = this->position(k);
+    const double yaw = this->state[QB_YAW * this->nb_vehicles + k];
+    const Vec4 actual_position{p_G(0), p_G(1), p_G(2), yaw};
+    this->attitude_setpoints[k] =
+        this->position_controllers[k].update(this->position_setpoints[k],
+                                             actual_position,
+                                             0.0,
+                                             dt);
+  }
+  this->attitudeControl(dt);
+}
+
+void QuadrotorBatch::dynamics(const double *x, double *dx) const {
+  const size_t N = this->nb_vehicles;
+  const double Ix = this->Ix;
+  const double Iy = this->Iy;
+  const double Iz = this->Iz;
+  const double kr = this->kr;
+  const double kt = this->kt;
+  const double m = this->m;
+  const double g = this->g;
+
+  const double *ph = x + QB_ROLL * N;
+  const double *th = x + QB_PITCH * N;
+  const double *ps = x + QB_YAW * N;
+  const double *p = x + QB_P * N;
+  const double *q = x + QB_Q * N;
+  const double *r = x + QB_R * N;
+  const double *vx = x + QB_VX * N;
+  const double *vy = x + QB_VY * N;
+  const double *vz = x + QB_VZ * N;
+  const double *tauf = this->tau.data();
+  const double *taup = tauf + N;
+  const double *tauq = tauf + 2 * N;
+  const double *taur = tauf + 3 * N;
+
+  for (size_t k = 0; k < N; k++) {
+    // Trigonometric terms shared by all equations
+    const double s_ph = sin(ph[k]);
+    const double c_ph = cos(ph[k]);
+    const double s_th = sin(th[k]);
+    const double c_th = cos(th[k]);
+    const double s_ps = sin(ps[k]);
+    const double c_ps = cos(ps[k]);
+    const double t_th = s_th / c_th;
+
+    // clang-format off
+    dx[QB_ROLL * N + k] = p[k] + q[k] * s_ph * t_th + r[k] * c_ph * t_th;
+    dx[QB_PITCH * N + k] = q[k] * c_ph - r[k] * s_ph;
+    dx[QB_YAW * N + k] = (1 / c_th) * (q[k] * s_ph + r[k] * c_ph);
+
+    dx[QB_P * N + k] = -((Iz - Iy) / Ix) * q[k] * r[k] - (kr * p[k] / Ix) + (1 / Ix) * taup[k];
+    dx[QB_Q * N + k] = -((Ix - Iz) / Iy) * p[k] * r[k] - (kr * q[k] / Iy) + (1 / Iy) * tauq[k];
+    dx[QB_R * N + k] = -((Iy - Ix) / Iz) * p[k] * q[k] - (kr * r[k] / Iz) + (1 / Iz) * taur[k];
+
+    dx[QB_X * N + k] = vx[k];
+    dx[QB_Y * N + k] = vy[k];
+    dx[QB_Z * N + k] = vz[k];
+
+    dx[QB_VX * N + k] = (-kt * vx[k] / m) + (1 / m) * (c_ph * s_th * c_ps + s_ph * s_ps) * tauf[k];
+    dx[QB_VY * N + k] = (-kt * vy[k] / m) + (1 / m) * (c_ph * s_th * s_ps - s_ph * c_ps) * tauf[k];
+    dx[QB_VZ * N + k] = -(kt * vz[k] / m) + (1 / m) * (c_ph * c_th) * tauf[k] - g;
+    // clang-format on
+  }
+}
+
+void QuadrotorBatch::integrate(const double dt) {
+  const size_t size = this->state.size();
+  double *x = this->state.data();
+
+  if (this->integrator == QB_RK4) {
+    double *x_tmp = this->x_tmp.data();
+    double *k1 = this->k1.data();
+    double *k2 = this->k2.data();
+    double *k3 = this->k3.data();
+    double *k4 = this->k4.data();
+
+    this->dynamics(x, k1);
+    for (size_t i = 0; i < size; i++) {
+      x_tmp[i] = x[i] + 0.5 * dt * k1[i];
+    }
+    this->dynamics(x_tmp, k2);
+    for (size_t i = 0; i < size; i++) {
+      x_tmp[i] = x[i] + 0.5 * dt * k2[i];
+    }
+    this->dynamics(x_tmp, k3);
+    for (size_t i = 0; i < size; i++) {
+      x_tmp[i] = x[i] + dt * k3[i];
+    }
+    this->dynamics(x_tmp, k4);
+    for (size_t i = 0; i < size; i++) {
+      x[i] += dt / 6.0 * (k1[i] + 2.0 * k2[i] + 2.0 * k3[i] + k4[i]);
+    }
+
+  } else {
+    double *dx = this->k1.data();
+    this->dynamics(x, dx);
+    for (size_t i = 0; i < size; i++) {
+      x[i] += dx[i] * dt;
+    }
+  }
+
+  // Constrain yaw to be [-180, 180]
+  double *yaw = x + QB_YAW * this->nb_vehicles;
+  for (size_t k = 0; k < this->nb_vehicles; k++) {
+    yaw[k] = wrapToPi(yaw[k]);
+  }
+}
+
+int QuadrotorBatch::update(const double dt) {
+  if (this->nb_vehicles == 0) {
+    LOG_ERROR("QuadrotorBatch is not configured!");
+    return -1;
+  }
+
+  this->positionControl(dt);
+  this->integrate(dt);
+
+  return 0;
+}
+
+} // namespace gvio
@@ -3,7 +3,7 @@
 namespace gvio {
 
 int QuadrotorModel::loadMission(const std::string &mission_file) {
-  this->ctrl_mode = "WP_CTRL_MODE";
+  this->ctrl_mode = WP_CTRL_MODE;
   if (this->mission.configure(mission_file) != 0) {
     return -1;
   }
@@ -90,22 +90,93 @@ int QuadrotorModel::update(const VecX &motor_inputs, const double dt) {
 
 int QuadrotorModel::update(const double dt) {
   Vec4 motor_inputs;
-  if (this->ctrl_mode == "POS_CTRL_MODE") {
-    motor_inputs = this->positionControllerControl(dt);
+  switch (this->ctrl_mode) {
+    case POS_CTRL_MODE:
+      motor_inputs = this->positionControllerControl(dt);
+      break;
+
+    case ATT_CTRL_MODE:
+      motor_inputs = this->attitudeControllerControl(dt);
+      break;
+
+    case WP_CTRL_MODE:
+      if (this->mission.configured == false) {
+        LOG_ERROR("Mission is not configured!");
+        return -1;
+      }
+      motor_inputs = this->waypointControllerControl(dt);
+      break;
+
+    default:
+      LOG_ERROR("Invalid control mode [%d]!", (int) this->ctrl_mode);
+      return -1;
+  }
 
-  } else if (this->ctrl_mode == "ATT_CTRL_MODE") {
-    motor_inputs = this->attitudeControllerControl(dt);
+  return this->update(motor_inputs, dt);
+}
 
-  } else if (this->ctrl_mode == "WP_CTRL_MODE") {
-    if (this->mission.configured == false) {
-      LOG_ERROR("Mission is not configured!");
-      return -1;
+int QuadrotorModel::addTasks(PeriodicExecutor &executor) {
+  if (this->ctrl_mode == WP_CTRL_MODE && this->mission.configured == false) {
+    LOG_ERROR("Mission is not configured!");
+    return -1;
+  }
+
+  // Attitude controller and dynamics
+  auto attitude_task = [this](const double dt) {
+    return this->update(this->attitudeControllerControl(dt), dt);
+  };
+
+  // Position controller
+  auto position_task = [this](const double dt) {
+    if (this->ctrl_mode != POS_CTRL_MODE) {
+      return 0;
     }
+    const Vec4 actual_position{this->p_G(0),    // x
+                               this->p_G(1),    // y
+                               this->p_G(2),    // z
+                               this->rpy_G(2)}; // yaw
+    this->attitude_setpoints =
+        this->position_controller.update(this->position_setpoints,
+                                         actual_position,
+                                         0.0,
+                                         dt);
+    return 0;
+  };
 
-    motor_inputs = this->waypointControllerControl(dt);
+  // Waypoint controller
+  auto waypoint_task = [this](const double dt) {
+    if (this->ctrl_mode != WP_CTRL_MODE) {
+      return 0;
+    }
+    const int retval = this->waypoint_controller.update(this->mission,
+                                                        this->p_G,
+                                                        this->v_G,
+                                                        this->rpy_G,
+                                                        dt);
+    if (retval != 0) {
+      this->attitude_setpoints = Vec4{0.0, 0.0, 0.0, 0.5};
+    } else {
+      this->attitude_setpoints = this->waypoint_controller.outputs;
+    }
+    return 0;
+  };
+
+  // Outer loops first, so on a shared release the attitude controller
+  // already tracks the setpoints computed in the same tick
+  const double att_rate = this->attitude_rate;
+  const double pos_rate = this->position_rate;
+  const double wp_rate = this->waypoint_rate;
+  if (executor.addTask("waypoint", wp_rate, 2, waypoint_task) != 0) {
+    return -1;
+  }
+  if (executor.addTask("position", pos_rate, 1, position_task) != 0) {
+    return -1;
+  }
+  if (executor.addTask("attitude", att_rate, 0, attitude_task) != 0) {
+    return -1;
   }
 
-  return this->update(motor_inputs, dt);
+  return 0;
 }
 
 Vec4 QuadrotorModel::attitudeControllerControl(const double dt) {
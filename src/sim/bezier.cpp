@@ -0,0 +1,121 @@
+#include "gvio/sim/bezier.hpp"
+
+namespace gvio {
+
+/**
+ * Evaluate power basis polynomial with Horner's scheme at a vector of times
+ */
+static void horner(const Mat3X &coeffs, const VecX &t, Mat3X &result) {
+  const long nb_coeffs = coeffs.cols();
+  const long nb_times = t.size();
+  result.resize(3, nb_times);
+
+  // Horner per time on the raw column-major data, no temporaries
+  const double *c = coeffs.data();
+  const double *t_data = t.data();
+  double *r = result.data();
+  for (long j = 0; j < nb_times; j++) {
+    double x = 0.0;
+    double y = 0.0;
+    double z = 0.0;
+    for (long k = nb_coeffs - 1; k >= 0; k--) {
+      x = x * t_data[j] + c[3 * k];
+      y = y * t_data[j] + c[3 * k + 1];
+      z = z * t_data[j] + c[3 * k + 2];
+    }
+    r[3 * j] = x;
+    r[3 * j + 1] = y;
+    r[3 * j + 2] = z;
+  }
+}
+
+/**
+ * Evaluate power basis polynomial with Horner's scheme at t
+ */
+static Vec3 horner(const Mat3X &coeffs, const double t) {
+  Vec3 result{0.0, 0.0, 0.0};
+  for (long k = coeffs.cols() - 1; k >= 0; k--) {
+    result = result * t + coeffs.col(k);
+  }
+
+  return result;
+}
+
+/**
+ * Differentiate power basis polynomial
+ */
+static Mat3X power_derivative(const Mat3X &coeffs) {
+  const long nb_coeffs = std::max(0L, (long) coeffs.cols() - 1);
+  Mat3X result{3, nb_coeffs};
+  for (long k = 0; k < nb_coeffs; k++) {
+    result.col(k) = (k + 1) * coeffs.col(k + 1);
+  }
+
+  return result;
+}
+
+BezierCurve::BezierCurve(const std::vector<Vec3> &points) {
+  this->configure(points);
+}
+
+int BezierCurve::configure(const std::vector<Vec3> &points) {
+  if (points.size() == 0) {
+    LOG_ERROR("Bezier curve needs at least one control point!");
+    return -1;
+  }
+  this->points = points;
+
+  // Binomial coefficients, row n of Pascal's triangle is binom[n]
+  const int n = this->degree();
+  std::vector<std::vector<double>> binom(n + 1);
+  for (int i = 0; i <= n; i++) {
+    binom[i].assign(i + 1, 1.0);
+    for (int j = 1; j < i; j++) {
+      binom[i][j] = binom[i - 1][j - 1] + binom[i - 1][j];
+    }
+  }
+
+  // Convert control points to power basis:
+  // c_j = C(n, j) * sum_{i = 0}^{j} (-1)^(j - i) C(j, i) P_i
+  this->coeffs_pos = Mat3X::Zero(3, n + 1);
+  for (int j = 0; j <= n; j++) {
+    for (int i = 0; i <= j; i++) {
+      const double sign = ((j - i) % 2 == 0) ? 1.0 : -1.0;
+      this->coeffs_pos.col(j) += sign * binom[j][i] * points[i];
+    }
+    this->coeffs_pos.col(j) *= binom[n][j];
+  }
+  this->coeffs_vel = power_derivative(this->coeffs_pos);
+  this->coeffs_acc = power_derivative(this->coeffs_vel);
+
+  return 0;
+}
+
+Vec3 BezierCurve::position(const double t) const {
+  return horner(this->coeffs_pos, t);
+}
+
+Vec3 BezierCurve::velocity(const double t) const {
+  return horner(this->coeffs_vel, t);
+}
+
+Vec3 BezierCurve::acceleration(const double t) const {
+  return horner(this->coeffs_acc, t);
+}
+
+void BezierCurve::evaluate(const VecX &t,
+                           Mat3X *pos,
+                           Mat3X *vel,
+                           Mat3X *acc) const {
+  if (pos != nullptr) {
+    horner(this->coeffs_pos, t, *pos);
+  }
+  if (vel != nullptr) {
+    horner(this->coeffs_vel, t, *vel);
+  }
+  if (acc != nullptr) {
+    horner(this->coeffs_acc, t, *acc);
+  }
+}
+
+} // namespace gvio
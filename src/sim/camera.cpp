@@ -2,58 +2,160 @@
 
 namespace gvio {
 
+// Convert from Global frame NWU to Camera frame EDN
+// NWU: (x - forward, y - left, z - up)
+// EDN: (x - right, y - down, z - forward)
+static const Mat3 R_CG = rotx(-M_PI / 2.0) * rotz(-M_PI / 2.0);
+
+static Mat3 camera_rotation(const Vec3 &rpy_G) {
+  const Vec3 rpy_C{-rpy_G(1), -rpy_G(2), rpy_G(0)};
+  return euler123ToRot(rpy_C);
+}
+
 MatX VirtualCamera::observedFeatures(const MatX &features,
                                      const Vec3 &rpy_G,
                                      const Vec3 &t_G,
                                      std::vector<int> &mask) {
   // Rotation matrix
-  // Convert from Global frame NWU to Camera frame EDN
-  // NWU: (x - forward, y - left, z - up)
-  // EDN: (x - right, y - down, z - forward)
-  const Vec3 rpy_C{-rpy_G(1), -rpy_G(2), rpy_G(0)};
-  const Mat3 R = euler123ToRot(rpy_C);
-
-  // Check which features are observable from camera
-  std::vector<Vec2> observed;
-  for (int i = 0; i < features.rows(); i++) {
-    // Transform point from global frame to camera frame
-    const Vec3 pt_G = features.row(i).transpose();
-    const Vec3 pt_C = rotx(-M_PI / 2.0) * rotz(-M_PI / 2.0) * pt_G;
+  const Mat3 R = camera_rotation(rpy_G);
 
-    // Transform translation from global frame to camera frame
-    const Vec3 t_C = rotx(-M_PI / 2.0) * rotz(-M_PI / 2.0) * t_G;
+  // Transform points and translation from global frame to camera frame
+  const Mat3X pts_C = R_CG * features.transpose();
+  const Vec3 t_C = R_CG * t_G;
 
-    // Project 3D world point to 2D image plane
-    Vec3 img_pt = this->camera_model.project(homogeneous(pt_C), R, t_C);
+  // Project 3D world points to 2D image plane
+  Mat2X pixels;
+  VecX depths;
+  this->camera_model.project(pts_C, R, t_C, pixels, depths);
 
+  // Check which features are observable from camera
+  const int image_width = this->camera_model.image_width;
+  const int image_height = this->camera_model.image_height;
+  std::vector<int> observed;
+  for (long i = 0; i < pixels.cols(); i++) {
     // Check to see if feature is valid and infront of camera
-    if (img_pt(2) < 1.0) {
+    if (depths(i) < this->min_depth) {
       continue; // skip this feature! It is not infront of camera
     }
 
-    // Normalize pixels
-    img_pt(0) = img_pt(0) / img_pt(2);
-    img_pt(1) = img_pt(1) / img_pt(2);
-    img_pt(2) = img_pt(2) / img_pt(2);
-
     // Check to see if feature observed is within image plane
-    const int image_width = this->camera_model.image_width;
-    const int image_height = this->camera_model.image_height;
-    const bool x_ok = (img_pt(0) < image_width) && (img_pt(0) > 0.0);
-    const bool y_ok = (img_pt(1) < image_height) && (img_pt(1) > 0.0);
+    const bool x_ok = (pixels(0, i) < image_width) && (pixels(0, i) > 0.0);
+    const bool y_ok = (pixels(1, i) < image_height) && (pixels(1, i) > 0.0);
     if (x_ok && y_ok) {
-      observed.emplace_back(img_pt(0), img_pt(1));
+      observed.push_back(i);
       mask.push_back(i);
     }
   }
 
-  // Convert vector of Vec2 to MatX
+  // Convert observed pixels to MatX
   MatX result = zeros(observed.size(), 2);
   for (size_t i = 0; i < observed.size(); i++) {
-    result.block(i, 0, 1, 2) = observed[i].transpose();
+    result.block(i, 0, 1, 2) = pixels.col(observed[i]).transpose();
   }
 
   return result;
 }
 
+void VirtualCamera::observedFeatures(const FeatureGrid &grid,
+                                     const Vec3 &rpy_G,
+                                     const Vec3 &t_G,
+                                     std::vector<int> &feature_ids,
+                                     Mat2X &keypoints) {
+  feature_ids.clear();
+
+  // Far plane just beyond the grid corner furthest from the camera
+  double max_depth = this->min_depth;
+  for (int i = 0; i < 8; i++) {
+    const Vec3 corner{(i & 1) ? grid.grid_max(0) : grid.grid_min(0),
+                      (i & 2) ? grid.grid_max(1) : grid.grid_min(1),
+                      (i & 4) ? grid.grid_max(2) : grid.grid_min(2)};
+    max_depth = std::max(max_depth, (corner - t_G).norm() + 1.0);
+  }
+
+  // Cull grid cells outside the camera frustum
+  grid.query(this->frustum(rpy_G, t_G, max_depth), this->cells);
+  int nb_candidates = 0;
+  for (const int c : this->cells) {
+    nb_candidates += grid.cell_start[c + 1] - grid.cell_start[c];
+  }
+  keypoints.resize(2, nb_candidates);
+
+  // Project candidates, same arithmetic as `PinholeModel::project()`
+  const Mat3 R = camera_rotation(rpy_G);
+  const Vec3 t_C = R_CG * t_G;
+  const double fx = this->camera_model.fx;
+  const double fy = this->camera_model.fy;
+  const double cx = this->camera_model.cx;
+  const double cy = this->camera_model.cy;
+  const int image_width = this->camera_model.image_width;
+  const int image_height = this->camera_model.image_height;
+  int nb_observed = 0;
+  for (const int c : this->cells) {
+    for (int n = grid.cell_start[c]; n < grid.cell_start[c + 1]; n++) {
+      const Vec3 p_C = R * (R_CG * grid.points[n] - t_C);
+      if (p_C(2) < this->min_depth) {
+        continue;
+      }
+
+      const double inv_z = 1.0 / p_C(2);
+      const double x = fx * p_C(0) * inv_z + cx;
+      const double y = fy * p_C(1) * inv_z + cy;
+      const bool x_ok = (x < image_width) && (x > 0.0);
+      const bool y_ok = (y < image_height) && (y > 0.0);
+      if (x_ok && y_ok) {
+        keypoints(0, nb_observed) = x;
+        keypoints(1, nb_observed) = y;
+        feature_ids.push_back(grid.ids[n]);
+        nb_observed++;
+      }
+    }
+  }
+  keypoints.conservativeResize(2, nb_observed);
+}
+
+Frustum VirtualCamera::frustum(const Vec3 &rpy_G,
+                               const Vec3 &t_G,
+                               const double max_depth) const {
+  // Global to camera frame rotation
+  const Mat3 R = camera_rotation(rpy_G) * R_CG;
+
+  // Image bounds on the normalized image plane
+  const PinholeModel &cam = this->camera_model;
+  const double x_min = -cam.cx / cam.fx;
+  const double x_max = (cam.image_width - cam.cx) / cam.fx;
+  const double y_min = -cam.cy / cam.fy;
+  const double y_max = (cam.image_height - cam.cy) / cam.fy;
+
+  // Planes in camera frame
+  const Vec4 planes_C[6] = {Vec4{0.0, 0.0, 1.0, -this->min_depth},
+                            Vec4{0.0, 0.0, -1.0, max_depth},
+                            Vec4{1.0, 0.0, -x_min, 0.0},
+                            Vec4{-1.0, 0.0, x_max, 0.0},
+                            Vec4{0.0, 1.0, -y_min, 0.0},
+                            Vec4{0.0, -1.0, y_max, 0.0}};
+
+  // Transform planes to global frame, n_C' R (p - t) + d >= 0
+  Frustum frustum;
+  for (int i = 0; i < 6; i++) {
+    const Vec3 n_G = R.transpose() * planes_C[i].head(3);
+    frustum.planes[i].head(3) = n_G;
+    frustum.planes[i](3) = planes_C[i](3) - n_G.dot(t_G);
+  }
+
+  // Bounding box of frustum corners
+  frustum.box_min = t_G;
+  frustum.box_max = t_G;
+  for (const double z : {this->min_depth, max_depth}) {
+    for (const double x : {x_min, x_max}) {
+      for (const double y : {y_min, y_max}) {
+        const Vec3 corner = R.transpose() * Vec3{x * z, y * z, z} + t_G;
+        frustum.box_min = frustum.box_min.cwiseMin(corner);
+        frustum.box_max = frustum.box_max.cwiseMax(corner);
+      }
+    }
+  }
+
+  return frustum;
+}
+
 } // namespace gvio
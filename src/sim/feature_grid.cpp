@@ -0,0 +1,130 @@
+#include "gvio/sim/feature_grid.hpp"
+
+namespace gvio {
+
+bool Frustum::intersects(const Vec3 &box_min, const Vec3 &box_max) const {
+  // Bounding box
+  for (int i = 0; i < 3; i++) {
+    if (box_max(i) < this->box_min(i) || box_min(i) > this->box_max(i)) {
+      return false;
+    }
+  }
+
+  // Box is outside if its corner furthest along the plane normal is outside
+  for (const Vec4 &plane : this->planes) {
+    double d = plane(3);
+    for (int i = 0; i < 3; i++) {
+      d += plane(i) * ((plane(i) > 0.0) ? box_max(i) : box_min(i));
+    }
+    if (d < 0.0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+int FeatureGrid::build(const MatX &features, const double cell_size) {
+  const long nb_features = features.rows();
+  if (nb_features == 0 || features.cols() != 3) {
+    LOG_ERROR("Invalid features matrix [%ldx%ld]!",
+              (long) features.rows(),
+              (long) features.cols());
+    return -1;
+  }
+
+  // Bounds, padded so features on the max bound fall inside the last cell
+  this->grid_min = features.colwise().minCoeff().transpose();
+  this->grid_max = features.colwise().maxCoeff().transpose();
+  const Vec3 extent = (this->grid_max - this->grid_min).array() + 1e-6;
+  this->grid_max = this->grid_min + extent;
+
+  // Cell size
+  this->cell_size = cell_size;
+  if (this->cell_size <= 0.0) {
+    const double volume = extent(0) * extent(1) * extent(2);
+    const double cell_volume = volume * FEATURE_GRID_CELL_FEATURES;
+    this->cell_size = std::cbrt(cell_volume / nb_features);
+  }
+  this->cell_size = std::max(this->cell_size,
+                             extent.maxCoeff() / FEATURE_GRID_MAX_CELLS);
+  for (int i = 0; i < 3; i++) {
+    this->nb_cells[i] = std::ceil(extent(i) / this->cell_size);
+    this->nb_cells[i] = std::max(1, this->nb_cells[i]);
+  }
+
+  // Assign features to cells
+  const int total_cells = this->nb_cells[0] * this->nb_cells[1] *
+                          this->nb_cells[2];
+  std::vector<int> feature_cell(nb_features);
+  this->cell_start.assign(total_cells + 1, 0);
+  for (long n = 0; n < nb_features; n++) {
+    int index[3];
+    for (int i = 0; i < 3; i++) {
+      const double x = features(n, i) - this->grid_min(i);
+      index[i] = std::min((int) (x / this->cell_size), this->nb_cells[i] - 1);
+    }
+    feature_cell[n] = this->cellIndex(index[0], index[1], index[2]);
+    this->cell_start[feature_cell[n] + 1]++;
+  }
+
+  // Counting sort features by cell
+  for (int c = 0; c < total_cells; c++) {
+    this->cell_start[c + 1] += this->cell_start[c];
+  }
+  std::vector<int> offset(this->cell_start.begin(), this->cell_start.end());
+  this->ids.resize(nb_features);
+  this->points.resize(nb_features);
+  for (long n = 0; n < nb_features; n++) {
+    const int slot = offset[feature_cell[n]]++;
+    this->ids[slot] = n;
+    this->points[slot] = features.row(n).transpose();
+  }
+
+  return 0;
+}
+
+void FeatureGrid::query(const Frustum &frustum, std::vector<int> &cells) const {
+  cells.clear();
+  if (this->size() == 0) {
+    return;
+  }
+
+  // Range of cells overlapping the frustum bounding box
+  int lo[3];
+  int hi[3];
+  for (int i = 0; i < 3; i++) {
+    const double box_lo = (frustum.box_min(i) - this->grid_min(i));
+    const double box_hi = (frustum.box_max(i) - this->grid_min(i));
+    if (box_hi < 0.0 || box_lo > this->grid_max(i) - this->grid_min(i)) {
+      return;
+    }
+    lo[i] = std::max(0, (int) std::floor(box_lo / this->cell_size));
+    hi[i] = std::min(this->nb_cells[i] - 1,
+                     (int) std::floor(box_hi / this->cell_size));
+  }
+
+  // Test non-empty cells against the frustum planes
+  for (int k = lo[2]; k <= hi[2]; k++) {
+    for (int j = lo[1]; j <= hi[1]; j++) {
+      for (int i = lo[0]; i <= hi[0]; i++) {
+        const int c = this->cellIndex(i, j, k);
+        if (this->cell_start[c] == this->cell_start[c + 1]) {
+          continue;
+        }
+
+        // Padded, a feature on a cell border may be bucketed either side
+        const Vec3 ijk{i * 1.0, j * 1.0, k * 1.0};
+        const Vec3 cell_min = this->grid_min + ijk * this->cell_size;
+        const Vec3 cell_max = cell_min.array() + this->cell_size;
+        const double pad = 1e-6 * this->cell_size;
+        if (frustum.intersects(cell_min.array() - pad,
+                               cell_max.array() + pad)) {
+          cells.push_back(c);
+        }
+      }
+    }
+  }
+}
+
+} // namespace gvio
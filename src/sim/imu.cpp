@@ -0,0 +1,38 @@
+#include "gvio/sim/imu.hpp"
+
+namespace gvio {
+
+void SimIMU::reset() {
+  this->rng.seed(this->seed);
+  this->b_a = Vec3::Zero();
+  this->b_g = Vec3::Zero();
+}
+
+void SimIMU::measure(const double dt,
+                     const Mat3 &R_GB,
+                     const Vec3 &a_G,
+                     const Vec3 &w_B,
+                     Vec3 &a_m,
+                     Vec3 &w_m) {
+  // Discretize noise densities
+  const double sigma_a = this->accel_noise_density / sqrt(dt);
+  const double sigma_g = this->gyro_noise_density / sqrt(dt);
+  const double sigma_ba = this->accel_random_walk * sqrt(dt);
+  const double sigma_bg = this->gyro_random_walk * sqrt(dt);
+
+  // Bias random walk
+  for (int i = 0; i < 3; i++) {
+    this->b_a(i) += randn(this->rng, 0.0, sigma_ba);
+    this->b_g(i) += randn(this->rng, 0.0, sigma_bg);
+  }
+
+  // Measurements
+  a_m = R_GB.transpose() * (a_G - this->g_G) + this->b_a;
+  w_m = w_B + this->b_g;
+  for (int i = 0; i < 3; i++) {
+    a_m(i) += randn(this->rng, 0.0, sigma_a);
+    w_m(i) += randn(this->rng, 0.0, sigma_g);
+  }
+}
+
+} // namespace gvio
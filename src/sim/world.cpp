@@ -6,11 +6,17 @@ int SimWorld::configure(const double dt) {
   // Time settings
   this->t = 0.0;
   this->dt = dt;
+  this->time_index = 0;
+  this->rng.seed(this->seed);
+  this->imu.reset();
 
   // Features
   this->features3d = this->create3DFeaturePerimeter(this->origin,
                                                     this->dimensions,
                                                     this->nb_features);
+  if (this->buildIndex() != 0) {
+    return -1;
+  }
 
   // Robot settings
   double circle_radius = 5.0;
@@ -34,33 +40,58 @@ int SimWorld::configure(const double dt) {
   return 0;
 }
 
+int SimWorld::buildIndex() {
+  if (this->grid.build(this->features3d) != 0) {
+    LOG_ERROR("Failed to build feature grid!");
+    return -1;
+  }
+
+  const size_t nb_features = this->features3d.rows();
+  this->features_tracking.clear();
+  this->tracks_tracking.clear();
+  this->feature_track.assign(nb_features, -1);
+  this->feature_seen.assign(nb_features, 0);
+  this->nb_detections = 0;
+
+  return 0;
+}
+
 void SimWorld::detectFeatures() {
+  if (this->grid.size() != (size_t) this->features3d.rows()) {
+    this->buildIndex();
+  }
+  this->nb_detections++;
+
   // Check what features are observed
-  std::vector<int> feature_ids;
-  MatX keypoints = camera.observedFeatures(this->features3d,
-                                           this->robot.rpy_G,
-                                           this->robot.p_G,
-                                           feature_ids);
-
-  // Get features lost
-  std::vector<int> tracks_lost;
-  std::set_difference(this->features_tracking.begin(),
-                      this->features_tracking.end(),
-                      feature_ids.begin(),
-                      feature_ids.end(),
-                      std::inserter(tracks_lost, tracks_lost.begin()));
+  this->camera.observedFeatures(this->grid,
+                                this->robot.rpy_G,
+                                this->robot.p_G,
+                                this->observed_ids,
+                                this->keypoints);
+
+  // Add keypoint noise and convert to image coordinates
+  Mat2X pixels = this->keypoints;
+  if (this->pixel_noise > 0.0) {
+    for (long i = 0; i < pixels.cols(); i++) {
+      pixels(0, i) += randn(this->rng, 0.0, this->pixel_noise);
+      pixels(1, i) += randn(this->rng, 0.0, this->pixel_noise);
+    }
+  }
+  Mat2X img_pts;
+  this->camera.camera_model.pixel2image(pixels, img_pts);
 
   // Add or updated features observed
-  for (size_t i = 0; i < feature_ids.size(); i++) {
-    const size_t feature_id = feature_ids[i];
-    const Vec2 kp = keypoints.row(i).transpose();
-    const Vec2 img_pt = camera.camera_model.pixel2image(kp);
+  for (size_t i = 0; i < this->observed_ids.size(); i++) {
+    const int feature_id = this->observed_ids[i];
+    const Vec2 img_pt = img_pts.col(i);
     const Vec3 ground_truth = this->features3d.row(feature_id).transpose();
     const Feature f{img_pt, ground_truth};
+    this->feature_seen[feature_id] = this->nb_detections;
 
-    if (this->tracks_tracking.count(feature_id)) {
+    const int index = this->feature_track[feature_id];
+    if (index != -1) {
       // Update feature track
-      this->tracks_tracking[feature_id].update(this->time_index, f);
+      this->tracks_tracking[index].update(this->time_index, f);
 
     } else {
       // Add feature track
@@ -68,15 +99,31 @@ void SimWorld::detectFeatures() {
       track.frame_start = this->time_index;
       track.frame_end = this->time_index;
       track.track.push_back(f);
-      this->tracks_tracking[feature_id] = track;
+      this->feature_track[feature_id] = this->tracks_tracking.size();
+      this->features_tracking.push_back(feature_id);
+      this->tracks_tracking.push_back(track);
     }
   }
-  this->features_tracking = feature_ids;
 
-  // Remove lost features
-  for (auto feature_id : tracks_lost) {
-    this->tracks_lost.push_back(this->tracks_tracking[feature_id]);
-    this->tracks_tracking.erase(this->tracks_tracking.find(feature_id));
+  // Remove lost features, the last track is moved into the freed slot
+  size_t index = 0;
+  while (index < this->tracks_tracking.size()) {
+    const int feature_id = this->features_tracking[index];
+    if (this->feature_seen[feature_id] == this->nb_detections) {
+      index++;
+      continue;
+    }
+
+    this->tracks_lost.push_back(std::move(this->tracks_tracking[index]));
+    this->feature_track[feature_id] = -1;
+    if (index + 1 < this->tracks_tracking.size()) {
+      const int last_id = this->features_tracking.back();
+      this->tracks_tracking[index] = std::move(this->tracks_tracking.back());
+      this->features_tracking[index] = last_id;
+      this->feature_track[last_id] = index;
+    }
+    this->tracks_tracking.pop_back();
+    this->features_tracking.pop_back();
   }
 }
 
@@ -95,9 +142,9 @@ MatX SimWorld::create3DFeatures(const struct feature_bounds &bounds,
   // Create random 3D features
   MatX features = zeros(nb_features, 3);
   for (size_t i = 0; i < nb_features; i++) {
-    features(i, 0) = randf(bounds.x_min, bounds.x_max);
-    features(i, 1) = randf(bounds.y_min, bounds.y_max);
-    features(i, 2) = randf(bounds.z_min, bounds.z_max);
+    features(i, 0) = randf(this->rng, bounds.x_min, bounds.x_max);
+    features(i, 1) = randf(this->rng, bounds.y_min, bounds.y_max);
+    features(i, 2) = randf(this->rng, bounds.z_min, bounds.z_max);
   }
 
   return features;
@@ -162,14 +209,72 @@ MatX SimWorld::create3DFeaturePerimeter(const Vec3 &origin,
   return features;
 }
 
+int SimWorld::measureIMU(const double dt, const long ts) {
+  // True acceleration and angular velocity, the body velocity of the robot
+  // is constant between updates
+  const Mat3 R_GB = euler321ToRot(this->robot.rpy_G);
+  const Vec3 a_G = R_GB * this->robot.w_B.cross(this->robot.v_B);
+
+  Vec3 a_m;
+  Vec3 w_m;
+  this->imu.measure(dt, R_GB, a_G, this->robot.w_B, a_m, w_m);
+  if (this->imu_cb != nullptr) {
+    return this->imu_cb(a_m, w_m, ts);
+  }
+
+  return 0;
+}
+
 int SimWorld::step() {
-  // Update robot
-  this->robot.update(this->dt);
+  const long ts_prev = round(this->t * 1e9);
+  const long ts = round((this->t + this->dt) * 1e9);
+
+  // Update robot, at the IMU rate if the IMU is enabled
+  if (this->imu.rate > 0.0) {
+    const int nb_imu = std::max(1, (int) round(this->dt * this->imu.rate));
+    const double imu_dt = this->dt / nb_imu;
+    for (int i = 1; i <= nb_imu; i++) {
+      this->robot.update(imu_dt);
+      const long ts_imu = ts_prev + (ts - ts_prev) * i / nb_imu;
+      if (this->measureIMU(imu_dt, ts_imu) != 0) {
+        LOG_ERROR("IMU callback failed! Stopping SimWorld!");
+        return -2;
+      }
+    }
+  } else {
+    this->robot.update(this->dt);
+  }
   this->t += this->dt;
   this->time_index++;
 
   // Update camera
   this->detectFeatures();
+  if (this->camera_cb != nullptr) {
+    const FeatureTracks tracks = this->removeLostTracks();
+    if (this->camera_cb(tracks, ts) != 0) {
+      LOG_ERROR("Camera callback failed! Stopping SimWorld!");
+      return -3;
+    }
+  }
+
+  return 0;
+}
+
+int SimWorld::run() {
+  if (this->dt <= 0.0) {
+    LOG_ERROR("Invalid time step [%f]!", this->dt);
+    return -1;
+  }
+
+  // Step an integer number of times, comparing the accumulated time against
+  // t_end could add or drop the last step due to rounding
+  const long nb_steps = round((this->t_end - this->t) / this->dt);
+  for (long i = 0; i < nb_steps; i++) {
+    const int retval = this->step();
+    if (retval != 0) {
+      return retval;
+    }
+  }
 
   return 0;
 }
@@ -0,0 +1,309 @@
+#include "gvio/util/acquisition.hpp"
+
+namespace gvio {
+
+// Min-heap comparator, oldest event on top
+static bool event_later(const SensorEvent &a, const SensorEvent &b) {
+  if (a.timestamp != b.timestamp) {
+    return a.timestamp > b.timestamp;
+  }
+  return a.sensor_id > b.sensor_id;
+}
+
+AcquisitionService::~AcquisitionService() {
+  this->stop();
+}
+
+int AcquisitionService::addSensor(const std::string &name,
+                                  const SensorEventType type,
+                                  const SensorReadFunc &read,
+                                  const double period) {
+  if (this->merger_running) {
+    LOG_ERROR("Cannot add sensor [%s] while running!", name.c_str());
+    return -1;
+  } else if (!read) {
+    LOG_ERROR("Sensor [%s] has no read function!", name.c_str());
+    return -1;
+  }
+
+  auto sensor = std::unique_ptr<AcquisitionSensor>(
+      new AcquisitionSensor(this->queue_capacity));
+  sensor->name = name;
+  sensor->type = type;
+  sensor->read = read;
+  sensor->period = period;
+  this->sensors.push_back(std::move(sensor));
+
+  return this->sensors.size() - 1;
+}
+
+int AcquisitionService::record(const int sensor_id,
+                               const int data_stream,
+                               const int image_stream,
+                               const std::string &image_dir) {
+  if (this->merger_running) {
+    LOG_ERROR("Cannot change recording while running!");
+    return -1;
+  } else if (sensor_id < 0 || sensor_id >= (int) this->sensors.size()) {
+    LOG_ERROR("Invalid sensor id [%d]!", sensor_id);
+    return -1;
+  } else if (this->writer == nullptr) {
+    LOG_ERROR("Async writer not set!");
+    return -1;
+  }
+
+  AcquisitionSensor &sensor = *this->sensors[sensor_id];
+  sensor.data_stream = data_stream;
+  sensor.image_stream = image_stream;
+  sensor.image_dir = image_dir;
+
+  return 0;
+}
+
+int AcquisitionService::start() {
+  if (this->merger_running) {
+    LOG_ERROR("Acquisition service already running!");
+    return -1;
+  } else if (this->sensors.size() == 0) {
+    LOG_ERROR("No sensors added!");
+    return -1;
+  }
+
+  this->heap.clear();
+  this->nb_emitted = 0;
+  this->nb_late = 0;
+  this->last_emitted = 0;
+
+  this->sensors_running = true;
+  this->merger_running = true;
+  this->merger = std::thread(&AcquisitionService::mergeLoop, this);
+  for (size_t i = 0; i < this->sensors.size(); i++) {
+    AcquisitionSensor &sensor = *this->sensors[i];
+    sensor.thread =
+        std::thread(&AcquisitionService::sensorLoop, this, std::ref(sensor), i);
+  }
+
+  return 0;
+}
+
+int AcquisitionService::stop() {
+  if (this->merger_running == false) {
+    return 0;
+  }
+
+  // Stop sensors first, so the merger sees every event before it exits
+  this->sensors_running = false;
+  for (auto &sensor : this->sensors) {
+    if (sensor->thread.joinable()) {
+      sensor->thread.join();
+    }
+  }
+
+  this->merger_running = false;
+  if (this->merger.joinable()) {
+    this->merger.join();
+  }
+
+  return 0;
+}
+
+bool AcquisitionService::failed() const {
+  for (const auto &sensor : this->sensors) {
+    if (sensor->failed) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void AcquisitionService::printStats() const {
+  LOG_INFO("events emitted: %lu, late: %lu",
+           (unsigned long) this->nb_emitted,
+           (unsigned long) this->nb_late);
+
+  for (const auto &sensor : this->sensors) {
+    const char *name = sensor->name.c_str();
+    std::ostringstream latency;
+    std::ostringstream jitter;
+    std::ostringstream skew;
+    latency << sensor->latency;
+    jitter << sensor->jitter;
+    skew << sensor->skew;
+
+    LOG_INFO("%s: %lu events, %lu dropped",
+             name,
+             (unsigned long) sensor->nb_events,
+             (unsigned long) sensor->nb_dropped);
+    LOG_INFO("%s latency [ms]: %s", name, latency.str().c_str());
+    LOG_INFO("%s jitter [ms]: %s", name, jitter.str().c_str());
+    LOG_INFO("%s skew [ms]: %s", name, skew.str().c_str());
+  }
+}
+
+void AcquisitionService::drain() {
+  SensorEvent event;
+  for (auto &sensor : this->sensors) {
+    while (sensor->queue.pop(event)) {
+      sensor->last_timestamp = event.timestamp;
+      this->heap.push_back(event);
+      std::push_heap(this->heap.begin(), this->heap.end(), event_later);
+    }
+  }
+}
+
+int AcquisitionService::merge(const int64_t watermark) {
+  int nb_events = 0;
+  while (this->heap.size() && this->heap.front().timestamp <= watermark) {
+    std::pop_heap(this->heap.begin(), this->heap.end(), event_later);
+    this->emit(this->heap.back());
+    this->heap.pop_back();
+    nb_events++;
+  }
+
+  return nb_events;
+}
+
+void AcquisitionService::sensorLoop(AcquisitionSensor &sensor,
+                                    const int sensor_id) {
+  while (this->sensors_running) {
+    SensorEvent event;
+    const int retval = sensor.read(event);
+    const int64_t t_read = time_monotonic_ns();
+    if (retval == 1) {
+      continue;
+    } else if (retval != 0) {
+      LOG_ERROR("Failed to read sensor [%s]!", sensor.name.c_str());
+      sensor.failed = true;
+      return;
+    }
+
+    if (event.timestamp == 0) {
+      event.timestamp = t_read;
+    }
+    event.type = sensor.type;
+    event.sensor_id = sensor_id;
+    event.seq = sensor.nb_events++;
+    if (sensor.queue.push(event) == false) {
+      sensor.nb_dropped++;
+    }
+  }
+}
+
+int64_t AcquisitionService::watermark() const {
+  // Every sensor timestamps in order, so no sensor can produce an event older
+  // than the last one it queued. Sensors that have been silent for longer
+  // than the max latency are not waited for.
+  const int64_t max_latency = this->max_latency * 1e9;
+  const int64_t t_min = time_monotonic_ns() - max_latency;
+
+  int64_t watermark = INT64_MAX;
+  for (const auto &sensor : this->sensors) {
+    watermark = std::min(watermark, std::max(sensor->last_timestamp, t_min));
+  }
+
+  return watermark;
+}
+
+void AcquisitionService::mergeLoop() {
+  const int64_t period = this->merge_period * 1e9;
+  int64_t t_next = time_monotonic_ns();
+
+  while (this->merger_running) {
+    t_next += period;
+    struct timespec ts;
+    ts.tv_sec = t_next / 1000000000;
+    ts.tv_nsec = t_next % 1000000000;
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+
+    this->drain();
+    this->merge(this->watermark());
+  }
+
+  // Sensor threads have stopped, emit everything that is left
+  this->drain();
+  this->merge(INT64_MAX);
+}
+
+void AcquisitionService::emit(const SensorEvent &event) {
+  AcquisitionSensor &sensor = *this->sensors[event.sensor_id];
+  const int64_t t_now = time_monotonic_ns();
+
+  // Order
+  if (event.timestamp < this->last_emitted) {
+    this->nb_late++;
+  } else {
+    this->last_emitted = event.timestamp;
+  }
+  this->nb_emitted++;
+
+  // Latency from measurement to output
+  sensor.latency.add((t_now - event.timestamp) * 1e-6);
+
+  // Jitter against nominal period, or against the mean period so far
+  if (sensor.prev_timestamp > 0) {
+    const double dt = (event.timestamp - sensor.prev_timestamp) * 1e-6;
+    sensor.period_sum += dt;
+    sensor.nb_periods++;
+
+    const double period = (sensor.period > 0.0)
+                              ? sensor.period * 1e3
+                              : sensor.period_sum / sensor.nb_periods;
+    sensor.jitter.add(fabs(dt - period));
+  }
+  sensor.prev_timestamp = event.timestamp;
+
+  // Skew to the reference (first) sensor
+  const int64_t t_ref = this->sensors[0]->prev_timestamp;
+  if (event.sensor_id != 0 && t_ref > 0) {
+    sensor.skew.add((event.timestamp - t_ref) * 1e-6);
+  }
+
+  // Outputs
+  if (this->on_event) {
+    this->on_event(event);
+  }
+  if (this->writer != nullptr) {
+    if (sensor.data_stream != -1 && event.nb_values > 0) {
+      this->writer->write(sensor.data_stream, event.values, event.timestamp);
+    }
+    if (sensor.image_stream != -1 && event.image.empty() == false) {
+      const std::string image_path =
+          sensor.image_dir + "/" + std::to_string(event.timestamp) + ".png";
+      this->writer->writeImage(sensor.image_stream, image_path, event.image);
+    }
+  }
+}
+
+SensorReadFunc synthetic_sensor(const double rate,
+                                const int nb_values,
+                                const cv::Size &image_size) {
+  const int64_t period = 1e9 / rate;
+  auto t_next = std::make_shared<int64_t>(0);
+  auto seq = std::make_shared<uint64_t>(0);
+
+  return [=](SensorEvent &event) {
+    // Sleep until next tick
+    if (*t_next == 0) {
+      *t_next = time_monotonic_ns();
+    }
+    *t_next += period;
+    struct timespec ts;
+    ts.tv_sec = *t_next / 1000000000;
+    ts.tv_nsec = *t_next % 1000000000;
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+
+    // Measurement
+    event.nb_values = std::min(nb_values, SENSOR_EVENT_MAX_VALUES);
+    for (int i = 0; i < event.nb_values; i++) {
+      event.values[i] = *seq + i;
+    }
+    if (image_size.area() > 0) {
+      event.image = cv::Mat(image_size, CV_8UC1, cv::Scalar(*seq % 256));
+    }
+    (*seq)++;
+
+    return 0;
+  };
+}
+
+} // namespace gvio
@@ -0,0 +1,426 @@
+#include "gvio/util/async_writer.hpp"
+
+namespace gvio {
+
+static void csv_append_row(const int nb_timestamps,
+                           const int nb_fields,
+                           const int precision,
+                           const int64_t *timestamps,
+                           const double *values,
+                           std::string &out) {
+  char buf[64];
+
+  for (int i = 0; i < nb_timestamps; i++) {
+    snprintf(buf, sizeof(buf), "%lld", (long long) timestamps[i]);
+    out += buf;
+    out += (i + 1 < nb_timestamps || nb_fields > 0) ? "," : "";
+  }
+
+  for (int i = 0; i < nb_fields; i++) {
+    snprintf(buf, sizeof(buf), "%.*g", precision, values[i]);
+    out += buf;
+    out += (i + 1 < nb_fields) ? "," : "";
+  }
+  out += "\n";
+}
+
+AsyncWriter::~AsyncWriter() {
+  this->stop();
+}
+
+int AsyncWriter::addStream(const std::string &path,
+                           const std::string &header,
+                           const int nb_fields,
+                           const int nb_timestamps,
+                           const bool binary) {
+  // Pre-check
+  if (this->running) {
+    LOG_ERROR("Streams must be added before starting the writer!");
+    return -1;
+  } else if (nb_fields < 1 || nb_fields > ASYNC_WRITER_MAX_FIELDS) {
+    LOG_ERROR("Invalid number of fields [%d]!", nb_fields);
+    return -1;
+  } else if (nb_timestamps < 0 ||
+             nb_timestamps > ASYNC_WRITER_MAX_TIMESTAMPS) {
+    LOG_ERROR("Invalid number of timestamps [%d]!", nb_timestamps);
+    return -1;
+  }
+
+  // Open file
+  FILE *fp = fopen(path.c_str(), binary ? "wb" : "w");
+  if (fp == NULL) {
+    LOG_ERROR("Failed to open [%s] for writing!", path.c_str());
+    return -1;
+  }
+
+  // Write header
+  if (binary) {
+    const uint32_t nb = nb_fields;
+    const uint8_t ts = nb_timestamps;
+    const uint32_t header_len = header.size();
+    fwrite(ASYNC_WRITER_BIN_MAGIC, 1, 8, fp);
+    fwrite(&nb, sizeof(nb), 1, fp);
+    fwrite(&ts, sizeof(ts), 1, fp);
+    fwrite(&header_len, sizeof(header_len), 1, fp);
+    fwrite(header.data(), 1, header_len, fp);
+  } else if (header.size() > 0) {
+    fprintf(fp, "%s\n", header.c_str());
+  }
+
+  // Add stream
+  auto stream = std::unique_ptr<AsyncStream>(
+      new AsyncStream(this->queue_capacity, 1));
+  stream->path = path;
+  stream->fp = fp;
+  stream->binary = binary;
+  stream->nb_timestamps = nb_timestamps;
+  stream->nb_fields = nb_fields;
+  this->streams.push_back(std::move(stream));
+
+  return this->streams.size() - 1;
+}
+
+int AsyncWriter::addImageStream() {
+  if (this->running) {
+    LOG_ERROR("Streams must be added before starting the writer!");
+    return -1;
+  }
+
+  auto stream = std::unique_ptr<AsyncStream>(
+      new AsyncStream(1, this->image_capacity));
+  stream->image_stream = true;
+  this->streams.push_back(std::move(stream));
+
+  return this->streams.size() - 1;
+}
+
+int AsyncWriter::start() {
+  if (this->running) {
+    LOG_ERROR("Writer already started!");
+    return -1;
+  } else if (this->stopped) {
+    LOG_ERROR("Writer already stopped!");
+    return -1;
+  }
+
+  this->running = true;
+  this->writer = std::thread(&AsyncWriter::run, this, false);
+  for (const auto &stream : this->streams) {
+    if (stream->image_stream) {
+      this->image_writer = std::thread(&AsyncWriter::run, this, true);
+      break;
+    }
+  }
+
+  return 0;
+}
+
+int AsyncWriter::stop() {
+  // Stop writer threads
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->running = false;
+    this->stopped = true;
+  }
+  this->condition.notify_all();
+  if (this->writer.joinable()) {
+    this->writer.join();
+  }
+  if (this->image_writer.joinable()) {
+    this->image_writer.join();
+  }
+
+  // Write whatever is left in the queues, also covers records queued while
+  // the writer was never started
+  this->drain();
+
+  // Close files
+  int retval = 0;
+  for (auto &stream : this->streams) {
+    if (stream->fp != nullptr) {
+      if (fclose(stream->fp) != 0) {
+        LOG_ERROR("Failed to close [%s]!", stream->path.c_str());
+        retval = -1;
+      }
+      stream->fp = nullptr;
+    }
+  }
+
+  return retval;
+}
+
+AsyncStream *AsyncWriter::getStream(const int stream_id,
+                                    const bool image_stream) const {
+  if (stream_id < 0 || stream_id >= (int) this->streams.size()) {
+    LOG_ERROR("Invalid stream id [%d]!", stream_id);
+    return nullptr;
+  } else if (this->streams[stream_id]->image_stream != image_stream) {
+    LOG_ERROR("Stream [%d] is not %s stream!",
+              stream_id,
+              (image_stream) ? "an image" : "a data");
+    return nullptr;
+  }
+
+  return this->streams[stream_id].get();
+}
+
+int AsyncWriter::write(const int stream_id,
+                       const double *values,
+                       const int64_t timestamp) {
+  const int64_t timestamps[ASYNC_WRITER_MAX_TIMESTAMPS] = {timestamp};
+  return this->write(stream_id, values, timestamps);
+}
+
+int AsyncWriter::write(const int stream_id,
+                       const double *values,
+                       const int64_t *timestamps) {
+  AsyncStream *stream_ptr = this->getStream(stream_id, false);
+  if (stream_ptr == nullptr) {
+    return -1;
+  } else if (this->stopped) {
+    LOG_ERROR("Writer already stopped!");
+    return -1;
+  }
+  AsyncStream &stream = *stream_ptr;
+
+  DataRecord record;
+  for (int i = 0; i < stream.nb_timestamps; i++) {
+    record.timestamps[i] = timestamps[i];
+  }
+  for (int i = 0; i < stream.nb_fields; i++) {
+    record.values[i] = values[i];
+  }
+
+  while (stream.data_queue.push(record) == false) {
+    if (this->drop_when_full) {
+      stream.nb_dropped++;
+      return -1;
+    }
+    this->condition.notify_all();
+    std::this_thread::yield();
+  }
+
+  return 0;
+}
+
+int AsyncWriter::write(const int stream_id,
+                       const std::initializer_list<double> &values,
+                       const int64_t timestamp) {
+  const AsyncStream *stream = this->getStream(stream_id, false);
+  if (stream == nullptr) {
+    return -1;
+  } else if ((int) values.size() != stream->nb_fields) {
+    LOG_ERROR("Stream [%d] expects %d values, got %d!",
+              stream_id,
+              stream->nb_fields,
+              (int) values.size());
+    return -1;
+  }
+
+  return this->write(stream_id, values.begin(), timestamp);
+}
+
+int AsyncWriter::write(const int stream_id,
+                       const std::initializer_list<double> &values,
+                       const std::initializer_list<int64_t> &timestamps) {
+  const AsyncStream *stream = this->getStream(stream_id, false);
+  if (stream == nullptr) {
+    return -1;
+  } else if ((int) values.size() != stream->nb_fields) {
+    LOG_ERROR("Stream [%d] expects %d values, got %d!",
+              stream_id,
+              stream->nb_fields,
+              (int) values.size());
+    return -1;
+  } else if ((int) timestamps.size() != stream->nb_timestamps) {
+    LOG_ERROR("Stream [%d] expects %d timestamps, got %d!",
+              stream_id,
+              stream->nb_timestamps,
+              (int) timestamps.size());
+    return -1;
+  }
+
+  return this->write(stream_id, values.begin(), timestamps.begin());
+}
+
+int AsyncWriter::writeImage(const int stream_id,
+                            const std::string &path,
+                            const cv::Mat &image) {
+  AsyncStream *stream_ptr = this->getStream(stream_id, true);
+  if (stream_ptr == nullptr) {
+    return -1;
+  } else if (this->stopped) {
+    LOG_ERROR("Writer already stopped!");
+    return -1;
+  }
+  AsyncStream &stream = *stream_ptr;
+
+  ImageRecord record;
+  record.path = path;
+  record.image = image;
+  while (stream.image_queue.push(record) == false) {
+    if (this->drop_when_full) {
+      stream.nb_dropped++;
+      return -1;
+    }
+    this->condition.notify_all();
+    std::this_thread::yield();
+  }
+
+  return 0;
+}
+
+int64_t AsyncWriter::dropped(const int stream_id) const {
+  if (stream_id < 0 || stream_id >= (int) this->streams.size()) {
+    LOG_ERROR("Invalid stream id [%d]!", stream_id);
+    return -1;
+  }
+
+  return (int64_t) this->streams[stream_id]->nb_dropped;
+}
+
+void AsyncWriter::drain() {
+  this->drainData();
+  this->drainImages();
+}
+
+void AsyncWriter::drainData() {
+  for (auto &stream : this->streams) {
+    if (stream->image_stream || stream->fp == nullptr) {
+      continue;
+    }
+
+    // Format batch
+    DataRecord record;
+    const int nb_fields = stream->nb_fields;
+    while (stream->data_queue.pop(record)) {
+      if (stream->binary) {
+        const char *ts = (const char *) record.timestamps;
+        const char *values = (const char *) record.values;
+        stream->buffer.append(ts, stream->nb_timestamps * sizeof(int64_t));
+        stream->buffer.append(values, nb_fields * sizeof(double));
+      } else {
+        csv_append_row(stream->nb_timestamps,
+                       nb_fields,
+                       stream->precision,
+                       record.timestamps,
+                       record.values,
+                       stream->buffer);
+      }
+      stream->nb_written++;
+    }
+
+    // Write batch
+    if (stream->buffer.size() > 0) {
+      fwrite(stream->buffer.data(), 1, stream->buffer.size(), stream->fp);
+      fflush(stream->fp);
+      stream->buffer.clear();
+    }
+  }
+}
+
+void AsyncWriter::drainImages() {
+  for (auto &stream : this->streams) {
+    if (stream->image_stream == false) {
+      continue;
+    }
+
+    ImageRecord record;
+    while (stream->image_queue.pop(record)) {
+      cv::imwrite(record.path, record.image);
+      stream->nb_written++;
+    }
+  }
+}
+
+void AsyncWriter::run(const bool images) {
+  const long period_us = this->flush_period * 1e6;
+  const auto period = std::chrono::microseconds(period_us);
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (this->running) {
+    this->condition.wait_for(lock, period);
+    lock.unlock();
+    if (images) {
+      this->drainImages();
+    } else {
+      this->drainData();
+    }
+    lock.lock();
+  }
+}
+
+int async_writer_bin2csv(const std::string &bin_path,
+                         const std::string &csv_path,
+                         const int precision) {
+  // Open binary file
+  FILE *bin_file = fopen(bin_path.c_str(), "rb");
+  if (bin_file == NULL) {
+    LOG_ERROR("Failed to open [%s]!", bin_path.c_str());
+    return -1;
+  }
+
+  // Parse header
+  char magic[8];
+  uint32_t nb_fields = 0;
+  uint8_t nb_timestamps = 0;
+  uint32_t header_len = 0;
+  int nb_read = 0;
+  nb_read += fread(magic, 1, 8, bin_file);
+  nb_read += fread(&nb_fields, sizeof(nb_fields), 1, bin_file);
+  nb_read += fread(&nb_timestamps, sizeof(nb_timestamps), 1, bin_file);
+  nb_read += fread(&header_len, sizeof(header_len), 1, bin_file);
+  if (nb_read != 11 || memcmp(magic, ASYNC_WRITER_BIN_MAGIC, 8) != 0 ||
+      nb_fields < 1 || nb_fields > ASYNC_WRITER_MAX_FIELDS ||
+      nb_timestamps > ASYNC_WRITER_MAX_TIMESTAMPS) {
+    LOG_ERROR("Invalid binary record file [%s]!", bin_path.c_str());
+    fclose(bin_file);
+    return -1;
+  }
+  std::string header(header_len, '\0');
+  if (fread(&header[0], 1, header_len, bin_file) != header_len) {
+    LOG_ERROR("Invalid binary record file [%s]!", bin_path.c_str());
+    fclose(bin_file);
+    return -1;
+  }
+
+  // Open CSV file
+  FILE *csv_file = fopen(csv_path.c_str(), "w");
+  if (csv_file == NULL) {
+    LOG_ERROR("Failed to open [%s] for writing!", csv_path.c_str());
+    fclose(bin_file);
+    return -1;
+  }
+  if (header_len > 0) {
+    fprintf(csv_file, "%s\n", header.c_str());
+  }
+
+  // Convert records
+  std::string row;
+  int64_t timestamps[ASYNC_WRITER_MAX_TIMESTAMPS];
+  double values[ASYNC_WRITER_MAX_FIELDS];
+  while (true) {
+    if (fread(timestamps, sizeof(int64_t), nb_timestamps, bin_file) !=
+        nb_timestamps) {
+      break;
+    }
+    if (fread(values, sizeof(double), nb_fields, bin_file) != nb_fields) {
+      break;
+    }
+
+    row.clear();
+    csv_append_row(nb_timestamps,
+                   nb_fields,
+                   precision,
+                   timestamps,
+                   values,
+                   row);
+    fwrite(row.data(), 1, row.size(), csv_file);
+  }
+
+  fclose(bin_file);
+  fclose(csv_file);
+  return 0;
+}
+
+} // namespace gvio
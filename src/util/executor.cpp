@@ -0,0 +1,174 @@
+#include "gvio/util/executor.hpp"
+
+namespace gvio {
+
+int PeriodicExecutor::addTask(const std::string &name,
+                              const double rate,
+                              const int priority,
+                              const ExecutorTaskFunc &func) {
+  if (this->running) {
+    LOG_ERROR("Cannot add task [%s] while executor is running!", name.c_str());
+    return -1;
+  } else if (rate <= 0.0) {
+    LOG_ERROR("Invalid rate [%f] for task [%s]!", rate, name.c_str());
+    return -1;
+  } else if (func == nullptr) {
+    LOG_ERROR("Task [%s] has no function!", name.c_str());
+    return -1;
+  }
+
+  ExecutorTask task;
+  task.name = name;
+  task.priority = priority;
+  task.period = round(1e9 / rate);
+  task.func = func;
+
+  // Keep tasks ordered by priority, equal priorities in order added
+  auto it = this->tasks.begin();
+  while (it != this->tasks.end() && it->priority >= priority) {
+    it++;
+  }
+  this->tasks.insert(it, task);
+
+  return 0;
+}
+
+int64_t PeriodicExecutor::now() const {
+  return (this->simulated) ? this->sim_time : time_monotonic_ns();
+}
+
+double PeriodicExecutor::elapsed() const {
+  return (this->now() - this->start_time) * 1e-9;
+}
+
+int PeriodicExecutor::advance(const double dt) {
+  if (this->simulated == false) {
+    LOG_ERROR("Executor is not in simulated mode!");
+    return -1;
+  }
+
+  this->sim_time += round(dt * 1e9);
+  return 0;
+}
+
+int PeriodicExecutor::start() {
+  if (this->tasks.size() == 0) {
+    LOG_ERROR("Executor has no tasks!");
+    return -1;
+  }
+
+  this->start_time = this->now();
+  for (auto &task : this->tasks) {
+    task.release = this->start_time;
+    task.last_start = -1;
+  }
+  this->running = true;
+
+  return 0;
+}
+
+void PeriodicExecutor::sleepUntil(const int64_t t) {
+  if (this->simulated) {
+    this->sim_time = std::max(this->sim_time, t);
+    return;
+  }
+
+  struct timespec deadline;
+  deadline.tv_sec = t / 1000000000;
+  deadline.tv_nsec = t % 1000000000;
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, NULL) ==
+         EINTR) {
+  }
+}
+
+int PeriodicExecutor::step() {
+  // Sleep until next release
+  int64_t release = this->tasks[0].release;
+  for (const auto &task : this->tasks) {
+    release = std::min(release, task.release);
+  }
+  this->sleepUntil(release);
+
+  // Run released tasks in order of priority
+  for (auto &task : this->tasks) {
+    const int64_t start = this->now();
+    if (task.release > start) {
+      continue;
+    }
+
+    const int64_t dt =
+        (task.last_start >= 0) ? start - task.last_start : task.period;
+    task.last_start = start;
+    task.jitter.add((start - task.release) * 1e-6);
+    const int retval = task.func(dt * 1e-9);
+    const int64_t end = this->now();
+    task.exec_time.add((end - start) * 1e-6);
+    task.nb_runs++;
+    if (retval != 0) {
+      LOG_ERROR("Task [%s] failed! Stopping executor!", task.name.c_str());
+      this->running = false;
+      return -1;
+    }
+
+    // Deadline is the next release, drop releases the task fell behind on
+    task.release += task.period;
+    if (end > task.release) {
+      task.nb_misses++;
+    }
+    if (end >= task.release + task.period) {
+      const int64_t behind = (end - task.release) / task.period;
+      task.release += behind * task.period;
+      task.nb_skipped += behind;
+    }
+  }
+
+  return 0;
+}
+
+int PeriodicExecutor::run(const double duration) {
+  if (this->start() != 0) {
+    return -1;
+  }
+
+  const int64_t end = this->start_time + (int64_t) round(duration * 1e9);
+  while (this->running) {
+    // Stop before the first release past the end
+    int64_t release = this->tasks[0].release;
+    for (const auto &task : this->tasks) {
+      release = std::min(release, task.release);
+    }
+    if (release >= end) {
+      break;
+    }
+
+    if (this->step() != 0) {
+      return -1;
+    }
+  }
+  this->running = false;
+
+  return 0;
+}
+
+void PeriodicExecutor::stop() { this->running = false; }
+
+void PeriodicExecutor::printStats() const {
+  for (const auto &task : this->tasks) {
+    const char *name = task.name.c_str();
+    std::ostringstream jitter;
+    std::ostringstream exec_time;
+    jitter << task.jitter;
+    exec_time << task.exec_time;
+
+    LOG_INFO("%s: %.1f Hz, %lu runs, %lu deadline misses, %lu skipped",
+             name,
+             1e9 / task.period,
+             (unsigned long) task.nb_runs,
+             (unsigned long) task.nb_misses,
+             (unsigned long) task.nb_skipped);
+    LOG_INFO("%s jitter [ms]: %s", name, jitter.str().c_str());
+    LOG_INFO("%s exec time [ms]: %s", name, exec_time.str().c_str());
+  }
+}
+
+} // namespace gvio
@@ -81,6 +81,18 @@ double randf(const double ub, const double lb) {
   return lb + f * (ub - lb);
 }
 
+double randf(std::mt19937 &rng, const double ub, const double lb) {
+  const double f = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+  return lb + f * (ub - lb);
+}
+
+double randn(std::mt19937 &rng, const double mean, const double stddev) {
+  if (stddev <= 0.0) {
+    return mean;
+  }
+  return std::normal_distribution<double>(mean, stddev)(rng);
+}
+
 int sign(const double x) {
   if (fltcmp(x, 0.0) == 0) {
     return 0;
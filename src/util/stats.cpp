@@ -45,4 +45,80 @@ int linreg(std::vector<Vec2> pts, double *m, double *c, double *r) {
   return 0;
 }
 
+void Histogram::add(const double x) {
+  if (this->bins.size() == 0) {
+    return;
+  }
+
+  const double width = (this->max - this->min) / this->bins.size();
+  long index = std::floor((x - this->min) / width);
+  index = std::max(0L, std::min(index, (long) this->bins.size() - 1));
+  this->bins[index]++;
+
+  if (this->nb_samples == 0 || x < this->min_value) {
+    this->min_value = x;
+  }
+  if (this->nb_samples == 0 || x > this->max_value) {
+    this->max_value = x;
+  }
+  this->nb_samples++;
+  this->sum += x;
+  this->sum_sq += x * x;
+}
+
+void Histogram::clear() {
+  std::fill(this->bins.begin(), this->bins.end(), 0);
+  this->nb_samples = 0;
+  this->sum = 0.0;
+  this->sum_sq = 0.0;
+  this->min_value = 0.0;
+  this->max_value = 0.0;
+}
+
+double Histogram::mean() const {
+  if (this->nb_samples == 0) {
+    return 0.0;
+  }
+  return this->sum / this->nb_samples;
+}
+
+double Histogram::stddev() const {
+  if (this->nb_samples < 2) {
+    return 0.0;
+  }
+
+  const double n = this->nb_samples;
+  const double var = (this->sum_sq - this->sum * this->sum / n) / (n - 1);
+  return sqrt(std::max(0.0, var));
+}
+
+double Histogram::percentile(const double p) const {
+  if (this->nb_samples == 0) {
+    return 0.0;
+  }
+
+  const double width = (this->max - this->min) / this->bins.size();
+  const double target = p / 100.0 * this->nb_samples;
+  size_t count = 0;
+  for (size_t i = 0; i < this->bins.size(); i++) {
+    count += this->bins[i];
+    if (count >= target && count > 0) {
+      return std::min(this->min + (i + 1) * width, this->max_value);
+    }
+  }
+
+  return this->max_value;
+}
+
+std::ostream &operator<<(std::ostream &os, const Histogram &hist) {
+  os << "nb_samples: " << hist.nb_samples;
+  os << " mean: " << hist.mean();
+  os << " stddev: " << hist.stddev();
+  os << " min: " << hist.min_value;
+  os << " p50: " << hist.percentile(50.0);
+  os << " p99: " << hist.percentile(99.0);
+  os << " max: " << hist.max_value;
+  return os;
+}
+
 } // namespace gvio
@@ -0,0 +1,143 @@
+#include "gvio/util/thread_pool.hpp"
+
+namespace gvio {
+
+// Pool owning the current thread, nullptr if not a worker thread
+static thread_local const ThreadPool *worker_pool = nullptr;
+
+ThreadPool::ThreadPool() : ThreadPool{std::thread::hardware_concurrency()} {}
+
+ThreadPool::ThreadPool(const size_t nb_threads) {
+  const size_t n = (nb_threads == 0) ? 1 : nb_threads;
+  for (size_t i = 0; i < n; i++) {
+    this->workers.emplace_back(&ThreadPool::work, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->condition.notify_all();
+
+  for (auto &worker : this->workers) {
+    worker.join();
+  }
+}
+
+size_t ThreadPool::size() const { return this->workers.size(); }
+
+std::future<void> ThreadPool::enqueue(const std::function<void()> &task) {
+  std::packaged_task<void()> packaged_task(task);
+  std::future<void> result = packaged_task.get_future();
+
+  {
+    std::unique_lock<std::mutex> lock(this->mutex);
+    this->tasks.push(std::move(packaged_task));
+  }
+  this->condition.notify_one();
+
+  return result;
+}
+
+void ThreadPool::parallelFor(const int begin,
+                             const int end,
+                             const std::function<void(int, int)> &func,
+                             const int nb_bands) {
+  const int length = end - begin;
+  if (length <= 0) {
+    return;
+  }
+
+  // Nested call from a worker, run inline to avoid deadlock
+  if (this->inWorker()) {
+    func(begin, end);
+    return;
+  }
+
+  // Split range into bands of roughly equal size
+  int bands = (nb_bands > 0) ? nb_bands : (int) this->workers.size();
+  bands = std::min(bands, length);
+  const int band_size = length / bands;
+  const int remainder = length % bands;
+
+  // Run bands on worker threads
+  std::vector<std::future<void>> results;
+  int start = begin;
+  for (int i = 0; i < bands; i++) {
+    const int stop = start + band_size + ((i < remainder) ? 1 : 0);
+    results.push_back(this->enqueue([&func, start, stop]() {
+      func(start, stop);
+    }));
+    start = stop;
+  }
+
+  // Wait for all bands to complete
+  for (auto &result : results) {
+    result.get();
+  }
+}
+
+void ThreadPool::parallelForDynamic(const int begin,
+                                    const int end,
+                                    const std::function<void(int, int)> &func,
+                                    const int nb_tasks) {
+  const int length = end - begin;
+  if (length <= 0) {
+    return;
+  }
+
+  // Nested call from a worker, run inline to avoid deadlock
+  if (this->inWorker()) {
+    for (int i = begin; i < end; i++) {
+      func(0, i);
+    }
+    return;
+  }
+
+  // Each task pulls the next index until the range is exhausted
+  int tasks = (nb_tasks > 0) ? nb_tasks : (int) this->workers.size();
+  tasks = std::min(tasks, length);
+  std::atomic<int> next{begin};
+
+  std::vector<std::future<void>> results;
+  for (int t = 0; t < tasks; t++) {
+    results.push_back(this->enqueue([&func, &next, end, t]() {
+      for (int i = next++; i < end; i = next++) {
+        func(t, i);
+      }
+    }));
+  }
+
+  // Wait for all tasks to complete
+  for (auto &result : results) {
+    result.get();
+  }
+}
+
+bool ThreadPool::inWorker() const { return worker_pool == this; }
+
+void ThreadPool::work() {
+  worker_pool = this;
+
+  while (true) {
+    std::packaged_task<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(this->mutex);
+      this->condition.wait(lock, [this] {
+        return this->stop || this->tasks.empty() == false;
+      });
+      if (this->stop && this->tasks.empty()) {
+        return;
+      }
+      task = std::move(this->tasks.front());
+      this->tasks.pop();
+    }
+
+    task();
+  }
+}
+
+} // namespace gvio
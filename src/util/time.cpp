@@ -27,4 +27,10 @@ double time_now() {
   return ((double) t.tv_sec + ((double) t.tv_usec) / 1000000.0);
 }
 
+int64_t time_monotonic_ns() {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (int64_t) t.tv_sec * 1000000000 + t.tv_nsec;
+}
+
 } // namespace gvio
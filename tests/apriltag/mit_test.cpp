@@ -118,6 +118,94 @@ int test_MITDetector_extractTags() {
   return 0;
 }
 
+int test_MITDetector_trackTags() {
+  // setup
+  MITDetector detector;
+  detector.configure(TEST_CONFIG);
+  detector.tracking = true;
+
+  // First frame has nothing tracked, expect full-frame search
+  cv::Mat image = cv::imread(TEST_IMAGE_CENTER, CV_LOAD_IMAGE_COLOR);
+  std::vector<TagPose> tags;
+  int retval = detector.extractTags(image, tags);
+
+  MU_CHECK(0 == retval);
+  MU_CHECK(detector.full_search);
+  MU_CHECK(1 == tags.size());
+  MU_CHECK(1 == detector.tracks.size());
+  MU_CHECK_NEAR(0.0, tags[0].position(0), 0.15);
+  MU_CHECK_NEAR(0.0, tags[0].position(1), 0.15);
+  MU_CHECK_NEAR(2.2, tags[0].position(2), 0.15);
+  const Vec3 first = tags[0].position;
+  tags.clear();
+
+  // Second frame only searches the predicted region of interest
+  retval = detector.extractTags(image, tags);
+
+  MU_CHECK(0 == retval);
+  MU_FALSE(detector.full_search);
+  MU_CHECK(1 == tags.size());
+  MU_CHECK(1 == detector.tracks.size());
+  MU_CHECK((first - tags[0].position).norm() < 0.01);
+  tags.clear();
+
+  // Lost tag is dropped after max_missed frames
+  cv::Mat blank = cv::Mat::zeros(image.rows, image.cols, CV_8UC3);
+  for (int i = 0; i <= detector.max_missed; i++) {
+    MU_CHECK(1 == detector.tracks.size());
+    detector.extractTags(blank, tags);
+  }
+  MU_CHECK(0 == tags.size());
+  MU_CHECK(0 == detector.tracks.size());
+
+  return 0;
+}
+
+int test_MITDetector_trackTagsGray() {
+  // setup
+  MITDetector detector;
+  detector.configure(TEST_CONFIG);
+  detector.tracking = true;
+  const cv::Mat gray = cv::imread(TEST_IMAGE_CENTER, CV_LOAD_IMAGE_GRAYSCALE);
+
+  // Full-frame detection at full resolution as reference
+  const auto expected = detector.detector->extractTags(gray);
+  MU_CHECK(1 == expected.size());
+
+  // First frame runs a full-frame search and starts the track
+  cv::Mat image = gray.clone();
+  std::vector<TagPose> tags;
+  MU_CHECK(0 == detector.extractTags(image, tags));
+  MU_CHECK(detector.full_search);
+  MU_CHECK(1 == tags.size());
+  const Vec3 first = tags[0].position;
+  tags.clear();
+
+  // Region of interest around the track is narrower than the frame, so it
+  // is not continuous in the gray image
+  const auto rois = detector.predictROIs(gray);
+  MU_CHECK(1 == rois.size());
+  MU_CHECK(rois[0].width < gray.cols);
+
+  std::vector<AprilTags::TagDetection> detections;
+  detector.detectROI(gray, rois[0], 1, detections);
+  MU_CHECK(1 == detections.size());
+  MU_CHECK(expected[0].id == detections[0].id);
+  for (int i = 0; i < 4; i++) {
+    MU_CHECK_NEAR(expected[0].p[i].first, detections[0].p[i].first, 0.5);
+    MU_CHECK_NEAR(expected[0].p[i].second, detections[0].p[i].second, 0.5);
+  }
+
+  // Second frame only searches the predicted region of interest
+  image = gray.clone();
+  MU_CHECK(0 == detector.extractTags(image, tags));
+  MU_FALSE(detector.full_search);
+  MU_CHECK(1 == tags.size());
+  MU_CHECK((first - tags[0].position).norm() < 0.01);
+
+  return 0;
+}
+
 int test_MITDetector_changeMode() {
   MITDetector detector;
   cv::Mat image1, image2, image3;
@@ -188,6 +276,8 @@ void test_suite() {
   MU_ADD_TEST(test_MITDetector_configure);
   MU_ADD_TEST(test_MITDetector_illuminationInvarientTransform);
   MU_ADD_TEST(test_MITDetector_extractTags);
+  MU_ADD_TEST(test_MITDetector_trackTags);
+  MU_ADD_TEST(test_MITDetector_trackTagsGray);
   MU_ADD_TEST(test_MITDetector_changeMode);
   MU_ADD_TEST(test_MITDetector_maskImage);
   MU_ADD_TEST(test_MITDetector_cropImage);
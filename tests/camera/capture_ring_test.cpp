@@ -0,0 +1,149 @@
+#include <thread>
+
+#include "gvio/munit.hpp"
+#include "gvio/camera/capture_ring.hpp"
+
+namespace gvio {
+
+#define TEST_WIDTH 64
+#define TEST_HEIGHT 48
+
+cv::Mat test_image(const int value) {
+  return cv::Mat(TEST_HEIGHT, TEST_WIDTH, CV_8UC1, cv::Scalar(value));
+}
+
+int test_CaptureRing_constructor() {
+  FakeCaptureBackend backend{4, TEST_WIDTH, TEST_HEIGHT};
+  CaptureRing ring{&backend};
+
+  MU_CHECK(ring.backend == &backend);
+  MU_CHECK_EQ(4, (int) ring.held.size());
+  MU_FALSE(ring.started);
+
+  return 0;
+}
+
+int test_CaptureRing_grab_and_release() {
+  FakeCaptureBackend backend{4, TEST_WIDTH, TEST_HEIGHT};
+  CaptureRing ring{&backend};
+  MU_CHECK_EQ(0, ring.start());
+
+  // Grab frame
+  MU_CHECK_EQ(0, backend.publish(test_image(42), 1000));
+  CaptureFrame frame;
+  MU_CHECK_EQ(0, ring.grab(frame));
+  MU_CHECK_EQ(1000, frame.timestamp);
+  MU_CHECK_EQ(1, (int) frame.seq);
+  MU_CHECK_EQ(42, frame.image.at<uchar>(0, 0));
+  MU_CHECK_EQ(1, ring.stats().buffers_held);
+
+  // Image is a header over the capture buffer, not a copy
+  const int index = frame.buffer_index;
+  MU_CHECK(frame.image.data == backend.buffers[index].data);
+  MU_CHECK_EQ(FakeCaptureBackend::LOCKED, backend.states[index]);
+
+  // Release frame
+  MU_CHECK_EQ(0, ring.release(frame));
+  MU_CHECK(frame.image.empty());
+  MU_CHECK_EQ(-1, frame.buffer_index);
+  MU_CHECK_EQ(FakeCaptureBackend::FREE, backend.states[index]);
+  MU_CHECK_EQ(0, ring.stats().buffers_held);
+
+  // Double release
+  frame.buffer_index = index;
+  MU_CHECK_EQ(-1, ring.release(frame));
+
+  // Timeout
+  MU_CHECK_EQ(1, ring.grab(frame, 10));
+  MU_CHECK_EQ(1, (int) ring.stats().timeouts);
+
+  return 0;
+}
+
+int test_CaptureRing_dropped_frames() {
+  FakeCaptureBackend backend{3, TEST_WIDTH, TEST_HEIGHT};
+  CaptureRing ring{&backend};
+  ring.start();
+
+  // Consumer holds two frames, leaving one buffer to the driver
+  CaptureFrame frame0;
+  CaptureFrame frame1;
+  backend.publish(test_image(0), 0);
+  backend.publish(test_image(1), 1);
+  MU_CHECK_EQ(0, ring.grab(frame0));
+  MU_CHECK_EQ(0, ring.grab(frame1));
+
+  // The ring refuses to hand out the last buffer
+  CaptureFrame frame2;
+  MU_CHECK_EQ(-1, ring.grab(frame2));
+
+  // Driver fills the last buffer and has to drop the rest
+  MU_CHECK_EQ(0, backend.publish(test_image(2), 2));
+  MU_CHECK_EQ(-1, backend.publish(test_image(3), 3));
+  MU_CHECK_EQ(-1, backend.publish(test_image(4), 4));
+
+  // Release and grab again, the gap in sequence numbers is counted
+  ring.release(frame0);
+  ring.release(frame1);
+  MU_CHECK_EQ(0, ring.grab(frame2));
+  MU_CHECK_EQ(2, frame2.timestamp);
+  ring.release(frame2);
+
+  MU_CHECK_EQ(0, backend.publish(test_image(5), 5));
+  MU_CHECK_EQ(0, ring.grab(frame2));
+  MU_CHECK_EQ(5, frame2.timestamp);
+  MU_CHECK_EQ(5, frame2.image.at<uchar>(0, 0));
+  ring.release(frame2);
+
+  const CaptureStats stats = ring.stats();
+  MU_CHECK_EQ(4, (int) stats.frames_grabbed);
+  MU_CHECK_EQ(2, (int) stats.frames_dropped);
+  MU_CHECK_EQ(0, stats.buffers_held);
+
+  return 0;
+}
+
+int test_CaptureRing_threaded() {
+  FakeCaptureBackend backend{4, TEST_WIDTH, TEST_HEIGHT};
+  CaptureRing ring{&backend};
+  ring.start();
+
+  // Producer publishes frames while the consumer grabs and releases
+  const int nb_frames = 100;
+  std::thread producer([&] {
+    for (int i = 0; i < nb_frames; i++) {
+      backend.publish(test_image(i), i);
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  });
+
+  uint64_t nb_grabbed = 0;
+  long t_prev = -1;
+  CaptureFrame frame;
+  while (ring.grab(frame, 100) == 0) {
+    MU_CHECK(frame.timestamp > t_prev);
+    MU_CHECK_EQ(frame.timestamp, frame.image.at<uchar>(0, 0));
+    t_prev = frame.timestamp;
+    ring.release(frame);
+    nb_grabbed++;
+  }
+  producer.join();
+
+  const CaptureStats stats = ring.stats();
+  MU_CHECK_EQ(nb_grabbed, stats.frames_grabbed);
+  MU_CHECK(stats.frames_grabbed + stats.frames_dropped <= nb_frames);
+  MU_CHECK_EQ(0, stats.buffers_held);
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_CaptureRing_constructor);
+  MU_ADD_TEST(test_CaptureRing_grab_and_release);
+  MU_ADD_TEST(test_CaptureRing_dropped_frames);
+  MU_ADD_TEST(test_CaptureRing_threaded);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
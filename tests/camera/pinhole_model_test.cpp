@@ -132,6 +132,53 @@ int test_PinholeModel_project() {
   return 0;
 }
 
+int test_PinholeModel_projectBatch() {
+  PinholeModel cam_model = setup_pinhole_model();
+  const Mat3 R = euler321ToRot(Vec3{0.1, 0.2, 0.3});
+  const Vec3 t{1.0, 2.0, 3.0};
+
+  Mat3X X{3, 3};
+  X.col(0) = Vec3{0.0, 0.0, 10.0};
+  X.col(1) = Vec3{1.0, -2.0, 15.0};
+  X.col(2) = Vec3{-3.0, 1.0, 8.0};
+
+  // Batch projection should match single point projection
+  Mat2X pixels;
+  VecX depths;
+  cam_model.project(X, R, t, pixels, depths);
+  MU_CHECK_EQ(3, pixels.cols());
+  MU_CHECK_EQ(3, depths.size());
+  for (long i = 0; i < X.cols(); i++) {
+    const Vec3 x = cam_model.project(homogeneous(Vec3{X.col(i)}), R, t);
+    MU_CHECK_NEAR(x(0) / x(2), pixels(0, i), 1e-6);
+    MU_CHECK_NEAR(x(1) / x(2), pixels(1, i), 1e-6);
+    MU_CHECK_NEAR(x(2), depths(i), 1e-6);
+  }
+
+  // No distortion model, distorted projection should be the same
+  Mat2X pixels_d;
+  MU_CHECK_EQ(0, cam_model.projectDistorted(X, R, t, pixels_d, depths));
+  MU_CHECK(((pixels - pixels_d).norm() < 1e-6));
+
+  // Equidistant distorted projection
+  VecX D = zeros(4, 1);
+  D << 0.01, 0.001, 0.0, 0.0;
+  cam_model.setDistortion("equidistant", D);
+  MU_CHECK_EQ(0, cam_model.projectDistorted(X, R, t, pixels_d, depths));
+  for (long i = 0; i < X.cols(); i++) {
+    const Vec3 X_C = R * (X.col(i) - t);
+    const Vec2 expected = project_pinhole_equi(cam_model.K, D, X_C);
+    MU_CHECK_NEAR(expected(0), pixels_d(0, i), 1e-6);
+    MU_CHECK_NEAR(expected(1), pixels_d(1, i), 1e-6);
+  }
+
+  // Wrong number of distortion coefficients
+  cam_model.distortion_coeffs = zeros(3, 1);
+  MU_CHECK_EQ(-1, cam_model.projectDistorted(X, R, t, pixels_d, depths));
+
+  return 0;
+}
+
 int test_PinholeModel_pixel2image() {
   PinholeModel cam_model = setup_pinhole_model();
   Vec2 point = cam_model.pixel2image(Vec2{320, 320});
@@ -139,6 +186,64 @@ int test_PinholeModel_pixel2image() {
   MU_CHECK_FLOAT(0.0, point(0));
   MU_CHECK_FLOAT(0.0, point(1));
 
+  // Batch version
+  Mat2X pixels{2, 2};
+  pixels.col(0) = Vec2{320, 320};
+  pixels.col(1) = Vec2{10, 600};
+  Mat2X points;
+  cam_model.pixel2image(pixels, points);
+  for (long i = 0; i < pixels.cols(); i++) {
+    const Vec2 expected = cam_model.pixel2image(Vec2{pixels.col(i)});
+    MU_CHECK_FLOAT(expected(0), points(0, i));
+    MU_CHECK_FLOAT(expected(1), points(1, i));
+  }
+
+  return 0;
+}
+
+int test_PinholeModel_undistortPoints() {
+  PinholeModel cam_model = setup_pinhole_model();
+  const std::vector<cv::Point2f> pixels = {{320, 320}, {10, 600}};
+
+  // No distortion
+  std::vector<cv::Point2f> points;
+  cam_model.undistortPoints(pixels, points);
+  MU_CHECK_EQ(2, (int) points.size());
+  for (size_t i = 0; i < pixels.size(); i++) {
+    const Vec2 expected = cam_model.pixel2image(pixels[i]);
+    MU_CHECK_NEAR(expected(0), points[i].x, 1e-6);
+    MU_CHECK_NEAR(expected(1), points[i].y, 1e-6);
+  }
+
+  // Equidistant distortion
+  VecX D = zeros(4, 1);
+  D << 0.01, 0.001, 0.0, 0.0;
+  MU_CHECK_EQ(0, cam_model.setDistortion("equidistant", D));
+
+  const Vec3 X{0.4, -0.3, 1.0};
+  const Vec2 pixel = project_pinhole_equi(cam_model.K, D, X);
+  cam_model.undistortPoints({cv::Point2f(pixel(0), pixel(1))}, points);
+  MU_CHECK_NEAR(0.4, points[0].x, 1e-4);
+  MU_CHECK_NEAR(-0.3, points[0].y, 1e-4);
+
+  // Batch version
+  Mat2X pixels_batch{2, 3};
+  pixels_batch.col(0) = pixel;
+  pixels_batch.col(1) = Vec2{320, 320};
+  pixels_batch.col(2) = Vec2{10, 600};
+  Mat2X points_batch;
+  cam_model.undistortPoints(pixels_batch, points_batch);
+  MU_CHECK_EQ(3, points_batch.cols());
+  for (long i = 0; i < pixels_batch.cols(); i++) {
+    const cv::Point2f px(pixels_batch(0, i), pixels_batch(1, i));
+    cam_model.undistortPoints({px}, points);
+    MU_CHECK_NEAR(points[0].x, points_batch(0, i), 1e-6);
+    MU_CHECK_NEAR(points[0].y, points_batch(1, i), 1e-6);
+  }
+
+  // Invalid distortion model
+  MU_CHECK_EQ(-1, cam_model.setDistortion("invalid", D));
+
   return 0;
 }
 
@@ -149,7 +254,9 @@ void test_suite() {
   MU_ADD_TEST(test_PinholeModel_focalLength);
   MU_ADD_TEST(test_PinholeModel_P);
   MU_ADD_TEST(test_PinholeModel_project);
+  MU_ADD_TEST(test_PinholeModel_projectBatch);
   MU_ADD_TEST(test_PinholeModel_pixel2image);
+  MU_ADD_TEST(test_PinholeModel_undistortPoints);
 }
 
 } // namespace gvio
@@ -0,0 +1,149 @@
+#include "gvio/munit.hpp"
+#include "gvio/camera/undistort_grid.hpp"
+
+namespace gvio {
+
+struct test_config {
+  const int image_width = 752;
+  const int image_height = 480;
+  const double fx = 458.654;
+  const double fy = 457.296;
+  const double cx = 367.215;
+  const double cy = 248.375;
+};
+
+int test_UndistortGrid_configure() {
+  struct test_config config;
+  UndistortGrid grid;
+
+  VecX D = zeros(5, 1);
+  D << -0.28340811, 0.07395907, 0.00019359, 1.76187114e-05, 0.0;
+  int retval = grid.configure("radial-tangential",
+                              D,
+                              config.fx,
+                              config.fy,
+                              config.cx,
+                              config.cy,
+                              config.image_width,
+                              config.image_height);
+  MU_CHECK_EQ(0, retval);
+  MU_CHECK(grid.configured);
+  MU_CHECK_EQ(95, grid.grid_cols);
+  MU_CHECK_EQ(61, grid.grid_rows);
+  MU_CHECK_EQ(95 * 61, (int) grid.grid_x.size());
+
+  // Wrong number of distortion coefficients
+  retval = grid.configure("equidistant",
+                          D,
+                          config.fx,
+                          config.fy,
+                          config.cx,
+                          config.cy,
+                          config.image_width,
+                          config.image_height);
+  MU_CHECK_EQ(-1, retval);
+  MU_CHECK(grid.configured == false);
+
+  return 0;
+}
+
+int test_UndistortGrid_undistort_radtan() {
+  struct test_config config;
+  UndistortGrid grid;
+
+  const double k1 = -0.28340811;
+  const double k2 = 0.07395907;
+  const double p1 = 0.00019359;
+  const double p2 = 1.76187114e-05;
+  const double k3 = 0.0;
+  VecX D = zeros(5, 1);
+  D << k1, k2, p1, p2, k3;
+  grid.configure("radial-tangential",
+                 D,
+                 config.fx,
+                 config.fy,
+                 config.cx,
+                 config.cy,
+                 config.image_width,
+                 config.image_height);
+
+  // Distort points in image coordinates and convert them to pixels
+  std::vector<Vec2> expected;
+  std::vector<cv::Point2f> pixels;
+  for (double x = -0.6; x <= 0.6; x += 0.1) {
+    for (double y = -0.4; y <= 0.4; y += 0.1) {
+      const Vec2 p_d = radtan_distort(k1, k2, k3, p1, p2, Vec3{x, y, 1.0});
+      const double px = config.fx * p_d(0) + config.cx;
+      const double py = config.fy * p_d(1) + config.cy;
+      expected.emplace_back(x, y);
+      pixels.emplace_back(px, py);
+    }
+  }
+
+  // Un-distort points
+  std::vector<cv::Point2f> points;
+  grid.undistort(pixels, points);
+  MU_CHECK_EQ(pixels.size(), points.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    MU_CHECK_NEAR(expected[i](0), points[i].x, 1e-4);
+    MU_CHECK_NEAR(expected[i](1), points[i].y, 1e-4);
+  }
+
+  return 0;
+}
+
+int test_UndistortGrid_undistort_equi() {
+  struct test_config config;
+  UndistortGrid grid;
+
+  const double k1 = -0.0678890809361792;
+  const double k2 = 0.007709008000713503;
+  const double k3 = -0.010307689056822753;
+  const double k4 = 0.003975705353253985;
+  VecX D = zeros(4, 1);
+  D << k1, k2, k3, k4;
+  grid.configure("equidistant",
+                 D,
+                 config.fx,
+                 config.fy,
+                 config.cx,
+                 config.cy,
+                 config.image_width,
+                 config.image_height);
+
+  // Distort points in image coordinates and convert them to pixels, include
+  // points outside of the image to exercise the fallback without grid
+  std::vector<Vec2> expected;
+  std::vector<cv::Point2f> pixels;
+  for (double x = -1.2; x <= 1.2; x += 0.1) {
+    for (double y = -0.8; y <= 0.8; y += 0.1) {
+      const Vec3 X{x + 1e-3, y + 1e-3, 1.0};
+      const Vec2 p_d = equi_distort(k1, k2, k3, k4, X);
+      const double px = config.fx * p_d(0) + config.cx;
+      const double py = config.fy * p_d(1) + config.cy;
+      expected.emplace_back(X(0), X(1));
+      pixels.emplace_back(px, py);
+    }
+  }
+
+  // Un-distort points
+  std::vector<cv::Point2f> points;
+  grid.undistort(pixels, points);
+  MU_CHECK_EQ(pixels.size(), points.size());
+  for (size_t i = 0; i < points.size(); i++) {
+    MU_CHECK_NEAR(expected[i](0), points[i].x, 1e-4);
+    MU_CHECK_NEAR(expected[i](1), points[i].y, 1e-4);
+  }
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_UndistortGrid_configure);
+  MU_ADD_TEST(test_UndistortGrid_undistort_radtan);
+  MU_ADD_TEST(test_UndistortGrid_undistort_equi);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
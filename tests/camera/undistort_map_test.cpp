@@ -0,0 +1,103 @@
+#include "gvio/munit.hpp"
+#include "gvio/camera/undistort_map.hpp"
+
+namespace gvio {
+
+#define TEST_IMAGE "test_data/calibration/cam0/0.jpg"
+
+Mat3 test_K() {
+  Mat3 K;
+  // clang-format off
+  K << 393.37990041643656, 0.0, 370.05019923180885,
+       0.0, 395.3197707435412, 239.38250128073372,
+       0.0, 0.0, 1.0;
+  // clang-format on
+  return K;
+}
+
+VecX test_D() {
+  VecX D = zeros(4, 1);
+  D << -0.0678890809361792,
+      0.007709008000713503,
+      -0.010307689056822753,
+      0.003975705353253985;
+  return D;
+}
+
+int test_UndistortMap_constructor() {
+  UndistortMap map;
+
+  MU_CHECK(map.configured == false);
+  MU_CHECK(map.map1.empty());
+  MU_CHECK(map.map2.empty());
+
+  return 0;
+}
+
+int test_UndistortMap_configure() {
+  UndistortMap map;
+  const cv::Size size{752, 480};
+
+  // Equidistant
+  int retval = map.configure("equidistant", test_K(), test_D(), size, 0.0);
+  MU_CHECK_EQ(0, retval);
+  MU_CHECK(map.configured);
+  MU_CHECK_EQ(CV_16SC2, map.map1.type());
+  MU_CHECK(map.map1.size() == size);
+  MU_CHECK(map.matches("equidistant", test_K(), test_D(), size, 0.0));
+  MU_FALSE(map.matches("equidistant", test_K(), test_D(), size, 0.5));
+  MU_FALSE(map.matches("radial-tangential", test_K(), test_D(), size, 0.0));
+
+  // Unsupported distortion model
+  retval = map.configure("invalid", test_K(), test_D(), size, 0.0);
+  MU_CHECK_EQ(-1, retval);
+  MU_CHECK(map.configured == false);
+
+  return 0;
+}
+
+int test_UndistortMap_undistort() {
+  cv::Mat image;
+  cv::cvtColor(cv::imread(TEST_IMAGE), image, cv::COLOR_BGR2GRAY);
+  const Mat3 K = test_K();
+  const VecX D = test_D();
+
+  // Undistort with OpenCV
+  cv::Mat K_ud;
+  const cv::Mat R = cv::Mat::eye(3, 3, CV_64F);
+  cv::fisheye::estimateNewCameraMatrixForUndistortRectify(
+      convert(K), convert(D), image.size(), R, K_ud, 0.0);
+  cv::Mat expected;
+  cv::fisheye::undistortImage(image, expected, convert(K), convert(D), K_ud);
+
+  // Undistort with precomputed map
+  UndistortMap map;
+  map.configure("equidistant", K, D, image.size(), 0.0);
+  cv::Mat image_ud;
+  MU_CHECK_EQ(0, map.undistort(image, image_ud));
+  MU_CHECK(is_equal(K_ud, map.K_ud));
+  MU_CHECK(is_equal(expected, image_ud));
+
+  // Undistort by row bands in parallel
+  ThreadPool pool{4};
+  cv::Mat image_ud_parallel;
+  MU_CHECK_EQ(0, map.undistort(image, image_ud_parallel, &pool));
+  MU_CHECK(is_equal(expected, image_ud_parallel));
+
+  // Image size does not match map
+  cv::Mat image_small;
+  cv::resize(image, image_small, cv::Size(image.cols / 2, image.rows / 2));
+  MU_CHECK_EQ(-1, map.undistort(image_small, image_ud));
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_UndistortMap_constructor);
+  MU_ADD_TEST(test_UndistortMap_configure);
+  MU_ADD_TEST(test_UndistortMap_undistort);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
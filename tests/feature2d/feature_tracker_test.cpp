@@ -5,6 +5,7 @@ namespace gvio {
 
 static const std::string TEST_IMAGE_TOP = "test_data/apriltag/top.png";
 static const std::string TEST_IMAGE_BOTTOM = "test_data/apriltag/bottom.png";
+static const std::string TEST_CONFIG = "test_configs/feature2d/tracker.yaml";
 
 int test_FeatureTracker_constructor() {
   FeatureTracker tracker;
@@ -16,6 +17,30 @@ int test_FeatureTracker_constructor() {
   return 0;
 }
 
+int test_FeatureTracker_configure() {
+  FeatureTracker tracker;
+  MU_CHECK_EQ(0, tracker.configure(TEST_CONFIG));
+  MU_CHECK(tracker.camera_model != nullptr);
+
+  // Distortion model is loaded with the camera model
+  auto *pinhole_model = (const PinholeModel *) tracker.camera_model;
+  MU_CHECK_EQ(752, pinhole_model->image_width);
+  MU_CHECK_FLOAT(458.654, pinhole_model->fx);
+  MU_CHECK(pinhole_model->distortion_model == "radial-tangential");
+  MU_CHECK_EQ(5, pinhole_model->distortion_coeffs.size());
+  MU_CHECK(pinhole_model->undistort_grid.configured);
+
+  // Keypoints near the image corner are un-distorted
+  const std::vector<cv::Point2f> pixels = {cv::Point2f{20.0, 20.0}};
+  std::vector<cv::Point2f> points;
+  tracker.camera_model->undistortPoints(pixels, points);
+  const Vec2 distorted = pinhole_model->pixel2image(Vec2{20.0, 20.0});
+  MU_CHECK(fabs(points[0].x - distorted(0)) > 1e-2);
+  MU_CHECK(fabs(points[0].y - distorted(1)) > 1e-2);
+
+  return 0;
+}
+
 // int test_FeatureTracker_detect() {
 //   FeatureTracker tracker;
 //
@@ -128,6 +153,7 @@ int test_FeatureTracker_match() {
 
 void test_suite() {
   MU_ADD_TEST(test_FeatureTracker_constructor);
+  MU_ADD_TEST(test_FeatureTracker_configure);
   // MU_ADD_TEST(test_FeatureTracker_detect);
   MU_ADD_TEST(test_FeatureTracker_conversions);
   MU_ADD_TEST(test_FeatureTracker_match);
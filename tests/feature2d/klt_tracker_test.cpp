@@ -4,6 +4,24 @@
 
 namespace gvio {
 
+static const std::string TEST_CONFIG = "test_configs/feature2d/tracker.yaml";
+
+int test_KLTTracker_configure() {
+  KLTTracker tracker;
+  MU_CHECK_EQ(0, tracker.configure(TEST_CONFIG));
+  MU_CHECK_EQ(500, tracker.max_corners);
+  MU_CHECK_FLOAT(0.01, tracker.quality_level);
+  MU_CHECK_FLOAT(10.0, tracker.min_distance);
+
+  // Distortion model is loaded with the camera model
+  MU_CHECK(tracker.camera_model == tracker.pinhole_model.get());
+  MU_CHECK(tracker.pinhole_model->distortion_model == "radial-tangential");
+  MU_CHECK_EQ(5, tracker.pinhole_model->distortion_coeffs.size());
+  MU_CHECK(tracker.pinhole_model->undistort_grid.configured);
+
+  return 0;
+}
+
 int test_KLTTracker_detect() {
   KLTTracker tracker;
 
@@ -133,6 +151,7 @@ int test_KLTTracker_demo() {
 }
 
 void test_suite() {
+  MU_ADD_TEST(test_KLTTracker_configure);
   MU_ADD_TEST(test_KLTTracker_detect);
   MU_ADD_TEST(test_KLTTracker_track);
   // MU_ADD_TEST(test_KLTTracker_update);
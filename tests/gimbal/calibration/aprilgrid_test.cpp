@@ -62,6 +62,82 @@ int test_AprilGrid_extractTags() {
   return 0;
 }
 
+int test_AprilGrid_extractTagsTiled() {
+  const std::vector<std::string> images = {"test_data/calibration/cam0/0.jpg",
+                                           "test_data/calibration/cam1/0.jpg",
+                                           "test_data/calibration/cam2/0.jpg"};
+  ThreadPool pool{4};
+
+  for (const auto &image_path : images) {
+    // Single-threaded
+    AprilGrid grid;
+    grid.subpix = true;
+    cv::Mat image = cv::imread(image_path);
+    std::map<int, std::vector<cv::Point2f>> tags;
+    MU_CHECK_EQ(grid.extractTags(image, tags), 0);
+
+    // Tiled
+    AprilGrid grid_tiled;
+    grid_tiled.subpix = true;
+    grid_tiled.thread_pool = &pool;
+    grid_tiled.tile_rows = 2;
+    grid_tiled.tile_cols = 3;
+    image = cv::imread(image_path);
+    std::map<int, std::vector<cv::Point2f>> tags_tiled;
+    MU_CHECK_EQ(grid_tiled.extractTags(image, tags_tiled), 0);
+
+    // Assert
+    MU_CHECK(tags.size() > 0);
+    MU_CHECK_EQ(tags.size(), tags_tiled.size());
+    for (const auto &tag : tags) {
+      MU_CHECK(tags_tiled.count(tag.first) == 1);
+      const auto &corners = tag.second;
+      const auto &corners_tiled = tags_tiled[tag.first];
+      for (size_t i = 0; i < corners.size(); i++) {
+        MU_CHECK_NEAR(corners[i].x, corners_tiled[i].x, 0.1);
+        MU_CHECK_NEAR(corners[i].y, corners_tiled[i].y, 0.1);
+      }
+    }
+  }
+
+  return 0;
+}
+
+int test_AprilGrid_detectTagsColumnTiles() {
+  ThreadPool pool{4};
+
+  // Single-threaded
+  AprilGrid grid;
+  cv::Mat image = cv::imread(TEST_IMAGE);
+  cv::Mat image_gray;
+  cv::cvtColor(image, image_gray, CV_BGR2GRAY);
+  const auto detections = grid.detectTags(image_gray);
+
+  // Tiles split columns only, so none of them is continuous in memory
+  AprilGrid grid_tiled;
+  grid_tiled.thread_pool = &pool;
+  grid_tiled.tile_rows = 1;
+  grid_tiled.tile_cols = 4;
+  const auto detections_tiled = grid_tiled.detectTags(image_gray);
+
+  // Assert
+  MU_CHECK(detections.size() > 0);
+  MU_CHECK_EQ(detections.size(), detections_tiled.size());
+  for (size_t i = 0; i < detections.size(); i++) {
+    MU_CHECK_EQ(detections[i].id, detections_tiled[i].id);
+    for (int j = 0; j < 4; j++) {
+      MU_CHECK_NEAR(detections[i].p[j].first,
+                    detections_tiled[i].p[j].first,
+                    0.5);
+      MU_CHECK_NEAR(detections[i].p[j].second,
+                    detections_tiled[i].p[j].second,
+                    0.5);
+    }
+  }
+
+  return 0;
+}
+
 int test_AprilGrid_formObjectPoints() {
   AprilGrid grid(6, 6, 0.088, 0.3);
 
@@ -141,6 +217,8 @@ void test_suite() {
   MU_ADD_TEST(test_AprilGrid_constructor);
   MU_ADD_TEST(test_AprilGrid_detect);
   MU_ADD_TEST(test_AprilGrid_extractTags);
+  MU_ADD_TEST(test_AprilGrid_extractTagsTiled);
+  MU_ADD_TEST(test_AprilGrid_detectTagsColumnTiles);
   MU_ADD_TEST(test_AprilGrid_formObjectPoints);
   MU_ADD_TEST(test_AprilGrid_formImagePoints);
   MU_ADD_TEST(test_AprilGrid_solvePnP);
@@ -13,13 +13,32 @@ int test_CalibPreprocessor_constructor() {
 
 int test_CalibPreprocessor_preprocess() {
   CalibPreprocessor preprocessor;
-  preprocessor.preprocess(TEST_DATA);
+  preprocessor.nb_workers = 2;
+  preprocessor.cache_file = "/tmp/test_calib_preprocessor.bin";
+  remove(preprocessor.cache_file.c_str());
+  MU_CHECK_EQ(0, preprocessor.preprocess(TEST_DATA));
+  MU_CHECK_EQ(preprocessor.nb_measurements,
+              (int) preprocessor.detections.size());
 
   std::cout << preprocessor.target << std::endl;
   std::cout << preprocessor.camera_properties[0] << std::endl;
   std::cout << preprocessor.camera_properties[1] << std::endl;
   std::cout << preprocessor.camera_properties[2] << std::endl;
 
+  // Second run resumes from the cache and gives the same detections
+  CalibPreprocessor resumed;
+  resumed.cache_file = preprocessor.cache_file;
+  MU_CHECK_EQ(0, resumed.preprocess(TEST_DATA));
+  MU_CHECK_EQ(preprocessor.detections.size(), resumed.detections.size());
+  for (size_t i = 0; i < resumed.detections.size(); i++) {
+    const CalibDetection &expected = preprocessor.detections[i];
+    const CalibDetection &actual = resumed.detections[i];
+    MU_CHECK(expected.common_ids == actual.common_ids);
+    MU_CHECK_EQ(expected.tags0.size(), actual.tags0.size());
+    MU_CHECK_EQ(expected.tags1.size(), actual.tags1.size());
+    MU_CHECK_EQ(expected.tags2.size(), actual.tags2.size());
+  }
+
   return 0;
 }
 
@@ -80,6 +80,50 @@ int test_CalibValidator_validateStereo() {
   return 0;
 }
 
+int test_CalibValidator_validateStereoStream() {
+  // Load validator
+  CalibValidator validator;
+  int retval = validator.load(3, TEST_CALIB_FILE, TEST_TARGET_FILE);
+  MU_CHECK_EQ(0, retval);
+  validator.redetect_interval = 3;
+
+  // Different views, chessboard is re-detected
+  for (int i = 0; i < 8; i++) {
+    const std::string img_name = "image_" + std::to_string(i) + ".jpg";
+    const cv::Mat img0 = cv::imread(TEST_CHESSBOARD_CAM0 + img_name);
+    const cv::Mat img1 = cv::imread(TEST_CHESSBOARD_CAM1 + img_name);
+    retval = validator.validateStereoStream(img0, img1);
+    MU_CHECK(retval >= 0);
+  }
+  const long nb_frames = validator.stereo_stats.nb_frames;
+  MU_CHECK(nb_frames > 0);
+
+  // Same view, corners are tracked until the re-detect interval
+  const cv::Mat img0 = cv::imread(TEST_CHESSBOARD_CAM0 "image_0.jpg");
+  const cv::Mat img1 = cv::imread(TEST_CHESSBOARD_CAM1 "image_0.jpg");
+  for (int i = 0; i < 4; i++) {
+    MU_CHECK_EQ(1, validator.validateStereoStream(img0, img1));
+  }
+  MU_CHECK_EQ(3, validator.tracks[0].nb_tracked);
+  MU_CHECK_EQ(1, validator.validateStereoStream(img0, img1));
+  MU_CHECK_EQ(0, validator.tracks[0].nb_tracked);
+
+  // Statistics
+  const ReprojectionStats &stats = validator.stereo_stats;
+  std::cout << stats << std::endl;
+  MU_CHECK_EQ(nb_frames + 5, stats.nb_frames);
+  MU_CHECK(stats.nb_points > 0);
+  MU_CHECK(stats.rmse() > 0.0);
+  MU_CHECK(stats.max >= stats.rmse());
+
+  // Reset
+  validator.resetStream();
+  MU_CHECK_EQ(0, validator.stereo_stats.nb_frames);
+  MU_FALSE(validator.tracks[0].valid);
+
+  return 0;
+}
+
 int test_CalibValidator_validate_live() {
   // Load validator
   CalibValidator validator;
@@ -214,6 +258,7 @@ void test_suite() {
   MU_ADD_TEST(test_CalibValidator_load);
   // MU_ADD_TEST(test_CalibValidator_validate);
   MU_ADD_TEST(test_CalibValidator_validateStereo);
+  MU_ADD_TEST(test_CalibValidator_validateStereoStream);
   // MU_ADD_TEST(test_CalibValidator_validate_live);
   // MU_ADD_TEST(test_CalibValidator_validateStereo_live);
   // MU_ADD_TEST(test_CalibValidator_validateTriclops_live);
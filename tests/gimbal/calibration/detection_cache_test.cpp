@@ -0,0 +1,135 @@
+#include "gvio/munit.hpp"
+#include "gvio/gimbal/calibration/detection_cache.hpp"
+
+namespace gvio {
+
+#define TEST_CACHE "/tmp/test_detection_cache.bin"
+
+static DetectionCacheEntry test_entry() {
+  DetectionCacheEntry entry;
+  entry.retval = 0;
+  entry.points[1] = {{1.0, 2.0}, {3.0, 4.0}, {5.0, 6.0}, {7.0, 8.0}};
+  entry.points[5] = {{1.5, 2.5}, {3.5, 4.5}, {5.5, 6.5}, {7.5, 8.5}};
+  return entry;
+}
+
+int test_DetectionCache_key() {
+  cv::Mat image0(10, 20, CV_8UC1, cv::Scalar(0));
+  cv::Mat image1(10, 20, CV_8UC1, cv::Scalar(0));
+  image1.at<uchar>(5, 5) = 255;
+
+  // Same image and config gives the same key
+  const uint64_t key0 = DetectionCache::key(image0, "config");
+  MU_CHECK(key0 == DetectionCache::key(image0, "config"));
+
+  // Different image content or config gives a different key
+  MU_CHECK(key0 != DetectionCache::key(image1, "config"));
+  MU_CHECK(key0 != DetectionCache::key(image0, "config2"));
+
+  return 0;
+}
+
+int test_DetectionCache_insert_and_lookup() {
+  remove(TEST_CACHE);
+  const DetectionCacheEntry expected = test_entry();
+
+  DetectionCache cache;
+  MU_CHECK_EQ(0, cache.open(TEST_CACHE));
+  MU_CHECK_EQ(0, cache.insert(42, expected));
+
+  DetectionCacheEntry entry;
+  MU_CHECK(cache.lookup(42, entry));
+  MU_CHECK_EQ(0, entry.retval);
+  MU_CHECK_EQ(2, (int) entry.points.size());
+  MU_CHECK_FLOAT(3.5, entry.points[5][1].x);
+  MU_FALSE(cache.lookup(43, entry));
+
+  return 0;
+}
+
+int test_DetectionCache_open() {
+  remove(TEST_CACHE);
+
+  // Write entries, including a failed detection
+  {
+    DetectionCache cache;
+    DetectionCacheEntry failed;
+    failed.retval = -1;
+    MU_CHECK_EQ(0, cache.open(TEST_CACHE));
+    MU_CHECK_EQ(0, cache.insert(1, test_entry()));
+    MU_CHECK_EQ(0, cache.insert(2, failed));
+  }
+
+  // Reopen and append
+  {
+    DetectionCache cache;
+    MU_CHECK_EQ(0, cache.open(TEST_CACHE));
+    MU_CHECK_EQ(2, (int) cache.size());
+    MU_CHECK_EQ(0, cache.insert(3, test_entry()));
+  }
+
+  // Reopen
+  DetectionCache cache;
+  DetectionCacheEntry entry;
+  MU_CHECK_EQ(0, cache.open(TEST_CACHE));
+  MU_CHECK_EQ(3, (int) cache.size());
+  MU_CHECK(cache.lookup(2, entry));
+  MU_CHECK_EQ(-1, entry.retval);
+  MU_CHECK(cache.lookup(3, entry));
+  MU_CHECK_FLOAT(8.0, entry.points[1][3].y);
+
+  // Invalid cache file
+  FILE *fp = fopen(TEST_CACHE, "wb");
+  fprintf(fp, "bogus data");
+  fclose(fp);
+  MU_CHECK_EQ(-1, cache.open(TEST_CACHE));
+
+  return 0;
+}
+
+int test_DetectionCache_open_truncated() {
+  remove(TEST_CACHE);
+  {
+    DetectionCache cache;
+    MU_CHECK_EQ(0, cache.open(TEST_CACHE));
+    MU_CHECK_EQ(0, cache.insert(1, test_entry()));
+    MU_CHECK_EQ(0, cache.insert(2, test_entry()));
+  }
+
+  // Simulate an interrupted write by truncating the last entry
+  FILE *fp = fopen(TEST_CACHE, "rb");
+  fseek(fp, 0, SEEK_END);
+  const long size = ftell(fp);
+  fclose(fp);
+  MU_CHECK_EQ(0, truncate(TEST_CACHE, size - 5));
+
+  // Truncated entry is dropped, new entries are appended after the last
+  // complete entry
+  {
+    DetectionCache cache;
+    MU_CHECK_EQ(0, cache.open(TEST_CACHE));
+    MU_CHECK_EQ(1, (int) cache.size());
+    MU_CHECK_EQ(0, cache.insert(3, test_entry()));
+  }
+
+  DetectionCache cache;
+  DetectionCacheEntry entry;
+  MU_CHECK_EQ(0, cache.open(TEST_CACHE));
+  MU_CHECK_EQ(2, (int) cache.size());
+  MU_CHECK(cache.lookup(1, entry));
+  MU_FALSE(cache.lookup(2, entry));
+  MU_CHECK(cache.lookup(3, entry));
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_DetectionCache_key);
+  MU_ADD_TEST(test_DetectionCache_insert_and_lookup);
+  MU_ADD_TEST(test_DetectionCache_open);
+  MU_ADD_TEST(test_DetectionCache_open_truncated);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
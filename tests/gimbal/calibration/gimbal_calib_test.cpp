@@ -6,12 +6,68 @@ namespace gvio {
 // #define TEST_CONFIG_FILE "test_configs/gimbal/calibration/params.yaml"
 // #define TEST_JOINT_DATA "test_data/calibration/joint.csv"
 #define TEST_DATA "/home/chutsu/Dropbox/measurements2"
+#define TEST_SOLVER_CONFIG "test_configs/gimbal/calibration/solver.yaml"
+#define TEST_CAMCHAIN "test_configs/gimbal/calibration/camchain.yaml"
+#define TEST_JOINT_DATA "test_data/calibration/joint.csv"
 
 int test_GimbalCalib_constructor() {
   GimbalCalib calib;
   return 0;
 }
 
+int test_GimbalCalib_configure() {
+  GimbalCalib calib;
+
+  MU_CHECK_EQ(0, calib.configure(TEST_SOLVER_CONFIG));
+  MU_CHECK(calib.linear_solver == "DENSE_SCHUR");
+  MU_CHECK_EQ(2, calib.nb_threads);
+  MU_CHECK_EQ(100, calib.max_iterations);
+  MU_FALSE(calib.verbose);
+
+  return 0;
+}
+
+int test_GimbalCalib_setupSolver() {
+  GimbalCalib calib;
+  MU_CHECK_EQ(0, calib.params.load(TEST_CAMCHAIN, TEST_JOINT_DATA));
+
+  // Solver settings without a problem, nothing to order
+  MU_CHECK_EQ(0, calib.configure(TEST_SOLVER_CONFIG));
+  MU_CHECK_EQ(0, calib.setupSolver());
+  MU_CHECK(calib.options.linear_solver_type == ceres::DENSE_SCHUR);
+  MU_CHECK_EQ(2, calib.options.num_threads);
+  MU_CHECK_EQ(100, calib.options.max_num_iterations);
+  MU_CHECK(calib.options.linear_solver_ordering.get() == nullptr);
+
+  // Problem with one corner per measurement
+  calib.data.nb_measurements = calib.params.nb_measurements;
+  for (int i = 0; i < calib.data.nb_measurements; i++) {
+    calib.data.P_s.emplace_back(Vec3{0.0, 0.0, 1.0}.transpose());
+    calib.data.P_d.emplace_back(Vec3{0.0, 0.0, 1.0}.transpose());
+    calib.data.Q_s.emplace_back(Vec2{376.0, 240.0}.transpose());
+    calib.data.Q_d.emplace_back(Vec2{376.0, 240.0}.transpose());
+  }
+  MU_CHECK_EQ(0, calib.setup());
+  calib.problem.SetParameterBlockConstant(&calib.params.Lambda1[0]);
+  MU_CHECK_EQ(0, calib.setupSolver());
+
+  // Joint angles Lambda1 are eliminated first, constant blocks not ordered
+  auto ordering = calib.options.linear_solver_ordering.get();
+  MU_CHECK(ordering != nullptr);
+  MU_CHECK_EQ(2, ordering->NumGroups());
+  MU_CHECK_EQ(calib.data.nb_measurements - 1, ordering->GroupSize(0));
+  MU_CHECK_EQ(-1, ordering->GroupId(&calib.params.Lambda1[0]));
+  MU_CHECK_EQ(0, ordering->GroupId(&calib.params.Lambda1[1]));
+  MU_CHECK_EQ(1, ordering->GroupId(calib.params.tau_s));
+  MU_CHECK_EQ(-1, ordering->GroupId(calib.params.w2));
+
+  // Invalid linear solver
+  calib.linear_solver = "BOGUS";
+  MU_CHECK_EQ(-1, calib.setupSolver());
+
+  return 0;
+}
+
 int test_GimbalCalib_load() {
   GimbalCalib calib;
 
@@ -38,6 +94,8 @@ int test_GimbalCalib_load() {
 
 void test_suite() {
   MU_ADD_TEST(test_GimbalCalib_constructor);
+  MU_ADD_TEST(test_GimbalCalib_configure);
+  MU_ADD_TEST(test_GimbalCalib_setupSolver);
   MU_ADD_TEST(test_GimbalCalib_load);
 }
 
@@ -67,6 +67,83 @@ int test_GimbalCalibResidual_K() {
 //   return 0;
 // }
 
+int test_GimbalCalibMeasurementResidual_evaluate() {
+  // Calibration parameters away from zero, so every Jacobian is non-trivial
+  double tau_s[6] = {-0.0485, -0.0766, 0.6578, 0.0326, -0.0212, 0.0100};
+  double tau_d[6] = {0.0124, 0.0004, -0.0565, 1.5789, 0.0130, -1.5700};
+  double w1[3] = {0.5913, -0.0035, 1.5707};
+  double w2[3] = {0.01, 0.02, 0.03};
+  double Lambda1[1] = {-0.4};
+  double Lambda2[1] = {0.15};
+  double *params[6] = {tau_s, tau_d, w1, w2, Lambda1, Lambda2};
+  const int block_sizes[6] = {6, 6, 3, 3, 1, 1};
+
+  // Camera intrinsics
+  Mat3 K_s;
+  K_s << 393.4, 0.0, 370.0, 0.0, 395.3, 239.4, 0.0, 0.0, 1.0;
+  Mat3 K_d;
+  K_d << 524.9, 0.0, 364.9, 0.0, 526.8, 238.2, 0.0, 0.0, 1.0;
+  const Vec4 D_s{-0.0679, 0.0077, -0.0103, 0.0040};
+  const Vec4 D_d{-0.1118, 0.0067, 0.0267, -0.0348};
+
+  // Corner observations
+  const int nb_corners = 5;
+  MatX P_s(nb_corners, 3);
+  MatX P_d(nb_corners, 3);
+  MatX Q_s(nb_corners, 2);
+  MatX Q_d(nb_corners, 2);
+  for (int i = 0; i < nb_corners; i++) {
+    P_s.row(i) << 0.05 * i - 0.1, 0.03 * i - 0.05, 0.8 + 0.01 * i;
+    P_d.row(i) << 0.04 * i - 0.1, -0.02 * i + 0.05, 0.9 - 0.01 * i;
+    Q_s.row(i) << 300.0 + i, 200.0 - i;
+    Q_d.row(i) << 350.0 - i, 250.0 + i;
+  }
+
+  // Evaluate residual of the whole measurement
+  GimbalCalibMeasurementResidual cost(P_s, P_d, Q_s, Q_d, K_s, K_d, D_s, D_d);
+  VecX r = zeros(4 * nb_corners, 1);
+  std::vector<MatX> J;
+  double *J_ptrs[6];
+  for (int b = 0; b < 6; b++) {
+    J.emplace_back(zeros(block_sizes[b], 4 * nb_corners));
+    J_ptrs[b] = J[b].data();
+  }
+  MU_CHECK(cost.Evaluate(params, r.data(), J_ptrs));
+
+  // Compare against the autodiff residual of every corner
+  for (int i = 0; i < nb_corners; i++) {
+    ceres::AutoDiffCostFunction<GimbalCalibResidual, 4, 6, 6, 3, 3, 1, 1>
+        autodiff_cost(new GimbalCalibResidual(P_s.row(i).transpose(),
+                                              P_d.row(i).transpose(),
+                                              Q_s.row(i).transpose(),
+                                              Q_d.row(i).transpose(),
+                                              K_s,
+                                              K_d,
+                                              D_s,
+                                              D_d));
+
+    Vec4 r_autodiff;
+    std::vector<MatX> J_autodiff;
+    double *J_autodiff_ptrs[6];
+    for (int b = 0; b < 6; b++) {
+      J_autodiff.emplace_back(zeros(block_sizes[b], 4));
+      J_autodiff_ptrs[b] = J_autodiff[b].data();
+    }
+    const bool ok =
+        autodiff_cost.Evaluate(params, r_autodiff.data(), J_autodiff_ptrs);
+    MU_CHECK(ok);
+
+    // Jacobians are row-major, hence stored transposed in column-major MatX
+    MU_CHECK((r.segment(4 * i, 4) - r_autodiff).norm() < 1e-8);
+    for (int b = 0; b < 6; b++) {
+      const MatX J_block = J[b].block(0, 4 * i, block_sizes[b], 4);
+      MU_CHECK((J_block - J_autodiff[b]).norm() < 1e-6);
+    }
+  }
+
+  return 0;
+}
+
 int test_GimbalCalibResidual_evaluate() {
   // Data
   CalibData data;
@@ -146,6 +223,7 @@ void test_suite() {
   MU_ADD_TEST(test_GimbalCalibResidual_euler321ToRot);
   MU_ADD_TEST(test_GimbalCalibResidual_K);
   // MU_ADD_TEST(test_GimbalCalibResidual_T_sd);
+  MU_ADD_TEST(test_GimbalCalibMeasurementResidual_evaluate);
   MU_ADD_TEST(test_GimbalCalibResidual_evaluate);
 }
 
@@ -31,6 +31,128 @@ std::string cvmattype2str(int type) {
   return r;
 }
 
+/**
+ * Red square on a noisy gray background, offset horizontally by `shift`
+ */
+static cv::Mat test_image(const int shift = 0) {
+  cv::Mat image(240, 320, CV_8UC3);
+  for (int row = 0; row < image.rows; row++) {
+    for (int col = 0; col < image.cols; col++) {
+      const int x = col - shift;
+      const bool inside = (row >= 80 && row < 160 && x >= 110 && x < 210);
+      cv::Vec3b &pixel = image.at<cv::Vec3b>(row, col);
+      for (int k = 0; k < 3; k++) {
+        const int value = (inside) ? ((k == 2) ? 220 : 30) : 128;
+        pixel[k] = cv::saturate_cast<uchar>(value + randi(10, -10));
+      }
+    }
+  }
+
+  return image;
+}
+
+int test_GMR_GetSal_synthetic() {
+  const cv::Mat image = test_image();
+
+  // Saliency map is normalized and highlights the square
+  GMR gmr;
+  cv::Mat input = image.clone();
+  const cv::Mat saliency = gmr.GetSal(input);
+  MU_CHECK(saliency.size() == image.size());
+  MU_CHECK_EQ(CV_32F, saliency.type());
+
+  double val_min, val_max;
+  cv::minMaxLoc(saliency, &val_min, &val_max);
+  MU_CHECK_FLOAT(0.0, val_min);
+  MU_CHECK_FLOAT(1.0, val_max);
+
+  const double inside = cv::mean(saliency(cv::Rect(120, 90, 80, 60)))[0];
+  const double border = cv::mean(saliency(cv::Rect(0, 0, 320, 40)))[0];
+  MU_CHECK(inside > 0.5);
+  MU_CHECK(border < 0.2);
+
+  // Same sized frames reuse the previous factorization pattern
+  cv::Mat input2 = image.clone();
+  const cv::Mat saliency2 = gmr.GetSal(input2);
+  MU_CHECK(cv::norm(saliency, saliency2, cv::NORM_INF) < 1e-6);
+
+  return 0;
+}
+
+int test_GMR_Update() {
+  GMR gmr;
+
+  // First frame of a session is equivalent to GetSal()
+  cv::Mat image = test_image();
+  cv::Mat input = image.clone();
+  const cv::Mat expected = gmr.GetSal(input);
+  input = image.clone();
+  const cv::Mat saliency = gmr.Update(input);
+  MU_FALSE(gmr.graph_reused);
+  MU_CHECK(cv::norm(expected, saliency, cv::NORM_INF) < 1e-6);
+
+  // Square moving slowly, saliency follows it
+  for (int shift = 1; shift <= 5; shift++) {
+    cv::Mat frame = test_image(shift);
+    const cv::Mat saliency = gmr.Update(frame);
+    MU_CHECK(saliency.size() == image.size());
+
+    const cv::Rect roi(120 + shift, 90, 80, 60);
+    MU_CHECK(cv::mean(saliency(roi))[0] > 0.5);
+    MU_CHECK(cv::mean(saliency(cv::Rect(0, 0, 320, 40)))[0] < 0.2);
+  }
+
+  // Reset
+  gmr.Reset();
+  input = image.clone();
+  gmr.Update(input);
+  MU_FALSE(gmr.graph_reused);
+
+  return 0;
+}
+
+int test_GMR_Update_graph_reused() {
+  // Keep the superpixels of the first frame so the graph is reused
+  GMR gmr;
+  gmr.refine_iterations = 0;
+  gmr.lab_threshold = 0.0f;
+
+  // Same frame twice, nothing changed so the ranking is reused
+  const cv::Mat image = test_image();
+  cv::Mat input = image.clone();
+  const cv::Mat first = gmr.Update(input);
+  MU_FALSE(gmr.graph_reused);
+  input = image.clone();
+  const cv::Mat second = gmr.Update(input);
+  MU_CHECK(gmr.graph_reused);
+  MU_CHECK_EQ(0, gmr.nb_changed);
+  MU_CHECK(cv::norm(first, second, cv::NORM_INF) < 1e-6);
+
+  // Square grows to the right by a few pixels, only the superpixels around
+  // it change
+  cv::Mat frame = image.clone();
+  frame(cv::Rect(210, 80, 4, 80)).setTo(cv::Scalar(30, 30, 220));
+  input = frame.clone();
+  const cv::Mat saliency = gmr.Update(input);
+  MU_CHECK(gmr.graph_reused);
+  MU_CHECK(gmr.nb_changed > 0);
+  MU_CHECK(gmr.nb_changed < 50);
+
+  // A negative threshold re-weights every edge, which is a fresh ranking of
+  // the same graph
+  GMR reference;
+  reference.refine_iterations = 0;
+  reference.lab_threshold = -1.0f;
+  input = image.clone();
+  reference.Update(input);
+  input = frame.clone();
+  const cv::Mat expected = reference.Update(input);
+  MU_CHECK(reference.graph_reused);
+  MU_CHECK(cv::norm(expected, saliency, cv::NORM_INF) < 1e-6);
+
+  return 0;
+}
+
 int test_GMR_GetSal() {
   GMR gmr;
 
@@ -95,7 +217,12 @@ int test_GMR_GetSal() {
   return 0;
 }
 
-void test_suite() { MU_ADD_TEST(test_GMR_GetSal); }
+void test_suite() {
+  MU_ADD_TEST(test_GMR_GetSal_synthetic);
+  MU_ADD_TEST(test_GMR_Update);
+  MU_ADD_TEST(test_GMR_Update_graph_reused);
+  MU_ADD_TEST(test_GMR_GetSal);
+}
 
 } // namespace gvio
 
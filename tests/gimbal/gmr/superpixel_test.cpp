@@ -0,0 +1,155 @@
+#include "gvio/munit.hpp"
+#include "gvio/gimbal/gmr/superpixel.hpp"
+
+namespace gvio {
+
+/**
+ * Image with four uniformly coloured quadrants plus noise
+ */
+static cv::Mat test_image() {
+  // clang-format off
+  const int colors[4][3] = {{20, 200, 40},
+                            {220, 30, 30},
+                            {30, 30, 220},
+                            {240, 240, 240}};
+  // clang-format on
+
+  cv::Mat image(480, 640, CV_8UC3);
+  for (int row = 0; row < image.rows; row++) {
+    for (int col = 0; col < image.cols; col++) {
+      const int quadrant = (row < 240) * 2 + (col < 320);
+      cv::Vec3b &pixel = image.at<cv::Vec3b>(row, col);
+      for (int k = 0; k < 3; k++) {
+        const int noise = randi(10, -10);
+        pixel[k] = cv::saturate_cast<uchar>(colors[quadrant][k] + noise);
+      }
+    }
+  }
+
+  return image;
+}
+
+int test_SuperpixelSLIC_convertLab() {
+  const cv::Mat image = test_image();
+
+  SuperpixelSLIC slic;
+  MU_CHECK_EQ(0, slic.convertLab(image));
+  MU_CHECK(slic.lab.size() == image.size());
+  MU_CHECK_EQ(CV_32FC3, slic.lab.type());
+
+  // Compare against OpenCV's float conversion
+  cv::Mat image_float, expected;
+  image.convertTo(image_float, CV_32FC3, 1.0 / 255.0);
+  cv::cvtColor(image_float, expected, cv::COLOR_BGR2Lab);
+  MU_CHECK(cv::norm(slic.lab, expected, cv::NORM_INF) < 0.5);
+
+  // Invalid image type
+  cv::Mat gray(10, 10, CV_8UC1);
+  MU_CHECK_EQ(-1, slic.convertLab(gray));
+
+  return 0;
+}
+
+int test_SuperpixelSLIC_segment() {
+  const cv::Mat image = test_image();
+
+  SuperpixelSLIC slic;
+  cv::Mat labels;
+  int nb_labels = 0;
+  MU_CHECK_EQ(0, slic.segment(image, labels, nb_labels));
+  MU_CHECK_EQ(CV_32SC1, labels.type());
+  MU_CHECK(labels.size() == image.size());
+  MU_CHECK(nb_labels > 150);
+  MU_CHECK(nb_labels <= 250);
+
+  // Labels are within range, non-empty and do not cross colour boundaries
+  std::vector<int> counts(nb_labels, 0);
+  std::vector<int> quadrants(nb_labels, -1);
+  for (int row = 0; row < labels.rows; row++) {
+    for (int col = 0; col < labels.cols; col++) {
+      const int label = labels.at<int>(row, col);
+      MU_CHECK(label >= 0 && label < nb_labels);
+
+      const int quadrant = (row < 240) * 2 + (col < 320);
+      if (quadrants[label] == -1) {
+        quadrants[label] = quadrant;
+      }
+      MU_CHECK_EQ(quadrants[label], quadrant);
+      counts[label]++;
+    }
+  }
+  for (int i = 0; i < nb_labels; i++) {
+    MU_CHECK(counts[i] > 0);
+  }
+
+  return 0;
+}
+
+int test_SuperpixelSLIC_segment_parallel() {
+  const cv::Mat image = test_image();
+
+  // Serial
+  SuperpixelSLIC slic;
+  cv::Mat expected;
+  int expected_nb_labels = 0;
+  MU_CHECK_EQ(0, slic.segment(image, expected, expected_nb_labels));
+
+  // Parallel, segmenting twice to reuse buffers
+  ThreadPool pool{4};
+  SuperpixelSLIC slic_mt;
+  slic_mt.thread_pool = &pool;
+  cv::Mat labels;
+  int nb_labels = 0;
+  for (int i = 0; i < 2; i++) {
+    MU_CHECK_EQ(0, slic_mt.segment(image, labels, nb_labels));
+    MU_CHECK_EQ(expected_nb_labels, nb_labels);
+    MU_CHECK_EQ(0, cv::countNonZero(labels != expected));
+  }
+
+  return 0;
+}
+
+int test_SuperpixelSLIC_refine() {
+  const cv::Mat image = test_image();
+
+  // Refining the same image keeps the number of superpixels
+  SuperpixelSLIC slic;
+  cv::Mat labels;
+  int nb_labels = 0;
+  MU_CHECK_EQ(0, slic.segment(image, labels, nb_labels));
+  const int step = slic.step;
+  const size_t nb_seeds = slic.seeds.size();
+  int nb_refined = 0;
+  MU_CHECK_EQ(0, slic.refine(image, labels, nb_refined, 2));
+  MU_CHECK_EQ(step, slic.step);
+  MU_CHECK_EQ(nb_seeds, slic.seeds.size());
+
+  // Changing the number of superpixels re-segments with the new step size
+  slic.nb_superpixels = 50;
+  MU_CHECK_EQ(0, slic.refine(image, labels, nb_labels, 2));
+  MU_CHECK(slic.step > step);
+  MU_CHECK(slic.seeds.size() < nb_seeds);
+  MU_CHECK(nb_labels < nb_refined);
+
+  // Same result as segmenting from scratch
+  SuperpixelSLIC expected_slic;
+  expected_slic.nb_superpixels = 50;
+  cv::Mat expected;
+  int expected_nb_labels = 0;
+  MU_CHECK_EQ(0, expected_slic.segment(image, expected, expected_nb_labels));
+  MU_CHECK_EQ(expected_nb_labels, nb_labels);
+  MU_CHECK_EQ(0, cv::countNonZero(labels != expected));
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_SuperpixelSLIC_convertLab);
+  MU_ADD_TEST(test_SuperpixelSLIC_segment);
+  MU_ADD_TEST(test_SuperpixelSLIC_segment_parallel);
+  MU_ADD_TEST(test_SuperpixelSLIC_refine);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
@@ -1,8 +1,193 @@
+#include <atomic>
+#include <thread>
+
 #include "gvio/munit.hpp"
 #include "gvio/gimbal/sbgc.hpp"
 
 namespace gvio {
 
+static std::vector<uint8_t> form_frame(const int cmd_id,
+                                       uint8_t *data,
+                                       const int data_size) {
+  SBGCFrame frame;
+  frame.buildFrame(cmd_id, data, data_size);
+
+  std::vector<uint8_t> bytes = {'>',
+                                frame.cmd_id,
+                                frame.data_size,
+                                frame.header_checksum};
+  bytes.insert(bytes.end(), data, data + data_size);
+  bytes.push_back(frame.data_checksum);
+
+  return bytes;
+}
+
+/**
+ * SBGC controller emulated on the master side of a pseudo-terminal
+ */
+struct SBGCEmulator {
+  int master = -1;
+  std::string slave;
+  std::thread thread;
+  std::atomic<bool> running{false};
+  std::atomic<int> nb_control{0};
+
+  int start() {
+    this->master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (this->master < 0 || grantpt(this->master) != 0 ||
+        unlockpt(this->master) != 0) {
+      return -1;
+    }
+    this->slave = ptsname(this->master);
+
+    this->running = true;
+    this->thread = std::thread(&SBGCEmulator::run, this);
+    return 0;
+  }
+
+  void stop() {
+    this->running = false;
+    this->thread.join();
+    close(this->master);
+  }
+
+  void reply(const int cmd_id, uint8_t *data, const int data_size) {
+    // Prefix line noise, the client has to resynchronise
+    std::vector<uint8_t> bytes = {0x00, '>', 0x01};
+    const std::vector<uint8_t> frame = form_frame(cmd_id, data, data_size);
+    bytes.insert(bytes.end(), frame.begin(), frame.end());
+    if (write(this->master, bytes.data(), bytes.size()) < 0) {
+      LOG_ERROR("Failed to write to pseudo-terminal!");
+    }
+  }
+
+  void run() {
+    SBGCParser parser;
+    while (this->running) {
+      // Read requests
+      uint8_t buffer[256];
+      struct pollfd pfd = {this->master, POLLIN, 0};
+      if (poll(&pfd, 1, 10) <= 0) {
+        continue;
+      }
+      const ssize_t nb_bytes = read(this->master, buffer, sizeof(buffer));
+      if (nb_bytes <= 0) {
+        usleep(1000); // Slave not opened yet
+        continue;
+      }
+      parser.push(buffer, nb_bytes);
+
+      // Respond
+      SBGCFrame frame;
+      while (parser.pop(frame) == 1) {
+        uint8_t data[63] = {0};
+        const int16_t pitch = 10.0 / DEG_PER_BIT;
+
+        switch (frame.cmd_id) {
+          case CMD_BOARD_INFO:
+            data[0] = 30;
+            data[1] = 2604 & 0xff;
+            data[2] = 2604 >> 8;
+            this->reply(CMD_BOARD_INFO, data, 18);
+            break;
+          case CMD_REALTIME_DATA_3:
+            data[34] = pitch & 0xff;
+            data[35] = pitch >> 8;
+            this->reply(CMD_REALTIME_DATA_3, data, 63);
+            break;
+          case CMD_CONTROL: this->nb_control++; break;
+          default: break;
+        }
+        free(frame.data);
+      }
+    }
+  }
+};
+
+int test_SBGCParser_pop() {
+  SBGCParser parser;
+  SBGCFrame frame;
+  uint8_t data[3] = {1, 2, 3};
+
+  // Line noise, valid frame, corrupted frame and valid frame
+  std::vector<uint8_t> stream = {0x00, '>', 0x01};
+  std::vector<uint8_t> control = form_frame(CMD_CONTROL, data, 3);
+  std::vector<uint8_t> corrupted = form_frame(CMD_CONTROL, data, 3);
+  std::vector<uint8_t> info = form_frame(CMD_BOARD_INFO, data, 3);
+  corrupted[5] = 0xff;
+  stream.insert(stream.end(), control.begin(), control.end());
+  stream.insert(stream.end(), corrupted.begin(), corrupted.end());
+  stream.insert(stream.end(), info.begin(), info.end());
+
+  // Push all but the last 2 bytes
+  parser.push(stream.data(), stream.size() - 2);
+  MU_CHECK_EQ(1, parser.pop(frame));
+  MU_CHECK_EQ(CMD_CONTROL, frame.cmd_id);
+  MU_CHECK_EQ(3, frame.data_size);
+  MU_CHECK_EQ(3, frame.data[2]);
+  free(frame.data);
+  MU_CHECK_EQ(0, parser.pop(frame));
+
+  // Push rest of last frame
+  parser.push(stream.data() + stream.size() - 2, 2);
+  MU_CHECK_EQ(1, parser.pop(frame));
+  MU_CHECK_EQ(CMD_BOARD_INFO, frame.cmd_id);
+  free(frame.data);
+  MU_CHECK_EQ(0, parser.pop(frame));
+  MU_CHECK_EQ(0, parser.size());
+  MU_CHECK_EQ(3 + corrupted.size(), parser.nb_dropped);
+
+  return 0;
+}
+
+int test_SBGC_emulator() {
+  SBGCEmulator emulator;
+  MU_CHECK_EQ(0, emulator.start());
+
+  SBGC sbgc(emulator.slave);
+  MU_CHECK_EQ(0, sbgc.connect());
+
+  // Board info
+  MU_CHECK_EQ(0, sbgc.getBoardInfo());
+  MU_CHECK_EQ(30, sbgc.board_version);
+  MU_CHECK_EQ(2604, sbgc.firmware_version);
+
+  // Commands return once written
+  struct timespec t = tic();
+  for (int i = 0; i < 100; i++) {
+    MU_CHECK_EQ(0, sbgc.setAngle(0.0, 10.0, 0.0));
+  }
+  MU_CHECK(mtoc(&t) < 500.0);
+
+  // Realtime data
+  MU_CHECK_EQ(0, sbgc.getRealtimeData());
+  MU_CHECK_NEAR(10.0, sbgc.data.camera_angles(1), 0.1);
+
+  // Pipelined realtime data, dispatched by the event loop
+  int nb_callbacks = 0;
+  double pitch = 0.0;
+  sbgc.on_realtime_data = [&](const SBGCRealtimeData &data) {
+    pitch = data.camera_angles(1);
+    nb_callbacks++;
+  };
+  for (int i = 0; i < 10; i++) {
+    MU_CHECK_EQ(0, sbgc.requestRealtimeData());
+  }
+  const double deadline = time_now() + 2.0;
+  while (nb_callbacks < 10 && time_now() < deadline) {
+    MU_CHECK(sbgc.spinOnce(100) >= 0);
+  }
+  MU_CHECK_EQ(10, nb_callbacks);
+  MU_CHECK_NEAR(10.0, pitch, 0.1);
+  MU_CHECK_EQ(100, emulator.nb_control.load());
+
+  // Clean up
+  MU_CHECK_EQ(0, sbgc.disconnect());
+  emulator.stop();
+
+  return 0;
+}
+
 int test_SBGC_connectDisconnect() {
   SBGC sbgc("/dev/ttyUSB0");
   MU_CHECK_EQ(0, sbgc.connect());
@@ -145,6 +330,8 @@ int test_SBGC_setSpeedAngle() {
 }
 
 void test_suite() {
+  MU_ADD_TEST(test_SBGCParser_pop);
+  MU_ADD_TEST(test_SBGC_emulator);
   MU_ADD_TEST(test_SBGC_connectDisconnect);
   MU_ADD_TEST(test_SBGC_sendFrame);
   MU_ADD_TEST(test_SBGC_readFrame);
@@ -1,8 +1,84 @@
+#include <deque>
+
 #include "gvio/munit.hpp"
 #include "gvio/imu/mpu6050.hpp"
 
 namespace gvio {
 
+/**
+ * Simulated MPU6050 register map with FIFO
+ */
+struct MPU6050Sim : I2CRegisterMap {
+  std::deque<uint8_t> fifo;
+
+  int read(const uint8_t reg_addr,
+           uint8_t *data,
+           const size_t length) override {
+    for (size_t i = 0; i < length; i++) {
+      // FIFO data register does not auto-increment
+      if (reg_addr == MPU6050_RA_FIFO_R_W) {
+        data[i] = this->fifo.front();
+        this->fifo.pop_front();
+        continue;
+      }
+
+      const uint8_t reg = reg_addr + i;
+      if (reg == MPU6050_RA_FIFO_COUNTH) {
+        data[i] = this->fifo.size() >> 8;
+      } else if (reg == MPU6050_RA_FIFO_COUNTL) {
+        data[i] = this->fifo.size() & 0xff;
+      } else {
+        data[i] = this->registers[reg];
+      }
+    }
+
+    return 0;
+  }
+
+  int write(const uint8_t reg_addr,
+            const uint8_t *data,
+            const size_t length) override {
+    I2CRegisterMap::write(reg_addr, data, length);
+
+    // FIFO reset bit clears itself
+    uint8_t &user_ctrl = this->registers[MPU6050_RA_USER_CTRL];
+    if (user_ctrl & MPU6050_USER_CTRL_FIFO_RESET) {
+      this->fifo.clear();
+      user_ctrl &= ~MPU6050_USER_CTRL_FIFO_RESET;
+    }
+
+    return 0;
+  }
+
+  void addSample(const int16_t accel[3], const int16_t gyro[3]) {
+    if ((this->registers[MPU6050_RA_USER_CTRL] &
+         MPU6050_USER_CTRL_FIFO_EN) == 0) {
+      return;
+    }
+
+    for (int i = 0; i < 3; i++) {
+      this->fifo.push_back((accel[i] >> 8) & 0xff);
+      this->fifo.push_back(accel[i] & 0xff);
+    }
+    for (int i = 0; i < 3; i++) {
+      this->fifo.push_back((gyro[i] >> 8) & 0xff);
+      this->fifo.push_back(gyro[i] & 0xff);
+    }
+
+    // Overflow overwrites the oldest bytes
+    while (this->fifo.size() > MPU6050_FIFO_SIZE) {
+      this->fifo.pop_front();
+    }
+  }
+};
+
+static void setup_sim(MPU6050Sim &sim, MPU6050 &imu) {
+  imu.i2c.sim[MPU6050_ADDRESS] = &sim;
+  imu.accel.sensitivity = 16384.0;
+  imu.gyro.sensitivity = 131.0;
+  imu.sample_rate = 1000.0;
+}
+
 #define TEST_CONFIG "test_configs/imu/config.yaml"
 int test_MPU6050_configure() {
   int retval;
@@ -14,7 +90,70 @@ int test_MPU6050_configure() {
   return 0;
 }
 
-void test_suite() { MU_ADD_TEST(test_MPU6050_configure); }
+int test_MPU6050_readFIFO() {
+  MPU6050Sim sim;
+  MPU6050 imu;
+  setup_sim(sim, imu);
+  MU_CHECK_EQ(0, imu.enableFIFO());
+  MU_CHECK(imu.fifo_enabled);
+
+  // Burst of 25 samples, last sample is stamped with the read time
+  for (int i = 0; i < 25; i++) {
+    const int16_t accel[3] = {0, -16384, (int16_t) i};
+    const int16_t gyro[3] = {131, (int16_t) -i, 0};
+    sim.addSample(accel, gyro);
+  }
+  MU_CHECK_EQ(25, imu.readFIFO(1.0));
+  MU_CHECK_EQ(0, (int) sim.fifo.size());
+
+  MPU6050Sample sample;
+  for (int i = 0; i < 25; i++) {
+    MU_CHECK(imu.popSample(sample));
+    MU_CHECK_NEAR(1.0 - (24 - i) * 0.001, sample.timestamp, 1e-9);
+    MU_CHECK_NEAR(0.0, sample.accel[0], 1e-6);
+    MU_CHECK_NEAR(-9.81, sample.accel[1], 1e-5);
+    MU_CHECK_NEAR(i * 9.81 / 16384.0, sample.accel[2], 1e-6);
+    MU_CHECK_NEAR(deg2rad(1.0), sample.gyro[0], 1e-6);
+    MU_CHECK_NEAR(deg2rad(-i / 131.0), sample.gyro[1], 1e-6);
+  }
+  MU_FALSE(imu.popSample(sample));
+
+  // Next burst continues the timeline
+  const int16_t zeros[3] = {0, 0, 0};
+  for (int i = 0; i < 10; i++) {
+    sim.addSample(zeros, zeros);
+  }
+  MU_CHECK_EQ(10, imu.readFIFO(1.010));
+  MU_CHECK(imu.popSample(sample));
+  MU_CHECK_NEAR(1.001, sample.timestamp, 1e-9);
+
+  // Incomplete packet is left in the FIFO
+  sim.fifo.push_back(0x00);
+  MU_CHECK_EQ(0, imu.readFIFO(1.011));
+  MU_CHECK_EQ(1, (int) sim.fifo.size());
+  sim.fifo.clear();
+
+  // Overflow resets the FIFO
+  for (int i = 0; i < 100; i++) {
+    sim.addSample(zeros, zeros);
+  }
+  MU_CHECK_EQ(-2, imu.readFIFO(1.2));
+  MU_CHECK_EQ(1, (int) imu.nb_overflows);
+  MU_CHECK_EQ(0, (int) sim.fifo.size());
+
+  // Disable
+  MU_CHECK_EQ(0, imu.disableFIFO());
+  sim.addSample(zeros, zeros);
+  MU_CHECK_EQ(0, (int) sim.fifo.size());
+  MU_CHECK_EQ(-1, imu.readFIFO(1.3));
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_MPU6050_configure);
+  MU_ADD_TEST(test_MPU6050_readFIFO);
+}
 
 } // namespace gvio
 
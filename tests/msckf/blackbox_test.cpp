@@ -0,0 +1,55 @@
+#include "gvio/munit.hpp"
+#include "gvio/msckf/blackbox.hpp"
+
+namespace gvio {
+
+int test_BlackBox_record() {
+  BlackBox blackbox;
+  MSCKF msckf;
+  msckf.cam_states.emplace_back();
+  const Vec3 zero{0.0, 0.0, 0.0};
+
+  // Not configured
+  MU_CHECK_EQ(-1, blackbox.recordEstimate(0.0, zero, zero, zero));
+  MU_CHECK_EQ(-1, blackbox.recordMeasurement(0.0, zero, zero));
+  MU_CHECK_EQ(-1, blackbox.recordGroundTruth(0.0, zero, zero, zero));
+  MU_CHECK_EQ(-1, blackbox.recordCameraStates(msckf));
+
+  // Record
+  MU_CHECK_EQ(0, blackbox.configure("/tmp", "test_blackbox"));
+  MU_CHECK_EQ(0, blackbox.recordEstimate(0.0, zero, zero, zero));
+  MU_CHECK_EQ(0, blackbox.recordMeasurement(0.0, zero, zero));
+  MU_CHECK_EQ(0, blackbox.recordGroundTruth(0.0, zero, zero, zero));
+  MU_CHECK_EQ(0, blackbox.recordCameraStates(msckf));
+  int retval =
+      blackbox.recordTimeStep(0.1, msckf, zero, zero, zero, zero, zero);
+  MU_CHECK_EQ(0, retval);
+
+  // Records after close are lost and have to be reported
+  MU_CHECK_EQ(0, blackbox.close());
+  MU_CHECK_EQ(-1, blackbox.recordEstimate(0.2, zero, zero, zero));
+  MU_CHECK_EQ(-1, blackbox.recordMeasurement(0.2, zero, zero));
+  MU_CHECK_EQ(-1, blackbox.recordGroundTruth(0.2, zero, zero, zero));
+  MU_CHECK_EQ(-1, blackbox.recordCameraStates(msckf));
+  retval = blackbox.recordTimeStep(0.2, msckf, zero, zero, zero, zero, zero);
+  MU_CHECK_EQ(-1, retval);
+
+  // Only records before close are in the file
+  std::ifstream est_file("/tmp/test_blackbox_est.dat");
+  std::string line;
+  int nb_lines = 0;
+  while (std::getline(est_file, line)) {
+    nb_lines++;
+  }
+  MU_CHECK_EQ(3, nb_lines);
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_BlackBox_record);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
@@ -0,0 +1,78 @@
+#include "gvio/munit.hpp"
+#include "gvio/msckf/monte_carlo.hpp"
+
+namespace gvio {
+
+#define TEST_CONFIG "test_configs/msckf/monte_carlo.yaml"
+
+int test_MSCKFMonteCarlo_configure() {
+  MSCKFMonteCarlo monte_carlo;
+
+  MU_CHECK_EQ(0, monte_carlo.configure(TEST_CONFIG));
+  MU_CHECK_EQ(4, monte_carlo.nb_runs);
+  MU_CHECK_EQ(42, monte_carlo.seed);
+  MU_CHECK_FLOAT(0.5, monte_carlo.pixel_noise);
+  MU_CHECK_FLOAT(200.0, monte_carlo.imu.rate);
+  MU_CHECK_FLOAT(2.0e-3, monte_carlo.imu.accel_noise_density);
+  MU_CHECK_EQ(1000, monte_carlo.msckf.max_nb_tracks);
+
+  return 0;
+}
+
+int test_MSCKFMonteCarlo_run() {
+  MSCKFMonteCarlo monte_carlo;
+  MU_CHECK_EQ(0, monte_carlo.configure(TEST_CONFIG));
+
+  MU_CHECK_EQ(0, monte_carlo.run());
+  monte_carlo.printReport();
+  MU_CHECK_EQ(4, (int) monte_carlo.runs.size());
+  for (const auto &run : monte_carlo.runs) {
+    MU_CHECK_EQ(0, run.retval);
+    MU_CHECK_EQ(30, (int) run.frame_times.size());
+    MU_CHECK(run.ate > 0.0);
+    MU_CHECK(run.nees > 0.0);
+  }
+  MU_CHECK_EQ(0, monte_carlo.saveResults("/tmp/test_monte_carlo.csv"));
+
+  // Same seed reproduces every run, regardless of the number of threads
+  const std::vector<MonteCarloRun> runs = monte_carlo.runs;
+  monte_carlo.nb_threads = 1;
+  MU_CHECK_EQ(0, monte_carlo.run());
+  MU_CHECK_EQ(runs.size(), monte_carlo.runs.size());
+  for (size_t i = 0; i < runs.size(); i++) {
+    MU_CHECK_EQ(runs[i].index, monte_carlo.runs[i].index);
+    MU_CHECK_EQ(runs[i].retval, monte_carlo.runs[i].retval);
+    MU_CHECK_FLOAT(runs[i].ate, monte_carlo.runs[i].ate);
+    MU_CHECK_FLOAT(runs[i].rpe, monte_carlo.runs[i].rpe);
+    MU_CHECK_FLOAT(runs[i].nees, monte_carlo.runs[i].nees);
+  }
+
+  // Runs are independent
+  MU_CHECK(fabs(monte_carlo.runs[0].ate - monte_carlo.runs[1].ate) > 0.0);
+
+  return 0;
+}
+
+int test_MSCKFMonteCarlo_nbFrames() {
+  MSCKFMonteCarlo monte_carlo;
+  MU_CHECK_EQ(0, monte_carlo.configure(TEST_CONFIG));
+
+  // Duration is not an exact multiple of dt in binary (0.3 / 0.1 < 3)
+  monte_carlo.nb_runs = 1;
+  monte_carlo.duration = 0.3;
+  MU_CHECK_EQ(0, monte_carlo.run());
+  MU_CHECK_EQ(0, monte_carlo.runs[0].retval);
+  MU_CHECK_EQ(3, (int) monte_carlo.runs[0].frame_times.size());
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_MSCKFMonteCarlo_configure);
+  MU_ADD_TEST(test_MSCKFMonteCarlo_run);
+  MU_ADD_TEST(test_MSCKFMonteCarlo_nbFrames);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
@@ -293,6 +293,7 @@ int test_MSCKF_predictionUpdate() {
     // cv::waitKey(0);
   }
 
+  blackbox.close();
   PYTHON_SCRIPT("scripts/plot_msckf.py /tmp/test_msckf_predictionUpdate");
 
   return 0;
@@ -588,6 +589,7 @@ int test_MSCKF_measurementUpdate() {
   }
   printf("-- total elasped: %fs --\n", toc(&msckf_start));
   blackbox.recordCameraStates(msckf);
+  blackbox.close();
   PYTHON_SCRIPT("scripts/plot_msckf.py /tmp/test_msckf_measurementUpdate");
 
   return 0;
@@ -666,17 +668,17 @@ int test_MSCKF_measurementUpdate2() {
 
   printf("-- total elasped: %fs --\n", toc(&msckf_start));
   // blackbox.recordCameraStates(msckf);
+  blackbox.close();
   PYTHON_SCRIPT("scripts/plot_msckf.py /tmp/test_msckf_measurementUpdate");
 
   return 0;
 }
 
 int test_MSCKF_measurementUpdate3() {
-  std::srand(23);
-
   // Setup world
   SimWorld world;
   const double dt = 0.1;
+  world.seed = 23;
   world.nb_features = 10000;
   world.configure(dt);
 
@@ -737,6 +739,7 @@ int test_MSCKF_measurementUpdate3() {
            tracks.size());
   }
   blackbox.recordCameraStates(msckf);
+  blackbox.close();
   PYTHON_SCRIPT("scripts/plot_msckf.py /tmp/test_msckf_measurementUpdate");
 
   // mat2csv("/tmp/features.dat", world.features3d);
@@ -83,6 +83,38 @@ int test_Mission_configure_LOCAL() {
   return 0;
 }
 
+int test_Mission_buildSegments() {
+  Mission mission;
+
+  // Needs at least two waypoints
+  MU_CHECK_EQ(-1, mission.buildSegments());
+
+  // Setup
+  mission.local_waypoints.emplace_back(0.0, 0.0, 10.0);
+  mission.local_waypoints.emplace_back(3.0, 4.0, 10.0);
+  mission.local_waypoints.emplace_back(3.0, 4.0, 20.0);
+  MU_CHECK_EQ(0, mission.buildSegments());
+  MU_CHECK_EQ(2, (int) mission.segments.size());
+
+  // Segment geometry
+  const MissionSegment &seg = mission.segments[0];
+  MU_CHECK_FLOAT(5.0, seg.length);
+  MU_CHECK(seg.direction.isApprox(Vec3{0.6, 0.8, 0.0}));
+  MU_CHECK(seg.normal.isApprox(Vec3{-0.8, 0.6, 0.0}));
+  MU_CHECK_FLOAT(atan2(4.0, 3.0), seg.heading);
+
+  // Vertical segment has no horizontal normal
+  MU_CHECK_FLOAT(10.0, mission.segments[1].length);
+  MU_CHECK_FLOAT(0.0, mission.segments[1].normal.norm());
+
+  // First segment is active
+  MU_CHECK(mission.wp_start.isApprox(mission.local_waypoints[0]));
+  MU_CHECK(mission.wp_end.isApprox(mission.local_waypoints[1]));
+  MU_CHECK_FLOAT(5.0, mission.activeSegment().length);
+
+  return 0;
+}
+
 int test_Mission_closestPoint() {
   Mission mission;
 
@@ -232,6 +264,46 @@ int test_Mission_waypointReached() {
   return 0;
 }
 
+int test_Mission_updateSurvey() {
+  Mission mission;
+  mission.configured = true;
+  mission.look_ahead_dist = 0.5;
+  mission.threshold_waypoint_reached = 0.2;
+
+  // Lawnmower survey
+  const int nb_rows = 50;
+  for (int i = 0; i < nb_rows; i++) {
+    const double y = 5.0 * i;
+    mission.local_waypoints.emplace_back((i % 2) ? 20.0 : 0.0, y, 10.0);
+    mission.local_waypoints.emplace_back((i % 2) ? 0.0 : 20.0, y, 10.0);
+  }
+  MU_CHECK_EQ(0, mission.buildSegments());
+
+  // Follow interpolated waypoints until the mission is completed
+  Vec3 position{0.0, 0.0, 10.0};
+  int retval = 0;
+  int nb_ticks = 0;
+  double max_error = 0.0;
+  while (retval == 0 && nb_ticks < 100000) {
+    Vec3 waypoint;
+    retval = mission.update(position, waypoint);
+    const double error = fabs(mission.crossTrackError(position));
+    max_error = std::max(max_error, error);
+
+    const Vec3 dp = waypoint - position;
+    position += (dp.norm() > 0.2) ? 0.2 * dp.normalized() : dp;
+    nb_ticks++;
+  }
+
+  // All segments flown
+  MU_CHECK_EQ(-2, retval);
+  MU_CHECK(mission.completed);
+  // Corners are cut by at most the look ahead plus the reached threshold
+  MU_CHECK(max_error < 0.7 + 1e-6);
+
+  return 0;
+}
+
 int test_Mission_update() {
   Mission mission;
 
@@ -300,12 +372,14 @@ void test_suite() {
   MU_ADD_TEST(test_Mission_constructor);
   MU_ADD_TEST(test_Mission_configure_GPS);
   MU_ADD_TEST(test_Mission_configure_LOCAL);
+  MU_ADD_TEST(test_Mission_buildSegments);
   MU_ADD_TEST(test_Mission_closestPoint);
   MU_ADD_TEST(test_Mission_pointLineSide);
   MU_ADD_TEST(test_Mission_crossTrackError);
   MU_ADD_TEST(test_Mission_waypointInterpolate);
   MU_ADD_TEST(test_Mission_waypointHeading);
   MU_ADD_TEST(test_Mission_waypointReached);
+  MU_ADD_TEST(test_Mission_updateSurvey);
   MU_ADD_TEST(test_Mission_update);
 }
 
@@ -0,0 +1,95 @@
+#include "gvio/munit.hpp"
+#include "gvio/quadrotor/quadrotor_batch.hpp"
+#include "gvio/quadrotor/quadrotor_model.hpp"
+
+namespace gvio {
+
+int test_QuadrotorBatch_configure() {
+  QuadrotorBatch batch;
+
+  MU_CHECK_EQ(-1, batch.configure(0));
+  MU_CHECK_EQ(0, batch.configure(8));
+  MU_CHECK_EQ(8, (int) batch.nb_vehicles);
+  MU_CHECK_EQ(QB_STATE_SIZE * 8, (int) batch.state.size());
+  MU_CHECK_EQ(8, (int) batch.attitude_controllers.size());
+
+  batch.setPose(3, Vec3{0.1, 0.2, 0.3}, Vec3{1.0, 2.0, 3.0});
+  MU_CHECK((batch.attitude(3) - Vec3{0.1, 0.2, 0.3}).norm() < 1e-12);
+  MU_CHECK((batch.position(3) - Vec3{1.0, 2.0, 3.0}).norm() < 1e-12);
+  MU_CHECK(batch.position(2).norm() < 1e-12);
+
+  return 0;
+}
+
+int test_QuadrotorBatch_update() {
+  // Setup batch and reference models with different setpoints
+  const int nb_vehicles = 4;
+  QuadrotorBatch batch;
+  batch.configure(nb_vehicles);
+  std::vector<QuadrotorModel> models;
+  for (int k = 0; k < nb_vehicles; k++) {
+    const Vec3 rpy_G{0.0, 0.0, 0.1 * k};
+    const Vec3 p_G{0.0, 0.0, 5.0};
+    const Vec3 setpoint{1.0 + k, 2.0 - k, 5.0 + 0.5 * k};
+    batch.setPose(k, rpy_G, p_G);
+    batch.position_setpoints[k] = setpoint;
+
+    models.emplace_back(rpy_G, p_G);
+    models.back().setPosition(setpoint);
+  }
+
+  // Simulate
+  const double dt = 0.001;
+  for (int i = 0; i < 5000; i++) {
+    MU_CHECK_EQ(0, batch.update(dt));
+    for (auto &model : models) {
+      model.update(dt);
+    }
+  }
+
+  // Batch follows the same trajectories
+  for (int k = 0; k < nb_vehicles; k++) {
+    MU_CHECK((batch.position(k) - models[k].p_G).norm() < 1e-6);
+    MU_CHECK((batch.velocity(k) - models[k].v_G).norm() < 1e-6);
+    MU_CHECK((batch.attitude(k) - models[k].rpy_G).norm() < 1e-6);
+  }
+  MU_CHECK((batch.position(1) - batch.position(2)).norm() > 0.1);
+
+  return 0;
+}
+
+int test_QuadrotorBatch_integrate() {
+  // Constant motor inputs, slightly off hover so the vehicle drifts
+  const Vec4 motor_inputs{2.5, 2.48, 2.51, 2.49};
+  auto rollout = [&](const QuadrotorBatchIntegrator integrator,
+                     const double dt) {
+    QuadrotorBatch batch;
+    batch.configure(1);
+    batch.integrator = integrator;
+    batch.setPose(0, Vec3{0.0, 0.0, 0.0}, Vec3{0.0, 0.0, 5.0});
+    batch.setMotorInputs(0, motor_inputs);
+    for (int i = 0; i < round(1.0 / dt); i++) {
+      batch.integrate(dt);
+    }
+    return batch.position(0);
+  };
+
+  // RK4 at a coarse step is closer to the fine step solution than Euler
+  const Vec3 p_ref = rollout(QB_RK4, 1e-4);
+  const double euler_error = (rollout(QB_EULER, 0.01) - p_ref).norm();
+  const double rk4_error = (rollout(QB_RK4, 0.01) - p_ref).norm();
+  MU_CHECK(rk4_error < 1e-6);
+  MU_CHECK(rk4_error < euler_error / 100.0);
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_QuadrotorBatch_configure);
+  MU_ADD_TEST(test_QuadrotorBatch_update);
+  MU_ADD_TEST(test_QuadrotorBatch_integrate);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
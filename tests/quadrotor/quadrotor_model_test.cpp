@@ -182,9 +182,70 @@ int test_QuadrotorModel_update() {
   return 0;
 }
 
+int test_QuadrotorModel_addTasks() {
+  QuadrotorModel quad(Vec3{0.0, 0.0, 0.0}, Vec3{0.0, 0.0, 5.0});
+  quad.setPosition(Vec3{1.0, 1.0, 5.0});
+
+  // Waypoint mode needs a mission
+  PeriodicExecutor executor{true};
+  quad.ctrl_mode = WP_CTRL_MODE;
+  MU_CHECK_EQ(-1, quad.addTasks(executor));
+
+  // Fly to position setpoint in simulated time
+  quad.ctrl_mode = POS_CTRL_MODE;
+  MU_CHECK_EQ(0, quad.addTasks(executor));
+  MU_CHECK_EQ(0, executor.run(30.0));
+  executor.printStats();
+
+  MU_CHECK(executor.tasks[0].name == "waypoint");
+  MU_CHECK(executor.tasks[1].name == "position");
+  MU_CHECK(executor.tasks[2].name == "attitude");
+  MU_CHECK_EQ(300, (int) executor.tasks[0].nb_runs);
+  MU_CHECK_EQ(3000, (int) executor.tasks[1].nb_runs);
+  MU_CHECK_EQ(15000, (int) executor.tasks[2].nb_runs);
+  MU_CHECK((quad.p_G - Vec3{1.0, 1.0, 5.0}).norm() < 0.2);
+
+  return 0;
+}
+
+int test_QuadrotorModel_addTasksOrder() {
+  QuadrotorModel quad(Vec3{0.0, 0.0, 0.0}, Vec3{0.0, 0.0, 5.0});
+  quad.setPosition(Vec3{1.0, 1.0, 5.0});
+  QuadrotorModel expected = quad;
+
+  // Run the first tick only, where all tasks are released together
+  PeriodicExecutor executor{true};
+  MU_CHECK_EQ(0, quad.addTasks(executor));
+  MU_CHECK_EQ(0, executor.run(1e-3));
+  MU_CHECK_EQ(1, (int) executor.tasks[1].nb_runs);
+  MU_CHECK_EQ(1, (int) executor.tasks[2].nb_runs);
+
+  // Attitude task has to use the position setpoints of the same tick
+  const double dt = 1.0 / quad.attitude_rate;
+  expected.attitude_setpoints = quad.attitude_setpoints;
+  MU_CHECK_EQ(0, expected.update(expected.attitudeControllerControl(dt), dt));
+  MU_CHECK((quad.rpy_G - expected.rpy_G).norm() < 1e-12);
+  MU_CHECK((quad.w_G - expected.w_G).norm() < 1e-12);
+  MU_CHECK((quad.p_G - expected.p_G).norm() < 1e-12);
+  MU_CHECK((quad.v_G - expected.v_G).norm() < 1e-12);
+
+  return 0;
+}
+
+int test_QuadrotorModel_updateInvalidMode() {
+  QuadrotorModel quad;
+  quad.ctrl_mode = (QuadrotorControlMode) 3;
+  MU_CHECK_EQ(-1, quad.update(0.01));
+
+  return 0;
+}
+
 void test_suite() {
   MU_ADD_TEST(test_QuadrotorModel_constructor);
   MU_ADD_TEST(test_QuadrotorModel_update);
+  MU_ADD_TEST(test_QuadrotorModel_addTasks);
+  MU_ADD_TEST(test_QuadrotorModel_addTasksOrder);
+  MU_ADD_TEST(test_QuadrotorModel_updateInvalidMode);
 }
 
 } // namespace gvio
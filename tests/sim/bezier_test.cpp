@@ -180,12 +180,93 @@ int test_decasteljau() {
   return 0;
 }
 
+int test_BezierCurve() {
+  // Setup
+  std::vector<Vec3> points;
+  points.emplace_back(0, 0, 0);
+  points.emplace_back(1, 2, 0);
+  points.emplace_back(2, 0, 1);
+  points.emplace_back(3, 3, 0);
+  points.emplace_back(4, 1, 2);
+  BezierCurve curve{points};
+  MU_CHECK_EQ(4, curve.degree());
+
+  // End points
+  MU_CHECK((curve.position(0.0) - points.front()).norm() < 1e-12);
+  MU_CHECK((curve.position(1.0) - points.back()).norm() < 1e-12);
+  MU_CHECK((curve.velocity(0.0) - 4 * (points[1] - points[0])).norm() < 1e-12);
+
+  // Compare against the generic implementation
+  for (int i = 0; i <= 10; i++) {
+    const double t = i * 0.1;
+    const Vec3 p = bezier(points, t);
+    const Vec3 v = bezier_derivative(points, t, 1);
+    const Vec3 a = bezier_derivative(points, t, 2);
+    MU_CHECK((curve.position(t) - p).norm() < 1e-5);
+    MU_CHECK((curve.velocity(t) - v).norm() < 1e-5);
+    MU_CHECK((curve.acceleration(t) - a).norm() < 1e-5);
+    MU_CHECK((curve.position(t) - decasteljau(points, t)).norm() < 1e-5);
+  }
+
+  // Invalid curve
+  MU_CHECK_EQ(-1, curve.configure(std::vector<Vec3>()));
+
+  return 0;
+}
+
+int test_BezierCurve_evaluate() {
+  // Setup
+  std::vector<Vec3> points;
+  points.emplace_back(0, 0, 0);
+  points.emplace_back(1, 2, 0);
+  points.emplace_back(2, 0, 1);
+  points.emplace_back(3, 3, 0);
+  const BezierCurve curve{points};
+
+  // Evaluate a batch of times
+  const int nb_samples = 100000;
+  const VecX t = VecX::LinSpaced(nb_samples, 0.0, 1.0);
+  Mat3X pos;
+  Mat3X vel;
+  Mat3X acc;
+  struct timespec start = tic();
+  curve.evaluate(t, &pos, &vel, &acc);
+  const double batch_time = mtoc(&start);
+
+  start = tic();
+  for (int i = 0; i < nb_samples; i++) {
+    bezier(points, t(i));
+    bezier_derivative(points, t(i), 1);
+    bezier_derivative(points, t(i), 2);
+  }
+  const double generic_time = mtoc(&start);
+  std::cout << "batch: " << batch_time << "ms  ";
+  std::cout << "generic: " << generic_time << "ms" << std::endl;
+
+  // Batch matches single evaluation
+  MU_CHECK_EQ(nb_samples, pos.cols());
+  for (int i = 0; i < nb_samples; i += 1000) {
+    MU_CHECK((pos.col(i) - curve.position(t(i))).norm() < 1e-12);
+    MU_CHECK((vel.col(i) - curve.velocity(t(i))).norm() < 1e-12);
+    MU_CHECK((acc.col(i) - curve.acceleration(t(i))).norm() < 1e-12);
+  }
+
+  // Only requested outputs are evaluated
+  Mat3X pos_only;
+  curve.evaluate(t, &pos_only, nullptr, nullptr);
+  MU_CHECK((pos_only - pos).norm() < 1e-12);
+
+  return 0;
+}
+
 void test_suite() {
   // MU_ADD_TEST(test_bezier);
   // MU_ADD_TEST(test_bezier_derivative);
   // MU_ADD_TEST(test_bezier_derivative2);
   MU_ADD_TEST(test_bezier_tangent);
   // MU_ADD_TEST(test_decasteljau);
+  MU_ADD_TEST(test_BezierCurve);
+  MU_ADD_TEST(test_BezierCurve_evaluate);
 }
 
 } // namespace gvio
@@ -1,3 +1,5 @@
+#include <map>
+
 #include "gvio/munit.hpp"
 #include "gvio/camera/pinhole_model.hpp"
 #include "gvio/sim/camera.hpp"
@@ -143,9 +145,58 @@ int test_VirtualCamera_observedFeatures() {
   return 0;
 }
 
+int test_VirtualCamera_observedFeaturesGrid() {
+  struct test_config config;
+  VirtualCamera cam_model(config.image_width,
+                          config.image_height,
+                          config.fx,
+                          config.fy,
+                          config.cx,
+                          config.cy);
+
+  // Random features and index
+  MatX features = zeros(10000, 3);
+  for (long i = 0; i < features.rows(); i++) {
+    features(i, 0) = randf(-15.0, 15.0);
+    features(i, 1) = randf(-15.0, 15.0);
+    features(i, 2) = randf(-30.0, 30.0);
+  }
+  FeatureGrid grid;
+  MU_CHECK_EQ(0, grid.build(features));
+
+  // Grid query must observe exactly the same features as projecting all
+  for (int i = 0; i < 50; i++) {
+    const Vec3 rpy{randf(-0.3, 0.3), randf(-0.3, 0.3), randf(-M_PI, M_PI)};
+    const Vec3 t{randf(-20.0, 20.0), randf(-20.0, 20.0), randf(-5.0, 5.0)};
+
+    std::vector<int> expected_ids;
+    const MatX expected =
+        cam_model.observedFeatures(features, rpy, t, expected_ids);
+
+    std::vector<int> feature_ids;
+    Mat2X keypoints;
+    cam_model.observedFeatures(grid, rpy, t, feature_ids, keypoints);
+    MU_CHECK_EQ(expected_ids.size(), feature_ids.size());
+    MU_CHECK_EQ(feature_ids.size(), (size_t) keypoints.cols());
+
+    std::map<int, int> index;
+    for (size_t j = 0; j < expected_ids.size(); j++) {
+      index[expected_ids[j]] = j;
+    }
+    for (size_t j = 0; j < feature_ids.size(); j++) {
+      MU_CHECK(index.count(feature_ids[j]));
+      const Vec2 kp = expected.row(index[feature_ids[j]]).transpose();
+      MU_CHECK((kp - keypoints.col(j)).norm() < 1e-9);
+    }
+  }
+
+  return 0;
+}
+
 void test_suite() {
   MU_ADD_TEST(test_VirtualCamera_constructor);
   MU_ADD_TEST(test_VirtualCamera_observedFeatures);
+  MU_ADD_TEST(test_VirtualCamera_observedFeaturesGrid);
 }
 
 } // namespace gvio
@@ -0,0 +1,104 @@
+#include "gvio/munit.hpp"
+#include "gvio/sim/feature_grid.hpp"
+
+namespace gvio {
+
+static bool inside(const Frustum &frustum, const Vec3 &p) {
+  for (const Vec4 &plane : frustum.planes) {
+    if (plane.head(3).dot(p) + plane(3) < 0.0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int test_FeatureGrid_build() {
+  MatX features = zeros(1000, 3);
+  for (long i = 0; i < features.rows(); i++) {
+    features(i, 0) = randf(0.0, 10.0);
+    features(i, 1) = randf(0.0, 20.0);
+    features(i, 2) = randf(0.0, 30.0);
+  }
+
+  FeatureGrid grid;
+  MU_CHECK_EQ(-1, grid.build(zeros(0, 3)));
+  MU_CHECK_EQ(0, grid.build(features, 2.0));
+  MU_CHECK_EQ(1000, (int) grid.size());
+  MU_CHECK_EQ(5, grid.nb_cells[0]);
+  MU_CHECK_EQ(10, grid.nb_cells[1]);
+  MU_CHECK_EQ(15, grid.nb_cells[2]);
+
+  // Every feature is stored once, inside its cell
+  std::vector<bool> found(features.rows(), false);
+  for (int k = 0; k < grid.nb_cells[2]; k++) {
+    for (int j = 0; j < grid.nb_cells[1]; j++) {
+      for (int i = 0; i < grid.nb_cells[0]; i++) {
+        const int c = grid.cellIndex(i, j, k);
+        for (int n = grid.cell_start[c]; n < grid.cell_start[c + 1]; n++) {
+          const Vec3 p = grid.points[n] - grid.grid_min;
+          MU_CHECK_EQ(i, (int) (p(0) / grid.cell_size));
+          MU_CHECK_EQ(j, (int) (p(1) / grid.cell_size));
+          MU_CHECK_EQ(k, (int) (p(2) / grid.cell_size));
+          MU_CHECK(found[grid.ids[n]] == false);
+          found[grid.ids[n]] = true;
+        }
+      }
+    }
+  }
+  MU_CHECK(std::count(found.begin(), found.end(), true) == 1000);
+
+  return 0;
+}
+
+int test_FeatureGrid_query() {
+  MatX features = zeros(10000, 3);
+  for (long i = 0; i < features.rows(); i++) {
+    features(i, 0) = randf(-10.0, 10.0);
+    features(i, 1) = randf(-10.0, 10.0);
+    features(i, 2) = randf(-10.0, 10.0);
+  }
+  FeatureGrid grid;
+  MU_CHECK_EQ(0, grid.build(features));
+
+  // Box shaped frustum
+  Frustum frustum;
+  frustum.planes[0] = Vec4{1.0, 0.0, 0.0, 2.0};  // x >= -2
+  frustum.planes[1] = Vec4{-1.0, 0.0, 0.0, 3.0}; // x <= 3
+  frustum.planes[2] = Vec4{0.0, 1.0, 0.0, 1.0};  // y >= -1
+  frustum.planes[3] = Vec4{0.0, -1.0, 0.0, 1.0}; // y <= 1
+  frustum.planes[4] = Vec4{0.0, 0.0, 1.0, 0.0};  // z >= 0
+  frustum.planes[5] = Vec4{0.0, 0.0, -1.0, 5.0}; // z <= 5
+  frustum.box_min = Vec3{-2.0, -1.0, 0.0};
+  frustum.box_max = Vec3{3.0, 1.0, 5.0};
+
+  std::vector<int> cells;
+  grid.query(frustum, cells);
+  MU_CHECK(cells.size() > 0);
+
+  // All features inside are in the cells returned
+  int nb_candidates = 0;
+  int nb_inside = 0;
+  for (const int c : cells) {
+    for (int n = grid.cell_start[c]; n < grid.cell_start[c + 1]; n++) {
+      nb_inside += inside(frustum, grid.points[n]);
+      nb_candidates++;
+    }
+  }
+  int expected = 0;
+  for (long i = 0; i < features.rows(); i++) {
+    expected += inside(frustum, features.row(i).transpose());
+  }
+  MU_CHECK_EQ(expected, nb_inside);
+  MU_CHECK(nb_candidates < features.rows() / 4);
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_FeatureGrid_build);
+  MU_ADD_TEST(test_FeatureGrid_query);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
@@ -0,0 +1,81 @@
+#include "gvio/munit.hpp"
+#include "gvio/sim/imu.hpp"
+
+namespace gvio {
+
+int test_SimIMU_measure() {
+  SimIMU imu;
+  imu.reset();
+
+  // Noise free measurement
+  const Mat3 R_GB = euler321ToRot(Vec3{0.0, 0.0, M_PI / 2.0});
+  const Vec3 a_G{1.0, 0.0, 0.0};
+  const Vec3 w_B{0.0, 0.0, 0.1};
+  Vec3 a_m;
+  Vec3 w_m;
+  imu.measure(0.005, R_GB, a_G, w_B, a_m, w_m);
+  MU_CHECK(((R_GB * a_m + imu.g_G) - a_G).norm() < 1e-10);
+  MU_CHECK((w_m - w_B).norm() < 1e-10);
+
+  return 0;
+}
+
+int test_SimIMU_noise() {
+  SimIMU imu;
+  imu.accel_noise_density = 0.01;
+  imu.gyro_noise_density = 0.001;
+  imu.accel_random_walk = 0.1;
+  imu.gyro_random_walk = 0.01;
+  imu.reset();
+
+  // Stationary IMU at 200Hz
+  const double dt = 1.0 / 200.0;
+  const int nb_samples = 10000;
+  const Mat3 R_GB = I(3);
+  const Vec3 zero{0.0, 0.0, 0.0};
+  double a_sq = 0.0;
+  double w_sq = 0.0;
+  for (int i = 0; i < nb_samples; i++) {
+    Vec3 a_m;
+    Vec3 w_m;
+    const Vec3 b_a = imu.b_a;
+    const Vec3 b_g = imu.b_g;
+    imu.measure(dt, R_GB, zero, zero, a_m, w_m);
+
+    // White noise relative to the bias before the measurement, the bias
+    // only moved by one random walk step
+    a_sq += (a_m - b_a - Vec3{0.0, 0.0, 9.81}).squaredNorm();
+    w_sq += (w_m - b_g).squaredNorm();
+  }
+
+  // Discrete noise standard deviation is density / sqrt(dt)
+  const double sigma_a = sqrt(a_sq / (3 * nb_samples));
+  const double sigma_g = sqrt(w_sq / (3 * nb_samples));
+  MU_CHECK_NEAR(0.01 / sqrt(dt), sigma_a, 0.01 / sqrt(dt) * 0.05);
+  MU_CHECK_NEAR(0.001 / sqrt(dt), sigma_g, 0.001 / sqrt(dt) * 0.05);
+
+  // Biases performed a random walk
+  MU_CHECK(imu.b_a.norm() > 0.0);
+  MU_CHECK(imu.b_g.norm() > 0.0);
+
+  // Same seed, same measurements
+  SimIMU imu2 = imu;
+  imu.reset();
+  imu2.reset();
+  Vec3 a_m, w_m, a_m2, w_m2;
+  imu.measure(dt, R_GB, zero, zero, a_m, w_m);
+  imu2.measure(dt, R_GB, zero, zero, a_m2, w_m2);
+  MU_CHECK((a_m - a_m2).norm() < 1e-12);
+  MU_CHECK((w_m - w_m2).norm() < 1e-12);
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_SimIMU_measure);
+  MU_ADD_TEST(test_SimIMU_noise);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
@@ -85,6 +85,14 @@ int test_SimWorld_detectFeatures() {
   MU_CHECK(world.tracks_tracking.size() > 0);
   MU_CHECK(world.tracks_lost.size() > 0);
 
+  // Flat tracking state is consistent
+  MU_CHECK_EQ(world.features_tracking.size(), world.tracks_tracking.size());
+  for (size_t i = 0; i < world.features_tracking.size(); i++) {
+    const int feature_id = world.features_tracking[i];
+    MU_CHECK_EQ((int) i, world.feature_track[feature_id]);
+    MU_CHECK_EQ((long) world.time_index, world.tracks_tracking[i].frame_end);
+  }
+
   return 0;
 }
 
@@ -121,6 +129,65 @@ int test_SimWorld_step() {
   return 0;
 }
 
+int test_SimWorld_run() {
+  SimWorld world;
+  world.imu.rate = 200.0;
+  world.configure(0.1);
+  world.t_end = 2.0;
+
+  // Dead reckon the noise free IMU measurements from the initial state
+  Mat3 R_GB = euler321ToRot(world.robot.rpy_G);
+  Vec3 v_G = R_GB * world.robot.v_B;
+  Vec3 p_G = world.robot.p_G;
+  std::vector<long> imu_ts;
+  std::vector<long> camera_ts;
+  std::vector<size_t> nb_imu;
+  world.imu_cb = [&](const Vec3 &a_m, const Vec3 &w_m, const long ts) {
+    const double dt = 1.0 / world.imu.rate;
+    p_G += v_G * dt;
+    v_G += (R_GB * a_m + world.imu.g_G) * dt;
+    R_GB = R_GB * euler321ToRot(w_m * dt);
+    imu_ts.push_back(ts);
+    return 0;
+  };
+  world.camera_cb = [&](const FeatureTracks &, const long ts) {
+    camera_ts.push_back(ts);
+    nb_imu.push_back(imu_ts.size());
+    return 0;
+  };
+  MU_CHECK_EQ(0, world.run());
+
+  // IMU and camera events are time ordered
+  MU_CHECK_EQ(20, (int) camera_ts.size());
+  MU_CHECK_EQ(400, (int) imu_ts.size());
+  for (size_t i = 1; i < imu_ts.size(); i++) {
+    MU_CHECK_EQ(5000000, imu_ts[i] - imu_ts[i - 1]);
+  }
+  for (size_t i = 0; i < camera_ts.size(); i++) {
+    MU_CHECK_EQ(20 * (i + 1), nb_imu[i]);
+    MU_CHECK_EQ(imu_ts[nb_imu[i] - 1], camera_ts[i]);
+  }
+
+  // IMU measurements are consistent with the robot trajectory
+  MU_CHECK((p_G - world.robot.p_G).norm() < 1e-3);
+
+  // Number of steps does not depend on rounding of the accumulated time,
+  // ten steps of 0.1s add up to slightly less than 1s
+  world.configure(0.1);
+  world.t_end = 1.0;
+  camera_ts.clear();
+  imu_ts.clear();
+  nb_imu.clear();
+  MU_CHECK_EQ(0, world.run());
+  MU_CHECK_EQ(10, (int) camera_ts.size());
+
+  // Callback failures stop the simulation
+  world.imu_cb = [](const Vec3 &, const Vec3 &, const long) { return -1; };
+  MU_CHECK_EQ(-2, world.step());
+
+  return 0;
+}
+
 void test_suite() {
   MU_ADD_TEST(test_SimWorld_constructor);
   MU_ADD_TEST(test_SimWorld_constructor);
@@ -130,6 +197,7 @@ void test_suite() {
   MU_ADD_TEST(test_SimWorld_detectFeatures);
   MU_ADD_TEST(test_SimWorld_removeLostTracks);
   MU_ADD_TEST(test_SimWorld_step);
+  MU_ADD_TEST(test_SimWorld_run);
 }
 
 } // namespace gvio
@@ -0,0 +1,138 @@
+#include <unistd.h>
+
+#include "gvio/munit.hpp"
+#include "gvio/util/acquisition.hpp"
+#include "gvio/util/data.hpp"
+
+namespace gvio {
+
+#define TEST_IMU_CSV "/tmp/test_acquisition_imu.csv"
+
+int test_AcquisitionService_addSensor() {
+  AcquisitionService service;
+
+  const auto imu = synthetic_sensor(200.0, 6);
+  const auto gimbal = synthetic_sensor(50.0, 3);
+  MU_CHECK_EQ(0, service.addSensor("imu", SENSOR_IMU_EVENT, imu));
+  MU_CHECK_EQ(1, service.addSensor("gimbal", SENSOR_GIMBAL_EVENT, gimbal));
+  MU_CHECK_EQ(-1, service.addSensor("bogus", SENSOR_IMU_EVENT, nullptr));
+
+  // Recording requires a writer
+  MU_CHECK_EQ(-1, service.record(0, 0));
+
+  return 0;
+}
+
+int test_AcquisitionService_merge() {
+  AcquisitionService service;
+  service.addSensor("imu", SENSOR_IMU_EVENT, synthetic_sensor(200.0, 6));
+
+  // Events queued out of order are emitted in order up to the watermark
+  std::vector<int64_t> timestamps;
+  service.on_event = [&](const SensorEvent &event) {
+    timestamps.push_back(event.timestamp);
+  };
+
+  SensorEvent event;
+  event.sensor_id = 0;
+  for (const int64_t t : {30, 10, 20, 50, 40}) {
+    event.timestamp = t;
+    service.sensors[0]->queue.push(event);
+  }
+  service.drain();
+  MU_CHECK_EQ(3, service.merge(30));
+  MU_CHECK_EQ(2, service.merge(100));
+
+  MU_CHECK_EQ(5, (int) timestamps.size());
+  for (size_t i = 0; i < timestamps.size(); i++) {
+    MU_CHECK_EQ((int64_t) (i + 1) * 10, timestamps[i]);
+  }
+  MU_CHECK_EQ(0, (int) service.nb_late);
+
+  return 0;
+}
+
+int test_AcquisitionService_synthetic() {
+  AsyncWriter writer;
+  const std::string header = "t,ax,ay,az,wx,wy,wz";
+  const int imu_stream = writer.addStream(TEST_IMU_CSV, header, 6, 1);
+  writer.start();
+
+  AcquisitionService service;
+  service.writer = &writer;
+  const cv::Size image_size(64, 48);
+  const int imu = service.addSensor("imu",
+                                    SENSOR_IMU_EVENT,
+                                    synthetic_sensor(200.0, 6),
+                                    1.0 / 200.0);
+  const int cam = service.addSensor("cam",
+                                    SENSOR_CAMERA_EVENT,
+                                    synthetic_sensor(20.0, 0, image_size),
+                                    1.0 / 20.0);
+  const int gimbal = service.addSensor("gimbal",
+                                       SENSOR_GIMBAL_EVENT,
+                                       synthetic_sensor(50.0, 3),
+                                       1.0 / 50.0);
+  MU_CHECK_EQ(0, service.record(imu, imu_stream));
+
+  // Collect events
+  std::vector<SensorEvent> events;
+  service.on_event = [&](const SensorEvent &event) {
+    events.push_back(event);
+  };
+  MU_CHECK_EQ(0, service.start());
+  usleep(500 * 1000);
+  MU_CHECK_EQ(0, service.stop());
+  writer.stop();
+  service.printStats();
+
+  // Every event read was emitted, in timestamp order
+  uint64_t nb_read = 0;
+  for (const auto &sensor : service.sensors) {
+    nb_read += sensor->nb_events;
+    MU_CHECK_EQ(0, (int) sensor->nb_dropped);
+  }
+  MU_CHECK_EQ(nb_read, events.size());
+  MU_CHECK_EQ(0, (int) service.nb_late);
+  for (size_t i = 1; i < events.size(); i++) {
+    MU_CHECK(events[i].timestamp >= events[i - 1].timestamp);
+  }
+
+  // Rates
+  int nb_imu = 0;
+  int nb_cam = 0;
+  int nb_gimbal = 0;
+  for (const auto &event : events) {
+    nb_imu += (event.type == SENSOR_IMU_EVENT);
+    nb_cam += (event.type == SENSOR_CAMERA_EVENT);
+    nb_gimbal += (event.type == SENSOR_GIMBAL_EVENT);
+    if (event.type == SENSOR_CAMERA_EVENT) {
+      MU_CHECK(event.sensor_id == cam);
+      MU_CHECK(event.image.size() == image_size);
+    }
+  }
+  MU_CHECK(nb_imu > 80 && nb_imu < 120);
+  MU_CHECK(nb_cam > 7 && nb_cam < 13);
+  MU_CHECK(nb_gimbal > 20 && nb_gimbal < 30);
+
+  // Statistics
+  MU_CHECK_EQ(nb_imu, (int) service.sensors[imu]->latency.nb_samples);
+  MU_CHECK_EQ(nb_imu - 1, (int) service.sensors[imu]->jitter.nb_samples);
+  MU_CHECK(service.sensors[gimbal]->skew.nb_samples > 0);
+  MU_CHECK(service.sensors[imu]->latency.max_value < 1000.0 * 0.05 + 10.0);
+
+  // IMU events were recorded
+  MU_CHECK_EQ(nb_imu + 1, (int) csvrows(TEST_IMU_CSV));
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_AcquisitionService_addSensor);
+  MU_ADD_TEST(test_AcquisitionService_merge);
+  MU_ADD_TEST(test_AcquisitionService_synthetic);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
@@ -0,0 +1,201 @@
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "gvio/munit.hpp"
+#include "gvio/util/async_writer.hpp"
+#include "gvio/util/file.hpp"
+
+namespace gvio {
+
+#define TEST_CSV "/tmp/test_async_writer.csv"
+#define TEST_BIN "/tmp/test_async_writer.bin"
+#define TEST_BIN_CSV "/tmp/test_async_writer_bin.csv"
+
+static std::string read_file(const std::string &path) {
+  std::ifstream file(path);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+
+int test_AsyncWriter_addStream() {
+  AsyncWriter writer;
+
+  MU_CHECK_EQ(0, writer.addStream(TEST_CSV, "t,x", 2));
+  MU_CHECK_EQ(1, writer.addImageStream());
+  MU_CHECK_EQ(-1, writer.addStream(TEST_CSV, "", 0));
+  MU_CHECK_EQ(-1, writer.addStream(TEST_CSV, "", 100));
+  MU_CHECK_EQ(-1, writer.addStream("/bogus/dir/file.csv", "", 1));
+
+  // Streams cannot be added once the writer runs
+  writer.start();
+  MU_CHECK_EQ(-1, writer.addStream(TEST_CSV, "", 1));
+  writer.stop();
+
+  return 0;
+}
+
+int test_AsyncWriter_csv() {
+  AsyncWriter writer;
+  const int stream = writer.addStream(TEST_CSV, "t,x,y", 2, 1);
+  writer.start();
+
+  MU_CHECK_EQ(0, writer.write(stream, {1.5, -2.0}, 1000000000123));
+  MU_CHECK_EQ(0, writer.write(stream, {0.25, 3.0}, 1000000000456));
+  writer.stop();
+
+  // Same layout as writing with std::ofstream
+  const std::string expected = "t,x,y\n"
+                               "1000000000123,1.5,-2\n"
+                               "1000000000456,0.25,3\n";
+  MU_CHECK_EQ(expected, read_file(TEST_CSV));
+
+  return 0;
+}
+
+int test_AsyncWriter_binary() {
+  AsyncWriter writer;
+  const int stream = writer.addStream(TEST_BIN, "t,x,y", 2, 1, true);
+  writer.start();
+
+  // Write from a producer thread
+  std::thread producer([&] {
+    for (int i = 0; i < 1000; i++) {
+      writer.write(stream, {i * 0.5, -i * 1.0}, i);
+    }
+  });
+  producer.join();
+  writer.stop();
+  MU_CHECK_EQ(0, (int) writer.dropped(stream));
+
+  // Convert to CSV
+  MU_CHECK_EQ(0, async_writer_bin2csv(TEST_BIN, TEST_BIN_CSV));
+  std::ifstream csv_file(TEST_BIN_CSV);
+  std::string line;
+  std::getline(csv_file, line);
+  MU_CHECK_EQ("t,x,y", line);
+  for (int i = 0; i < 1000; i++) {
+    std::getline(csv_file, line);
+    std::ostringstream expected;
+    expected << i << "," << i * 0.5 << "," << -i * 1.0;
+    MU_CHECK_EQ(expected.str(), line);
+  }
+  MU_FALSE((bool) std::getline(csv_file, line));
+
+  // Not a binary record file
+  MU_CHECK_EQ(-1, async_writer_bin2csv(TEST_CSV, TEST_BIN_CSV));
+
+  return 0;
+}
+
+int test_AsyncWriter_timestamps() {
+  AsyncWriter writer;
+  const int csv_stream = writer.addStream(TEST_CSV, "t,t_sensor,x", 1, 2);
+  const int bin_stream = writer.addStream(TEST_BIN, "t,t_sensor,x", 1, 2, true);
+  MU_CHECK_EQ(-1, writer.addStream(TEST_CSV, "", 1, 3));
+  writer.start();
+
+  // Nanosecond timestamps above 2^53 are not exact as doubles
+  const int64_t t_sensor = 9007199254740993;
+  MU_CHECK_EQ(0, writer.write(csv_stream, {0.5}, {100, t_sensor}));
+  MU_CHECK_EQ(0, writer.write(bin_stream, {0.5}, {100, t_sensor}));
+  MU_CHECK_EQ(-1, writer.write(csv_stream, {0.5}, {100}));
+  writer.stop();
+
+  const std::string expected = "t,t_sensor,x\n"
+                               "100,9007199254740993,0.5\n";
+  MU_CHECK_EQ(expected, read_file(TEST_CSV));
+  MU_CHECK_EQ(0, async_writer_bin2csv(TEST_BIN, TEST_BIN_CSV));
+  MU_CHECK_EQ(expected, read_file(TEST_BIN_CSV));
+
+  return 0;
+}
+
+int test_AsyncWriter_dropped() {
+  AsyncWriter writer;
+  writer.queue_capacity = 4;
+  const int stream = writer.addStream(TEST_CSV, "", 1);
+
+  // Writer not running, queue fills up and records are dropped
+  for (int i = 0; i < 10; i++) {
+    writer.write(stream, {(double) i});
+  }
+  MU_CHECK_EQ(6, (int) writer.dropped(stream));
+
+  return 0;
+}
+
+int test_AsyncWriter_invalid() {
+  AsyncWriter writer;
+  const int stream = writer.addStream(TEST_CSV, "", 2);
+  const int image_stream = writer.addImageStream();
+
+  // Invalid stream ids
+  MU_CHECK_EQ(-1, writer.write(-1, {1.0, 2.0}));
+  MU_CHECK_EQ(-1, writer.write(2, {1.0, 2.0}));
+  MU_CHECK_EQ(-1, writer.writeImage(2, "/tmp/test.png", cv::Mat()));
+  MU_CHECK_EQ(-1, (int) writer.dropped(-1));
+  MU_CHECK_EQ(-1, (int) writer.dropped(2));
+
+  // Wrong stream type
+  MU_CHECK_EQ(-1, writer.write(image_stream, {1.0, 2.0}));
+  MU_CHECK_EQ(-1, writer.writeImage(stream, "/tmp/test.png", cv::Mat()));
+
+  // Number of values does not match the stream
+  MU_CHECK_EQ(-1, writer.write(stream, {1.0}));
+  MU_CHECK_EQ(-1, writer.write(stream, {1.0, 2.0, 3.0}));
+
+  // Records queued without starting the writer are written on stop
+  MU_CHECK_EQ(0, writer.write(stream, {1.0, 2.0}));
+  MU_CHECK_EQ(0, writer.stop());
+  MU_CHECK_EQ("1,2\n", read_file(TEST_CSV));
+
+  // Files are closed once stopped, further records would be lost
+  MU_CHECK_EQ(-1, writer.write(stream, {3.0, 4.0}));
+  MU_CHECK_EQ(-1, writer.writeImage(image_stream, "/tmp/test.png", cv::Mat()));
+  MU_CHECK_EQ(-1, writer.start());
+  MU_CHECK_EQ("1,2\n", read_file(TEST_CSV));
+
+  return 0;
+}
+
+int test_AsyncWriter_wait_when_full() {
+  AsyncWriter writer;
+  writer.queue_capacity = 4;
+  writer.drop_when_full = false;
+  const int stream = writer.addStream(TEST_CSV, "", 1);
+  writer.start();
+
+  // Producer waits for the writer instead of dropping records
+  for (int i = 0; i < 1000; i++) {
+    MU_CHECK_EQ(0, writer.write(stream, {(double) i}));
+  }
+  writer.stop();
+  MU_CHECK_EQ(0, (int) writer.dropped(stream));
+
+  std::ifstream csv_file(TEST_CSV);
+  std::string line;
+  int nb_lines = 0;
+  while (std::getline(csv_file, line)) {
+    MU_CHECK_EQ(std::to_string(nb_lines), line);
+    nb_lines++;
+  }
+  MU_CHECK_EQ(1000, nb_lines);
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_AsyncWriter_addStream);
+  MU_ADD_TEST(test_AsyncWriter_csv);
+  MU_ADD_TEST(test_AsyncWriter_binary);
+  MU_ADD_TEST(test_AsyncWriter_timestamps);
+  MU_ADD_TEST(test_AsyncWriter_dropped);
+  MU_ADD_TEST(test_AsyncWriter_invalid);
+  MU_ADD_TEST(test_AsyncWriter_wait_when_full);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
@@ -0,0 +1,144 @@
+#include "gvio/munit.hpp"
+#include "gvio/util/executor.hpp"
+
+namespace gvio {
+
+int test_PeriodicExecutor_addTask() {
+  PeriodicExecutor executor;
+  auto func = [](const double) { return 0; };
+
+  MU_CHECK_EQ(-1, executor.addTask("invalid", 0.0, 0, func));
+  MU_CHECK_EQ(-1, executor.addTask("invalid", 10.0, 0, nullptr));
+  MU_CHECK_EQ(0, executor.addTask("low", 10.0, 0, func));
+  MU_CHECK_EQ(0, executor.addTask("high", 500.0, 2, func));
+  MU_CHECK_EQ(0, executor.addTask("mid", 100.0, 1, func));
+  MU_CHECK_EQ(0, executor.addTask("mid2", 100.0, 1, func));
+
+  // Tasks are ordered by priority
+  MU_CHECK_EQ(4, (int) executor.tasks.size());
+  MU_CHECK(executor.tasks[0].name == "high");
+  MU_CHECK(executor.tasks[1].name == "mid");
+  MU_CHECK(executor.tasks[2].name == "mid2");
+  MU_CHECK(executor.tasks[3].name == "low");
+  MU_CHECK_EQ(2000000, executor.tasks[0].period);
+
+  return 0;
+}
+
+int test_PeriodicExecutor_simulated() {
+  PeriodicExecutor executor{true};
+
+  // Record order of runs and time steps
+  std::vector<std::string> order;
+  std::vector<double> dts;
+  auto task = [&](const std::string &name) {
+    return [&, name](const double dt) {
+      order.push_back(name);
+      if (name == "attitude") {
+        dts.push_back(dt);
+      }
+      return 0;
+    };
+  };
+  executor.addTask("waypoint", 10.0, 0, task("waypoint"));
+  executor.addTask("position", 100.0, 1, task("position"));
+  executor.addTask("attitude", 500.0, 2, task("attitude"));
+  MU_CHECK_EQ(0, executor.run(1.0));
+
+  // Every task ran at its rate, highest priority first
+  MU_CHECK_EQ(500, (int) executor.tasks[0].nb_runs);
+  MU_CHECK_EQ(100, (int) executor.tasks[1].nb_runs);
+  MU_CHECK_EQ(10, (int) executor.tasks[2].nb_runs);
+  MU_CHECK(order[0] == "attitude");
+  MU_CHECK(order[1] == "position");
+  MU_CHECK(order[2] == "waypoint");
+  MU_CHECK(order[3] == "attitude");
+  for (const double dt : dts) {
+    MU_CHECK_NEAR(0.002, dt, 1e-12);
+  }
+
+  // No jitter or misses in simulated time
+  for (const auto &task : executor.tasks) {
+    MU_CHECK_EQ(0, (int) task.nb_misses);
+    MU_CHECK_EQ(0, (int) task.nb_skipped);
+    MU_CHECK_FLOAT(0.0, task.jitter.max_value);
+  }
+  executor.printStats();
+
+  return 0;
+}
+
+int test_PeriodicExecutor_deadlineMiss() {
+  PeriodicExecutor executor{true};
+
+  // Third run takes 2.5 periods
+  int nb_runs = 0;
+  executor.addTask("task", 100.0, 0, [&](const double) {
+    nb_runs++;
+    return (nb_runs == 3) ? executor.advance(0.025) : 0;
+  });
+  MU_CHECK_EQ(0, executor.run(0.1));
+
+  // Run finished after its deadline, one release is dropped and the next
+  // run starts late
+  const ExecutorTask &task = executor.tasks[0];
+  MU_CHECK_EQ(1, (int) task.nb_misses);
+  MU_CHECK_EQ(1, (int) task.nb_skipped);
+  MU_CHECK_EQ(9, (int) task.nb_runs);
+  MU_CHECK_NEAR(5.0, task.jitter.max_value, 1e-6);
+
+  return 0;
+}
+
+int test_PeriodicExecutor_stop() {
+  PeriodicExecutor executor{true};
+
+  int nb_runs = 0;
+  executor.addTask("task", 100.0, 0, [&](const double) {
+    nb_runs++;
+    if (nb_runs == 5) {
+      executor.stop();
+    }
+    return 0;
+  });
+  MU_CHECK_EQ(0, executor.run(1.0));
+  MU_CHECK_EQ(5, nb_runs);
+
+  // Task failure stops executor
+  PeriodicExecutor failing{true};
+  failing.addTask("task", 100.0, 0, [](const double) { return -1; });
+  MU_CHECK_EQ(-1, failing.run(1.0));
+  MU_CHECK_EQ(1, (int) failing.tasks[0].nb_runs);
+
+  return 0;
+}
+
+int test_PeriodicExecutor_realtime() {
+  PeriodicExecutor executor;
+
+  executor.addTask("task", 200.0, 0, [](const double) { return 0; });
+  struct timespec start = tic();
+  MU_CHECK_EQ(0, executor.run(0.2));
+  const double elapsed = toc(&start);
+  executor.printStats();
+
+  // Sleeps until the releases instead of running back to back
+  const ExecutorTask &task = executor.tasks[0];
+  MU_CHECK(task.nb_runs + task.nb_skipped == 40);
+  MU_CHECK(elapsed > 0.19);
+  MU_CHECK(elapsed < 0.3);
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_PeriodicExecutor_addTask);
+  MU_ADD_TEST(test_PeriodicExecutor_simulated);
+  MU_ADD_TEST(test_PeriodicExecutor_deadlineMiss);
+  MU_ADD_TEST(test_PeriodicExecutor_stop);
+  MU_ADD_TEST(test_PeriodicExecutor_realtime);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
@@ -192,6 +192,35 @@ int test_lerp() {
   return 0;
 }
 
+int test_randfAndRandn() {
+  // Same seed gives the same sequence
+  std::mt19937 rng_a(42);
+  std::mt19937 rng_b(42);
+  for (int i = 0; i < 100; i++) {
+    const double x = randf(rng_a, 2.0, -1.0);
+    MU_CHECK(x >= -1.0 && x <= 2.0);
+    MU_CHECK_FLOAT(x, randf(rng_b, 2.0, -1.0));
+  }
+
+  // Normal distribution
+  std::mt19937 rng(42);
+  double sum = 0.0;
+  double sum_sq = 0.0;
+  const int n = 10000;
+  for (int i = 0; i < n; i++) {
+    const double x = randn(rng, 1.0, 2.0);
+    sum += x;
+    sum_sq += x * x;
+  }
+  const double mean = sum / n;
+  const double stddev = sqrt(sum_sq / n - mean * mean);
+  MU_CHECK_NEAR(1.0, mean, 0.1);
+  MU_CHECK_NEAR(2.0, stddev, 0.1);
+  MU_CHECK_FLOAT(1.0, randn(rng, 1.0, 0.0));
+
+  return 0;
+}
+
 void test_suite() {
   MU_ADD_TEST(test_median);
   MU_ADD_TEST(test_deg2radAndrad2deg);
@@ -201,6 +230,7 @@ void test_suite() {
   MU_ADD_TEST(test_point_left_right);
   MU_ADD_TEST(test_closest_point);
   MU_ADD_TEST(test_lerp);
+  MU_ADD_TEST(test_randfAndRandn);
 }
 
 } // namespace gvio
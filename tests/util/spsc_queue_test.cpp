@@ -0,0 +1,71 @@
+#include <thread>
+
+#include "gvio/munit.hpp"
+#include "gvio/util/spsc_queue.hpp"
+
+namespace gvio {
+
+int test_SPSCQueue_push_and_pop() {
+  SPSCQueue<int> queue{3};
+  MU_CHECK_EQ(3, (int) queue.capacity());
+  MU_CHECK(queue.empty());
+
+  // Fill queue
+  MU_CHECK(queue.push(1));
+  MU_CHECK(queue.push(2));
+  MU_CHECK(queue.push(3));
+  MU_FALSE(queue.push(4));
+  MU_CHECK_EQ(3, (int) queue.size());
+
+  // Drain queue
+  int item = 0;
+  MU_CHECK(queue.pop(item));
+  MU_CHECK_EQ(1, item);
+  MU_CHECK(queue.push(4));
+  MU_CHECK(queue.pop(item));
+  MU_CHECK_EQ(2, item);
+  MU_CHECK(queue.pop(item));
+  MU_CHECK_EQ(3, item);
+  MU_CHECK(queue.pop(item));
+  MU_CHECK_EQ(4, item);
+  MU_FALSE(queue.pop(item));
+  MU_CHECK(queue.empty());
+
+  return 0;
+}
+
+int test_SPSCQueue_threaded() {
+  SPSCQueue<int> queue{16};
+  const int nb_items = 100000;
+
+  std::thread producer([&] {
+    for (int i = 0; i < nb_items; i++) {
+      while (queue.push(i) == false) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  // Items arrive in order and none are lost
+  int expected = 0;
+  while (expected < nb_items) {
+    int item = 0;
+    if (queue.pop(item)) {
+      MU_CHECK_EQ(expected, item);
+      expected++;
+    }
+  }
+  producer.join();
+  MU_CHECK(queue.empty());
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_SPSCQueue_push_and_pop);
+  MU_ADD_TEST(test_SPSCQueue_threaded);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
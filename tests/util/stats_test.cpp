@@ -31,7 +31,35 @@ int test_linreg() {
   return 0;
 }
 
-void test_suite() { MU_ADD_TEST(test_linreg); }
+int test_Histogram() {
+  Histogram hist{0.0, 10.0, 10};
+  for (int i = 0; i < 100; i++) {
+    hist.add(i * 0.1);
+  }
+  hist.add(-1.0);
+  hist.add(20.0);
+  std::cout << hist << std::endl;
+
+  MU_CHECK_EQ(102, (int) hist.nb_samples);
+  MU_CHECK_EQ(11, (int) hist.bins[0]);
+  MU_CHECK_EQ(11, (int) hist.bins[9]);
+  MU_CHECK_FLOAT(-1.0, hist.min_value);
+  MU_CHECK_FLOAT(20.0, hist.max_value);
+  MU_CHECK_NEAR(5.0, hist.percentile(50.0), 1e-6);
+  MU_CHECK_NEAR(10.0, hist.percentile(99.0), 1e-6);
+  MU_CHECK_NEAR((4950 * 0.1 + 19.0) / 102.0, hist.mean(), 1e-6);
+
+  hist.clear();
+  MU_CHECK_EQ(0, (int) hist.nb_samples);
+  MU_CHECK_FLOAT(0.0, hist.mean());
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_linreg);
+  MU_ADD_TEST(test_Histogram);
+}
 
 } // namespace gvio
 
@@ -0,0 +1,114 @@
+#include <atomic>
+
+#include "gvio/munit.hpp"
+#include "gvio/util/thread_pool.hpp"
+
+namespace gvio {
+
+int test_ThreadPool_constructor() {
+  ThreadPool pool{4};
+  MU_CHECK_EQ(4, (int) pool.size());
+
+  ThreadPool pool2{0};
+  MU_CHECK_EQ(1, (int) pool2.size());
+
+  return 0;
+}
+
+int test_ThreadPool_enqueue() {
+  ThreadPool pool{4};
+
+  std::atomic<int> counter{0};
+  std::vector<std::future<void>> results;
+  for (int i = 0; i < 100; i++) {
+    results.push_back(pool.enqueue([&counter]() { counter++; }));
+  }
+  for (auto &result : results) {
+    result.get();
+  }
+  MU_CHECK_EQ(100, counter.load());
+
+  return 0;
+}
+
+int test_ThreadPool_parallelFor() {
+  ThreadPool pool{3};
+
+  // Each element should be visited exactly once
+  std::vector<int> data(1001, 0);
+  pool.parallelFor(0, data.size(), [&data](int start, int stop) {
+    for (int i = start; i < stop; i++) {
+      data[i] += 1;
+    }
+  });
+  for (auto &x : data) {
+    MU_CHECK_EQ(1, x);
+  }
+
+  // More bands than elements
+  std::vector<int> data2(2, 0);
+  pool.parallelFor(0, data2.size(), [&data2](int start, int stop) {
+    for (int i = start; i < stop; i++) {
+      data2[i] += 1;
+    }
+  }, 8);
+  MU_CHECK_EQ(1, data2[0]);
+  MU_CHECK_EQ(1, data2[1]);
+
+  // Empty range
+  pool.parallelFor(0, 0, [](int, int) {});
+
+  return 0;
+}
+
+int test_ThreadPool_parallelForDynamic() {
+  ThreadPool pool{3};
+  MU_FALSE(pool.inWorker());
+
+  // Each element should be visited exactly once, by a valid task
+  std::vector<int> data(1001, 0);
+  std::vector<int> task_ids(1001, -1);
+  pool.parallelForDynamic(0, data.size(), [&](int task, int i) {
+    data[i] += 1;
+    task_ids[i] = task;
+  });
+  for (size_t i = 0; i < data.size(); i++) {
+    MU_CHECK_EQ(1, data[i]);
+    MU_CHECK(task_ids[i] >= 0 && task_ids[i] < 3);
+  }
+
+  // Empty range
+  pool.parallelForDynamic(0, 0, [](int, int) {});
+
+  return 0;
+}
+
+int test_ThreadPool_nested() {
+  ThreadPool pool{2};
+
+  // Nested parallel loops on the same pool run inline instead of deadlocking
+  std::atomic<int> counter{0};
+  std::atomic<int> in_worker{0};
+  pool.parallelForDynamic(0, 8, [&](int, int) {
+    in_worker += pool.inWorker();
+    pool.parallelFor(0, 10, [&](int start, int stop) {
+      counter += stop - start;
+    });
+  });
+  MU_CHECK_EQ(8, in_worker.load());
+  MU_CHECK_EQ(80, counter.load());
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_ThreadPool_constructor);
+  MU_ADD_TEST(test_ThreadPool_enqueue);
+  MU_ADD_TEST(test_ThreadPool_parallelFor);
+  MU_ADD_TEST(test_ThreadPool_parallelForDynamic);
+  MU_ADD_TEST(test_ThreadPool_nested);
+}
+
+} // namespace gvio
+
+MU_RUN_TESTS(gvio::test_suite);
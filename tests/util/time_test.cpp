@@ -16,7 +16,20 @@ int test_ticAndToc() {
   return 0;
 }
 
-void test_suite() { MU_ADD_TEST(test_ticAndToc); }
+int test_time_monotonic_ns() {
+  const int64_t t0 = time_monotonic_ns();
+  usleep(10 * 1000);
+  const int64_t t1 = time_monotonic_ns();
+  MU_CHECK(t1 - t0 > 9000000);
+  MU_CHECK(t1 - t0 < 20000000);
+
+  return 0;
+}
+
+void test_suite() {
+  MU_ADD_TEST(test_ticAndToc);
+  MU_ADD_TEST(test_time_monotonic_ns);
+}
 
 } // namespace gvio
 
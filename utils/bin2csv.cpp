@@ -0,0 +1,26 @@
+#include "gvio/gvio.hpp"
+
+using namespace gvio;
+
+void print_usage() {
+  std::cout << "Usage: bin2csv <binary record file> <output csv>" << std::endl;
+  std::cout << "Example: bin2csv msckf_est.bin msckf_est.dat" << std::endl;
+}
+
+int main(const int argc, const char *argv[]) {
+  // Parse CLI args
+  if (argc != 3) {
+    print_usage();
+    exit(-1);
+  }
+  const std::string bin_path(argv[1]);
+  const std::string csv_path(argv[2]);
+
+  // Convert
+  if (async_writer_bin2csv(bin_path, csv_path) != 0) {
+    LOG_ERROR("Failed to convert [%s] to csv!", bin_path.c_str());
+    return -1;
+  }
+
+  return 0;
+}
@@ -1,6 +1,5 @@
 #include <map>
-#include <mutex>
-#include <thread>
+#include <memory>
 #include <signal.h>
 
 #include "gvio/gvio.hpp"
@@ -17,19 +16,21 @@ void signal_handler(int signum) {
 }
 
 struct recorder_state {
-  bool pwm_ready = false;
-  bool gimbal_ready = false;
-  bool imu_ready = false;
-  bool cam0_ready = false;
-  bool cam1_ready = false;
-  bool cam2_ready = false;
-
-  std::map<long, long> camera_timestamps;
-  long cam0_counter = -1;
-  long cam1_counter = -1;
-  long cam2_counter = -1;
-
-  bool record = false;
+  // Drivers
+  PCA9685 pwm;
+  Gimbal gimbal;
+  MPU6050 imu;
+  IDSCamera camera[3];
+  std::unique_ptr<CaptureRing> ring[3];
+
+  // Acquisition service timestamps and orders all sensor events, the async
+  // writer records them so sensor threads never block on disk I/O
+  AsyncWriter writer;
+  AcquisitionService service;
+  int gimbal_stream = -1;
+  int imu_stream = -1;
+  int timestamp_stream = -1;
+  int image_stream[3] = {-1, -1, -1};
 };
 
 struct recorder_config {
@@ -84,198 +85,196 @@ int recorder_load_config(const std::string &config_file,
   return 0;
 }
 
-void recorder_is_ready(struct recorder_state *state) {
-  if (state->pwm_ready == true && state->gimbal_ready == true &&
-      state->imu_ready == true && state->cam0_ready == true &&
-      state->cam1_ready == true && state->cam2_ready == true) {
-    state->record = true;
+int recorder_setup_writer(const std::string &output_dir,
+                          struct recorder_state *state) {
+  AsyncWriter &writer = state->writer;
+
+  // Gimbal and IMU
+  // clang-format off
+  state->gimbal_stream = writer.addStream(output_dir + "/gimbal.dat", "t, roll, pitch, yaw", 3, 1);
+  state->imu_stream = writer.addStream(output_dir + "/imu.dat", "t, ax_B, ay_B, az_B, wx_B, wy_B, wz_B", 6, 1);
+  state->timestamp_stream = writer.addStream(output_dir + "/image_timestamps.csv", "t, sensor_timestamp, camera_index", 1, 2);
+  // clang-format on
+  if (state->gimbal_stream == -1 || state->imu_stream == -1 ||
+      state->timestamp_stream == -1) {
+    LOG_ERROR("Failed to create output files in [%s]!", output_dir.c_str());
+    return -1;
+  }
+
+  // Images
+  for (int i = 0; i < 3; i++) {
+    state->image_stream[i] = writer.addImageStream();
   }
+
+  return 0;
 }
 
-void pwm_thread(const double freq, struct recorder_state *state) {
+int recorder_setup_sensors(const struct recorder_config &config,
+                           struct recorder_state *state) {
   // Setup PWM signal
-  PCA9685 pwm_driver;
-  if (pwm_driver.configure(freq) != 0) {
+  if (state->pwm.configure(config.pwm_frequency) != 0) {
     LOG_ERROR("Failed to configure PWM driver!");
-    halt = 1;
-    return;
+    return -1;
   }
-  pwm_driver.setAllPWM(4096 / 2);
+  state->pwm.setAllPWM(4096 / 2);
 
-  // Set PWM signal as ready
-  state->pwm_ready = true;
-}
-
-void gimbal_thread(const std::string config_file,
-                   struct recorder_state *state,
-                   const std::string output_dir) {
-  // Setup Gimbal
-  Gimbal gimbal;
-  if (gimbal.configure(config_file) != 0) {
+  // Setup gimbal
+  if (state->gimbal.configure(config.gimbal_config) != 0) {
     LOG_ERROR("Failed to configure gimbal!");
-    halt = 1;
-    return;
+    return -1;
   }
 
-  // Set Gimbal as ready
-  state->gimbal_ready = true;
-
-  // Setup output file
-  const std::string output_path = output_dir + "/gimbal.dat";
-  std::ofstream output_file(output_path);
-  if (output_file.good() == false) {
-    LOG_ERROR("Failed to create output file [%s]", output_path.c_str());
-    halt = 1;
+  // Setup IMU, samples are read in bursts from the on-chip FIFO
+  if (state->imu.configure(config.imu_config) != 0) {
+    LOG_ERROR("Failed to configure imu!");
+    return -1;
+  } else if (state->imu.enableFIFO() != 0) {
+    LOG_ERROR("Failed to enable imu FIFO!");
+    return -1;
   }
-  output_file << "t, roll, pitch, yaw" << std::endl;
-
-  // Loop settings
-  const double frequency = 20.0;
-  double t_prev = time_now();
-  double t = 0.0;
-
-  // Loop
-  while (halt != 1) {
-    // Calculate loop rate
-    const double t_now = time_now();
-    t += t_now - t_prev;
-    t_prev = t_now;
-    if (t < (1.0 / frequency)) {
-      continue;
+
+  // Setup cameras with zero-copy capture
+  const std::string cam_configs[3] = {config.cam0_config,
+                                      config.cam1_config,
+                                      config.cam2_config};
+  for (int i = 0; i < 3; i++) {
+    if (state->camera[i].configure(cam_configs[i]) != 0) {
+      LOG_ERROR("Failed to configure camera [%d]!", i);
+      return -1;
+    }
+
+    const std::string output_path =
+        config.output_dir + "/cam" + std::to_string(i);
+    if (dir_create(output_path) != 0) {
+      LOG_ERROR("Failed to create output path [%s]!", output_path.c_str());
     }
-    t = 0.0;
-
-    // Update gimbal
-    gimbal.update();
-
-    // Record gimbal measurements
-    recorder_is_ready(state);
-    if (state->record) {
-      const long t = time_now() * 1e9;
-      output_file << std::to_string(t) << ",";
-      output_file << gimbal.camera_angles(0) << ",";
-      output_file << gimbal.camera_angles(1) << ",";
-      output_file << gimbal.camera_angles(2) << std::endl;
+
+    state->ring[i].reset(new CaptureRing(&state->camera[i]));
+    if (state->ring[i]->start() != 0) {
+      LOG_ERROR("Failed to start capture ring [%d]!", i);
+      return -1;
     }
   }
-  output_file.close();
-}
 
-void imu_thread(const std::string config_file,
-                struct recorder_state *state,
-                const std::string output_dir) {
-  // Setup IMU
-  MPU6050 imu;
-  if (imu.configure(config_file) != 0) {
-    LOG_ERROR("Failed to configure imu!");
-    halt = 1;
-    return;
-  }
+  return 0;
+}
 
-  // Set IMU as ready
-  state->imu_ready = true;
+int recorder_setup_service(const std::string &output_dir,
+                           struct recorder_state *state) {
+  AcquisitionService &service = state->service;
+  service.writer = &state->writer;
+
+  // IMU, timestamped by the FIFO timeline on the monotonic clock
+  MPU6050 &imu = state->imu;
+  auto imu_read = [&imu](SensorEvent &event) {
+    MPU6050Sample sample;
+    if (imu.popSample(sample) == false) {
+      usleep(2000);
+      if (imu.readFIFO(time_monotonic_ns() * 1e-9) == -1) {
+        return -1;
+      }
+      return 1;
+    }
 
-  // Setup output file
-  const std::string output_path = output_dir + "/imu.dat";
-  std::ofstream output_file(output_path);
-  if (output_file.good() == false) {
-    LOG_ERROR("Failed to create output file [%s]", output_path.c_str());
-    halt = 1;
-  }
-  output_file << "t, ax_B, ay_B, az_B, wx_B, wy_B, wz_B" << std::endl;
-
-  // Loop
-  while (halt != 1) {
-    // Get imu data
-    imu.getData();
-
-    // Record IMU measurements
-    recorder_is_ready(state);
-    if (state->record) {
-      const long t = time_now() * 1e9;
-      output_file << std::to_string(t) << ",";
-      output_file << imu.accel.x << ",";
-      output_file << imu.accel.y << ",";
-      output_file << imu.accel.z << ",";
-      output_file << imu.gyro.x << ",";
-      output_file << imu.gyro.y << ",";
-      output_file << imu.gyro.z << std::endl;
+    event.timestamp = sample.timestamp * 1e9;
+    event.nb_values = 6;
+    for (int i = 0; i < 3; i++) {
+      event.values[i] = sample.accel[i];
+      event.values[i + 3] = sample.gyro[i];
     }
-  }
-  output_file.close();
-}
+    return 0;
+  };
+  const double imu_period = 1.0 / imu.sample_rate;
+  const int imu_id =
+      service.addSensor("imu", SENSOR_IMU_EVENT, imu_read, imu_period);
+
+  // Gimbal, polled at a fixed rate
+  Gimbal &gimbal = state->gimbal;
+  const double gimbal_period = 1.0 / 20.0;
+  int64_t t_next = 0;
+  auto gimbal_read = [&gimbal, gimbal_period, t_next](
+                         SensorEvent &event) mutable {
+    if (t_next == 0) {
+      t_next = time_monotonic_ns();
+    }
+    t_next += gimbal_period * 1e9;
+    struct timespec ts;
+    ts.tv_sec = t_next / 1000000000;
+    ts.tv_nsec = t_next % 1000000000;
+    clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+
+    if (gimbal.update() != 0) {
+      return 1;
+    }
+    event.nb_values = 3;
+    for (int i = 0; i < 3; i++) {
+      event.values[i] = gimbal.camera_angles(i);
+    }
+    return 0;
+  };
+  const int gimbal_id = service.addSensor("gimbal",
+                                          SENSOR_GIMBAL_EVENT,
+                                          gimbal_read,
+                                          gimbal_period);
+
+  // Cameras, image is copied out of the capture buffer so the buffer can be
+  // released before the writer thread gets to encode it
+  int camera_id[3] = {-1, -1, -1};
+  for (int i = 0; i < 3; i++) {
+    CaptureRing &ring = *state->ring[i];
+    auto camera_read = [&ring](SensorEvent &event) {
+      CaptureFrame frame;
+      const int retval = ring.grab(frame);
+      if (retval != 0) {
+        return retval;
+      }
 
-void camera_thread(const int camera_index,
-                   const std::string config_file,
-                   struct recorder_state *state,
-                   const std::string output_dir) {
-  // Setup camera
-  IDSCamera camera;
-  if (camera.configure(config_file) != 0) {
-    LOG_ERROR("Failed to configure camera!");
-    halt = 1;
-    return;
+      event.sensor_timestamp = frame.timestamp;
+      event.image = frame.image.clone();
+      ring.release(frame);
+      return 0;
+    };
+    const std::string name = "cam" + std::to_string(i);
+    camera_id[i] = service.addSensor(name, SENSOR_CAMERA_EVENT, camera_read);
   }
 
-  // Set camera as ready
-  switch (camera_index) {
-    case 0: state->cam0_ready = true; break;
-    case 1: state->cam1_ready = true; break;
-    case 2: state->cam2_ready = true; break;
+  // Record
+  int retval = 0;
+  retval += service.record(imu_id, state->imu_stream);
+  retval += service.record(gimbal_id, state->gimbal_stream);
+  for (int i = 0; i < 3; i++) {
+    const int stream = state->image_stream[i];
+    const std::string image_dir = output_dir + "/cam" + std::to_string(i);
+    retval += service.record(camera_id[i], -1, stream, image_dir);
   }
-
-  // Create output directory if not already created
-  std::string output_path = output_dir;
-  output_path += "/cam" + std::to_string(camera_index);
-  if (dir_create(output_path) != 0) {
-    LOG_ERROR("Failed to create output path [%s]!", output_path.c_str());
+  if (retval != 0) {
+    LOG_ERROR("Failed to setup recording!");
+    return -1;
   }
 
-  // Create image timestamp file
-  std::string timestamp_path = output_dir + "/image_timestamps.csv";
-  std::ofstream timestamp_file;
-  if (camera_index == 0) {
-    timestamp_file.open(timestamp_path);
+  // Map image timestamps to hardware timestamps, `on_event` runs on the
+  // merger thread which is the only producer of all writer streams
+  AsyncWriter &writer = state->writer;
+  const int timestamp_stream = state->timestamp_stream;
+  std::map<int, int> camera_index;
+  for (int i = 0; i < 3; i++) {
+    camera_index[camera_id[i]] = i;
   }
-
-  // Loop
-  while (halt != 1) {
-    // Get camera frame
-    cv::Mat image;
-    if (camera.getFrame(image) != 0) {
-      break;
+  service.on_event = [&writer, timestamp_stream, camera_index](
+                         const SensorEvent &event) {
+    if (event.type != SENSOR_CAMERA_EVENT) {
+      return;
     }
 
-    // Record
-    recorder_is_ready(state);
-    if (state->record) {
-      // Get camera counter
-      long counter = 0;
-      switch (camera_index) {
-        case 0: {
-          state->cam0_counter++;
-          counter = state->cam0_counter;
-          const long t = time_now() * 1.0e9;
-          timestamp_file << t << std::endl;
-          break;
-        }
-        case 1:
-          state->cam1_counter++;
-          counter = state->cam1_counter;
-          break;
-        case 2:
-          state->cam2_counter++;
-          counter = state->cam2_counter;
-          break;
-      }
+    // Hardware timestamps are nanoseconds, written as integers so they do
+    // not lose precision through a double
+    const double index = camera_index.at(event.sensor_id);
+    writer.write(timestamp_stream,
+                 {index},
+                 {event.timestamp, event.sensor_timestamp});
+  };
 
-      // Save image
-      std::string image_path = output_path + "/";
-      image_path += std::to_string(counter) + ".png";
-      cv::imwrite(image_path, image);
-    }
-  }
-  timestamp_file.close();
+  return 0;
 }
 
 int main(const int argc, const char *argv[]) {
@@ -296,22 +295,41 @@ int main(const int argc, const char *argv[]) {
     return -1;
   }
 
-  // Launch threads
-  // clang-format off
+  // Setup recorder
   struct recorder_state state;
-  std::vector<std::thread> threads;
-  threads.emplace_back(pwm_thread, config.pwm_frequency, &state);
-  threads.emplace_back(gimbal_thread, config.gimbal_config, &state, config.output_dir);
-  threads.emplace_back(imu_thread, config.imu_config, &state, config.output_dir);
-  threads.emplace_back(camera_thread, 0, config.cam0_config, &state, config.output_dir);
-  threads.emplace_back(camera_thread, 1, config.cam1_config, &state, config.output_dir);
-  threads.emplace_back(camera_thread, 2, config.cam2_config, &state, config.output_dir);
-  // clang-format on
+  if (recorder_setup_writer(config.output_dir, &state) != 0) {
+    LOG_ERROR("Failed to setup recorder writer!");
+    return -1;
+  } else if (recorder_setup_sensors(config, &state) != 0) {
+    LOG_ERROR("Failed to setup sensors!");
+    return -1;
+  } else if (recorder_setup_service(config.output_dir, &state) != 0) {
+    LOG_ERROR("Failed to setup acquisition service!");
+    return -1;
+  }
 
-  // Join threads
-  for (auto &thread : threads) {
-    thread.join();
+  // Record until stopped or a sensor fails
+  if (state.writer.start() != 0 || state.service.start() != 0) {
+    LOG_ERROR("Failed to start recording!");
+    return -1;
+  }
+  while (halt != 1 && state.service.failed() == false) {
+    usleep(100 * 1000);
+  }
+  state.service.stop();
+  state.service.printStats();
+
+  // Capture statistics
+  for (int i = 0; i < 3; i++) {
+    const CaptureStats stats = state.ring[i]->stats();
+    LOG_INFO("cam%d: %lu frames grabbed, %lu frames dropped, %ld not written",
+             i,
+             (unsigned long) stats.frames_grabbed,
+             (unsigned long) stats.frames_dropped,
+             (long) state.writer.dropped(state.image_stream[i]));
+    state.ring[i]->stop();
   }
 
-  return 0;
+  // Flush remaining records
+  return state.writer.stop();
 }